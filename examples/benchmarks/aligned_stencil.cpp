@@ -0,0 +1,137 @@
+// Microbenchmark: the laplace example kernels (Jacobi update, max
+// difference, copy back) on CArray and FArray with three allocation
+// policies: the default new alignment, MATAR_HOST_ALIGNMENT (64 bytes),
+// and 64 bytes with the fastest dimension padded to whole cache lines.
+//
+// The grid is (height+2) x (width+2) like examples/laplace, so unpadded rows
+// of 1002 doubles start at a different offset within a line each time and
+// the inner loop splits lines.  The reported time is the best of num_trials
+// runs of num_reps sweeps.
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include "matar.h"
+
+using namespace mtr; // matar namespace
+
+const size_t num_trials = 5;
+const size_t num_reps = 20;
+const size_t height = 1000;
+const size_t width = 1000;
+
+template <typename F>
+double time_kernel(F kernel) {
+    double best = 1.0e30;
+    for (size_t trial = 0; trial < num_trials; trial++) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (size_t rep = 0; rep < num_reps; rep++) {
+            kernel();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+        best = seconds < best ? seconds : best;
+    }
+    return best;
+}
+
+// the laplace boundary conditions, zero inside
+template <typename A>
+void initialize(A &temperature_previous) {
+    for (size_t i = 0; i <= height+1; i++) {
+        for (size_t j = 0; j <= width+1; j++) {
+            temperature_previous(i,j) = 0.0;
+        }
+    }
+    for (size_t i = 0; i <= height+1; i++) {
+        temperature_previous(i,width+1) = (100.0/height)*i;
+    }
+    for (size_t j = 0; j <= width+1; j++) {
+        temperature_previous(height+1,j) = (100.0/width)*j;
+    }
+}
+
+// one laplace iteration, j is contiguous for CArray
+template <typename A>
+double sweep_c(A &temperature, A &temperature_previous) {
+    for (size_t i = 1; i <= height; i++) {
+        for (size_t j = 1; j <= width; j++) {
+            temperature(i,j) = 0.25 * (temperature_previous(i+1,j)
+                                     + temperature_previous(i-1,j)
+                                     + temperature_previous(i,j+1)
+                                     + temperature_previous(i,j-1));
+        }
+    }
+    double worst_dt = 0.0;
+    for (size_t i = 1; i <= height; i++) {
+        for (size_t j = 1; j <= width; j++) {
+            worst_dt = fmax(fabs(temperature(i,j) - temperature_previous(i,j)), worst_dt);
+        }
+    }
+    for (size_t i = 1; i <= height; i++) {
+        for (size_t j = 1; j <= width; j++) {
+            temperature_previous(i,j) = temperature(i,j);
+        }
+    }
+    return worst_dt;
+}
+
+// the same iteration with i contiguous for FArray
+template <typename A>
+double sweep_f(A &temperature, A &temperature_previous) {
+    for (size_t j = 1; j <= width; j++) {
+        for (size_t i = 1; i <= height; i++) {
+            temperature(i,j) = 0.25 * (temperature_previous(i+1,j)
+                                     + temperature_previous(i-1,j)
+                                     + temperature_previous(i,j+1)
+                                     + temperature_previous(i,j-1));
+        }
+    }
+    double worst_dt = 0.0;
+    for (size_t j = 1; j <= width; j++) {
+        for (size_t i = 1; i <= height; i++) {
+            worst_dt = fmax(fabs(temperature(i,j) - temperature_previous(i,j)), worst_dt);
+        }
+    }
+    for (size_t j = 1; j <= width; j++) {
+        for (size_t i = 1; i <= height; i++) {
+            temperature_previous(i,j) = temperature(i,j);
+        }
+    }
+    return worst_dt;
+}
+
+template <typename A>
+double run(const AllocPolicy &policy, bool c_order, double &worst_dt) {
+    A temperature(height+2, width+2, policy);
+    A temperature_previous(height+2, width+2, policy);
+    initialize(temperature);
+    initialize(temperature_previous);
+    return time_kernel([&]() {
+        worst_dt = c_order ? sweep_c(temperature, temperature_previous)
+                           : sweep_f(temperature, temperature_previous);
+    });
+}
+
+template <typename A>
+void report(const char *name, bool c_order) {
+    AllocPolicy unaligned;
+    unaligned.alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    double dt_new, dt_aligned, dt_padded;
+    double t_new = run<A>(unaligned, c_order, dt_new);
+    double t_aligned = run<A>(AllocPolicy(), c_order, dt_aligned);
+    double t_padded = run<A>(simd_padded<double>(), c_order, dt_padded);
+    printf("%-8s new %8.4f s   aligned %8.4f s (%5.2fx)   padded %8.4f s (%5.2fx)   %s\n",
+           name, t_new, t_aligned, t_new/t_aligned, t_padded, t_new/t_padded,
+           (dt_new == dt_aligned && dt_new == dt_padded) ? "match" : "MISMATCH");
+}
+
+int main() {
+
+    printf("aligned and padded allocation benchmark, laplace sweeps, best of %zu x %zu reps, %zu x %zu grid\n\n",
+           num_trials, num_reps, height+2, width+2);
+
+    report<CArray <double>>("CArray", true);
+    report<FArray <double>>("FArray", false);
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+// Benchmark: solving a batch of small dense systems A x = b, 3x3, 8x8 and
+// 24x24, written two ways.  The first is what a kernel does by hand today,
+// Gaussian elimination with partial pivoting inside a FOR_ALL with the
+// matrices stored num x n x n in C order.  The second is batched_solve
+// (batched_linalg.h) on the same matrices stored with the matrix index
+// fastest, so the host blocks vectorize across the batch and device loads
+// coalesce; with Kokkos it is also run with one team per matrix.
+//
+// The arrays are the Kokkos types in a Kokkos build and the host types
+// otherwise.  Each rep copies the matrices and right hand sides in, since
+// both versions solve in place, and the time of the copies alone is
+// subtracted; the reported time is the best of num_trials runs of num_reps
+// solves.
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include "matar.h"
+
+using namespace mtr; // matar namespace
+
+#ifdef HAVE_KOKKOS
+using CBatch = CArrayKokkos <double>;
+using FBatch = FArrayKokkos <double>;
+#else
+using CBatch = CArray <double>;
+using FBatch = FArray <double>;
+#endif
+
+const size_t num_trials = 5;
+const size_t num_reps = 10;
+const size_t num_entries = 1 << 23; // matrix entries in a batch
+
+template <typename F>
+double time_kernel(F kernel) {
+    double best = 1.0e30;
+    for (size_t trial = 0; trial < num_trials; trial++) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (size_t rep = 0; rep < num_reps; rep++) {
+            kernel();
+        }
+#ifdef HAVE_KOKKOS
+        Kokkos::fence();
+#endif
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+        best = seconds < best ? seconds : best;
+    }
+    return best;
+}
+
+// diagonally dominant after a row rotation, so every elimination step swaps rows
+template <typename A, typename V>
+void initialize(const A &a, const V &b, int num, int n) {
+    FOR_ALL (m, 0, num,
+             i, 0, n, {
+        for (int j = 0; j < n; j++) {
+            a(m,i,j) = (i == (j+1) % n) ? 2.0*n : 1.0/(1.0 + i + j + (m % 7));
+        }
+        b(m,i) = 1.0 + i;
+    });
+}
+
+// what a kernel writes by hand, one matrix per iteration
+void hand_solve(const CBatch &a, const CBatch &b, int num, int n) {
+    FOR_ALL (m, 0, num, {
+        for (int k = 0; k < n; k++) {
+            int p = k;
+            for (int i = k+1; i < n; i++) {
+                if (fabs(a(m,i,k)) > fabs(a(m,p,k))) p = i;
+            }
+            for (int j = 0; j < n; j++) {
+                double temp = a(m,k,j);
+                a(m,k,j) = a(m,p,j);
+                a(m,p,j) = temp;
+            }
+            double temp = b(m,k);
+            b(m,k) = b(m,p);
+            b(m,p) = temp;
+            for (int i = k+1; i < n; i++) {
+                double factor = a(m,i,k)/a(m,k,k);
+                for (int j = k; j < n; j++) {
+                    a(m,i,j) -= factor*a(m,k,j);
+                }
+                b(m,i) -= factor*b(m,k);
+            }
+        }
+        for (int i = n-1; i >= 0; i--) {
+            double sum = b(m,i);
+            for (int j = i+1; j < n; j++) {
+                sum -= a(m,i,j)*b(m,j);
+            }
+            b(m,i) = sum/a(m,i,i);
+        }
+    });
+}
+
+template <typename A>
+void copy(A &dest, const A &src) {
+    dest = src + 0.0;
+}
+
+template <typename V>
+double checksum(const V &x, int num, int n) {
+    double loc_sum = 0.0;
+    double sum = 0.0;
+    REDUCE_SUM (m, 0, num,
+                i, 0, n,
+                loc_sum, {
+        loc_sum += x(m,i);
+    }, sum);
+    return sum;
+}
+
+template <size_t N>
+void run() {
+    const int num = num_entries/(N*N);
+
+    CBatch a0_c(num, N, N), a_c(num, N, N), b0_c(num, N), b_c(num, N);
+    FBatch a0_f(num, N, N), a_f(num, N, N), b0_f(num, N), b_f(num, N);
+    initialize(a0_c, b0_c, num, N);
+    initialize(a0_f, b0_f, num, N);
+
+    double t_copy_c = time_kernel([&]() {
+        copy(a_c, a0_c);
+        copy(b_c, b0_c);
+    });
+    double t_copy_f = time_kernel([&]() {
+        copy(a_f, a0_f);
+        copy(b_f, b0_f);
+    });
+
+    double t_hand = time_kernel([&]() {
+        copy(a_c, a0_c);
+        copy(b_c, b0_c);
+        hand_solve(a_c, b_c, num, N);
+    }) - t_copy_c;
+    double sum_hand = checksum(b_c, num, N);
+
+    double t_batch = time_kernel([&]() {
+        copy(a_f, a0_f);
+        copy(b_f, b0_f);
+        batched_solve<N>(a_f, b_f);
+    }) - t_copy_f;
+    double sum_batch = checksum(b_f, num, N);
+
+    printf("%2zux%-2zu %8d systems   by hand %8.4f s   batched %8.4f s (%5.2fx)",
+           N, N, num, t_hand, t_batch, t_hand/t_batch);
+#ifdef HAVE_KOKKOS
+    double t_team = time_kernel([&]() {
+        copy(a_f, a0_f);
+        copy(b_f, b0_f);
+        batched_solve<N>(a_f, b_f, BatchMode::per_team);
+    }) - t_copy_f;
+    double sum_team = checksum(b_f, num, N);
+    printf("   per team %8.4f s (%5.2fx)", t_team, t_hand/t_team);
+    sum_batch = fabs(sum_team - sum_hand) > fabs(sum_batch - sum_hand) ? sum_team : sum_batch;
+#endif
+    printf("   %s\n", fabs(sum_batch - sum_hand) <= 1e-9*fabs(sum_hand) ? "match" : "MISMATCH");
+}
+
+int main() {
+
+#ifdef HAVE_KOKKOS
+    Kokkos::initialize();
+    {
+#endif
+
+    printf("batched small dense solves, best of %zu x %zu reps, %zu matrix entries per batch\n\n",
+           num_trials, num_reps, num_entries);
+
+    run<3>();
+    run<8>();
+    run<24>();
+
+#ifdef HAVE_KOKKOS
+    }
+    Kokkos::finalize();
+#endif
+
+    return 0;
+}
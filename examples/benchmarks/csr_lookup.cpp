@@ -0,0 +1,104 @@
+// Microbenchmark: random A(i,j) lookups in a CSRArray as the row length grows.
+//
+// Compares a linear scan of the row (how CSRArray used to search), the binary
+// search over the sorted columns, and the per-row hash index from
+// build_hash_index().  Half of the lookups hit a stored entry and half miss,
+// as in an assembly loop that probes a fixed sparsity pattern.  The reported
+// time is the best of num_trials runs, in nanoseconds per lookup.
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include "matar.h"
+
+using namespace mtr; // matar namespace
+
+const size_t num_trials = 5;
+const size_t num_lookups = 1 << 20;
+const size_t num_entries = 1 << 18;  // about the same nnz for every row length
+
+template <typename F>
+double time_kernel(F kernel) {
+    double best = 1.0e30;
+    for (size_t trial = 0; trial < num_trials; trial++) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        kernel();
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+        best = seconds < best ? seconds : best;
+    }
+    return best;
+}
+
+// the search CSRArray did before the columns were sorted
+size_t linear_flat_index(CSRArray<double> &A, size_t i, size_t j) {
+    for (size_t k = A.begin_index(i); k < A.end_index(i); k++) {
+        if (A.get_col_flat(k) == j) return k;
+    }
+    return A.nnz();
+}
+
+int main() {
+
+    printf("CSRArray lookup benchmark, %zu random lookups, best of %zu, ns per lookup\n\n",
+           num_lookups, num_trials);
+    printf("%10s %12s %12s %12s\n", "row nnz", "linear", "binary", "hash");
+
+    srand(1);
+    for (size_t row_nnz = 4; row_nnz <= 4096; row_nnz *= 4) {
+        size_t dim1 = num_entries / row_nnz;
+        size_t dim2 = 2 * row_nnz;
+
+        // every row stores the even columns
+        CArray<double> values(dim1 * row_nnz);
+        CArray<size_t> columns(dim1 * row_nnz);
+        CArray<size_t> starts(dim1 + 1);
+        for (size_t i = 0; i <= dim1; i++) {
+            starts(i) = i * row_nnz;
+        }
+        for (size_t k = 0; k < dim1 * row_nnz; k++) {
+            columns(k) = 2 * (k % row_nnz);
+            values(k) = 1.0;
+        }
+        CSRArray<double> A(values, columns, starts, dim1, dim2);
+
+        CArray<size_t> rows(num_lookups);
+        CArray<size_t> cols(num_lookups);
+        for (size_t n = 0; n < num_lookups; n++) {
+            rows(n) = rand() % dim1;
+            cols(n) = rand() % dim2;
+        }
+
+        double sum_linear = 0.0;
+        double sum_binary = 0.0;
+        double sum_hash = 0.0;
+
+        double t_linear = time_kernel([&]() {
+            sum_linear = 0.0;
+            for (size_t n = 0; n < num_lookups; n++) {
+                size_t k = linear_flat_index(A, rows(n), cols(n));
+                sum_linear += (k < A.nnz()) ? A.get_val_flat(k) : 0.0;
+            }
+        });
+
+        double t_binary = time_kernel([&]() {
+            sum_binary = 0.0;
+            for (size_t n = 0; n < num_lookups; n++) {
+                sum_binary += A(rows(n), cols(n));
+            }
+        });
+
+        A.build_hash_index(0);
+        double t_hash = time_kernel([&]() {
+            sum_hash = 0.0;
+            for (size_t n = 0; n < num_lookups; n++) {
+                sum_hash += A(rows(n), cols(n));
+            }
+        });
+
+        printf("%10zu %12.2f %12.2f %12.2f   %s\n", row_nnz,
+               1e9 * t_linear / num_lookups, 1e9 * t_binary / num_lookups, 1e9 * t_hash / num_lookups,
+               (sum_linear == sum_binary && sum_binary == sum_hash) ? "match" : "MISMATCH");
+    }
+
+    return 0;
+}
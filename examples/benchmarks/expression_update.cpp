@@ -0,0 +1,167 @@
+// Benchmark: the update a = b + dt*c - d over whole arrays written three
+// ways, a hand-written fused FOR_ALL, the same update as an expression
+// (expressions.h), and the unfused form with one FOR_ALL per operation and a
+// temporary, which reads and writes memory three times.
+//
+// The arrays are CArrayKokkos in a Kokkos build and CArray otherwise, so the
+// FOR_ALL loops and the expression loop both run on the configured backend.
+// The update is run on a 1D and a 3D array of the same length, the
+// expression loop is over the storage in both cases.  The reported time is
+// the best of num_trials runs of num_reps updates.
+#include <stdio.h>
+#include <chrono>
+#include "matar.h"
+
+using namespace mtr; // matar namespace
+
+#ifdef HAVE_KOKKOS
+using Array = CArrayKokkos <double>;
+#else
+using Array = CArray <double>;
+#endif
+
+const size_t num_trials = 5;
+const size_t num_reps = 20;
+const int n3 = 256;          // 3D arrays are n3^3
+const int n1 = n3*n3*n3;     // 1D arrays have the same length
+
+template <typename F>
+double time_kernel(F kernel) {
+    double best = 1.0e30;
+    for (size_t trial = 0; trial < num_trials; trial++) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (size_t rep = 0; rep < num_reps; rep++) {
+            kernel();
+        }
+#ifdef HAVE_KOKKOS
+        Kokkos::fence();
+#endif
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+        best = seconds < best ? seconds : best;
+    }
+    return best;
+}
+
+double checksum(const Array &a) {
+    double loc_sum = 0.0;
+    double sum = 0.0;
+    REDUCE_SUM (i, 0, n1,
+                loc_sum, {
+        loc_sum += a.pointer()[i];
+    }, sum);
+    return sum;
+}
+
+void report(const char *name, double t_hand, double t_expr, double t_unfused,
+            double sum_hand, double sum_expr, double sum_unfused) {
+    printf("%-4s FOR_ALL %8.4f s   expression %8.4f s (%5.2fx)   unfused %8.4f s (%5.2fx)   %s\n",
+           name, t_hand, t_expr, t_hand/t_expr, t_unfused, t_hand/t_unfused,
+           (sum_hand == sum_expr && sum_hand == sum_unfused) ? "match" : "MISMATCH");
+}
+
+int main() {
+
+#ifdef HAVE_KOKKOS
+    Kokkos::initialize();
+    {
+#endif
+
+    printf("expression template benchmark, a = b + dt*c - d, best of %zu x %zu reps, %d elements\n\n",
+           num_trials, num_reps, n1);
+
+    const double dt = 0.01;
+
+    {
+        Array a(n1);
+        Array b(n1);
+        Array c(n1);
+        Array d(n1);
+        Array tmp(n1);
+        FOR_ALL (i, 0, n1, {
+            b(i) = 1.0 + (i % 7);
+            c(i) = 2.0 - (i % 5);
+            d(i) = 0.5;
+        });
+
+        double t_hand = time_kernel([&]() {
+            FOR_ALL (i, 0, n1, {
+                a(i) = b(i) + dt*c(i) - d(i);
+            });
+        });
+        double sum_hand = checksum(a);
+
+        double t_expr = time_kernel([&]() { a = b + dt*c - d; });
+        double sum_expr = checksum(a);
+
+        double t_unfused = time_kernel([&]() {
+            FOR_ALL (i, 0, n1, {
+                tmp(i) = dt*c(i);
+            });
+            FOR_ALL (i, 0, n1, {
+                tmp(i) = b(i) + tmp(i);
+            });
+            FOR_ALL (i, 0, n1, {
+                a(i) = tmp(i) - d(i);
+            });
+        });
+        double sum_unfused = checksum(a);
+
+        report("1D", t_hand, t_expr, t_unfused, sum_hand, sum_expr, sum_unfused);
+    }
+
+    {
+        Array a(n3, n3, n3);
+        Array b(n3, n3, n3);
+        Array c(n3, n3, n3);
+        Array d(n3, n3, n3);
+        Array tmp(n3, n3, n3);
+        FOR_ALL (i, 0, n3,
+                 j, 0, n3,
+                 k, 0, n3, {
+            b(i,j,k) = 1.0 + ((i + j + k) % 7);
+            c(i,j,k) = 2.0 - ((i + j + k) % 5);
+            d(i,j,k) = 0.5;
+        });
+
+        double t_hand = time_kernel([&]() {
+            FOR_ALL (i, 0, n3,
+                     j, 0, n3,
+                     k, 0, n3, {
+                a(i,j,k) = b(i,j,k) + dt*c(i,j,k) - d(i,j,k);
+            });
+        });
+        double sum_hand = checksum(a);
+
+        double t_expr = time_kernel([&]() { a = b + dt*c - d; });
+        double sum_expr = checksum(a);
+
+        double t_unfused = time_kernel([&]() {
+            FOR_ALL (i, 0, n3,
+                     j, 0, n3,
+                     k, 0, n3, {
+                tmp(i,j,k) = dt*c(i,j,k);
+            });
+            FOR_ALL (i, 0, n3,
+                     j, 0, n3,
+                     k, 0, n3, {
+                tmp(i,j,k) = b(i,j,k) + tmp(i,j,k);
+            });
+            FOR_ALL (i, 0, n3,
+                     j, 0, n3,
+                     k, 0, n3, {
+                a(i,j,k) = tmp(i,j,k) - d(i,j,k);
+            });
+        });
+        double sum_unfused = checksum(a);
+
+        report("3D", t_hand, t_expr, t_unfused, sum_hand, sum_expr, sum_unfused);
+    }
+
+#ifdef HAVE_KOKKOS
+    }
+    Kokkos::finalize();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+// Microbenchmark: runtime-rank dense types (CArray, FArray, CMatrix, FMatrix)
+// against the fixed-rank types (CArrayND, ...) that precompute strides.
+//
+// Each kernel walks a 4D or 7D array in its natural (contiguous) order and
+// does a read-modify-write per element.  The arrays are sized to stay in
+// cache so the indexing cost is not hidden behind memory bandwidth; the
+// reported time is the best of num_trials runs of num_reps sweeps.
+#include <stdio.h>
+#include <chrono>
+#include "matar.h"
+
+using namespace mtr; // matar namespace
+
+const size_t num_trials = 5;
+const size_t num_reps = 200;
+const size_t n4 = 12;   // 4D arrays are n4^4
+const size_t n7 = 4;    // 7D arrays are n7^7
+
+template <typename F>
+double time_kernel(F kernel) {
+    double best = 1.0e30;
+    for (size_t trial = 0; trial < num_trials; trial++) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (size_t rep = 0; rep < num_reps; rep++) {
+            kernel();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+        best = seconds < best ? seconds : best;
+    }
+    return best;
+}
+
+// row-major, 0-based
+template <typename A>
+void sweep_c4(A &a) {
+    for (size_t i = 0; i < n4; i++)
+    for (size_t j = 0; j < n4; j++)
+    for (size_t k = 0; k < n4; k++)
+    for (size_t l = 0; l < n4; l++)
+        a(i,j,k,l) = 0.5*a(i,j,k,l) + 1.0;
+}
+
+template <typename A>
+void sweep_c7(A &a) {
+    for (size_t i = 0; i < n7; i++)
+    for (size_t j = 0; j < n7; j++)
+    for (size_t k = 0; k < n7; k++)
+    for (size_t l = 0; l < n7; l++)
+    for (size_t m = 0; m < n7; m++)
+    for (size_t n = 0; n < n7; n++)
+    for (size_t o = 0; o < n7; o++)
+        a(i,j,k,l,m,n,o) = 0.5*a(i,j,k,l,m,n,o) + 1.0;
+}
+
+// column-major, 0-based
+template <typename A>
+void sweep_f4(A &a) {
+    for (size_t l = 0; l < n4; l++)
+    for (size_t k = 0; k < n4; k++)
+    for (size_t j = 0; j < n4; j++)
+    for (size_t i = 0; i < n4; i++)
+        a(i,j,k,l) = 0.5*a(i,j,k,l) + 1.0;
+}
+
+// row-major, 1-based
+template <typename A>
+void sweep_cm4(A &a) {
+    for (size_t i = 1; i <= n4; i++)
+    for (size_t j = 1; j <= n4; j++)
+    for (size_t k = 1; k <= n4; k++)
+    for (size_t l = 1; l <= n4; l++)
+        a(i,j,k,l) = 0.5*a(i,j,k,l) + 1.0;
+}
+
+// column-major, 1-based
+template <typename A>
+void sweep_fm4(A &a) {
+    for (size_t l = 1; l <= n4; l++)
+    for (size_t k = 1; k <= n4; k++)
+    for (size_t j = 1; j <= n4; j++)
+    for (size_t i = 1; i <= n4; i++)
+        a(i,j,k,l) = 0.5*a(i,j,k,l) + 1.0;
+}
+
+template <typename A>
+double checksum(const A &a) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); i++) {
+        sum += a.pointer()[i];
+    }
+    return sum;
+}
+
+void report(const char *name, double t_old, double t_new, double sum_old, double sum_new) {
+    printf("%-10s runtime rank %8.4f s   fixed rank %8.4f s   speedup %5.2fx   %s\n",
+           name, t_old, t_new, t_old/t_new, sum_old == sum_new ? "match" : "MISMATCH");
+}
+
+int main() {
+
+    printf("fixed-rank indexing benchmark, best of %zu x %zu reps, 4D = %zu^4, 7D = %zu^7\n\n",
+           num_trials, num_reps, n4, n7);
+
+    {
+        CArray <double> a(n4, n4, n4, n4);
+        CArrayND <double,4> b(n4, n4, n4, n4);
+        for (size_t i = 0; i < a.size(); i++) { a.pointer()[i] = b.pointer()[i] = 1.0; }
+        double t_old = time_kernel([&]() { sweep_c4(a); });
+        double t_new = time_kernel([&]() { sweep_c4(b); });
+        report("CArray4D", t_old, t_new, checksum(a), checksum(b));
+    }
+
+    {
+        CArray <double> a(n7, n7, n7, n7, n7, n7, n7);
+        CArrayND <double,7> b(n7, n7, n7, n7, n7, n7, n7);
+        for (size_t i = 0; i < a.size(); i++) { a.pointer()[i] = b.pointer()[i] = 1.0; }
+        double t_old = time_kernel([&]() { sweep_c7(a); });
+        double t_new = time_kernel([&]() { sweep_c7(b); });
+        report("CArray7D", t_old, t_new, checksum(a), checksum(b));
+    }
+
+    {
+        FArray <double> a(n4, n4, n4, n4);
+        FArrayND <double,4> b(n4, n4, n4, n4);
+        for (size_t i = 0; i < a.size(); i++) { a.pointer()[i] = b.pointer()[i] = 1.0; }
+        double t_old = time_kernel([&]() { sweep_f4(a); });
+        double t_new = time_kernel([&]() { sweep_f4(b); });
+        report("FArray4D", t_old, t_new, checksum(a), checksum(b));
+    }
+
+    {
+        CMatrix <double> a(n4, n4, n4, n4);
+        CMatrixND <double,4> b(n4, n4, n4, n4);
+        for (size_t i = 0; i < a.size(); i++) { a.pointer()[i] = b.pointer()[i] = 1.0; }
+        double t_old = time_kernel([&]() { sweep_cm4(a); });
+        double t_new = time_kernel([&]() { sweep_cm4(b); });
+        report("CMatrix4D", t_old, t_new, checksum(a), checksum(b));
+    }
+
+    {
+        FMatrix <double> a(n4, n4, n4, n4);
+        FMatrixND <double,4> b(n4, n4, n4, n4);
+        for (size_t i = 0; i < a.size(); i++) { a.pointer()[i] = b.pointer()[i] = 1.0; }
+        double t_old = time_kernel([&]() { sweep_fm4(a); });
+        double t_new = time_kernel([&]() { sweep_fm4(b); });
+        report("FMatrix4D", t_old, t_new, checksum(a), checksum(b));
+    }
+
+    {
+        double *raw_a = new double[n4*n4*n4*n4];
+        double *raw_b = new double[n4*n4*n4*n4];
+        for (size_t i = 0; i < n4*n4*n4*n4; i++) { raw_a[i] = raw_b[i] = 1.0; }
+        ViewCArray <double> a(raw_a, n4, n4, n4, n4);
+        ViewCArrayND <double,4> b(raw_b, n4, n4, n4, n4);
+        double t_old = time_kernel([&]() { sweep_c4(a); });
+        double t_new = time_kernel([&]() { sweep_c4(b); });
+        report("ViewCArray", t_old, t_new, checksum(a), checksum(b));
+        delete[] raw_a;
+        delete[] raw_b;
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+// Benchmark: STREAM triad, a = b + scalar*c, on DCArrayKokkos arrays made
+// three ways: the usual zero-filled DualView (Kokkos fills it on one
+// thread), ArrayInit::none, and ArrayInit::first_touch, which writes every
+// page from the thread whose FOR_ALL block holds it.
+//
+// Build with the OpenMP backend and run on a multi-socket node with
+// OMP_PROC_BIND=spread OMP_PLACES=threads.  With the zero-filled arrays all
+// pages sit on the first socket and the triad runs at one socket's memory
+// bandwidth; with first touch each socket streams from its own memory.
+// none leaves placement to whatever loop writes first, here the triad
+// itself.  The reported bandwidth is the best of num_trials runs of
+// num_reps triads, counting three arrays of traffic per triad.
+#include <stdio.h>
+#include <chrono>
+#include "matar.h"
+
+using namespace mtr; // matar namespace
+
+const size_t num_trials = 5;
+const size_t num_reps = 20;
+const size_t n = 1 << 25; // 256 MB per array of doubles
+
+template <typename F>
+double time_kernel(F kernel) {
+    double best = 1.0e30;
+    for (size_t trial = 0; trial < num_trials; trial++) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (size_t rep = 0; rep < num_reps; rep++) {
+            kernel();
+        }
+        Kokkos::fence();
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+        best = seconds < best ? seconds : best;
+    }
+    return best;
+}
+
+// allocation and the first triad are timed separately, the first triad also
+// takes the page faults when the arrays were not touched
+double triad(ArrayInit init, double &alloc_seconds, double &checksum) {
+    auto begin = std::chrono::high_resolution_clock::now();
+    DCArrayKokkos <double> a(init, "a", n);
+    DCArrayKokkos <double> b(init, "b", n);
+    DCArrayKokkos <double> c(init, "c", n);
+    Kokkos::fence();
+    auto end = std::chrono::high_resolution_clock::now();
+    alloc_seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+
+    FOR_ALL (i, 0, n, {
+        b(i) = 1.0;
+        c(i) = 2.0;
+    });
+    const double scalar = 3.0;
+    double seconds = time_kernel([&]() {
+        FOR_ALL (i, 0, n, {
+            a(i) = b(i) + scalar*c(i);
+        });
+    });
+
+    double loc_sum = 0.0;
+    checksum = 0.0;
+    REDUCE_SUM (i, 0, n,
+                loc_sum, {
+        loc_sum += a(i);
+    }, checksum);
+    return seconds;
+}
+
+int main() {
+
+    Kokkos::initialize();
+    {
+
+    printf("first touch benchmark, STREAM triad on DCArrayKokkos, %zu doubles per array, best of %zu x %zu reps\n\n",
+           n, num_trials, num_reps);
+
+    const double bytes = 3.0 * sizeof(double) * n * num_reps;
+    const ArrayInit inits[] = {ArrayInit::zero, ArrayInit::none, ArrayInit::first_touch};
+    const char* names[] = {"zero", "none", "first_touch"};
+
+    double expected = 0.0;
+    for (size_t m = 0; m < 3; m++) {
+        double alloc_seconds = 0.0;
+        double checksum = 0.0;
+        double seconds = triad(inits[m], alloc_seconds, checksum);
+        if (m == 0) expected = checksum;
+        printf("%-12s allocate %8.4f s   triad %8.2f GB/s   %s\n",
+               names[m], alloc_seconds, bytes / seconds * 1e-9,
+               checksum == expected ? "match" : "MISMATCH");
+    }
+
+    }
+    Kokkos::finalize();
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+// Benchmark: the flat-View Kokkos types (CArrayKokkos, FArrayKokkos) against
+// the rank-N View types (CArrayKokkosND, FArrayKokkosND) on the Jacobi
+// stencil of examples/laplace, in 2D and in 3D (7-point).
+//
+// Each sweep is the laplace update, temperature from temperature_previous,
+// followed by the copy back.  The arrays are larger than cache, so the
+// difference is what Kokkos' own indexing and layout give over the hand
+// computed flat offset; the reported time is the best of num_trials runs of
+// num_reps sweeps.
+#include <stdio.h>
+#include <chrono>
+#include "matar.h"
+
+using namespace mtr; // matar namespace
+
+const size_t num_trials = 5;
+const size_t num_reps = 20;
+const int n2 = 2048; // 2D arrays are n2^2
+const int n3 = 160;  // 3D arrays are n3^3
+
+template <typename F>
+double time_kernel(F kernel) {
+    double best = 1.0e30;
+    for (size_t trial = 0; trial < num_trials; trial++) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (size_t rep = 0; rep < num_reps; rep++) {
+            kernel();
+        }
+        Kokkos::fence();
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+        best = seconds < best ? seconds : best;
+    }
+    return best;
+}
+
+// zero inside, a linear profile on the last row (2D) or face (3D)
+template <typename A>
+void initialize_2d(const A &temperature_previous) {
+    FOR_ALL (i, 0, n2,
+             j, 0, n2, {
+        temperature_previous(i,j) = (i == n2-1) ? (100.0/n2)*j : 0.0;
+    });
+}
+
+template <typename A>
+void initialize_3d(const A &temperature_previous) {
+    FOR_ALL (i, 0, n3,
+             j, 0, n3,
+             k, 0, n3, {
+        temperature_previous(i,j,k) = (i == n3-1) ? (100.0/n3)*(j+k) : 0.0;
+    });
+}
+
+// row-major, the last index is contiguous
+template <typename A>
+void jacobi_c2d(const A &temperature, const A &temperature_previous) {
+    FOR_ALL (i, 1, n2-1,
+             j, 1, n2-1, {
+        temperature(i,j) = 0.25 * (temperature_previous(i+1,j)
+                                 + temperature_previous(i-1,j)
+                                 + temperature_previous(i,j+1)
+                                 + temperature_previous(i,j-1));
+    });
+    FOR_ALL (i, 1, n2-1,
+             j, 1, n2-1, {
+        temperature_previous(i,j) = temperature(i,j);
+    });
+}
+
+template <typename A>
+void jacobi_c3d(const A &temperature, const A &temperature_previous) {
+    FOR_ALL (i, 1, n3-1,
+             j, 1, n3-1,
+             k, 1, n3-1, {
+        temperature(i,j,k) = (1.0/6.0) * (temperature_previous(i+1,j,k)
+                                        + temperature_previous(i-1,j,k)
+                                        + temperature_previous(i,j+1,k)
+                                        + temperature_previous(i,j-1,k)
+                                        + temperature_previous(i,j,k+1)
+                                        + temperature_previous(i,j,k-1));
+    });
+    FOR_ALL (i, 1, n3-1,
+             j, 1, n3-1,
+             k, 1, n3-1, {
+        temperature_previous(i,j,k) = temperature(i,j,k);
+    });
+}
+
+// column-major, the first index is contiguous so it is the last loop
+template <typename A>
+void jacobi_f3d(const A &temperature, const A &temperature_previous) {
+    FOR_ALL (k, 1, n3-1,
+             j, 1, n3-1,
+             i, 1, n3-1, {
+        temperature(i,j,k) = (1.0/6.0) * (temperature_previous(i+1,j,k)
+                                        + temperature_previous(i-1,j,k)
+                                        + temperature_previous(i,j+1,k)
+                                        + temperature_previous(i,j-1,k)
+                                        + temperature_previous(i,j,k+1)
+                                        + temperature_previous(i,j,k-1));
+    });
+    FOR_ALL (k, 1, n3-1,
+             j, 1, n3-1,
+             i, 1, n3-1, {
+        temperature_previous(i,j,k) = temperature(i,j,k);
+    });
+}
+
+template <typename A>
+double checksum_2d(const A &a) {
+    double loc_sum = 0.0;
+    double sum = 0.0;
+    REDUCE_SUM (i, 0, n2,
+                j, 0, n2,
+                loc_sum, {
+        loc_sum += a(i,j);
+    }, sum);
+    return sum;
+}
+
+template <typename A>
+double checksum_3d(const A &a) {
+    double loc_sum = 0.0;
+    double sum = 0.0;
+    REDUCE_SUM (i, 0, n3,
+                j, 0, n3,
+                k, 0, n3,
+                loc_sum, {
+        loc_sum += a(i,j,k);
+    }, sum);
+    return sum;
+}
+
+void report(const char *name, double t_old, double t_new, double sum_old, double sum_new) {
+    printf("%-16s flat view %8.4f s   rank-N view %8.4f s   speedup %5.2fx   %s\n",
+           name, t_old, t_new, t_old/t_new, sum_old == sum_new ? "match" : "MISMATCH");
+}
+
+int main() {
+
+    Kokkos::initialize();
+    {
+
+    printf("rank-N Kokkos View benchmark, laplace Jacobi sweeps, best of %zu x %zu reps, 2D = %d^2, 3D = %d^3\n\n",
+           num_trials, num_reps, n2, n3);
+
+    {
+        CArrayKokkos <double> a(n2, n2);
+        CArrayKokkos <double> a_previous(n2, n2);
+        CArrayKokkosND <double,2> b(n2, n2);
+        CArrayKokkosND <double,2> b_previous(n2, n2);
+        initialize_2d(a_previous);
+        initialize_2d(b_previous);
+        double t_old = time_kernel([&]() { jacobi_c2d(a, a_previous); });
+        double t_new = time_kernel([&]() { jacobi_c2d(b, b_previous); });
+        report("CArrayKokkos2D", t_old, t_new, checksum_2d(a_previous), checksum_2d(b_previous));
+    }
+
+    {
+        CArrayKokkos <double> a(n3, n3, n3);
+        CArrayKokkos <double> a_previous(n3, n3, n3);
+        CArrayKokkosND <double,3> b(n3, n3, n3);
+        CArrayKokkosND <double,3> b_previous(n3, n3, n3);
+        initialize_3d(a_previous);
+        initialize_3d(b_previous);
+        double t_old = time_kernel([&]() { jacobi_c3d(a, a_previous); });
+        double t_new = time_kernel([&]() { jacobi_c3d(b, b_previous); });
+        report("CArrayKokkos3D", t_old, t_new, checksum_3d(a_previous), checksum_3d(b_previous));
+    }
+
+    {
+        FArrayKokkos <double> a(n3, n3, n3);
+        FArrayKokkos <double> a_previous(n3, n3, n3);
+        FArrayKokkosND <double,3> b(n3, n3, n3);
+        FArrayKokkosND <double,3> b_previous(n3, n3, n3);
+        initialize_3d(a_previous);
+        initialize_3d(b_previous);
+        double t_old = time_kernel([&]() { jacobi_f3d(a, a_previous); });
+        double t_new = time_kernel([&]() { jacobi_f3d(b, b_previous); });
+        report("FArrayKokkos3D", t_old, t_new, checksum_3d(a_previous), checksum_3d(b_previous));
+    }
+
+    }
+    Kokkos::finalize();
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Microbenchmark: a timestep loop that creates and destroys a handful of
+// small scratch CArrays per cell block, the pattern the solvers use for
+// temporaries.  Each step is run with the default aligned operator new, a
+// PoolAllocator and an ArenaAllocator rewound at the end of every step.
+//
+// The arrays are small, so the time is mostly allocation; the pool and arena
+// rows should show nearly all requests served without going upstream.  The
+// reported time is the best of num_trials runs of num_steps steps.
+#include <stdio.h>
+#include <chrono>
+#include "matar.h"
+
+using namespace mtr; // matar namespace
+
+const size_t num_trials = 5;
+const size_t num_steps = 200;
+const size_t num_blocks = 500;
+const size_t block_size = 8;
+
+template <typename F>
+double time_kernel(F kernel) {
+    double best = 1.0e30;
+    for (size_t trial = 0; trial < num_trials; trial++) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (size_t step = 0; step < num_steps; step++) {
+            kernel();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+        best = seconds < best ? seconds : best;
+    }
+    return best;
+}
+
+// one block of cells: a gradient, a stress and a flux temporary
+double block_work(const AllocPolicy &policy, size_t block) {
+    CArray <double> gradient(block_size, 3, policy);
+    CArray <double> stress(block_size, 3, 3, policy);
+    CArray <double> flux(block_size, policy);
+    for (size_t i = 0; i < block_size; i++) {
+        for (size_t d = 0; d < 3; d++) {
+            gradient(i,d) = double(block + i + d);
+        }
+    }
+    for (size_t i = 0; i < block_size; i++) {
+        flux(i) = 0.0;
+        for (size_t d = 0; d < 3; d++) {
+            for (size_t e = 0; e < 3; e++) {
+                stress(i,d,e) = gradient(i,d) * gradient(i,e);
+                flux(i) += stress(i,d,e);
+            }
+        }
+    }
+    double sum = 0.0;
+    for (size_t i = 0; i < block_size; i++) {
+        sum += flux(i);
+    }
+    return sum;
+}
+
+double step(const AllocPolicy &policy) {
+    double sum = 0.0;
+    for (size_t block = 0; block < num_blocks; block++) {
+        sum += block_work(policy, block);
+    }
+    return sum;
+}
+
+int main() {
+
+    printf("scratch allocation benchmark, %zu blocks x 3 temporaries per step, best of %zu x %zu steps\n\n",
+           num_blocks, num_trials, num_steps);
+
+    double sum_new = 0.0;
+    double sum_pool = 0.0;
+    double sum_arena = 0.0;
+
+    double t_new = time_kernel([&]() { sum_new = step(AllocPolicy()); });
+
+    PoolAllocator pool("pool");
+    AllocPolicy pool_policy;
+    pool_policy.allocator = &pool;
+    double t_pool = time_kernel([&]() { sum_pool = step(pool_policy); });
+
+    ArenaAllocator arena("arena");
+    AllocPolicy arena_policy;
+    arena_policy.allocator = &arena;
+    double t_arena = time_kernel([&]() {
+        ArenaScope scope(arena);
+        sum_arena = step(arena_policy);
+    });
+
+    printf("new   %8.4f s\n", t_new);
+    printf("pool  %8.4f s (%5.2fx)\n", t_pool, t_new/t_pool);
+    printf("arena %8.4f s (%5.2fx)   %s\n\n", t_arena, t_new/t_arena,
+           (sum_new == sum_pool && sum_new == sum_arena) ? "match" : "MISMATCH");
+
+    pool.report();
+    arena.report();
+
+    return 0;
+}
@@ -0,0 +1,424 @@
+// Benchmark: sparse matrix-vector products y = A*x (sparse_linalg.h) with each
+// of the spmv variants, for the CSR and CSC types, on synthetic matrices and
+// on any Matrix Market files given on the command line,
+//
+//     ./spmv [matrix.mtx ...]
+//
+// The synthetic matrices are a 2D 5-point Laplacian (every row about the same
+// length), a 3D elasticity pattern of 3 x 3 blocks, rows with power law lengths
+// and random columns, and an arrow (a diagonal with a few full rows), where one
+// thread per row leaves most of the threads waiting for the few long rows.
+// The SELL-C-sigma line (SELLArray) shows C-sigma and the padded size over
+// nnz, and the BSR line (BSRArray, when the dims are multiples of 3) the
+// stored block values over nnz.  GB/s counts the values and indices of A, the
+// row (or column) starts, x and y each once, the least traffic the product
+// can have, and GFLOP/s counts 2 flops per stored value.
+//
+// The arrays are the Kokkos types in a Kokkos build and the host types
+// otherwise.  The reported time is the best of num_trials runs of num_reps
+// products, and each result is checked against the CSR row_per_thread one.
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "matar.h"
+
+using namespace mtr; // matar namespace
+
+#ifdef HAVE_KOKKOS
+using Vector = CArrayKokkos <double>;
+using CSR = CSRArrayKokkos <double>;
+using CSC = CSCArrayKokkos <double>;
+using SELL = SELLArrayKokkos <double>;
+using BSR = BSRArrayKokkos <double,3>;
+#else
+using Vector = CArray <double>;
+using CSR = CSRArray <double>;
+using CSC = CSCArray <double>;
+using SELL = SELLArray <double>;
+using BSR = BSRArray <double,3>;
+#endif
+
+const size_t num_trials = 5;
+const size_t num_reps = 10;
+const size_t grid = 1000;       // the Laplacian is grid^2 x grid^2
+const size_t solid_grid = 50;   // the elasticity matrix has 3 solid_grid^3 rows
+const size_t num_rows = 1000000; // rows of the other synthetic matrices
+
+template <typename F>
+double time_kernel(F kernel) {
+    double best = 1.0e30;
+    for (size_t trial = 0; trial < num_trials; trial++) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (size_t rep = 0; rep < num_reps; rep++) {
+            kernel();
+        }
+#ifdef HAVE_KOKKOS
+        Kokkos::fence();
+#endif
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+        best = seconds < best ? seconds : best;
+    }
+    return best/num_reps;
+}
+
+// a compressed row matrix on the host, as the generators and the reader make it
+struct HostMatrix {
+    size_t rows = 0;
+    size_t cols = 0;
+    CArray <size_t> starts;
+    CArray <size_t> columns;
+    CArray <double> values;
+};
+
+// the starts from the row lengths in starts(1..rows)
+void prefix_sum(HostMatrix &m) {
+    m.starts(0) = 0;
+    for (size_t i = 0; i < m.rows; i++) {
+        m.starts(i+1) += m.starts(i);
+    }
+}
+
+HostMatrix laplace_2d(size_t n) {
+    HostMatrix m;
+    m.rows = m.cols = n*n;
+    m.starts = CArray <size_t> (m.rows+1);
+    m.columns = CArray <size_t> (5*m.rows);
+    m.values = CArray <double> (5*m.rows);
+    size_t k = 0;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            size_t row = i*n + j;
+            m.starts(row) = k;
+            if (i > 0)   { m.columns(k) = row - n; m.values(k++) = -1.0; }
+            if (j > 0)   { m.columns(k) = row - 1; m.values(k++) = -1.0; }
+            m.columns(k) = row; m.values(k++) = 4.0;
+            if (j < n-1) { m.columns(k) = row + 1; m.values(k++) = -1.0; }
+            if (i < n-1) { m.columns(k) = row + n; m.values(k++) = -1.0; }
+        }
+    }
+    m.starts(m.rows) = k;
+    return m;
+}
+
+// 3 unknowns per node of an n^3 grid, with a full 3 x 3 block for each node
+// and its 6 neighbors, the pattern of a 3D elasticity system
+HostMatrix elasticity_3d(size_t n) {
+    HostMatrix m;
+    m.rows = m.cols = 3*n*n*n;
+    m.starts = CArray <size_t> (m.rows+1);
+    m.columns = CArray <size_t> (21*m.rows);
+    m.values = CArray <double> (21*m.rows);
+    size_t k = 0;
+    for (size_t node = 0; node < n*n*n; node++) {
+        size_t i = node/(n*n), j = (node/n) % n, l = node % n;
+        size_t neighbors[7];
+        size_t count = 0;
+        if (i > 0)   neighbors[count++] = node - n*n;
+        if (j > 0)   neighbors[count++] = node - n;
+        if (l > 0)   neighbors[count++] = node - 1;
+        neighbors[count++] = node;
+        if (l < n-1) neighbors[count++] = node + 1;
+        if (j < n-1) neighbors[count++] = node + n;
+        if (i < n-1) neighbors[count++] = node + n*n;
+        for (size_t a = 0; a < 3; a++) {
+            m.starts(3*node + a) = k;
+            for (size_t b = 0; b < count; b++) {
+                for (size_t c = 0; c < 3; c++) {
+                    m.columns(k) = 3*neighbors[b] + c;
+                    m.values(k++) = neighbors[b] == node ? (a == c ? 6.0 : 0.5) : -1.0/(1.0 + a + c);
+                }
+            }
+        }
+    }
+    m.starts(m.rows) = k;
+    return m;
+}
+
+// a linear congruential generator, so every run makes the same matrix
+size_t next_random(size_t &state) {
+    state = state*6364136223846793005ULL + 1442695040888963407ULL;
+    return state >> 33;
+}
+
+// row lengths 1/u^0.75 for u uniform in (0,1], a mean of about 4 and a few
+// rows of tens of thousands, with distinct columns spread over the row
+HostMatrix power_law(size_t rows) {
+    HostMatrix m;
+    m.rows = m.cols = rows;
+    m.starts = CArray <size_t> (rows+1);
+    size_t state = 12345;
+    for (size_t i = 0; i < rows; i++) {
+        double u = (next_random(state) % 1000000 + 1)/1.0e6;
+        size_t len = (size_t)pow(u, -0.75);
+        m.starts(i+1) = len < rows ? len : rows;
+    }
+    prefix_sum(m);
+    m.columns = CArray <size_t> (m.starts(rows));
+    m.values = CArray <double> (m.starts(rows));
+    for (size_t i = 0; i < rows; i++) {
+        size_t len = m.starts(i+1) - m.starts(i);
+        size_t step = rows/len;
+        size_t first = next_random(state) % step;
+        for (size_t k = 0; k < len; k++) {
+            m.columns(m.starts(i) + k) = first + k*step; // spread over the row, distinct
+            m.values(m.starts(i) + k) = 1.0/(1.0 + k);
+        }
+    }
+    return m;
+}
+
+// a diagonal with num_full full rows spread through it
+HostMatrix arrow(size_t rows, size_t num_full) {
+    HostMatrix m;
+    m.rows = m.cols = rows;
+    m.starts = CArray <size_t> (rows+1);
+    size_t spacing = rows/num_full;
+    for (size_t i = 0; i < rows; i++) {
+        m.starts(i+1) = (i % spacing == 0) ? rows : 1;
+    }
+    prefix_sum(m);
+    m.columns = CArray <size_t> (m.starts(rows));
+    m.values = CArray <double> (m.starts(rows));
+    for (size_t i = 0; i < rows; i++) {
+        size_t k = m.starts(i);
+        if (i % spacing == 0) {
+            for (size_t j = 0; j < rows; j++) {
+                m.columns(k + j) = j;
+                m.values(k + j) = 1.0/(1.0 + j);
+            }
+        }
+        else {
+            m.columns(k) = i;
+            m.values(k) = 2.0;
+        }
+    }
+    return m;
+}
+
+// A coordinate Matrix Market file, real, integer or pattern, general or
+// symmetric.  Returns false if the file cannot be read.
+bool read_matrix_market(const char *path, HostMatrix &m) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        printf("%s: cannot open\n", path);
+        return false;
+    }
+    char line[1024];
+    char object[64], format[64], field[64], symmetry[64];
+    if (fgets(line, sizeof(line), file) == NULL ||
+        sscanf(line, "%%%%MatrixMarket %63s %63s %63s %63s", object, format, field, symmetry) != 4 ||
+        strcmp(format, "coordinate") != 0 || strcmp(field, "complex") == 0) {
+        printf("%s: only coordinate real, integer or pattern Matrix Market files are read\n", path);
+        fclose(file);
+        return false;
+    }
+    bool pattern = strcmp(field, "pattern") == 0;
+    bool symmetric = strcmp(symmetry, "general") != 0;
+    double sign = strcmp(symmetry, "skew-symmetric") == 0 ? -1.0 : 1.0;
+
+    size_t rows = 0, cols = 0, entries = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (line[0] != '%') {
+            sscanf(line, "%zu %zu %zu", &rows, &cols, &entries);
+            break;
+        }
+    }
+    CArray <size_t> row_of(2*entries);
+    CArray <size_t> col_of(2*entries);
+    CArray <double> value_of(2*entries);
+    size_t count = 0;
+    for (size_t e = 0; e < entries; e++) {
+        size_t i, j;
+        double value = 1.0;
+        if (fscanf(file, "%zu %zu", &i, &j) != 2 || (!pattern && fscanf(file, "%lf", &value) != 1)) {
+            printf("%s: entry %zu is not readable\n", path, e);
+            fclose(file);
+            return false;
+        }
+        row_of(count) = i-1; col_of(count) = j-1; value_of(count) = value; count++;
+        if (symmetric && i != j) {
+            row_of(count) = j-1; col_of(count) = i-1; value_of(count) = sign*value; count++;
+        }
+    }
+    fclose(file);
+
+    // counting sort by row, the CSR constructor sorts each row by column
+    m.rows = rows;
+    m.cols = cols;
+    m.starts = CArray <size_t> (rows+1);
+    for (size_t i = 0; i <= rows; i++) {
+        m.starts(i) = 0;
+    }
+    for (size_t e = 0; e < count; e++) {
+        m.starts(row_of(e)+1)++;
+    }
+    prefix_sum(m);
+    m.columns = CArray <size_t> (count);
+    m.values = CArray <double> (count);
+    CArray <size_t> next(rows);
+    for (size_t i = 0; i < rows; i++) {
+        next(i) = m.starts(i);
+    }
+    for (size_t e = 0; e < count; e++) {
+        size_t k = next(row_of(e))++;
+        m.columns(k) = col_of(e);
+        m.values(k) = value_of(e);
+    }
+    return true;
+}
+
+#ifdef HAVE_KOKKOS
+template <typename T>
+CArrayKokkos <T> to_device(const CArray <T> &host, size_t size) {
+    CArrayKokkos <T> device(size);
+    auto mirror = Kokkos::create_mirror_view(device.get_kokkos_view());
+    for (size_t n = 0; n < size; n++) {
+        mirror(n) = host(n);
+    }
+    Kokkos::deep_copy(device.get_kokkos_view(), mirror);
+    return device;
+}
+#endif
+
+double checksum(const Vector &y, size_t size) {
+    double loc_sum = 0.0;
+    double sum = 0.0;
+    REDUCE_SUM (i, 0, (int)size,
+                loc_sum, {
+        loc_sum += fabs(y(i));
+    }, sum);
+    return sum;
+}
+
+const char *algorithm_name(SpmvAlgorithm algorithm) {
+    switch (algorithm) {
+        case SpmvAlgorithm::row_per_thread: return "row_per_thread";
+        case SpmvAlgorithm::team_per_row: return "team_per_row";
+        case SpmvAlgorithm::merge_path: return "merge_path";
+        default: return "automatic";
+    }
+}
+
+template <typename F>
+void report(const char *format, const char *variant, F product, const Vector &y,
+            double bytes, double flops, double reference) {
+    double seconds = time_kernel(product);
+    double sum = checksum(y, y.size());
+    printf("    %-4s %-15s %10.4f ms %8.2f GB/s %8.2f GFLOP/s   %s\n",
+           format, variant, 1e3*seconds, 1e-9*bytes/seconds, 1e-9*flops/seconds,
+           fabs(sum - reference) <= 1e-9*reference ? "match" : "MISMATCH");
+}
+
+template <typename S>
+void report(const char *format, const S &a, const Vector &x, const Vector &y,
+            SpmvAlgorithm algorithm, double bytes, double flops, double reference) {
+    SpmvPlan plan = spmv_plan(a, algorithm);
+    report(format, algorithm_name(algorithm), [&]() { spmv(a, x, y, 1.0, 0.0, plan); },
+           y, bytes, flops, reference);
+}
+
+void run(const char *name, const HostMatrix &m) {
+    const size_t nnz = m.starts(m.rows);
+    const size_t index = sizeof(size_t);
+    const size_t value = sizeof(double);
+
+#ifdef HAVE_KOKKOS
+    CArrayKokkos <double> values = to_device(m.values, nnz);
+    CArrayKokkos <size_t> columns = to_device(m.columns, nnz);
+    CArrayKokkos <size_t> starts = to_device(m.starts, m.rows+1);
+    CSR csr(values, starts, columns, m.rows, m.cols);
+    CArrayKokkos <double> csc_values(nnz);
+    CArrayKokkos <size_t> csc_rows(nnz);
+    CArrayKokkos <size_t> csc_starts(m.cols+1);
+    csr.toCSC(csc_values, csc_starts, csc_rows);
+    CSC csc(csc_values, csc_starts, csc_rows, m.rows, m.cols);
+#else
+    CSR csr(m.values, m.columns, m.starts, m.rows, m.cols);
+    CSC csc(csr);
+#endif
+    SELL sell(csr);
+
+    Vector x(m.cols);
+    Vector y(m.rows);
+    FOR_ALL (j, 0, (int)m.cols, {
+        x(j) = 1.0 + 0.1*(j % 7);
+    });
+
+    SpmvPlan plan = spmv_plan(csr);
+    printf("%-12s %9zu x %-9zu %10zu nnz   max row %8zu   mean row %7.2f   automatic %s\n",
+           name, m.rows, m.cols, nnz, plan.max_row_nnz, plan.mean_row_nnz, algorithm_name(plan.algorithm));
+
+    spmv(csr, x, y, 1.0, 0.0, spmv_plan(csr, SpmvAlgorithm::row_per_thread));
+    double reference = checksum(y, m.rows);
+
+    double flops = 2.0*nnz;
+    double csr_bytes = (double)nnz*(value + index) + (m.rows+1)*index + m.cols*value + m.rows*value;
+    double csc_bytes = (double)nnz*(value + index) + (m.cols+1)*index + m.cols*value + 2.0*m.rows*value;
+    SpmvAlgorithm algorithms[] = {SpmvAlgorithm::row_per_thread, SpmvAlgorithm::team_per_row,
+                                  SpmvAlgorithm::merge_path};
+    for (SpmvAlgorithm algorithm : algorithms) {
+#ifndef HAVE_KOKKOS
+        if (algorithm == SpmvAlgorithm::team_per_row) continue; // runs as row_per_thread
+#endif
+        report("CSR", csr, x, y, algorithm, csr_bytes, flops, reference);
+    }
+#ifdef HAVE_KOKKOS
+    for (SpmvAlgorithm algorithm : algorithms) {
+        report("CSC", csc, x, y, algorithm, csc_bytes, flops, reference);
+    }
+#else
+    // the host CSC product has one path, a merge path split into per thread copies of y
+    report("CSC", csc, x, y, SpmvAlgorithm::merge_path, csc_bytes, flops, reference);
+#endif
+
+    // the padding is read too, and the row order to scatter y
+    double sell_bytes = (double)sell.padded_nnz()*(value + index) + (sell.num_chunks()+1)*index
+                      + m.rows*index + m.cols*value + m.rows*value;
+    char sell_name[64];
+    snprintf(sell_name, sizeof(sell_name), "%zu-%zu, %.2fx", sell.chunk_height(), sell.sigma(),
+             (double)sell.padded_nnz()/nnz);
+    report("SELL", sell_name, [&]() { spmv(sell, x, y); }, y, sell_bytes, flops, reference);
+
+    // one index per 3 x 3 block, and the zeros in the stored blocks
+    if (m.rows % 3 == 0 && m.cols % 3 == 0) {
+        BSR bsr(csr);
+        double bsr_bytes = (double)bsr.nnzb()*(9*value + index) + (bsr.block_dim1()+1)*index
+                         + m.cols*value + m.rows*value;
+        char bsr_name[64];
+        snprintf(bsr_name, sizeof(bsr_name), "3x3, %.2fx", (double)bsr.nnz()/nnz);
+        report("BSR", bsr_name, [&]() { spmv(bsr, x, y); }, y, bsr_bytes, flops, reference);
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[]) {
+
+#ifdef HAVE_KOKKOS
+    Kokkos::initialize();
+    {
+#endif
+
+    printf("sparse matrix-vector products, best of %zu x %zu reps\n\n", num_trials, num_reps);
+
+    run("laplace2d", laplace_2d(grid));
+    run("elasticity3d", elasticity_3d(solid_grid));
+    run("power_law", power_law(num_rows));
+    run("arrow", arrow(num_rows, 8));
+
+    for (int n = 1; n < argc; n++) {
+        HostMatrix m;
+        if (read_matrix_market(argv[n], m)) {
+            const char *name = strrchr(argv[n], '/');
+            run(name != NULL ? name+1 : argv[n], m);
+        }
+    }
+
+#ifdef HAVE_KOKKOS
+    }
+    Kokkos::finalize();
+#endif
+
+    return 0;
+}
@@ -5,6 +5,22 @@
 
 using namespace mtr; // matar namespace
 
+// sum and max of an array in one pass with REDUCE_CUSTOM, the default
+// constructor is the identity and join combines two partial results
+struct SumMax {
+    int sum;
+    int max;
+
+    KOKKOS_INLINE_FUNCTION
+    SumMax() : sum(0), max(-2147483647) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void join(const SumMax& other) {
+        sum += other.sum;
+        max = other.max > max ? other.max : max;
+    }
+};
+
 
 // main
 int main(){
@@ -123,13 +139,41 @@ int main(){
     
     printf("3D reduce MIN %i\n", result);
 
+
+    // the location of the largest value
+    FOR_ALL (i, 0, 10, {
+        arr(i) = (i*7) % 10;
+    });
+    ValLoc <int> loc_max_loc;
+    ValLoc <int> max_loc;
+    REDUCE_MAXLOC(i, 0, 10,
+                  loc_max_loc, {
+        if(arr(i) > loc_max_loc.val){
+            loc_max_loc.val = arr(i);
+            loc_max_loc.loc = i;
+        }
+    }, max_loc);
+    printf("1D reduce MAXLOC %i at %i vs. 9 at 7\n", max_loc.val, max_loc.loc);
+
+    // the sum and the max in a single pass
+    SumMax loc_sum_max;
+    SumMax sum_max;
+    REDUCE_CUSTOM(i, 0, 10,
+                  loc_sum_max, {
+        loc_sum_max.sum += arr(i);
+        if(arr(i) > loc_sum_max.max){
+            loc_sum_max.max = arr(i);
+        }
+    }, sum_max);
+    printf("1D reduce CUSTOM sum %i max %i vs. 45 and 9\n", sum_max.sum, sum_max.max);
+
     
     
 
     
     // DO ALL
 
-    FMatrixKokkos <int> matrix1D(10,10);
+    FMatrixKokkos <int> matrix1D(10);
 
     // Initialize matrix2D
     DO_ALL (i, 1, 10, {
@@ -192,8 +236,8 @@ int main(){
                   j, 1, 10,
                   i, 1, 10,
                   loc_max, {
-                    if(loc_max < matrix3D(i,j)){
-                       loc_max = matrix3D(i,j);
+                    if(loc_max < matrix3D(i,j,k)){
+                       loc_max = matrix3D(i,j,k);
                     }
                }, result);
     printf("result max 3D matrix = %i\n", result);
@@ -230,6 +274,41 @@ int main(){
     printf("result min 3D matrix = %i\n", result);
 
 
+    // team loops, one team per row of a ragged-right array and
+    // the threads of the team split the row
+    CArrayKokkos <size_t> strides(10);
+    FOR_ALL (i, 0, 10, {
+        strides(i) = i + 1;
+    });
+    RaggedRightArrayKokkos <int> ragged(strides);
+    CArrayKokkos <int> row_sums(10);
+
+    FOR_FIRST (i, 0, 10, {
+        FOR_SECOND (j, 0, ragged.stride(i), {
+            ragged(i,j) = j;
+        });
+        TEAM_BARRIER; // the row is written before it is summed
+
+        int loc_row_sum = 0;
+        int row_sum = 0;
+        FOR_REDUCE_SUM_SECOND (j, 0, ragged.stride(i),
+                               loc_row_sum, {
+            loc_row_sum += ragged(i,j);
+        }, row_sum);
+        TEAM_SINGLE({
+            row_sums(i) = row_sum;
+        });
+    });
+
+    loc_sum = 0;
+    result = 0;
+    REDUCE_SUM(i, 0, 10,
+               loc_sum, {
+        loc_sum += row_sums(i);
+    }, result);
+    printf("team loop ragged sum: %i vs. 165\n", result);
+
+
     // testing serial FOR and DO loop macros.  These
     // serial loops work on the host or the device.
     // the serial FOR and DO macros are intended to
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include <matar.h>
+
+using namespace mtr; // matar namespace
+
+// Same Jacobi solver as main_carray_right.cpp, written with the FOR_ALL and
+// REDUCE_MAX macros.  Without kokkos the loops are serial, or run on the
+// thread pool when MATAR is configured with -DTHREAD_POOL=ON; the number of
+// threads is set with the MATAR_NUM_THREADS environment variable.
+
+const int width = 1000;
+const int height = 1000;
+const double temp_tolerance = 0.01;
+
+void initialize(CArray<double> &temperature_previous);
+void track_progress(int iteration, CArray<double> &temperature);
+
+int main() {
+    int iteration = 1;
+    double worst_dt = 100;
+    double max_value;
+
+    auto temperature = CArray <double> (height+2, width+2);
+    auto temperature_previous = CArray <double> (height+2, width+2);
+
+    // Start measuring time
+    auto begin = std::chrono::high_resolution_clock::now();
+
+    // initialize temperature profile
+    initialize(temperature_previous);
+
+    while (worst_dt > temp_tolerance) {
+        // finite difference, with kokkos the tile is looked up by the loop name
+        // and tuned over the first iterations when MATAR_TILE_TUNING=1
+        FOR_ALL_TUNED("laplace stencil", i, 1, height+1,
+                                         j, 1, width+1, {
+            temperature(i,j) = 0.25 * (temperature_previous(i+1,j)
+                                    + temperature_previous(i-1,j)
+                                    + temperature_previous(i,j+1)
+                                    + temperature_previous(i,j-1));
+        });
+
+        // calculate max difference between temperature and temperature_previous
+        double loc_max_value = 0.0;
+        REDUCE_MAX(i, 1, height+1,
+                   j, 1, width+1,
+                   loc_max_value, {
+            double value = fabs(temperature(i,j) - temperature_previous(i,j));
+            if (value > loc_max_value) loc_max_value = value;
+        }, max_value);
+        worst_dt = max_value;
+
+        // update temperature_previous
+        FOR_ALL(i, 1, height+1,
+                j, 1, width+1, {
+            temperature_previous(i,j) = temperature(i,j);
+        });
+
+        // track progress
+        if (iteration % 100 == 0) {
+            track_progress(iteration, temperature);
+        }
+
+        iteration++;
+    }
+
+    // Stop measuring time and calculate the elapsed time
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin);
+
+    printf("Total time was %f seconds.\n", elapsed.count() * 1e-9);
+    printf("\nMax error at iteration %d was %f\n", iteration-1, worst_dt);
+
+    return 0;
+}
+
+void initialize(CArray<double> &temperature_previous) {
+
+    // initialize temperature_previous to 0.0
+    FOR_ALL(i, 0, height+2,
+            j, 0, width+2, {
+        temperature_previous(i,j) = 0.0;
+    });
+
+    // setting the left and right boundary conditions
+    FOR_ALL(i, 0, height+2, {
+        temperature_previous(i,0) = 0.0;
+        temperature_previous(i,width+1) = (100.0/height)*i;
+    });
+
+    // setting the top and bottom boundary condition
+    FOR_ALL(j, 0, width+2, {
+        temperature_previous(0,j) = 0.0;
+        temperature_previous(height+1,j) = (100.0/width)*j;
+    });
+}
+
+void track_progress(int iteration, CArray<double> &temperature) {
+    int i;
+
+    printf("---------- Iteration number: %d ----------\n", iteration);
+    for (i = height-5; i <= height; i++) {
+        printf("[%d,%d]: %5.2f  ", i,i, temperature(i,i));
+    }
+    printf("\n");
+}
@@ -192,7 +192,7 @@ int main(int argc, char *argv[])
       FOR_ALL(j, 0, width_loc, {
         halo_down_out(j) = temperature_previous_loc(height_loc-1, j);
       });
-      halo_up_out.update_host();
+      halo_down_out.update_host();
     }
     //
     Kokkos::fence();
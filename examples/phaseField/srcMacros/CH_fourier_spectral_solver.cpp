@@ -94,10 +94,11 @@ void CHFourierSpectralSolver::time_march(DCArrayKokkos<double> &comp, CArrayKokk
     // get foward fft of dfdc
     fft_manager.perform_forward_fft(dfdc.pointer(), dfdc_img_.pointer());
 
-    // solve Cahn Hilliard equation in fourier space
-    FOR_ALL_CLASS(i, 0, nn_img_[0],
-                  j, 0, nn_img_[1],
-                  k, 0, nn_img_[2], {
+    // solve Cahn Hilliard equation in fourier space, the tile is tuned over
+    // the first time steps when MATAR_TILE_TUNING=1
+    FOR_ALL_TUNED_CLASS("CH fourier update", i, 0, nn_img_[0],
+                                             j, 0, nn_img_[1],
+                                             k, 0, nn_img_[2], {
         comp_img_(i,j,k,0) =   (comp_img_(i,j,k,0) - (dt_ * M_ * kpow2_(i,j,k)) * dfdc_img_(i,j,k,0))
                              / (denominator_(i,j,k));
     
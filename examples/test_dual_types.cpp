@@ -8,6 +8,8 @@ using namespace mtr; // matar namespace
 
 void DViewCArrayKokkosTwoDimensionExample();
 void DCArrayKokkosTwoDimensionExample();
+void DCArrayKokkosSyncTrackingExample();
+void DCArrayKokkosBlockUpdateExample();
 
 int main() {
 
@@ -20,6 +22,12 @@ int main() {
     // Run DCArrayKokkos 2D example
     DCArrayKokkosTwoDimensionExample();
 
+    // Run DCArrayKokkos sync tracking example
+    DCArrayKokkosSyncTrackingExample();
+
+    // Run DCArrayKokkos block update example
+    DCArrayKokkosBlockUpdateExample();
+
     } // end of kokkos scope
     Kokkos::finalize();
 }
@@ -161,3 +169,69 @@ void DCArrayKokkosTwoDimensionExample()
     printf("Device data pointer: %p\n", A_2D.device_pointer());
 
 }
+
+
+
+void DCArrayKokkosSyncTrackingExample()
+{
+    printf("\n====================Running DCArrayKokkos sync tracking example====================\n");
+
+    int nx = 2;
+    int ny = 2;
+
+    auto A_2D = DCArrayKokkos <int> (nx, ny);
+    reset_dual_sync_counts();
+
+    // Record the write on the device, only the first update_host copies
+    FOR_ALL(i, 0, nx,
+            j, 0, ny, {
+        A_2D(i,j) = 3;
+    });
+    A_2D.modify_device();
+    A_2D.update_host();
+    A_2D.update_host();
+    Kokkos::fence();
+    printf("host current: %d, device current: %d\n", A_2D.host_is_current(), A_2D.device_is_current());
+
+    // The host was not written, so the device is still current and this is skipped
+    A_2D.update_device();
+
+    // Record a write on the host, the next update_device copies
+    A_2D.host(0,0) = 4;
+    A_2D.modify_host();
+    A_2D.update_device();
+    Kokkos::fence();
+
+    printf("transfers: %zu (should be 2), skipped: %zu (should be 2)\n",
+           dual_sync_counts().transfers, dual_sync_counts().skipped);
+}
+
+
+
+void DCArrayKokkosBlockUpdateExample()
+{
+    printf("\n====================Running DCArrayKokkos block update example====================\n");
+
+    int nx = 4;
+    int ny = 3;
+
+    auto A_2D = DCArrayKokkos <int> (nx, ny);
+
+    FOR_ALL(i, 0, nx,
+            j, 0, ny, {
+        A_2D(i,j) = 10*i + j;
+    });
+    Kokkos::fence();
+
+    // Copy only the last row (one contiguous run) and the first column (strided)
+    A_2D.update_host({nx-1, nx});
+    A_2D.update_host({0, nx}, {0, 1});
+
+    printf("Printing host copy of data (last row and first column set, rest 0):\n");
+    for (int i = 0; i < nx; i++){
+        for (int j = 0; j < ny; j++){
+            printf("%3d ", A_2D.host(i,j));
+        }
+        printf("\n");
+    }
+}
@@ -0,0 +1,508 @@
+#ifndef ALLOCATORS_H
+#define ALLOCATORS_H
+/**********************************************************************************************
+ © 2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+/**********************************************************************************************
+ Allocators for the MATAR arrays.  An Allocator hands out aligned blocks of bytes; the host
+ dense types take one through AllocPolicy, and CArrayKokkos and FArrayKokkos take a scoped one
+ (an ArenaAllocator) as the first constructor input.
+
+ PoolAllocator keeps freed blocks in power-of-two size classes and hands them out again, so
+ a scratch array that is made and dropped every time step costs a lock and a pop.  It is
+ thread safe.
+
+     PoolAllocator pool("scratch");
+     AllocPolicy policy;
+     policy.allocator = &pool;
+     CArray <double> work(num_elems, 8, policy);   // returned to the pool with the last copy
+
+ ArenaAllocator bumps a pointer through large chunks and frees nothing one at a time; an
+ ArenaScope gives back everything allocated since it was made when it goes out of scope,
+ and the chunks are reused by the next scope.  It is not thread safe.
+
+     ArenaAllocator arena("step");
+     for (int step = 0; step < num_steps; step++) {
+         ArenaScope scope(arena);
+         CArray <double> flux(num_faces, 3, policy_with_arena);
+         ...
+     } // flux must not outlive the scope
+
+ Both count their allocations and their calls to the upstream allocator, stats() returns
+ the counts and report() prints them; with MATAR_ALLOC_STATS=1 in the environment every
+ allocator prints its report when it is destroyed.  An allocator must outlive the arrays
+ made from it.
+ **********************************************************************************************/
+
+#include <stdio.h>
+#include <assert.h>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+
+namespace mtr
+{
+
+// the counts kept by every allocator
+struct AllocStats {
+    size_t allocations = 0;    // blocks handed out
+    size_t deallocations = 0;  // blocks given back
+    size_t reused = 0;         // allocations served without the upstream allocator
+    size_t upstream_allocations = 0;
+    size_t upstream_bytes = 0; // bytes currently held from the upstream allocator
+    size_t bytes_in_use = 0;   // bytes handed out and not given back
+    size_t peak_bytes_in_use = 0;
+};
+
+class Allocator {
+
+protected:
+    std::string name_;
+    AllocStats stats_;
+
+    void count_allocation(size_t bytes, bool reused);
+
+    void count_deallocation(size_t bytes);
+
+public:
+    explicit Allocator(const std::string& name = "allocator");
+
+    Allocator(const Allocator&) = delete;
+    Allocator& operator=(const Allocator&) = delete;
+
+    // a block of at least bytes starting on an alignment-byte boundary, a power of two
+    virtual void* allocate(size_t bytes, size_t alignment) = 0;
+
+    // gives back a block with the bytes and alignment it was allocated with
+    virtual void deallocate(void* ptr, size_t bytes, size_t alignment) = 0;
+
+    // true when the blocks are given back all at once (an arena), so the
+    // owner of a block does not have to deallocate it
+    virtual bool scoped() const;
+
+    const std::string& name() const;
+
+    AllocStats stats() const;
+
+    void report(FILE* out = stdout) const;
+
+    virtual ~Allocator();
+
+}; // end of Allocator
+
+
+// host memory from the aligned operator new, the default upstream allocator
+class NewAllocator : public Allocator {
+
+private:
+    mutable std::mutex mutex_;
+
+public:
+    explicit NewAllocator(const std::string& name = "new");
+
+    void* allocate(size_t bytes, size_t alignment) override;
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) override;
+
+}; // end of NewAllocator
+
+// the NewAllocator shared by the pools and arenas that are not given an upstream
+NewAllocator& new_allocator();
+
+
+// Thread safe size-class pool.  Requests up to max_block bytes are rounded up to a power of
+// two (at least min_block) and aligned to block_alignment; a freed block goes on the free
+// list of its class.  Larger or more strictly aligned requests go straight upstream.
+class PoolAllocator : public Allocator {
+
+private:
+    static constexpr size_t min_block = 64;
+    static constexpr size_t max_block = size_t(1) << 30;
+
+    Allocator* upstream_;
+    size_t block_alignment_;
+    std::vector<std::vector<void*>> free_lists_; // one per size class
+    mutable std::mutex mutex_;
+
+    // the size class of a request, or free_lists_.size() when it bypasses the pool
+    size_t size_class(size_t bytes, size_t alignment) const;
+
+public:
+    explicit PoolAllocator(const std::string& name = "pool",
+                           Allocator* upstream = nullptr,
+                           size_t block_alignment = 64);
+
+    void* allocate(size_t bytes, size_t alignment) override;
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) override;
+
+    // gives the cached blocks back to the upstream allocator
+    void trim();
+
+    ~PoolAllocator();
+
+}; // end of PoolAllocator
+
+
+// Bump-pointer arena over chunks of at least chunk_bytes from the upstream allocator.
+// deallocate does nothing, rewind() and release() give back the space and keep the chunks.
+class ArenaAllocator : public Allocator {
+
+public:
+    // a position in the arena, returned by mark()
+    struct Marker {
+        size_t chunk = 0;
+        size_t offset = 0;
+        size_t bytes_in_use = 0;
+    };
+
+private:
+    struct Chunk {
+        char* data;
+        size_t bytes;
+    };
+
+    Allocator* upstream_;
+    size_t chunk_bytes_;
+    std::vector<Chunk> chunks_;
+    size_t chunk_;  // the chunk being bumped through
+    size_t offset_; // the next free byte in that chunk
+
+public:
+    explicit ArenaAllocator(const std::string& name = "arena",
+                            Allocator* upstream = nullptr,
+                            size_t chunk_bytes = size_t(1) << 20);
+
+    void* allocate(size_t bytes, size_t alignment) override;
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) override;
+
+    bool scoped() const override;
+
+    Marker mark() const;
+
+    // gives back everything allocated after the marker
+    void rewind(const Marker& marker);
+
+    // gives back everything, the chunks are kept for the next allocations
+    void release();
+
+    // gives the chunks back to the upstream allocator, nothing may be in use
+    void trim();
+
+    ~ArenaAllocator();
+
+}; // end of ArenaAllocator
+
+
+// gives back everything allocated from the arena during its lifetime, scopes nest
+class ArenaScope {
+
+private:
+    ArenaAllocator& arena_;
+    ArenaAllocator::Marker marker_;
+
+public:
+    explicit ArenaScope(ArenaAllocator& arena);
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    ~ArenaScope();
+
+}; // end of ArenaScope
+
+
+//---Allocator definitions----
+
+inline Allocator::Allocator(const std::string& name) : name_(name) {}
+
+inline void Allocator::count_allocation(size_t bytes, bool reused) {
+    stats_.allocations++;
+    stats_.reused += reused ? 1 : 0;
+    stats_.bytes_in_use += bytes;
+    if (stats_.bytes_in_use > stats_.peak_bytes_in_use) {
+        stats_.peak_bytes_in_use = stats_.bytes_in_use;
+    }
+}
+
+inline void Allocator::count_deallocation(size_t bytes) {
+    stats_.deallocations++;
+    stats_.bytes_in_use -= bytes;
+}
+
+inline bool Allocator::scoped() const {
+    return false;
+}
+
+inline const std::string& Allocator::name() const {
+    return name_;
+}
+
+inline AllocStats Allocator::stats() const {
+    return stats_;
+}
+
+inline void Allocator::report(FILE* out) const {
+    double reused = stats_.allocations > 0 ? 100.0 * stats_.reused / stats_.allocations : 0.0;
+    fprintf(out, "allocator %s: %zu allocations, %zu deallocations, %.1f%% reused, "
+                 "%zu upstream allocations, %zu upstream bytes held, %zu bytes in use, %zu peak\n",
+            name_.c_str(), stats_.allocations, stats_.deallocations, reused,
+            stats_.upstream_allocations, stats_.upstream_bytes,
+            stats_.bytes_in_use, stats_.peak_bytes_in_use);
+}
+
+inline Allocator::~Allocator() {
+    const char* alloc_stats = std::getenv("MATAR_ALLOC_STATS");
+    if (alloc_stats != nullptr && std::string(alloc_stats) == "1") {
+        report(stderr);
+    }
+}
+
+
+//---NewAllocator definitions----
+
+inline NewAllocator::NewAllocator(const std::string& name) : Allocator(name) {}
+
+inline void* NewAllocator::allocate(size_t bytes, size_t alignment) {
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && "alignment must be a power of two!");
+    void* ptr = ::operator new[](bytes, static_cast<std::align_val_t>(alignment));
+    std::lock_guard<std::mutex> lock(mutex_);
+    count_allocation(bytes, false);
+    stats_.upstream_allocations++;
+    stats_.upstream_bytes += bytes;
+    return ptr;
+}
+
+inline void NewAllocator::deallocate(void* ptr, size_t bytes, size_t alignment) {
+    ::operator delete[](ptr, static_cast<std::align_val_t>(alignment));
+    std::lock_guard<std::mutex> lock(mutex_);
+    count_deallocation(bytes);
+    stats_.upstream_bytes -= bytes;
+}
+
+inline NewAllocator& new_allocator() {
+    static NewAllocator allocator;
+    return allocator;
+}
+
+
+//---PoolAllocator definitions----
+
+inline PoolAllocator::PoolAllocator(const std::string& name, Allocator* upstream, size_t block_alignment)
+    : Allocator(name),
+      upstream_(upstream != nullptr ? upstream : &new_allocator()),
+      block_alignment_(block_alignment) {
+    assert(block_alignment > 0 && (block_alignment & (block_alignment - 1)) == 0 && "block_alignment must be a power of two!");
+    size_t num_classes = 0;
+    for (size_t block = min_block; block <= max_block; block *= 2) {
+        num_classes++;
+    }
+    free_lists_.resize(num_classes);
+}
+
+inline size_t PoolAllocator::size_class(size_t bytes, size_t alignment) const {
+    if (bytes > max_block || alignment > block_alignment_) {
+        return free_lists_.size();
+    }
+    size_t c = 0;
+    for (size_t block = min_block; block < bytes; block *= 2) {
+        c++;
+    }
+    return c;
+}
+
+inline void* PoolAllocator::allocate(size_t bytes, size_t alignment) {
+    size_t c = size_class(bytes, alignment);
+    if (c == free_lists_.size()) {
+        void* ptr = upstream_->allocate(bytes, alignment);
+        std::lock_guard<std::mutex> lock(mutex_);
+        count_allocation(bytes, false);
+        stats_.upstream_allocations++;
+        stats_.upstream_bytes += bytes;
+        return ptr;
+    }
+
+    size_t block = min_block << c;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_lists_[c].empty()) {
+            void* ptr = free_lists_[c].back();
+            free_lists_[c].pop_back();
+            count_allocation(block, true);
+            return ptr;
+        }
+    }
+    void* ptr = upstream_->allocate(block, block_alignment_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    count_allocation(block, false);
+    stats_.upstream_allocations++;
+    stats_.upstream_bytes += block;
+    return ptr;
+}
+
+inline void PoolAllocator::deallocate(void* ptr, size_t bytes, size_t alignment) {
+    size_t c = size_class(bytes, alignment);
+    if (c == free_lists_.size()) {
+        upstream_->deallocate(ptr, bytes, alignment);
+        std::lock_guard<std::mutex> lock(mutex_);
+        count_deallocation(bytes);
+        stats_.upstream_bytes -= bytes;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_lists_[c].push_back(ptr);
+    count_deallocation(min_block << c);
+}
+
+inline void PoolAllocator::trim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t c = 0; c < free_lists_.size(); c++) {
+        for (void* ptr : free_lists_[c]) {
+            upstream_->deallocate(ptr, min_block << c, block_alignment_);
+            stats_.upstream_bytes -= min_block << c;
+        }
+        free_lists_[c].clear();
+    }
+}
+
+inline PoolAllocator::~PoolAllocator() {
+    trim();
+}
+
+
+//---ArenaAllocator definitions----
+
+inline ArenaAllocator::ArenaAllocator(const std::string& name, Allocator* upstream, size_t chunk_bytes)
+    : Allocator(name),
+      upstream_(upstream != nullptr ? upstream : &new_allocator()),
+      chunk_bytes_(chunk_bytes),
+      chunk_(0),
+      offset_(0) {
+    assert(chunk_bytes > 0 && "chunk_bytes must be positive in ArenaAllocator!");
+}
+
+inline void* ArenaAllocator::allocate(size_t bytes, size_t alignment) {
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && "alignment must be a power of two!");
+    bool reused = true;
+    while (true) {
+        if (chunk_ < chunks_.size()) {
+            size_t base = reinterpret_cast<size_t>(chunks_[chunk_].data);
+            size_t start = ((base + offset_ + alignment - 1) & ~(alignment - 1)) - base;
+            if (start + bytes <= chunks_[chunk_].bytes) {
+                offset_ = start + bytes;
+                count_allocation(bytes, reused);
+                return chunks_[chunk_].data + start;
+            }
+            if (chunk_ + 1 < chunks_.size()) {
+                chunk_++;
+                offset_ = 0;
+                continue;
+            }
+        }
+        // a new chunk big enough for the request at any alignment
+        size_t chunk_bytes = bytes + alignment > chunk_bytes_ ? bytes + alignment : chunk_bytes_;
+        Chunk chunk;
+        chunk.data = static_cast<char*>(upstream_->allocate(chunk_bytes, 64));
+        chunk.bytes = chunk_bytes;
+        chunks_.push_back(chunk);
+        stats_.upstream_allocations++;
+        stats_.upstream_bytes += chunk_bytes;
+        chunk_ = chunks_.size() - 1;
+        offset_ = 0;
+        reused = false;
+    }
+}
+
+inline void ArenaAllocator::deallocate(void* /*ptr*/, size_t /*bytes*/, size_t /*alignment*/) {
+    stats_.deallocations++;
+}
+
+inline bool ArenaAllocator::scoped() const {
+    return true;
+}
+
+inline ArenaAllocator::Marker ArenaAllocator::mark() const {
+    Marker marker;
+    marker.chunk = chunk_;
+    marker.offset = offset_;
+    marker.bytes_in_use = stats_.bytes_in_use;
+    return marker;
+}
+
+inline void ArenaAllocator::rewind(const Marker& marker) {
+    assert(marker.chunk <= chunk_ && "ArenaAllocator marker is past the current position!");
+    chunk_ = marker.chunk;
+    offset_ = marker.offset;
+    stats_.bytes_in_use = marker.bytes_in_use;
+}
+
+inline void ArenaAllocator::release() {
+    rewind(Marker());
+}
+
+inline void ArenaAllocator::trim() {
+    assert(stats_.bytes_in_use == 0 && "ArenaAllocator trim() while blocks are in use!");
+    for (const Chunk& chunk : chunks_) {
+        upstream_->deallocate(chunk.data, chunk.bytes, 64);
+        stats_.upstream_bytes -= chunk.bytes;
+    }
+    chunks_.clear();
+    chunk_ = offset_ = 0;
+}
+
+inline ArenaAllocator::~ArenaAllocator() {
+    stats_.bytes_in_use = 0;
+    trim();
+}
+
+
+//---ArenaScope definitions----
+
+inline ArenaScope::ArenaScope(ArenaAllocator& arena) : arena_(arena), marker_(arena.mark()) {}
+
+inline ArenaScope::~ArenaScope() {
+    arena_.rewind(marker_);
+}
+
+} // end namespace
+
+#endif // ALLOCATORS_H
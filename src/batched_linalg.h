@@ -0,0 +1,1133 @@
+#ifndef BATCHED_LINALG_H
+#define BATCHED_LINALG_H
+/**********************************************************************************************
+ © 2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+/**********************************************************************************************
+ Small dense linear algebra over batches of matrices: GEMM, GEMV, LU with partial pivoting,
+ Cholesky, triangular solves, inverse and determinant.  The sizes are template parameters,
+ so the loops have constant trip counts and the compiler can unroll them, and the 1x1 to 3x3
+ inverse and determinant use closed forms.
+
+ A batch is a rank 3 array with the matrix index first, vectors are rank 2 and scalars rank
+ 1, e.g. the element stiffness matrices of a mesh
+
+     FArray <double> K(num_elems, 24, 24);
+     FArray <double> f(num_elems, 24);
+     batched_solve<24>(K, f);   // f holds the solution, K its LU factors
+
+ The batched_ functions take CArray, FArray, CArrayKokkos or FArrayKokkos and run where
+ FOR_ALL runs for the array.  On a Kokkos device there is one matrix per thread, or with
+ BatchMode::per_team one matrix per team with the rows split over its threads (for the
+ larger sizes, where one thread runs out of registers).  On the host, including a host
+ execution space of Kokkos, each thread copies MATAR_BATCH_WIDTH matrices at a time into
+ thread local storage with the matrix index fastest and works on them with that index in
+ the innermost loop, so the arithmetic is vectorized across the batch whatever the layout
+ of the array.  On a GPU the loads of neighboring threads coalesce when the matrix index is
+ the fastest one, so FArrayKokkos is the better type for device batches.
+
+ The small_ functions are the same kernels on one matrix, for use inside a FOR_ALL body on
+ any type indexed (i,j), such as CArrayFixed or a slice:
+
+     using Matrix3 = CArrayFixed <double,3,3>;
+     FOR_ALL (elem, 0, num_elems, {
+         Matrix3 jacobian;
+         ...
+         double det_j = small_determinant<3>(jacobian);
+     });
+
+ An exactly zero pivot is skipped, so a singular matrix factors with a zero on the diagonal
+ of U, its determinant is zero, and a solve or inverse gives infs or NaNs.  Cholesky reads the lower
+ triangle and gives NaNs for a matrix that is not positive definite.  The inputs and outputs
+ of one call must not overlap, except where a function works in place.
+ **********************************************************************************************/
+
+#include <assert.h>
+#include <math.h>
+#include <type_traits>
+#include "host_types.h"
+#ifdef HAVE_KOKKOS
+#include "kokkos_types.h"
+#endif
+#include "expressions.h"
+
+#ifdef HAVE_KOKKOS
+#define BATCH_INLINE_FUNCTION KOKKOS_INLINE_FUNCTION
+#else
+#define BATCH_INLINE_FUNCTION inline
+#endif
+
+#ifndef MATAR_BATCH_WIDTH
+#define MATAR_BATCH_WIDTH 8 // matrices per host thread step, a few SIMD registers of doubles
+#endif
+
+
+namespace mtr
+{
+
+// how the matrices of a batch are given to the Kokkos threads
+enum class BatchMode {
+    per_thread, // one matrix per thread
+    per_team    // one matrix per team, the rows split over its threads
+};
+
+
+//---How a kernel walks its matrices---
+
+// One thread working through Width matrices at a time.  The kernels put the
+// loop over the lanes innermost, and with Width = 1 it disappears.
+template <size_t Width>
+struct BatchLanes {
+    static constexpr size_t width = Width;
+
+    BATCH_INLINE_FUNCTION
+    static constexpr size_t lanes() { return Width; }
+
+    template <typename F>
+    BATCH_INLINE_FUNCTION
+    void split(size_t begin, size_t end, const F& fcn) const {
+        for (size_t i = begin; i < end; i++) {
+            fcn(i);
+        }
+    }
+
+    BATCH_INLINE_FUNCTION
+    void barrier() const {}
+};
+
+#ifdef HAVE_KOKKOS
+// A team working on one matrix, split() spreads its range over the threads.
+// Anything computed outside split() is computed by every thread of the team.
+template <typename Member>
+struct BatchTeam {
+    static constexpr size_t width = 1;
+    const Member& team;
+
+    BATCH_INLINE_FUNCTION
+    static constexpr size_t lanes() { return 1; }
+
+    template <typename F>
+    BATCH_INLINE_FUNCTION
+    void split(size_t begin, size_t end, const F& fcn) const {
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, begin, end), fcn);
+    }
+
+    BATCH_INLINE_FUNCTION
+    void barrier() const { team.team_barrier(); }
+};
+#endif
+
+
+//---What a kernel indexes, (lane, i, j)---
+
+// the matrices of a batch array from first on
+template <typename A>
+struct BatchMatrices {
+    const A& array;
+    size_t first;
+
+    BATCH_INLINE_FUNCTION
+    decltype(auto) operator()(size_t l, size_t i, size_t j) const { return array(first+l, i, j); }
+};
+
+// the vectors of a batch array from first on, as one column matrices
+template <typename A>
+struct BatchVectors {
+    const A& array;
+    size_t first;
+
+    BATCH_INLINE_FUNCTION
+    decltype(auto) operator()(size_t l, size_t i, size_t) const { return array(first+l, i); }
+};
+
+// a single matrix
+template <typename M>
+struct SmallMatrix {
+    M& matrix;
+
+    BATCH_INLINE_FUNCTION
+    decltype(auto) operator()(size_t, size_t i, size_t j) const { return matrix(i, j); }
+};
+
+// a single vector, as a one column matrix
+template <typename V>
+struct SmallVector {
+    V& vector;
+
+    BATCH_INLINE_FUNCTION
+    decltype(auto) operator()(size_t, size_t i, size_t) const { return vector(i); }
+};
+
+// Thread local matrices, one per lane, with the lane index fastest.  A host
+// block copies its matrices in and out of these, so the lane loops of the
+// kernels are unit stride whatever the layout of the batch array, and the
+// compiler can see that the matrices do not overlap.
+template <typename T, size_t Width, size_t Rows, size_t Cols>
+struct LocalMatrices {
+    mutable T values[Rows][Cols][Width];
+
+    BATCH_INLINE_FUNCTION
+    T& operator()(size_t l, size_t i, size_t j) const { return values[i][j][l]; }
+
+    template <typename M>
+    BATCH_INLINE_FUNCTION
+    void load(const M& m) const {
+        for (size_t i = 0; i < Rows; i++) {
+            for (size_t j = 0; j < Cols; j++) {
+                for (size_t l = 0; l < Width; l++) {
+                    values[i][j][l] = m(l,i,j);
+                }
+            }
+        }
+    }
+
+    template <typename M>
+    BATCH_INLINE_FUNCTION
+    void store(const M& m) const {
+        for (size_t i = 0; i < Rows; i++) {
+            for (size_t j = 0; j < Cols; j++) {
+                for (size_t l = 0; l < Width; l++) {
+                    m(l,i,j) = values[i][j][l];
+                }
+            }
+        }
+    }
+};
+
+// the row swapped with row k at step k of an LU factorization, one set per lane.
+// A team keeps a copy in every thread.
+template <size_t Width, size_t N>
+struct LocalPivots {
+    mutable size_t rows[N][Width];
+
+    BATCH_INLINE_FUNCTION
+    size_t& operator()(size_t l, size_t k) const { return rows[k][l]; }
+};
+
+template <typename M>
+using batch_value_t = typename std::decay<decltype(std::declval<const M&>()(0, 0, 0))>::type;
+
+template <typename T>
+BATCH_INLINE_FUNCTION
+T batch_abs(const T& x) {
+    return x < T(0) ? -x : x;
+}
+
+
+//---Kernels---
+
+// piv(l,k) = the row of the largest entry in column k on or below the diagonal
+template <size_t N, typename Exec, typename MA, typename PV>
+BATCH_INLINE_FUNCTION
+void pivot_search(const Exec& exec, const MA& a, const PV& piv, size_t k) {
+    using T = batch_value_t<MA>;
+    T largest[Exec::width];
+    for (size_t l = 0; l < exec.lanes(); l++) {
+        largest[l] = batch_abs(a(l,k,k));
+        piv(l,k) = k;
+    }
+    for (size_t i = k+1; i < N; i++) {
+        for (size_t l = 0; l < exec.lanes(); l++) {
+            const T candidate = batch_abs(a(l,i,k));
+            piv(l,k) = (candidate > largest[l]) ? i : piv(l,k);
+            largest[l] = (candidate > largest[l]) ? candidate : largest[l];
+        }
+    }
+}
+
+// C = alpha*A*B + beta*C, A is M x K and B is K x N.  With beta = 0, C is not read.
+template <size_t M, size_t N, size_t K, typename Exec, typename MA, typename MB, typename MC, typename S>
+BATCH_INLINE_FUNCTION
+void gemm_kernel(const Exec& exec, S alpha, const MA& a, const MB& b, S beta, const MC& c) {
+    exec.split(0, M, [&](size_t i) {
+        for (size_t j = 0; j < N; j++) {
+            for (size_t l = 0; l < exec.lanes(); l++) {
+                c(l,i,j) = (beta == S(0)) ? S(0) : beta*c(l,i,j);
+            }
+            for (size_t k = 0; k < K; k++) {
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    c(l,i,j) += alpha*a(l,i,k)*b(l,k,j);
+                }
+            }
+        }
+    });
+    exec.barrier();
+}
+
+// y = alpha*A*x + beta*y, A is M x N.  With beta = 0, y is not read.
+template <size_t M, size_t N, typename Exec, typename MA, typename VX, typename VY, typename S>
+BATCH_INLINE_FUNCTION
+void gemv_kernel(const Exec& exec, S alpha, const MA& a, const VX& x, S beta, const VY& y) {
+    exec.split(0, M, [&](size_t i) {
+        for (size_t l = 0; l < exec.lanes(); l++) {
+            y(l,i,0) = (beta == S(0)) ? S(0) : beta*y(l,i,0);
+        }
+        for (size_t j = 0; j < N; j++) {
+            for (size_t l = 0; l < exec.lanes(); l++) {
+                y(l,i,0) += alpha*a(l,i,j)*x(l,j,0);
+            }
+        }
+    });
+    exec.barrier();
+}
+
+// A = P*L*U in place with partial pivoting, L has a unit diagonal that is not
+// stored.  piv(l,k) is the row that was swapped with row k at step k.
+template <size_t N, typename Exec, typename MA, typename PV>
+BATCH_INLINE_FUNCTION
+void lu_kernel(const Exec& exec, const MA& a, const PV& piv) {
+    using T = batch_value_t<MA>;
+    for (size_t k = 0; k < N; k++) {
+
+        pivot_search<N>(exec, a, piv, k);
+        exec.barrier();
+
+        exec.split(0, N, [&](size_t j) {
+            for (size_t l = 0; l < exec.lanes(); l++) {
+                const size_t p = piv(l,k);
+                if (p != k) {
+                    T temp = a(l,k,j);
+                    a(l,k,j) = a(l,p,j);
+                    a(l,p,j) = temp;
+                }
+            }
+        });
+        exec.barrier();
+
+        T inv_pivot[Exec::width];
+        for (size_t l = 0; l < exec.lanes(); l++) {
+            inv_pivot[l] = (a(l,k,k) != T(0)) ? T(1)/a(l,k,k) : T(0);
+        }
+
+        // the multipliers and the update of the trailing rows.  Row k is read
+        // into lane arrays first so the compiler can vectorize over the lanes
+        // without proving that rows i and k differ.
+        exec.split(k+1, N, [&](size_t i) {
+            T factor[Exec::width];
+            for (size_t l = 0; l < exec.lanes(); l++) {
+                a(l,i,k) *= inv_pivot[l];
+                factor[l] = a(l,i,k);
+            }
+            for (size_t j = k+1; j < N; j++) {
+                T row_k[Exec::width];
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    row_k[l] = a(l,k,j);
+                }
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    a(l,i,j) -= factor[l]*row_k[l];
+                }
+            }
+        });
+        exec.barrier();
+    }
+}
+
+// B = A^-1 B from the factors of lu_kernel, B is N x NRHS
+template <size_t N, size_t NRHS, typename Exec, typename MA, typename PV, typename MB>
+BATCH_INLINE_FUNCTION
+void lu_solve_kernel(const Exec& exec, const MA& a, const PV& piv, const MB& b) {
+    using T = batch_value_t<MB>;
+
+    // the row swaps, in order
+    exec.split(0, NRHS, [&](size_t c) {
+        for (size_t k = 0; k < N; k++) {
+            for (size_t l = 0; l < exec.lanes(); l++) {
+                const size_t p = piv(l,k);
+                if (p != k) {
+                    T temp = b(l,k,c);
+                    b(l,k,c) = b(l,p,c);
+                    b(l,p,c) = temp;
+                }
+            }
+        }
+    });
+    exec.barrier();
+
+    // L y = P b, a column of L at a time
+    for (size_t j = 0; j < N; j++) {
+        exec.split(j+1, N, [&](size_t i) {
+            for (size_t c = 0; c < NRHS; c++) {
+                T solved[Exec::width];
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    solved[l] = b(l,j,c);
+                }
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    b(l,i,c) -= a(l,i,j)*solved[l];
+                }
+            }
+        });
+        exec.barrier();
+    }
+
+    // U x = y
+    for (size_t j = N; j-- > 0;) {
+        exec.split(0, 1, [&](size_t) {
+            for (size_t c = 0; c < NRHS; c++) {
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    b(l,j,c) /= a(l,j,j);
+                }
+            }
+        });
+        exec.barrier();
+        exec.split(0, j, [&](size_t i) {
+            for (size_t c = 0; c < NRHS; c++) {
+                T solved[Exec::width];
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    solved[l] = b(l,j,c);
+                }
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    b(l,i,c) -= a(l,i,j)*solved[l];
+                }
+            }
+        });
+        exec.barrier();
+    }
+}
+
+// A = L*L^T in place, the lower triangle is read and overwritten with L and
+// the strict upper triangle is not touched
+template <size_t N, typename Exec, typename MA>
+BATCH_INLINE_FUNCTION
+void cholesky_kernel(const Exec& exec, const MA& a) {
+    using T = batch_value_t<MA>;
+    for (size_t k = 0; k < N; k++) {
+        exec.split(0, 1, [&](size_t) {
+            for (size_t l = 0; l < exec.lanes(); l++) {
+                a(l,k,k) = sqrt(a(l,k,k));
+            }
+        });
+        exec.barrier();
+        exec.split(k+1, N, [&](size_t i) {
+            for (size_t l = 0; l < exec.lanes(); l++) {
+                a(l,i,k) /= a(l,k,k);
+            }
+        });
+        exec.barrier();
+        exec.split(k+1, N, [&](size_t i) {
+            T factor[Exec::width];
+            for (size_t l = 0; l < exec.lanes(); l++) {
+                factor[l] = a(l,i,k);
+            }
+            for (size_t j = k+1; j <= i; j++) {
+                T column_k[Exec::width];
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    column_k[l] = a(l,j,k);
+                }
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    a(l,i,j) -= factor[l]*column_k[l];
+                }
+            }
+        });
+        exec.barrier();
+    }
+}
+
+// B = (L L^T)^-1 B from the factor of cholesky_kernel, B is N x NRHS
+template <size_t N, size_t NRHS, typename Exec, typename MA, typename MB>
+BATCH_INLINE_FUNCTION
+void cholesky_solve_kernel(const Exec& exec, const MA& a, const MB& b) {
+    using T = batch_value_t<MB>;
+
+    // L y = b
+    for (size_t j = 0; j < N; j++) {
+        exec.split(0, 1, [&](size_t) {
+            for (size_t c = 0; c < NRHS; c++) {
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    b(l,j,c) /= a(l,j,j);
+                }
+            }
+        });
+        exec.barrier();
+        exec.split(j+1, N, [&](size_t i) {
+            for (size_t c = 0; c < NRHS; c++) {
+                T solved[Exec::width];
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    solved[l] = b(l,j,c);
+                }
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    b(l,i,c) -= a(l,i,j)*solved[l];
+                }
+            }
+        });
+        exec.barrier();
+    }
+
+    // L^T x = y
+    for (size_t j = N; j-- > 0;) {
+        exec.split(0, 1, [&](size_t) {
+            for (size_t c = 0; c < NRHS; c++) {
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    b(l,j,c) /= a(l,j,j);
+                }
+            }
+        });
+        exec.barrier();
+        exec.split(0, j, [&](size_t i) {
+            for (size_t c = 0; c < NRHS; c++) {
+                T solved[Exec::width];
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    solved[l] = b(l,j,c);
+                }
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    b(l,i,c) -= a(l,j,i)*solved[l];
+                }
+            }
+        });
+        exec.barrier();
+    }
+}
+
+// the determinant of the 1x1 to 3x3 matrices
+template <size_t N, typename MA>
+BATCH_INLINE_FUNCTION
+batch_value_t<MA> closed_form_determinant(const MA& a, size_t l) {
+    static_assert(N >= 1 && N <= 3, "closed form determinants are for 1x1 to 3x3 matrices");
+    if constexpr (N == 1) {
+        return a(l,0,0);
+    }
+    else if constexpr (N == 2) {
+        return a(l,0,0)*a(l,1,1) - a(l,0,1)*a(l,1,0);
+    }
+    else {
+        return a(l,0,0)*(a(l,1,1)*a(l,2,2) - a(l,1,2)*a(l,2,1))
+             - a(l,0,1)*(a(l,1,0)*a(l,2,2) - a(l,1,2)*a(l,2,0))
+             + a(l,0,2)*(a(l,1,0)*a(l,2,1) - a(l,1,1)*a(l,2,0));
+    }
+}
+
+// det(l) = det(A), A is not changed
+template <size_t N, typename Exec, typename MA, typename SD>
+BATCH_INLINE_FUNCTION
+void determinant_kernel(const Exec& exec, const MA& a, const SD& det) {
+    using T = batch_value_t<MA>;
+    if constexpr (N <= 3) {
+        for (size_t l = 0; l < exec.lanes(); l++) {
+            det(l) = closed_form_determinant<N>(a, l);
+        }
+    }
+    else {
+        // the product of the pivots of an LU factorization of a copy
+        LocalMatrices <T,Exec::width,N,N> lu;
+        LocalPivots <Exec::width,N> piv{};
+        lu.load(a);
+        lu_kernel<N>(exec, lu, piv);
+        for (size_t l = 0; l < exec.lanes(); l++) {
+            T product = T(1);
+            for (size_t k = 0; k < N; k++) {
+                product *= (piv(l,k) == k) ? lu(l,k,k) : -lu(l,k,k);
+            }
+            det(l) = product;
+        }
+    }
+}
+
+// Ainv = A^-1, A is not changed.  Gauss-Jordan elimination with partial
+// pivoting in the storage of Ainv, so no other matrix is needed.
+template <size_t N, typename Exec, typename MA, typename MI>
+BATCH_INLINE_FUNCTION
+void inverse_kernel(const Exec& exec, const MA& a, const MI& ainv) {
+    using T = batch_value_t<MI>;
+
+    if constexpr (N <= 3) {
+        exec.split(0, 1, [&](size_t) {
+            for (size_t l = 0; l < exec.lanes(); l++) {
+                const T inv_det = T(1)/closed_form_determinant<N>(a, l);
+                if constexpr (N == 1) {
+                    ainv(l,0,0) = inv_det;
+                }
+                else if constexpr (N == 2) {
+                    ainv(l,0,0) =  a(l,1,1)*inv_det;
+                    ainv(l,0,1) = -a(l,0,1)*inv_det;
+                    ainv(l,1,0) = -a(l,1,0)*inv_det;
+                    ainv(l,1,1) =  a(l,0,0)*inv_det;
+                }
+                else {
+                    ainv(l,0,0) = (a(l,1,1)*a(l,2,2) - a(l,1,2)*a(l,2,1))*inv_det;
+                    ainv(l,0,1) = (a(l,0,2)*a(l,2,1) - a(l,0,1)*a(l,2,2))*inv_det;
+                    ainv(l,0,2) = (a(l,0,1)*a(l,1,2) - a(l,0,2)*a(l,1,1))*inv_det;
+                    ainv(l,1,0) = (a(l,1,2)*a(l,2,0) - a(l,1,0)*a(l,2,2))*inv_det;
+                    ainv(l,1,1) = (a(l,0,0)*a(l,2,2) - a(l,0,2)*a(l,2,0))*inv_det;
+                    ainv(l,1,2) = (a(l,0,2)*a(l,1,0) - a(l,0,0)*a(l,1,2))*inv_det;
+                    ainv(l,2,0) = (a(l,1,0)*a(l,2,1) - a(l,1,1)*a(l,2,0))*inv_det;
+                    ainv(l,2,1) = (a(l,0,1)*a(l,2,0) - a(l,0,0)*a(l,2,1))*inv_det;
+                    ainv(l,2,2) = (a(l,0,0)*a(l,1,1) - a(l,0,1)*a(l,1,0))*inv_det;
+                }
+            }
+        });
+        exec.barrier();
+    }
+    else {
+        exec.split(0, N, [&](size_t i) {
+            for (size_t j = 0; j < N; j++) {
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    ainv(l,i,j) = a(l,i,j);
+                }
+            }
+        });
+        exec.barrier();
+
+        LocalPivots <Exec::width,N> piv{};
+        for (size_t k = 0; k < N; k++) {
+
+            pivot_search<N>(exec, ainv, piv, k);
+            exec.barrier();
+
+            exec.split(0, N, [&](size_t j) {
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    const size_t p = piv(l,k);
+                    if (p != k) {
+                        T temp = ainv(l,k,j);
+                        ainv(l,k,j) = ainv(l,p,j);
+                        ainv(l,p,j) = temp;
+                    }
+                }
+            });
+            exec.barrier();
+
+            // every thread reads the pivot before row k is scaled
+            T inv_pivot[Exec::width];
+            for (size_t l = 0; l < exec.lanes(); l++) {
+                inv_pivot[l] = (ainv(l,k,k) != T(0)) ? T(1)/ainv(l,k,k) : T(0);
+            }
+            exec.barrier();
+
+            exec.split(0, N, [&](size_t j) {
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    ainv(l,k,j) = ((j == k) ? T(1) : ainv(l,k,j))*inv_pivot[l];
+                }
+            });
+            exec.barrier();
+
+            // eliminate column k from the other rows, the column becomes
+            // that of the inverse
+            exec.split(0, N, [&](size_t i) {
+                if (i != k) {
+                    T factor[Exec::width];
+                    for (size_t l = 0; l < exec.lanes(); l++) {
+                        factor[l] = ainv(l,i,k);
+                        ainv(l,i,k) = T(0);
+                    }
+                    for (size_t j = 0; j < N; j++) {
+                        T row_k[Exec::width];
+                        for (size_t l = 0; l < exec.lanes(); l++) {
+                            row_k[l] = ainv(l,k,j);
+                        }
+                        for (size_t l = 0; l < exec.lanes(); l++) {
+                            ainv(l,i,j) -= factor[l]*row_k[l];
+                        }
+                    }
+                }
+            });
+            exec.barrier();
+        }
+
+        // undo the row swaps as column swaps, in reverse order
+        for (size_t k = N; k-- > 0;) {
+            exec.split(0, N, [&](size_t i) {
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    const size_t p = piv(l,k);
+                    if (p != k) {
+                        T temp = ainv(l,i,k);
+                        ainv(l,i,k) = ainv(l,i,p);
+                        ainv(l,i,p) = temp;
+                    }
+                }
+            });
+            exec.barrier();
+        }
+    }
+}
+
+
+//---One matrix, for use inside a FOR_ALL body---
+
+// C = alpha*A*B + beta*C, A is M x K and B is K x N
+template <size_t M, size_t N, size_t K, typename MA, typename MB, typename MC, typename S>
+BATCH_INLINE_FUNCTION
+void small_gemm(S alpha, MA&& a, MB&& b, S beta, MC&& c) {
+    gemm_kernel<M,N,K>(BatchLanes<1>(), alpha,
+                       SmallMatrix<std::remove_reference_t<MA>>{a},
+                       SmallMatrix<std::remove_reference_t<MB>>{b}, beta,
+                       SmallMatrix<std::remove_reference_t<MC>>{c});
+}
+
+// y = alpha*A*x + beta*y, A is M x N
+template <size_t M, size_t N, typename MA, typename VX, typename VY, typename S>
+BATCH_INLINE_FUNCTION
+void small_gemv(S alpha, MA&& a, VX&& x, S beta, VY&& y) {
+    gemv_kernel<M,N>(BatchLanes<1>(), alpha,
+                     SmallMatrix<std::remove_reference_t<MA>>{a},
+                     SmallVector<std::remove_reference_t<VX>>{x}, beta,
+                     SmallVector<std::remove_reference_t<VY>>{y});
+}
+
+// A = P*L*U in place, piv(k) is the row swapped with row k at step k
+template <size_t N, typename MA, typename PV>
+BATCH_INLINE_FUNCTION
+void small_lu(MA&& a, PV&& piv) {
+    LocalPivots <1,N> rows{};
+    lu_kernel<N>(BatchLanes<1>(), SmallMatrix<std::remove_reference_t<MA>>{a}, rows);
+    for (size_t k = 0; k < N; k++) {
+        piv(k) = rows(0,k);
+    }
+}
+
+// x = A^-1 x from the factors and pivots of small_lu
+template <size_t N, typename MA, typename PV, typename VX>
+BATCH_INLINE_FUNCTION
+void small_lu_solve(MA&& a, PV&& piv, VX&& x) {
+    LocalPivots <1,N> rows{};
+    for (size_t k = 0; k < N; k++) {
+        rows(0,k) = piv(k);
+    }
+    lu_solve_kernel<N,1>(BatchLanes<1>(), SmallMatrix<std::remove_reference_t<MA>>{a}, rows,
+                         SmallVector<std::remove_reference_t<VX>>{x});
+}
+
+// A = L*L^T in place, in the lower triangle
+template <size_t N, typename MA>
+BATCH_INLINE_FUNCTION
+void small_cholesky(MA&& a) {
+    cholesky_kernel<N>(BatchLanes<1>(), SmallMatrix<std::remove_reference_t<MA>>{a});
+}
+
+// x = (L L^T)^-1 x from the factor of small_cholesky
+template <size_t N, typename MA, typename VX>
+BATCH_INLINE_FUNCTION
+void small_cholesky_solve(MA&& a, VX&& x) {
+    cholesky_solve_kernel<N,1>(BatchLanes<1>(), SmallMatrix<std::remove_reference_t<MA>>{a},
+                               SmallVector<std::remove_reference_t<VX>>{x});
+}
+
+// x = A^-1 x, A is overwritten with its LU factors
+template <size_t N, typename MA, typename VX>
+BATCH_INLINE_FUNCTION
+void small_solve(MA&& a, VX&& x) {
+    LocalPivots <1,N> rows{};
+    lu_kernel<N>(BatchLanes<1>(), SmallMatrix<std::remove_reference_t<MA>>{a}, rows);
+    lu_solve_kernel<N,1>(BatchLanes<1>(), SmallMatrix<std::remove_reference_t<MA>>{a}, rows,
+                         SmallVector<std::remove_reference_t<VX>>{x});
+}
+
+// Ainv = A^-1
+template <size_t N, typename MA, typename MI>
+BATCH_INLINE_FUNCTION
+void small_inverse(MA&& a, MI&& ainv) {
+    inverse_kernel<N>(BatchLanes<1>(), SmallMatrix<std::remove_reference_t<MA>>{a},
+                      SmallMatrix<std::remove_reference_t<MI>>{ainv});
+}
+
+// det(A)
+template <size_t N, typename MA>
+BATCH_INLINE_FUNCTION
+auto small_determinant(MA&& a) {
+    using T = batch_value_t<SmallMatrix<std::remove_reference_t<MA>>>;
+    T det[1];
+    determinant_kernel<N>(BatchLanes<1>(), SmallMatrix<std::remove_reference_t<MA>>{a},
+                          [&](size_t l) -> T& { return det[l]; });
+    return det[0];
+}
+
+
+//---Batches---
+
+// Step n of a host batch: a block of MATAR_BATCH_WIDTH matrices, or past the
+// last whole block one of the rest
+template <typename Op>
+BATCH_INLINE_FUNCTION
+void batch_host_step(const Op& op, size_t n, size_t num_blocks) {
+    if (n < num_blocks) {
+        op(BatchLanes<MATAR_BATCH_WIDTH>(), n*MATAR_BATCH_WIDTH);
+    }
+    else {
+        op(BatchLanes<1>(), num_blocks*MATAR_BATCH_WIDTH + (n - num_blocks));
+    }
+}
+
+// Runs op(exec, first) over the matrices of a batch on the backend of array,
+// which has the matrix index first
+template <typename A, typename Op>
+void batch_for_each(const char* name, const A& array, [[maybe_unused]] BatchMode mode, const Op& op) {
+    using traits = expr_array_traits<A>;
+    static_assert(traits::is_array, "batched operations take CArray, FArray, CArrayKokkos or FArrayKokkos!");
+    const size_t num = array.dims(0);
+    const size_t num_blocks = num/MATAR_BATCH_WIDTH;
+    const size_t num_steps = num_blocks + num%MATAR_BATCH_WIDTH;
+
+#ifdef HAVE_KOKKOS
+    if constexpr (traits::space == ExprSpace::kokkos) {
+        using exec_space = typename traits::execution_space;
+        if (mode == BatchMode::per_team) {
+            using policy = Kokkos::TeamPolicy<exec_space>;
+            Kokkos::parallel_for(name, policy(num, Kokkos::AUTO),
+                                 KOKKOS_LAMBDA(const typename policy::member_type& team) {
+                op(BatchTeam<typename policy::member_type>{team}, team.league_rank());
+            });
+        }
+        else if (std::is_same<typename exec_space::memory_space, Kokkos::HostSpace>::value) {
+            // a host execution space takes blocks, as without Kokkos
+            Kokkos::parallel_for(name, Kokkos::RangePolicy<exec_space>(0, num_steps),
+                                 KOKKOS_LAMBDA(const size_t n) {
+                batch_host_step(op, n, num_blocks);
+            });
+        }
+        else {
+            Kokkos::parallel_for(name, Kokkos::RangePolicy<exec_space>(0, num),
+                                 KOKKOS_LAMBDA(const size_t b) {
+                op(BatchLanes<1>(), b);
+            });
+        }
+        return;
+    }
+#endif
+
+    // mode only applies to Kokkos execution spaces
+    host_for_each(name, num_steps, [&](size_t n) {
+        batch_host_step(op, n, num_blocks);
+    });
+}
+
+// the shape checks of the batched functions
+template <typename A>
+bool is_matrix_batch(const A& array, size_t num, size_t rows, size_t cols) {
+    return array.order() == 3 && array.dims(0) == num && array.dims(1) == rows && array.dims(2) == cols;
+}
+
+template <typename A>
+bool is_vector_batch(const A& array, size_t num, size_t rows) {
+    return array.order() == 2 && array.dims(0) == num && array.dims(1) == rows;
+}
+
+// The operations of the batched functions on the matrices from first on.  A
+// host block (Width > 1) works on LocalMatrices copies.
+template <size_t M, size_t N, size_t K, typename A, typename B, typename C, typename S>
+struct BatchGemm {
+    S alpha; A a; B b; S beta; C c;
+
+    template <typename Exec>
+    BATCH_INLINE_FUNCTION
+    void operator()(const Exec& exec, size_t first) const {
+        using T = typename expr_array_traits<C>::value_type;
+        if constexpr (Exec::width > 1) {
+            LocalMatrices <T,Exec::width,M,K> a_block;
+            LocalMatrices <T,Exec::width,K,N> b_block;
+            LocalMatrices <T,Exec::width,M,N> c_block;
+            a_block.load(BatchMatrices<A>{a, first});
+            b_block.load(BatchMatrices<B>{b, first});
+            if (beta != S(0)) c_block.load(BatchMatrices<C>{c, first});
+            gemm_kernel<M,N,K>(exec, alpha, a_block, b_block, beta, c_block);
+            c_block.store(BatchMatrices<C>{c, first});
+        }
+        else {
+            gemm_kernel<M,N,K>(exec, alpha, BatchMatrices<A>{a, first}, BatchMatrices<B>{b, first},
+                               beta, BatchMatrices<C>{c, first});
+        }
+    }
+};
+
+template <size_t M, size_t N, typename A, typename X, typename Y, typename S>
+struct BatchGemv {
+    S alpha; A a; X x; S beta; Y y;
+
+    template <typename Exec>
+    BATCH_INLINE_FUNCTION
+    void operator()(const Exec& exec, size_t first) const {
+        using T = typename expr_array_traits<Y>::value_type;
+        if constexpr (Exec::width > 1) {
+            LocalMatrices <T,Exec::width,M,N> a_block;
+            LocalMatrices <T,Exec::width,N,1> x_block;
+            LocalMatrices <T,Exec::width,M,1> y_block;
+            a_block.load(BatchMatrices<A>{a, first});
+            x_block.load(BatchVectors<X>{x, first});
+            if (beta != S(0)) y_block.load(BatchVectors<Y>{y, first});
+            gemv_kernel<M,N>(exec, alpha, a_block, x_block, beta, y_block);
+            y_block.store(BatchVectors<Y>{y, first});
+        }
+        else {
+            gemv_kernel<M,N>(exec, alpha, BatchMatrices<A>{a, first}, BatchVectors<X>{x, first},
+                             beta, BatchVectors<Y>{y, first});
+        }
+    }
+};
+
+template <size_t N, typename A, typename P>
+struct BatchLU {
+    A a; P piv;
+
+    template <typename Exec>
+    BATCH_INLINE_FUNCTION
+    void operator()(const Exec& exec, size_t first) const {
+        using T = typename expr_array_traits<A>::value_type;
+        LocalPivots <Exec::width,N> rows{};
+        if constexpr (Exec::width > 1) {
+            LocalMatrices <T,Exec::width,N,N> a_block;
+            a_block.load(BatchMatrices<A>{a, first});
+            lu_kernel<N>(exec, a_block, rows);
+            a_block.store(BatchMatrices<A>{a, first});
+        }
+        else {
+            lu_kernel<N>(exec, BatchMatrices<A>{a, first}, rows);
+        }
+        exec.split(0, 1, [&](size_t) {
+            for (size_t k = 0; k < N; k++) {
+                for (size_t l = 0; l < exec.lanes(); l++) {
+                    piv(first+l, k) = rows(l,k);
+                }
+            }
+        });
+    }
+};
+
+template <size_t N, typename A, typename P, typename X>
+struct BatchLUSolve {
+    A a; P piv; X x;
+
+    template <typename Exec>
+    BATCH_INLINE_FUNCTION
+    void operator()(const Exec& exec, size_t first) const {
+        using T = typename expr_array_traits<A>::value_type;
+        LocalPivots <Exec::width,N> rows{};
+        for (size_t k = 0; k < N; k++) {
+            for (size_t l = 0; l < exec.lanes(); l++) {
+                rows(l,k) = piv(first+l, k);
+            }
+        }
+        if constexpr (Exec::width > 1) {
+            LocalMatrices <T,Exec::width,N,N> a_block;
+            LocalMatrices <T,Exec::width,N,1> x_block;
+            a_block.load(BatchMatrices<A>{a, first});
+            x_block.load(BatchVectors<X>{x, first});
+            lu_solve_kernel<N,1>(exec, a_block, rows, x_block);
+            x_block.store(BatchVectors<X>{x, first});
+        }
+        else {
+            lu_solve_kernel<N,1>(exec, BatchMatrices<A>{a, first}, rows, BatchVectors<X>{x, first});
+        }
+    }
+};
+
+template <size_t N, typename A>
+struct BatchCholesky {
+    A a;
+
+    template <typename Exec>
+    BATCH_INLINE_FUNCTION
+    void operator()(const Exec& exec, size_t first) const {
+        using T = typename expr_array_traits<A>::value_type;
+        if constexpr (Exec::width > 1) {
+            LocalMatrices <T,Exec::width,N,N> a_block;
+            a_block.load(BatchMatrices<A>{a, first});
+            cholesky_kernel<N>(exec, a_block);
+            a_block.store(BatchMatrices<A>{a, first});
+        }
+        else {
+            cholesky_kernel<N>(exec, BatchMatrices<A>{a, first});
+        }
+    }
+};
+
+template <size_t N, typename A, typename X>
+struct BatchCholeskySolve {
+    A a; X x;
+
+    template <typename Exec>
+    BATCH_INLINE_FUNCTION
+    void operator()(const Exec& exec, size_t first) const {
+        using T = typename expr_array_traits<A>::value_type;
+        if constexpr (Exec::width > 1) {
+            LocalMatrices <T,Exec::width,N,N> a_block;
+            LocalMatrices <T,Exec::width,N,1> x_block;
+            a_block.load(BatchMatrices<A>{a, first});
+            x_block.load(BatchVectors<X>{x, first});
+            cholesky_solve_kernel<N,1>(exec, a_block, x_block);
+            x_block.store(BatchVectors<X>{x, first});
+        }
+        else {
+            cholesky_solve_kernel<N,1>(exec, BatchMatrices<A>{a, first}, BatchVectors<X>{x, first});
+        }
+    }
+};
+
+template <size_t N, typename A, typename X>
+struct BatchSolve {
+    A a; X x;
+
+    template <typename Exec>
+    BATCH_INLINE_FUNCTION
+    void operator()(const Exec& exec, size_t first) const {
+        using T = typename expr_array_traits<A>::value_type;
+        LocalPivots <Exec::width,N> rows{};
+        if constexpr (Exec::width > 1) {
+            LocalMatrices <T,Exec::width,N,N> a_block;
+            LocalMatrices <T,Exec::width,N,1> x_block;
+            a_block.load(BatchMatrices<A>{a, first});
+            x_block.load(BatchVectors<X>{x, first});
+            lu_kernel<N>(exec, a_block, rows);
+            lu_solve_kernel<N,1>(exec, a_block, rows, x_block);
+            a_block.store(BatchMatrices<A>{a, first});
+            x_block.store(BatchVectors<X>{x, first});
+        }
+        else {
+            lu_kernel<N>(exec, BatchMatrices<A>{a, first}, rows);
+            lu_solve_kernel<N,1>(exec, BatchMatrices<A>{a, first}, rows, BatchVectors<X>{x, first});
+        }
+    }
+};
+
+template <size_t N, typename A, typename I>
+struct BatchInverse {
+    A a; I ainv;
+
+    template <typename Exec>
+    BATCH_INLINE_FUNCTION
+    void operator()(const Exec& exec, size_t first) const {
+        using T = typename expr_array_traits<I>::value_type;
+        if constexpr (Exec::width > 1) {
+            LocalMatrices <T,Exec::width,N,N> a_block;
+            LocalMatrices <T,Exec::width,N,N> ainv_block{};
+            a_block.load(BatchMatrices<A>{a, first});
+            inverse_kernel<N>(exec, a_block, ainv_block);
+            ainv_block.store(BatchMatrices<I>{ainv, first});
+        }
+        else {
+            inverse_kernel<N>(exec, BatchMatrices<A>{a, first}, BatchMatrices<I>{ainv, first});
+        }
+    }
+};
+
+// the kernel works on a copy of its own
+template <size_t N, typename A, typename D>
+struct BatchDeterminant {
+    A a; D det;
+
+    template <typename Exec>
+    BATCH_INLINE_FUNCTION
+    void operator()(const Exec& exec, size_t first) const {
+        determinant_kernel<N>(exec, BatchMatrices<A>{a, first},
+                              [&](size_t l) -> decltype(auto) { return det(first+l); });
+    }
+};
+
+// C(b) = alpha*A(b)*B(b) + beta*C(b), A is num x M x K, B is num x K x N and C
+// is num x M x N.  With beta = 0, C is not read.
+template <size_t M, size_t N, size_t K, typename A, typename B, typename C, typename S>
+void batched_gemm(S alpha, const A& a, const B& b, S beta, const C& c,
+                  BatchMode mode = BatchMode::per_thread) {
+    [[maybe_unused]] const size_t num = a.dims(0);
+    assert(is_matrix_batch(a, num, M, K) && is_matrix_batch(b, num, K, N) && is_matrix_batch(c, num, M, N)
+           && "batched_gemm arrays do not match the sizes!");
+    batch_for_each("mtr::batched_gemm", a, mode, BatchGemm<M,N,K,A,B,C,S>{alpha, a, b, beta, c});
+}
+
+// y(b) = alpha*A(b)*x(b) + beta*y(b), A is num x M x N, x is num x N and y is
+// num x M.  With beta = 0, y is not read.
+template <size_t M, size_t N, typename A, typename X, typename Y, typename S>
+void batched_gemv(S alpha, const A& a, const X& x, S beta, const Y& y,
+                  BatchMode mode = BatchMode::per_thread) {
+    [[maybe_unused]] const size_t num = a.dims(0);
+    assert(is_matrix_batch(a, num, M, N) && is_vector_batch(x, num, N) && is_vector_batch(y, num, M)
+           && "batched_gemv arrays do not match the sizes!");
+    batch_for_each("mtr::batched_gemv", a, mode, BatchGemv<M,N,A,X,Y,S>{alpha, a, x, beta, y});
+}
+
+// A(b) = P*L*U in place, A is num x N x N and piv(b,k), num x N, is the row
+// swapped with row k at step k
+template <size_t N, typename A, typename P>
+void batched_lu(const A& a, const P& piv, BatchMode mode = BatchMode::per_thread) {
+    [[maybe_unused]] const size_t num = a.dims(0);
+    assert(is_matrix_batch(a, num, N, N) && is_vector_batch(piv, num, N)
+           && "batched_lu arrays do not match the sizes!");
+    batch_for_each("mtr::batched_lu", a, mode, BatchLU<N,A,P>{a, piv});
+}
+
+// x(b) = A(b)^-1 x(b) from the factors and pivots of batched_lu
+template <size_t N, typename A, typename P, typename X>
+void batched_lu_solve(const A& a, const P& piv, const X& x, BatchMode mode = BatchMode::per_thread) {
+    [[maybe_unused]] const size_t num = a.dims(0);
+    assert(is_matrix_batch(a, num, N, N) && is_vector_batch(piv, num, N) && is_vector_batch(x, num, N)
+           && "batched_lu_solve arrays do not match the sizes!");
+    batch_for_each("mtr::batched_lu_solve", a, mode, BatchLUSolve<N,A,P,X>{a, piv, x});
+}
+
+// A(b) = L*L^T in place, in the lower triangle of the symmetric positive
+// definite A(b)
+template <size_t N, typename A>
+void batched_cholesky(const A& a, BatchMode mode = BatchMode::per_thread) {
+    assert(is_matrix_batch(a, a.dims(0), N, N) && "batched_cholesky array does not match the size!");
+    batch_for_each("mtr::batched_cholesky", a, mode, BatchCholesky<N,A>{a});
+}
+
+// x(b) = A(b)^-1 x(b) from the factor of batched_cholesky
+template <size_t N, typename A, typename X>
+void batched_cholesky_solve(const A& a, const X& x, BatchMode mode = BatchMode::per_thread) {
+    [[maybe_unused]] const size_t num = a.dims(0);
+    assert(is_matrix_batch(a, num, N, N) && is_vector_batch(x, num, N)
+           && "batched_cholesky_solve arrays do not match the sizes!");
+    batch_for_each("mtr::batched_cholesky_solve", a, mode, BatchCholeskySolve<N,A,X>{a, x});
+}
+
+// x(b) = A(b)^-1 x(b), A(b) is overwritten with its LU factors
+template <size_t N, typename A, typename X>
+void batched_solve(const A& a, const X& x, BatchMode mode = BatchMode::per_thread) {
+    [[maybe_unused]] const size_t num = a.dims(0);
+    assert(is_matrix_batch(a, num, N, N) && is_vector_batch(x, num, N)
+           && "batched_solve arrays do not match the sizes!");
+    batch_for_each("mtr::batched_solve", a, mode, BatchSolve<N,A,X>{a, x});
+}
+
+// ainv(b) = A(b)^-1, both num x N x N
+template <size_t N, typename A, typename I>
+void batched_inverse(const A& a, const I& ainv, BatchMode mode = BatchMode::per_thread) {
+    [[maybe_unused]] const size_t num = a.dims(0);
+    assert(is_matrix_batch(a, num, N, N) && is_matrix_batch(ainv, num, N, N)
+           && "batched_inverse arrays do not match the sizes!");
+    batch_for_each("mtr::batched_inverse", a, mode, BatchInverse<N,A,I>{a, ainv});
+}
+
+// det(b) = det(A(b)), A is not changed.  Always one matrix per thread, the
+// larger sizes factor a thread local copy.
+template <size_t N, typename A, typename D>
+void batched_determinant(const A& a, const D& det) {
+    [[maybe_unused]] const size_t num = a.dims(0);
+    assert(is_matrix_batch(a, num, N, N) && det.order() == 1 && det.dims(0) == num
+           && "batched_determinant arrays do not match the sizes!");
+    batch_for_each("mtr::batched_determinant", a, BatchMode::per_thread, BatchDeterminant<N,A,D>{a, det});
+}
+
+} // end namespace mtr
+
+#endif // BATCHED_LINALG_H
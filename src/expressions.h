@@ -0,0 +1,376 @@
+#ifndef EXPRESSIONS_H
+#define EXPRESSIONS_H
+/**********************************************************************************************
+ © 2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+/**********************************************************************************************
+ Lazy elementwise arithmetic on the dense MATAR types.  +, -, * and / between CArray,
+ FArray, CArrayKokkos or FArrayKokkos operands and scalars build an expression object and
+ nothing is computed until it is assigned to an array, e.g.
+
+     CArray <double> a(num_nodes, 3);
+     ...
+     a = b + dt*c - d;
+
+ runs one loop over the storage of a that reads b, c and d once per element and makes no
+ temporary arrays.  The loop runs on the backend that FOR_ALL uses for the array: a
+ RangePolicy on the execution space of a Kokkos array, and for a host array the thread pool,
+ a host RangePolicy with kokkos, or a serial loop.
+
+ Every array in an expression must have the same order, dims and storage size as the array
+ it is assigned to (asserted), and C and F types, or host and Kokkos types, can not be mixed
+ (a compile error).  The result element n depends only on element n of the operands, so an
+ array may appear on both sides, as in a = a + dt*b.
+ **********************************************************************************************/
+
+#include <assert.h>
+#include <type_traits>
+#include "host_types.h"
+#ifdef HAVE_KOKKOS
+#include "kokkos_types.h"
+#endif
+
+#ifdef HAVE_KOKKOS
+#define EXPR_INLINE_FUNCTION KOKKOS_INLINE_FUNCTION
+#else
+#define EXPR_INLINE_FUNCTION inline
+#endif
+
+
+namespace mtr
+{
+
+// the index order of the operands, scalars fit either
+struct ExprLayoutC {};
+struct ExprLayoutF {};
+struct ExprLayoutAny {};
+
+template <typename L1, typename L2>
+struct expr_common_layout { using type = void; };
+
+template <typename L>
+struct expr_common_layout<L, L> { using type = L; };
+
+template <typename L>
+struct expr_common_layout<L, ExprLayoutAny> { using type = L; };
+
+template <typename L>
+struct expr_common_layout<ExprLayoutAny, L> { using type = L; };
+
+template <>
+struct expr_common_layout<ExprLayoutAny, ExprLayoutAny> { using type = ExprLayoutAny; };
+
+// where the operands live, scalars fit either
+enum class ExprSpace {
+    any,
+    host,
+    kokkos,
+    mixed
+};
+
+constexpr ExprSpace expr_common_space(ExprSpace s1, ExprSpace s2) {
+    return s1 == ExprSpace::any ? s2
+         : s2 == ExprSpace::any ? s1
+         : s1 == s2 ? s1
+         : ExprSpace::mixed;
+}
+
+
+// The arrays that can be operands.  An operand holds the raw pointer, which is
+// what the loop body reads, and the address of the array for the shape check.
+template <typename A>
+struct expr_array_traits {
+    static constexpr bool is_array = false;
+};
+
+template <typename T>
+struct expr_array_traits<CArray<T>> {
+    static constexpr bool is_array = true;
+    using value_type = T;
+    using layout = ExprLayoutC;
+    static constexpr ExprSpace space = ExprSpace::host;
+};
+
+template <typename T>
+struct expr_array_traits<FArray<T>> {
+    static constexpr bool is_array = true;
+    using value_type = T;
+    using layout = ExprLayoutF;
+    static constexpr ExprSpace space = ExprSpace::host;
+};
+
+#ifdef HAVE_KOKKOS
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+struct expr_array_traits<CArrayKokkos<T,Layout,ExecSpace,MemoryTraits>> {
+    static constexpr bool is_array = true;
+    using value_type = T;
+    using layout = ExprLayoutC;
+    using execution_space = typename Kokkos::View<T*, Layout, ExecSpace, MemoryTraits>::execution_space;
+    static constexpr ExprSpace space = ExprSpace::kokkos;
+};
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+struct expr_array_traits<FArrayKokkos<T,Layout,ExecSpace,MemoryTraits>> {
+    static constexpr bool is_array = true;
+    using value_type = T;
+    using layout = ExprLayoutF;
+    using execution_space = typename Kokkos::View<T*, Layout, ExecSpace, MemoryTraits>::execution_space;
+    static constexpr ExprSpace space = ExprSpace::kokkos;
+};
+#endif
+
+// an array operand
+template <typename A>
+class ArrayExpr {
+
+private:
+    using traits = expr_array_traits<A>;
+    const typename traits::value_type* data_;
+    const A* array_;
+
+public:
+    using matar_expr = void;
+    using value_type = typename traits::value_type;
+    using layout = typename traits::layout;
+    static constexpr ExprSpace space = traits::space;
+
+    explicit ArrayExpr(const A& array) : data_(array.pointer()), array_(&array) {}
+
+    EXPR_INLINE_FUNCTION
+    value_type operator[](size_t n) const { return data_[n]; }
+
+    // true when the array has the shape of dest
+    template <typename D>
+    bool same_shape(const D& dest) const {
+        if (array_->order() != dest.order() || array_->size() != dest.size()) return false;
+        for (size_t i = 0; i < dest.order(); i++) {
+            if (array_->dims(i) != dest.dims(i)) return false;
+        }
+        return true;
+    }
+};
+
+// a scalar operand
+template <typename S>
+class ScalarExpr {
+
+private:
+    S value_;
+
+public:
+    using matar_expr = void;
+    using value_type = S;
+    using layout = ExprLayoutAny;
+    static constexpr ExprSpace space = ExprSpace::any;
+
+    explicit ScalarExpr(S value) : value_(value) {}
+
+    EXPR_INLINE_FUNCTION
+    value_type operator[](size_t) const { return value_; }
+
+    template <typename D>
+    bool same_shape(const D&) const { return true; }
+};
+
+// the operations
+struct ExprAdd {
+    template <typename L, typename R>
+    EXPR_INLINE_FUNCTION static auto apply(const L& l, const R& r) { return l + r; }
+};
+
+struct ExprSub {
+    template <typename L, typename R>
+    EXPR_INLINE_FUNCTION static auto apply(const L& l, const R& r) { return l - r; }
+};
+
+struct ExprMul {
+    template <typename L, typename R>
+    EXPR_INLINE_FUNCTION static auto apply(const L& l, const R& r) { return l * r; }
+};
+
+struct ExprDiv {
+    template <typename L, typename R>
+    EXPR_INLINE_FUNCTION static auto apply(const L& l, const R& r) { return l / r; }
+};
+
+template <typename Op, typename L, typename R>
+class BinaryExpr {
+
+private:
+    L lhs_;
+    R rhs_;
+
+public:
+    using matar_expr = void;
+    using value_type = decltype(Op::apply(std::declval<typename L::value_type>(),
+                                          std::declval<typename R::value_type>()));
+    using layout = typename expr_common_layout<typename L::layout, typename R::layout>::type;
+    static constexpr ExprSpace space = expr_common_space(L::space, R::space);
+
+    static_assert(!std::is_void<layout>::value, "C and F arrays can not be mixed in an expression!");
+    static_assert(space != ExprSpace::mixed, "host and Kokkos arrays can not be mixed in an expression!");
+
+    BinaryExpr(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {}
+
+    EXPR_INLINE_FUNCTION
+    value_type operator[](size_t n) const { return Op::apply(lhs_[n], rhs_[n]); }
+
+    template <typename D>
+    bool same_shape(const D& dest) const { return lhs_.same_shape(dest) && rhs_.same_shape(dest); }
+};
+
+template <typename E>
+class NegateExpr {
+
+private:
+    E expr_;
+
+public:
+    using matar_expr = void;
+    using value_type = typename E::value_type;
+    using layout = typename E::layout;
+    static constexpr ExprSpace space = E::space;
+
+    explicit NegateExpr(const E& expr) : expr_(expr) {}
+
+    EXPR_INLINE_FUNCTION
+    value_type operator[](size_t n) const { return -expr_[n]; }
+
+    template <typename D>
+    bool same_shape(const D& dest) const { return expr_.same_shape(dest); }
+};
+
+
+// what an operand of the operators turns into: arrays become ArrayExpr,
+// arithmetic scalars ScalarExpr, and expressions stay as they are
+template <typename X, typename = void>
+struct expr_operand {
+    static constexpr bool valid = false;
+};
+
+template <typename X>
+struct expr_operand<X, typename std::enable_if<expr_array_traits<X>::is_array>::type> {
+    static constexpr bool valid = true;
+    static constexpr bool is_scalar = false;
+    using type = ArrayExpr<X>;
+    static type wrap(const X& x) { return type(x); }
+};
+
+template <typename X>
+struct expr_operand<X, typename std::enable_if<std::is_arithmetic<X>::value>::type> {
+    static constexpr bool valid = true;
+    static constexpr bool is_scalar = true;
+    using type = ScalarExpr<X>;
+    static type wrap(const X& x) { return type(x); }
+};
+
+template <typename X>
+struct expr_operand<X, typename std::enable_if<std::is_void<typename X::matar_expr>::value>::type> {
+    static constexpr bool valid = true;
+    static constexpr bool is_scalar = false;
+    using type = X;
+    static const type& wrap(const X& x) { return x; }
+};
+
+// the operators take two valid operands that are not both scalars
+template <typename L, typename R>
+using enable_expr_binary = typename std::enable_if<
+    expr_operand<L>::valid && expr_operand<R>::valid &&
+    !(expr_operand<L>::is_scalar && expr_operand<R>::is_scalar)>::type;
+
+template <typename Op, typename L, typename R>
+using binary_expr_t = BinaryExpr<Op, typename expr_operand<L>::type, typename expr_operand<R>::type>;
+
+template <typename L, typename R, typename = enable_expr_binary<L, R>>
+binary_expr_t<ExprAdd, L, R> operator+ (const L& lhs, const R& rhs) {
+    return binary_expr_t<ExprAdd, L, R>(expr_operand<L>::wrap(lhs), expr_operand<R>::wrap(rhs));
+}
+
+template <typename L, typename R, typename = enable_expr_binary<L, R>>
+binary_expr_t<ExprSub, L, R> operator- (const L& lhs, const R& rhs) {
+    return binary_expr_t<ExprSub, L, R>(expr_operand<L>::wrap(lhs), expr_operand<R>::wrap(rhs));
+}
+
+template <typename L, typename R, typename = enable_expr_binary<L, R>>
+binary_expr_t<ExprMul, L, R> operator* (const L& lhs, const R& rhs) {
+    return binary_expr_t<ExprMul, L, R>(expr_operand<L>::wrap(lhs), expr_operand<R>::wrap(rhs));
+}
+
+template <typename L, typename R, typename = enable_expr_binary<L, R>>
+binary_expr_t<ExprDiv, L, R> operator/ (const L& lhs, const R& rhs) {
+    return binary_expr_t<ExprDiv, L, R>(expr_operand<L>::wrap(lhs), expr_operand<R>::wrap(rhs));
+}
+
+template <typename E, typename = typename std::enable_if<
+    expr_operand<E>::valid && !expr_operand<E>::is_scalar>::type>
+NegateExpr<typename expr_operand<E>::type> operator- (const E& expr) {
+    return NegateExpr<typename expr_operand<E>::type>(expr_operand<E>::wrap(expr));
+}
+
+
+// Evaluates expr into the storage of dest in one loop, called by the
+// expression assignment operators of the arrays
+template <typename A, typename E>
+void assign_expr(A& dest, const E& expr) {
+    using traits = expr_array_traits<A>;
+    static_assert(traits::is_array, "expressions can only be assigned to CArray, FArray, CArrayKokkos or FArrayKokkos!");
+    static_assert(!std::is_void<typename expr_common_layout<typename traits::layout, typename E::layout>::type>::value,
+                  "a C array can not be assigned an F expression or the reverse!");
+    static_assert(expr_common_space(traits::space, E::space) != ExprSpace::mixed,
+                  "host and Kokkos arrays can not be mixed in an expression!");
+    assert(expr.same_shape(dest) && "arrays in an expression must have the order, dims and size of the array assigned to!");
+
+    using T = typename traits::value_type;
+    T* data = dest.pointer();
+    const size_t length = dest.size();
+
+#ifdef HAVE_KOKKOS
+    if constexpr (traits::space == ExprSpace::kokkos) {
+        Kokkos::parallel_for("mtr::assign_expr", Kokkos::RangePolicy<typename traits::execution_space>(0, length),
+                             KOKKOS_LAMBDA(const size_t n) { data[n] = static_cast<T>(expr[n]); });
+    }
+    else {
+        host_for_each("mtr::assign_expr", length, [&](size_t n) { data[n] = static_cast<T>(expr[n]); });
+    }
+#else
+    host_for_each("mtr::assign_expr", length, [&](size_t n) { data[n] = static_cast<T>(expr[n]); });
+#endif
+}
+
+} // end namespace mtr
+
+#endif // EXPRESSIONS_H
@@ -40,7 +40,29 @@
 #include <stdlib.h>
 #include <string>
 #include <assert.h>
+#include <algorithm> // for stable_sort
 #include <memory> // for shared_ptr
+#include <new> // for align_val_t
+#include <type_traits>
+#include <utility> // for index_sequence
+
+#include "allocators.h"
+
+// the sorted index helpers below are also called by the kokkos sparse types,
+// and the fixed-size types can be declared inside device kernels
+#ifdef HAVE_KOKKOS
+#include <Kokkos_Core.hpp>
+#define SPARSE_INLINE_FUNCTION KOKKOS_INLINE_FUNCTION
+#define FIXED_INLINE_FUNCTION KOKKOS_INLINE_FUNCTION
+#else
+#define SPARSE_INLINE_FUNCTION inline
+#define FIXED_INLINE_FUNCTION inline
+#endif
+
+// the sparse transpose splits its rows over the native thread pool
+#if defined(HAVE_THREAD_POOL) && !defined(HAVE_KOKKOS)
+#include "thread_pool.h"
+#endif
 
 
 namespace mtr
@@ -49,6 +71,444 @@ namespace mtr
 
 //---Begin Standard Data Structures---
 
+// non-owning types returned by borrow()
+template <typename T> class ViewFArray;
+template <typename T> class ViewFMatrix;
+template <typename T> class ViewCArray;
+template <typename T> class ViewCMatrix;
+template <typename T, size_t Base> class ViewStrided;
+template <typename T> class ViewRaggedRightArray;
+template <typename T> class ViewRaggedDownArray;
+template <typename T> class ViewCSRArray;
+template <typename T> class ViewCSCArray;
+template <typename T, size_t Rank> class ViewFArrayND;
+template <typename T, size_t Rank> class ViewFMatrixND;
+template <typename T, size_t Rank> class ViewCArrayND;
+template <typename T, size_t Rank> class ViewCMatrixND;
+
+// evaluates an elementwise expression into an array, see expressions.h
+template <typename A, typename E> void assign_expr(A& dest, const E& expr);
+
+
+// How a new array's elements are initialized.  Memory is placed on the NUMA
+// node of the thread that first writes each page, so an array that is filled
+// by one thread ends up on one socket however it is used later.
+//   zero        - value-initialized (zero) on the calling thread
+//   none        - default-initialized, nothing is written for arithmetic types
+//   first_touch - value-initialized in parallel, split over the threads the
+//                 same way a FOR_ALL over the whole array is split, so each
+//                 page lands near the thread that will work on it
+// The host types default to none and the Kokkos types to zero.
+enum class ArrayInit {
+    zero,
+    none,
+    first_touch
+};
+
+// Calls fcn(n) for n in [0, length) on the host with the split of a FOR_ALL
+// over length indices: the chunks of the thread pool, or a host RangePolicy
+// with kokkos.  Serial without either.
+template <typename F>
+void host_for_each([[maybe_unused]] const char* name, size_t length, const F& fcn) {
+#if defined(HAVE_KOKKOS)
+    Kokkos::parallel_for(name, Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, length),
+                         [&](const size_t n) { fcn(n); });
+#elif defined(HAVE_THREAD_POOL)
+    pool_chunks(length, [&](size_t begin, size_t end, size_t) {
+        for (size_t n = begin; n < end; n++) {
+            fcn(n);
+        }
+    });
+#else
+    for (size_t n = 0; n < length; n++) {
+        fcn(n);
+    }
+#endif
+}
+
+// value-initializes [data, data+length), each element from the thread that
+// a FOR_ALL over the array gives it
+template <typename T>
+void first_touch_construct(T* data, size_t length) {
+    host_for_each("first_touch", length, [=](size_t n) { new (data + n) T(); });
+}
+
+#ifndef MATAR_HOST_ALIGNMENT
+#define MATAR_HOST_ALIGNMENT 64 // bytes, a cache line
+#endif
+
+// How FArray, FMatrix, CArray and CMatrix allocate.  alignment is the byte
+// alignment of the first element, a power of two.  pad rounds the fastest
+// dimension (the first for F types, the last for C types) up to a multiple
+// of pad elements and the index strides use the padded extent, so when
+// pad*sizeof(T) is a multiple of alignment every row (or column) starts
+// aligned.  dims() are the requested extents and size() counts the padded
+// storage, e.g.
+//     CArray <double> temperature(height+2, width+2, simd_padded<double>());
+// With an allocator (a PoolAllocator or an ArenaAllocator) the storage comes
+// from it and goes back to it with the last copy of the array.  init says how
+// the elements are first written, see ArrayInit.
+struct AllocPolicy {
+    size_t alignment = MATAR_HOST_ALIGNMENT;
+    size_t pad = 1;
+    Allocator* allocator = nullptr; // the aligned operator new when null, see allocators.h
+    ArrayInit init = ArrayInit::none;
+};
+
+// aligned, the elements zeroed in parallel by the threads that will use them
+inline AllocPolicy first_touch() {
+    AllocPolicy policy;
+    policy.init = ArrayInit::first_touch;
+    return policy;
+}
+
+// aligned, and the fastest dimension padded to whole alignment-sized blocks
+template <typename T>
+inline AllocPolicy simd_padded(size_t alignment = MATAR_HOST_ALIGNMENT) {
+    AllocPolicy policy;
+    policy.alignment = alignment;
+    policy.pad = (alignment % sizeof(T) == 0) ? alignment / sizeof(T) : 1;
+    return policy;
+}
+
+// length elements initialized as policy.init says, starting on a
+// policy.alignment-byte boundary, from policy.allocator when there is one
+template <typename T>
+std::shared_ptr <T []> aligned_allocate(size_t length, const AllocPolicy& policy) {
+    assert(policy.alignment > 0 && (policy.alignment & (policy.alignment - 1)) == 0 && "alignment must be a power of two!");
+    size_t alignment = policy.alignment > alignof(T) ? policy.alignment : alignof(T);
+    size_t bytes = length * sizeof(T);
+    Allocator* allocator = policy.allocator;
+    T* data = (allocator == nullptr)
+            ? static_cast<T*>(::operator new[](bytes, static_cast<std::align_val_t>(alignment)))
+            : static_cast<T*>(allocator->allocate(bytes, alignment));
+    if (policy.init == ArrayInit::first_touch) {
+        first_touch_construct(data, length);
+    }
+    else if (policy.init == ArrayInit::zero) {
+        std::uninitialized_value_construct_n(data, length);
+    }
+    else {
+        std::uninitialized_default_construct_n(data, length);
+    }
+    return std::shared_ptr <T []> (data, [length, bytes, alignment, allocator](T* ptr) {
+        std::destroy_n(ptr, length);
+        if (allocator == nullptr) {
+            ::operator delete[](ptr, static_cast<std::align_val_t>(alignment));
+        }
+        else {
+            allocator->deallocate(ptr, bytes, alignment);
+        }
+    });
+}
+
+// A range of indices [begin, end) taken every step elements, one per dimension
+// in subarray().  begin and end are in the indices of the array sliced, so
+// they start at 1 for the matrix types.  The default range is the whole
+// dimension.
+struct SliceRange {
+    size_t begin;
+    size_t end;
+    size_t step;
+
+    SliceRange() : begin(0), end((size_t) -1), step(1) {}
+
+    template <typename B, typename E>
+    SliceRange(B range_begin, E range_end, size_t range_step = 1)
+        : begin((size_t) range_begin), end((size_t) range_end), step(range_step) {}
+
+    bool whole() const { return end == (size_t) -1; }
+};
+
+// The extents and element strides of a strided view and the offset of its
+// first element from the start of the storage
+struct StridedShape {
+    size_t order = 0;
+    size_t dims[7] = {0, 0, 0, 0, 0, 0, 0};
+    size_t strides[7] = {0, 0, 0, 0, 0, 0, 0};
+    size_t offset = 0;
+};
+
+// the shape of a dense C (last index fastest) or F (first index fastest)
+// array whose fastest dimension is padded to padded_dim elements
+inline StridedShape dense_shape(size_t order, const size_t* dims, size_t padded_dim, bool c_order) {
+    StridedShape shape;
+    shape.order = order;
+    for (size_t d = 0; d < order; d++) {
+        shape.dims[d] = dims[d];
+    }
+    if (c_order) {
+        size_t stride = 1;
+        for (size_t d = order; d-- > 0;) {
+            shape.strides[d] = stride;
+            stride *= (d == order - 1) ? padded_dim : dims[d];
+        }
+    }
+    else {
+        size_t stride = 1;
+        for (size_t d = 0; d < order; d++) {
+            shape.strides[d] = stride;
+            stride *= (d == 0) ? padded_dim : dims[d];
+        }
+    }
+    return shape;
+}
+
+// shape with dimension dim fixed at index, one order less
+inline StridedShape slice_shape(const StridedShape& shape, size_t dim, size_t index, size_t base) {
+    assert(shape.order >= 2 && "slice needs an array of order 2 or more!");
+    assert(dim < shape.order && "slice dimension is out of range!");
+    assert(index >= base && index < shape.dims[dim] + base && "slice index is out of bounds!");
+    StridedShape sliced;
+    sliced.order = shape.order - 1;
+    sliced.offset = shape.offset + (index - base) * shape.strides[dim];
+    for (size_t d = 0, out = 0; d < shape.order; d++) {
+        if (d == dim) continue;
+        sliced.dims[out] = shape.dims[d];
+        sliced.strides[out] = shape.strides[d];
+        out++;
+    }
+    return sliced;
+}
+
+// shape restricted to a range per dimension, the order is unchanged
+inline StridedShape subarray_shape(const StridedShape& shape, const SliceRange* ranges, size_t base) {
+    StridedShape sub = shape;
+    for (size_t d = 0; d < 7; d++) {
+        const SliceRange& range = ranges[d];
+        if (d >= shape.order) {
+            assert(range.whole() && "subarray has more ranges than the array has dims!");
+            continue;
+        }
+        size_t begin = range.whole() ? base : range.begin;
+        size_t end = range.whole() ? shape.dims[d] + base : range.end;
+        assert(range.step > 0 && "subarray step must be positive!");
+        assert(begin >= base && begin <= end && end <= shape.dims[d] + base && "subarray range is out of bounds!");
+        sub.offset += (begin - base) * shape.strides[d];
+        sub.dims[d] = (end - begin + range.step - 1) / range.step;
+        sub.strides[d] = shape.strides[d] * range.step;
+    }
+    return sub;
+}
+
+// the number of storage elements from the first element of shape to its last
+inline size_t strided_span(const StridedShape& shape) {
+    size_t span = 1;
+    for (size_t d = 0; d < shape.order; d++) {
+        if (shape.dims[d] == 0) return 0;
+        span += (shape.dims[d] - 1) * shape.strides[d];
+    }
+    return span;
+}
+
+//0. ViewStrided
+// A non-owning view of a block of a dense array with a stride per dimension,
+// made by slice() and subarray() of the dense host types.  Indices start at
+// Base, 0 for ViewStridedArray and 1 for ViewStridedMatrix, e.g.
+//     CArray <double> u(nx, ny, nz);
+//     ViewStridedArray <double> face = u.slice(2, 0);              // u(i,j,0)
+//     ViewStridedArray <double> inner = u.subarray({1, nx-1}, {1, ny-1}, {1, nz-1});
+//     ViewStridedArray <double> red = u.subarray({0, nx, 2});      // every other i
+// The view reads and writes the array in place and must not outlive it.
+template <typename T, size_t Base>
+class ViewStrided {
+
+private:
+    T* array_; // the first element
+    StridedShape shape_;
+
+public:
+    ViewStrided();
+
+    ViewStrided(T* some_array, const StridedShape& shape);
+
+    T& operator()(size_t i) const;
+
+    T& operator()(size_t i, size_t j) const;
+
+    T& operator()(size_t i, size_t j, size_t k) const;
+
+    T& operator()(size_t i, size_t j, size_t k, size_t l) const;
+
+    T& operator()(size_t i, size_t j, size_t k, size_t l, size_t m) const;
+
+    T& operator()(size_t i, size_t j, size_t k, size_t l, size_t m, size_t n) const;
+
+    T& operator()(size_t i, size_t j, size_t k, size_t l, size_t m, size_t n, size_t o) const;
+
+    // number of elements in the view
+    size_t size() const;
+
+    size_t dims(size_t i) const;
+
+    // element stride of dimension i in the array viewed
+    size_t stride(size_t i) const;
+
+    size_t order() const;
+
+    // the first element
+    T* pointer() const;
+
+    // views of views, see the dense types
+    ViewStrided slice(size_t dim, size_t index) const;
+
+    ViewStrided subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                         SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                         SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
+}; // end of ViewStrided
+
+template <typename T>
+using ViewStridedArray = ViewStrided<T, 0>;
+
+template <typename T>
+using ViewStridedMatrix = ViewStrided<T, 1>;
+
+template <typename T, size_t Base>
+ViewStrided<T,Base>::ViewStrided() : array_(nullptr) {}
+
+template <typename T, size_t Base>
+ViewStrided<T,Base>::ViewStrided(T* some_array, const StridedShape& shape)
+    : array_(some_array + shape.offset), shape_(shape) {
+    shape_.offset = 0;
+}
+
+template <typename T, size_t Base>
+inline T& ViewStrided<T,Base>::operator()(size_t i) const {
+    assert(shape_.order == 1 && "Tensor order (rank) does not match the view in ViewStrided 1D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStrided 1D!");
+    return array_[(i - Base)*shape_.strides[0]];
+}
+
+template <typename T, size_t Base>
+inline T& ViewStrided<T,Base>::operator()(size_t i, size_t j) const {
+    assert(shape_.order == 2 && "Tensor order (rank) does not match the view in ViewStrided 2D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStrided 2D!");
+    assert(j >= Base && j < shape_.dims[1] + Base && "j is out of bounds in ViewStrided 2D!");
+    return array_[(i - Base)*shape_.strides[0] + (j - Base)*shape_.strides[1]];
+}
+
+template <typename T, size_t Base>
+inline T& ViewStrided<T,Base>::operator()(size_t i, size_t j, size_t k) const {
+    assert(shape_.order == 3 && "Tensor order (rank) does not match the view in ViewStrided 3D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStrided 3D!");
+    assert(j >= Base && j < shape_.dims[1] + Base && "j is out of bounds in ViewStrided 3D!");
+    assert(k >= Base && k < shape_.dims[2] + Base && "k is out of bounds in ViewStrided 3D!");
+    return array_[(i - Base)*shape_.strides[0]
+                  + (j - Base)*shape_.strides[1]
+                  + (k - Base)*shape_.strides[2]];
+}
+
+template <typename T, size_t Base>
+inline T& ViewStrided<T,Base>::operator()(size_t i, size_t j, size_t k, size_t l) const {
+    assert(shape_.order == 4 && "Tensor order (rank) does not match the view in ViewStrided 4D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStrided 4D!");
+    assert(j >= Base && j < shape_.dims[1] + Base && "j is out of bounds in ViewStrided 4D!");
+    assert(k >= Base && k < shape_.dims[2] + Base && "k is out of bounds in ViewStrided 4D!");
+    assert(l >= Base && l < shape_.dims[3] + Base && "l is out of bounds in ViewStrided 4D!");
+    return array_[(i - Base)*shape_.strides[0]
+                  + (j - Base)*shape_.strides[1]
+                  + (k - Base)*shape_.strides[2]
+                  + (l - Base)*shape_.strides[3]];
+}
+
+template <typename T, size_t Base>
+inline T& ViewStrided<T,Base>::operator()(size_t i, size_t j, size_t k, size_t l, size_t m) const {
+    assert(shape_.order == 5 && "Tensor order (rank) does not match the view in ViewStrided 5D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStrided 5D!");
+    assert(j >= Base && j < shape_.dims[1] + Base && "j is out of bounds in ViewStrided 5D!");
+    assert(k >= Base && k < shape_.dims[2] + Base && "k is out of bounds in ViewStrided 5D!");
+    assert(l >= Base && l < shape_.dims[3] + Base && "l is out of bounds in ViewStrided 5D!");
+    assert(m >= Base && m < shape_.dims[4] + Base && "m is out of bounds in ViewStrided 5D!");
+    return array_[(i - Base)*shape_.strides[0]
+                  + (j - Base)*shape_.strides[1]
+                  + (k - Base)*shape_.strides[2]
+                  + (l - Base)*shape_.strides[3]
+                  + (m - Base)*shape_.strides[4]];
+}
+
+template <typename T, size_t Base>
+inline T& ViewStrided<T,Base>::operator()(size_t i, size_t j, size_t k, size_t l, size_t m, size_t n) const {
+    assert(shape_.order == 6 && "Tensor order (rank) does not match the view in ViewStrided 6D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStrided 6D!");
+    assert(j >= Base && j < shape_.dims[1] + Base && "j is out of bounds in ViewStrided 6D!");
+    assert(k >= Base && k < shape_.dims[2] + Base && "k is out of bounds in ViewStrided 6D!");
+    assert(l >= Base && l < shape_.dims[3] + Base && "l is out of bounds in ViewStrided 6D!");
+    assert(m >= Base && m < shape_.dims[4] + Base && "m is out of bounds in ViewStrided 6D!");
+    assert(n >= Base && n < shape_.dims[5] + Base && "n is out of bounds in ViewStrided 6D!");
+    return array_[(i - Base)*shape_.strides[0]
+                  + (j - Base)*shape_.strides[1]
+                  + (k - Base)*shape_.strides[2]
+                  + (l - Base)*shape_.strides[3]
+                  + (m - Base)*shape_.strides[4]
+                  + (n - Base)*shape_.strides[5]];
+}
+
+template <typename T, size_t Base>
+inline T& ViewStrided<T,Base>::operator()(size_t i, size_t j, size_t k, size_t l, size_t m, size_t n, size_t o) const {
+    assert(shape_.order == 7 && "Tensor order (rank) does not match the view in ViewStrided 7D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStrided 7D!");
+    assert(j >= Base && j < shape_.dims[1] + Base && "j is out of bounds in ViewStrided 7D!");
+    assert(k >= Base && k < shape_.dims[2] + Base && "k is out of bounds in ViewStrided 7D!");
+    assert(l >= Base && l < shape_.dims[3] + Base && "l is out of bounds in ViewStrided 7D!");
+    assert(m >= Base && m < shape_.dims[4] + Base && "m is out of bounds in ViewStrided 7D!");
+    assert(n >= Base && n < shape_.dims[5] + Base && "n is out of bounds in ViewStrided 7D!");
+    assert(o >= Base && o < shape_.dims[6] + Base && "o is out of bounds in ViewStrided 7D!");
+    return array_[(i - Base)*shape_.strides[0]
+                  + (j - Base)*shape_.strides[1]
+                  + (k - Base)*shape_.strides[2]
+                  + (l - Base)*shape_.strides[3]
+                  + (m - Base)*shape_.strides[4]
+                  + (n - Base)*shape_.strides[5]
+                  + (o - Base)*shape_.strides[6]];
+}
+
+template <typename T, size_t Base>
+inline size_t ViewStrided<T,Base>::size() const {
+    size_t length = 1;
+    for (size_t d = 0; d < shape_.order; d++) {
+        length *= shape_.dims[d];
+    }
+    return length;
+}
+
+template <typename T, size_t Base>
+inline size_t ViewStrided<T,Base>::dims(size_t i) const {
+    assert(i < shape_.order && "ViewStrided order (rank) does not match constructor, dim[i] does not exist!");
+    return shape_.dims[i];
+}
+
+template <typename T, size_t Base>
+inline size_t ViewStrided<T,Base>::stride(size_t i) const {
+    assert(i < shape_.order && "ViewStrided order (rank) does not match constructor, stride[i] does not exist!");
+    return shape_.strides[i];
+}
+
+template <typename T, size_t Base>
+inline size_t ViewStrided<T,Base>::order() const {
+    return shape_.order;
+}
+
+template <typename T, size_t Base>
+inline T* ViewStrided<T,Base>::pointer() const {
+    return array_;
+}
+
+template <typename T, size_t Base>
+ViewStrided<T,Base> ViewStrided<T,Base>::slice(size_t dim, size_t index) const {
+    return ViewStrided(array_, slice_shape(shape_, dim, index, Base));
+}
+
+template <typename T, size_t Base>
+ViewStrided<T,Base> ViewStrided<T,Base>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                  SliceRange r3, SliceRange r4,
+                                                  SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStrided(array_, subarray_shape(shape_, ranges, Base));
+}
+
+//---end of ViewStrided class definitions----
+
 //1. FArray
 // indicies are [0:N-1]
 template <typename T>
@@ -58,7 +518,11 @@ private:
     size_t dims_[7];
     size_t length_;
     size_t order_;  // tensor order (rank)
+    size_t padded_dim_; // the fastest dimension padded by the AllocPolicy, the stride of the next index
     std::shared_ptr <T []> array_;
+
+    // pads the fastest dimension and allocates the storage
+    void allocate(const AllocPolicy& policy);
     
 public:
     
@@ -67,32 +531,38 @@ public:
    
     //overload constructors from 1D to 7D
      
-   FArray(size_t dim0);
+   FArray(size_t dim0,
+          const AllocPolicy& policy = AllocPolicy());
     
    FArray(size_t dim0,
-          size_t dim1);
+          size_t dim1,
+          const AllocPolicy& policy = AllocPolicy());
     
    FArray(size_t dim0,
           size_t dim1,
-          size_t dim2);
+          size_t dim2,
+          const AllocPolicy& policy = AllocPolicy());
     
    FArray(size_t dim0,
           size_t dim1,
           size_t dim2,
-          size_t dim3);
+          size_t dim3,
+          const AllocPolicy& policy = AllocPolicy());
     
    FArray(size_t dim0,
           size_t dim1,
           size_t dim2,
           size_t dim3,
-          size_t dim4);
+          size_t dim4,
+          const AllocPolicy& policy = AllocPolicy());
 
    FArray(size_t dim0,
           size_t dim1,
           size_t dim2,
           size_t dim3,
           size_t dim4,
-          size_t dim5);
+          size_t dim5,
+          const AllocPolicy& policy = AllocPolicy());
 
    FArray(size_t dim0,
           size_t dim1,
@@ -100,9 +570,13 @@ public:
           size_t dim3,
           size_t dim4,
           size_t dim5,
-          size_t dim6);
+          size_t dim6,
+          const AllocPolicy& policy = AllocPolicy());
 
     FArray (const FArray& temp);
+
+    // Move constructor, leaves temp empty
+    FArray (FArray&& temp) noexcept;
     
     // overload operator() to access data as array(i,....,n);
     T& operator()(size_t i) const;
@@ -141,6 +615,13 @@ public:
     
     //overload = operator
     FArray& operator=(const FArray& temp);
+
+    // Overload move assignment operator, leaves temp empty
+    FArray& operator= (FArray&& temp) noexcept;
+
+    // evaluates an elementwise expression (expressions.h) into this array
+    template <typename E, typename = typename E::matar_expr>
+    FArray& operator= (const E& expr);
     
     //return array size
     size_t size() const;
@@ -153,10 +634,24 @@ public:
     
     //return pointer
     T* pointer() const;
+
+    // return a non-owning ViewFArray of the same data, it does not
+    // touch the reference count and is cheap to pass by value
+    ViewFArray <T> borrow() const;
     
     // deconstructor
     ~FArray ();
     
+
+    // views of part of the array without a copy: slice() fixes dimension dim
+    // at index and drops it, subarray() takes a range per dimension (see
+    // SliceRange), both keep the array's strides
+    ViewStridedArray <T> slice(size_t dim, size_t index) const;
+
+    ViewStridedArray <T> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                  SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                  SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
 }; // end of f_array_t
 
 //---FArray class definnitions----
@@ -166,6 +661,7 @@ template <typename T>
 FArray<T>::FArray(){
     array_ = NULL;
     length_ = order_ = 0;
+    padded_dim_ = 0;
     for (int i = 0; i < 7; i++) {
         dims_[i] = 0;
     }
@@ -173,37 +669,37 @@ FArray<T>::FArray(){
 
 //1D
 template <typename T>
-FArray<T>::FArray(size_t dim0)
+FArray<T>::FArray(size_t dim0,
+                  const AllocPolicy& policy)
 {
     dims_[0] = dim0;
-    length_ = dim0;
     order_ = 1;
-    array_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
 }
 
 template <typename T>
 FArray<T>::FArray(size_t dim0,
-                  size_t dim1)
+                  size_t dim1,
+                  const AllocPolicy& policy)
 {
     dims_[0] = dim0;
     dims_[1] = dim1;
     order_ = 2;
-    length_ = dim0*dim1;
-    array_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
 }
 
 //3D
 template <typename T>
 FArray<T>::FArray(size_t dim0,
                   size_t dim1,
-                  size_t dim2)
+                  size_t dim2,
+                  const AllocPolicy& policy)
 {
     dims_[0] = dim0;
     dims_[1] = dim1;
     dims_[2] = dim2;
     order_ = 3;
-    length_ = dim0*dim1*dim2;
-    array_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
 }
 
 //4D
@@ -211,15 +707,15 @@ template <typename T>
 FArray<T>::FArray(size_t dim0,
                   size_t dim1,
                   size_t dim2,
-                  size_t dim3)
+                  size_t dim3,
+                  const AllocPolicy& policy)
 {
     dims_[0] = dim0;
     dims_[1] = dim1;
     dims_[2] = dim2;
     dims_[3] = dim3;
     order_ = 4;
-    length_ = dim0*dim1*dim2*dim3;
-    array_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
 }
 
 //5D
@@ -228,7 +724,8 @@ FArray<T>::FArray(size_t dim0,
                   size_t dim1,
                   size_t dim2,
                   size_t dim3,
-                  size_t dim4)
+                  size_t dim4,
+                  const AllocPolicy& policy)
 {
     dims_[0] = dim0;
     dims_[1] = dim1;
@@ -236,8 +733,7 @@ FArray<T>::FArray(size_t dim0,
     dims_[3] = dim3;
     dims_[4] = dim4;
     order_ = 5;
-    length_ = dim0*dim1*dim2*dim3*dim4;
-    array_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
 }
 
 //6D
@@ -247,7 +743,8 @@ FArray<T>::FArray(size_t dim0,
                   size_t dim2,
                   size_t dim3,
                   size_t dim4,
-                  size_t dim5)
+                  size_t dim5,
+                  const AllocPolicy& policy)
 {
     dims_[0] = dim0;
     dims_[1] = dim1;
@@ -256,8 +753,7 @@ FArray<T>::FArray(size_t dim0,
     dims_[4] = dim4;
     dims_[5] = dim5;
     order_ = 6;
-    length_ = dim0*dim1*dim2*dim3*dim4*dim5;
-    array_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
 }
 
 
@@ -269,7 +765,8 @@ FArray<T>::FArray(size_t dim0,
                   size_t dim3,
                   size_t dim4,
                   size_t dim5,
-                  size_t dim6)
+                  size_t dim6,
+                  const AllocPolicy& policy)
 {
     dims_[0] = dim0;
     dims_[1] = dim1;
@@ -279,11 +776,22 @@ FArray<T>::FArray(size_t dim0,
     dims_[5] = dim5;
     dims_[6] = dim6;
     order_ = 7;
-    length_ = dim0*dim1*dim2*dim3*dim4*dim5*dim6;
-    array_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
         
 }
 
+// the first dimension is rounded up to a multiple of policy.pad
+template <typename T>
+void FArray<T>::allocate(const AllocPolicy& policy) {
+    assert(policy.pad > 0 && "AllocPolicy pad must be positive in FArray!");
+    padded_dim_ = (dims_[0] + policy.pad - 1) / policy.pad * policy.pad;
+    length_ = padded_dim_;
+    for (size_t i = 1; i < order_; i++) {
+        length_ *= dims_[i];
+    }
+    array_ = aligned_allocate<T>(length_, policy);
+}
+
 //Copy constructor
 
 template <typename T>
@@ -298,6 +806,7 @@ FArray<T>::FArray(const FArray& temp) {
         
         order_  = temp.order_;
         length_ = temp.length_;
+        padded_dim_ = temp.padded_dim_;
         array_ = temp.array_;
     } // end if
     
@@ -323,7 +832,7 @@ T& FArray<T>::operator()(size_t i,
     assert(order_ == 2 && "Tensor order (rank) does not match constructor in FArray 2D!");
     assert(i >= 0 && i < dims_[0] && "i is out of bounds in FArray 2D!");
     assert(j >= 0 && j < dims_[1] && "j is out of bounds in FArray 2D!");
-    return array_[i + j*dims_[0]];
+    return array_[i + j*padded_dim_];
 }
 
 //3D
@@ -336,8 +845,8 @@ T& FArray<T>::operator()(size_t i,
     assert(i >= 0 && i < dims_[0] && "i is out of bounds in FArray 3D!");
     assert(j >= 0 && j < dims_[1] && "j is out of bounds in Farray 3D!");
     assert(k >= 0 && k < dims_[2] && "k is out of bounds in FArray 3D!");
-    return array_[i + j*dims_[0]
-                    + k*dims_[0]*dims_[1]];
+    return array_[i + j*padded_dim_
+                    + k*padded_dim_*dims_[1]];
 }
 
 //4D
@@ -352,9 +861,9 @@ T& FArray<T>::operator()(size_t i,
     assert(j >= 0 && j < dims_[1] && "j is out of bounds in FArray 4D!");
     assert(k >= 0 && k < dims_[2] && "k is out of bounds in FArray 4D!");
     assert(l >= 0 && l < dims_[3] && "l is out of bounds in FArray 4D!");
-    return array_[i + j*dims_[0]
-                    + k*dims_[0]*dims_[1]
-                    + l*dims_[0]*dims_[1]*dims_[2]];
+    return array_[i + j*padded_dim_
+                    + k*padded_dim_*dims_[1]
+                    + l*padded_dim_*dims_[1]*dims_[2]];
 }
 
 //5D
@@ -371,10 +880,10 @@ T& FArray<T>::operator()(size_t i,
     assert(k >= 0 && k < dims_[2] && "k is out of bounds in FArray 5D!");
     assert(l >= 0 && l < dims_[3] && "l is out of bounds in FArray 5D!");
     assert(m >= 0 && m < dims_[4] && "m is out of bounds in FArray 5D!");
-    return array_[i + j*dims_[0]
-                    + k*dims_[0]*dims_[1]
-                    + l*dims_[0]*dims_[1]*dims_[2]
-                    + m*dims_[0]*dims_[1]*dims_[2]*dims_[3]];
+    return array_[i + j*padded_dim_
+                    + k*padded_dim_*dims_[1]
+                    + l*padded_dim_*dims_[1]*dims_[2]
+                    + m*padded_dim_*dims_[1]*dims_[2]*dims_[3]];
 }
 
 //6D
@@ -393,11 +902,11 @@ T& FArray<T>::operator()(size_t i,
     assert(l >= 0 && l < dims_[3] && "l is out of bounds in FArray 6D!");
     assert(m >= 0 && m < dims_[4] && "m is out of bounds in FArray 6D!");
     assert(n >= 0 && n < dims_[5] && "n is out of bounds in FArray 6D!");
-    return array_[i + j*dims_[0]
-                    + k*dims_[0]*dims_[1]
-                    + l*dims_[0]*dims_[1]*dims_[2]
-                    + m*dims_[0]*dims_[1]*dims_[2]*dims_[3]
-                    + n*dims_[0]*dims_[1]*dims_[2]*dims_[3]*dims_[4]];
+    return array_[i + j*padded_dim_
+                    + k*padded_dim_*dims_[1]
+                    + l*padded_dim_*dims_[1]*dims_[2]
+                    + m*padded_dim_*dims_[1]*dims_[2]*dims_[3]
+                    + n*padded_dim_*dims_[1]*dims_[2]*dims_[3]*dims_[4]];
 }
 
 //7D
@@ -418,12 +927,12 @@ T& FArray<T>::operator()(size_t i,
     assert(m >= 0 && m < dims_[4] && "m is out of bounds in FArray 7D!");
     assert(n >= 0 && n < dims_[5] && "n is out of bounds in FArray 7D!");
     assert(o >= 0 && o < dims_[6] && "o is out of bounds in FArray 7D!");
-    return array_[i + j*dims_[0]
-                    + k*dims_[0]*dims_[1]
-                    + l*dims_[0]*dims_[1]*dims_[2]
-                    + m*dims_[0]*dims_[1]*dims_[2]*dims_[3]
-                    + n*dims_[0]*dims_[1]*dims_[2]*dims_[3]*dims_[4]
-                    + o*dims_[0]*dims_[1]*dims_[2]*dims_[3]*dims_[4]*dims_[5]];
+    return array_[i + j*padded_dim_
+                    + k*padded_dim_*dims_[1]
+                    + l*padded_dim_*dims_[1]*dims_[2]
+                    + m*padded_dim_*dims_[1]*dims_[2]*dims_[3]
+                    + n*padded_dim_*dims_[1]*dims_[2]*dims_[3]*dims_[4]
+                    + o*padded_dim_*dims_[1]*dims_[2]*dims_[3]*dims_[4]*dims_[5]];
 }
     
 // = operator
@@ -438,6 +947,7 @@ FArray<T>& FArray<T>::operator= (const FArray& temp)
 
         order_  = temp.order_;
         length_ = temp.length_;
+        padded_dim_ = temp.padded_dim_;
         array_  = temp.array_;
     }
     return *this;
@@ -467,9 +977,79 @@ inline T* FArray<T>::pointer() const {
 }
 
 //delete FArray
+// Move constructor
+template <typename T>
+FArray<T>::FArray(FArray&& temp) noexcept {
+    for (int iter = 0; iter < 7; iter++){
+        dims_[iter] = temp.dims_[iter];
+        temp.dims_[iter] = 0;
+    } // end for
+
+    order_  = temp.order_;
+    length_ = temp.length_;
+    padded_dim_ = temp.padded_dim_;
+    array_ = std::move(temp.array_);
+    temp.order_ = temp.length_ = temp.padded_dim_ = 0;
+}
+
+// Move assignment
+template <typename T>
+FArray<T>& FArray<T>::operator= (FArray&& temp) noexcept {
+    if (this != &temp) {
+        for (int iter = 0; iter < 7; iter++){
+            dims_[iter] = temp.dims_[iter];
+            temp.dims_[iter] = 0;
+        } // end for
+
+        order_  = temp.order_;
+        length_ = temp.length_;
+        padded_dim_ = temp.padded_dim_;
+        array_ = std::move(temp.array_);
+        temp.order_ = temp.length_ = temp.padded_dim_ = 0;
+    }
+    return *this;
+}
+
+// expression assignment
+template <typename T>
+template <typename E, typename>
+FArray<T>& FArray<T>::operator= (const E& expr)
+{
+    assign_expr(*this, expr);
+    return *this;
+}
+
+template <typename T>
+inline ViewFArray<T> FArray<T>::borrow() const {
+    assert(padded_dim_ == dims_[0] && "borrow() of a padded FArray is not supported!");
+    switch (order_) {
+        case 1: return ViewFArray <T> (array_.get(), dims_[0]);
+        case 2: return ViewFArray <T> (array_.get(), dims_[0], dims_[1]);
+        case 3: return ViewFArray <T> (array_.get(), dims_[0], dims_[1], dims_[2]);
+        case 4: return ViewFArray <T> (array_.get(), dims_[0], dims_[1], dims_[2], dims_[3]);
+        case 5: return ViewFArray <T> (array_.get(), dims_[0], dims_[1], dims_[2], dims_[3], dims_[4]);
+        case 6: return ViewFArray <T> (array_.get(), dims_[0], dims_[1], dims_[2], dims_[3], dims_[4], dims_[5]);
+        case 7: return ViewFArray <T> (array_.get(), dims_[0], dims_[1], dims_[2], dims_[3], dims_[4], dims_[5], dims_[6]);
+    }
+    return ViewFArray <T> ();
+}
+
 template <typename T>
 FArray<T>::~FArray(){}
 
+template <typename T>
+ViewStridedArray <T> FArray<T>::slice(size_t dim, size_t index) const {
+    return ViewStridedArray <T>(array_.get(), slice_shape(dense_shape(order_, dims_, padded_dim_, false), dim, index, 0));
+}
+
+template <typename T>
+ViewStridedArray <T> FArray<T>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                         SliceRange r3, SliceRange r4,
+                                         SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedArray <T>(array_.get(), subarray_shape(dense_shape(order_, dims_, padded_dim_, false), ranges, 0));
+}
+
 //---end of FArray class definitions----
 
 
@@ -583,6 +1163,16 @@ public:
     // return pointer
     T* pointer() const;
     
+
+    // views of part of the array without a copy: slice() fixes dimension dim
+    // at index and drops it, subarray() takes a range per dimension (see
+    // SliceRange), both keep the array's strides
+    ViewStridedArray <T> slice(size_t dim, size_t index) const;
+
+    ViewStridedArray <T> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                  SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                  SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
 }; // end of viewFArray
 
 //class definitions for viewFArray
@@ -871,6 +1461,19 @@ inline T* ViewFArray<T>::pointer() const {
     return array_;
 }
 
+template <typename T>
+ViewStridedArray <T> ViewFArray<T>::slice(size_t dim, size_t index) const {
+    return ViewStridedArray <T>(array_, slice_shape(dense_shape(order_, dims_, dims_[0], false), dim, index, 0));
+}
+
+template <typename T>
+ViewStridedArray <T> ViewFArray<T>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                             SliceRange r3, SliceRange r4,
+                                             SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedArray <T>(array_, subarray_shape(dense_shape(order_, dims_, dims_[0], false), ranges, 0));
+}
+
 //---end of ViewFArray class definitions---
 
 
@@ -882,39 +1485,49 @@ private:
     size_t dims_[7];
     size_t length_; // Length of 1D array
     size_t order_;  // tensor order (rank)
+    size_t padded_dim_; // the fastest dimension padded by the AllocPolicy, the stride of the next index
     std::shared_ptr <T []> matrix_;
 
+    // pads the fastest dimension and allocates the storage
+    void allocate(const AllocPolicy& policy);
+
 public:
     // Default constructor
     FMatrix ();
 
     //---1D to 7D matrix ---
-    FMatrix (size_t dim1);
+    FMatrix (size_t dim1,
+             const AllocPolicy& policy = AllocPolicy());
 
     FMatrix (size_t dim1,
-             size_t dim2);
+             size_t dim2,
+             const AllocPolicy& policy = AllocPolicy());
 
     FMatrix (size_t dim1,
              size_t dim2,
-             size_t dim3);
+             size_t dim3,
+             const AllocPolicy& policy = AllocPolicy());
 
     FMatrix (size_t dim1,
              size_t dim2,
              size_t dim3,
-             size_t dim4);
+             size_t dim4,
+             const AllocPolicy& policy = AllocPolicy());
 
     FMatrix (size_t dim1,
              size_t dim2,
              size_t dim3,
              size_t dim4,
-             size_t dim5);
+             size_t dim5,
+             const AllocPolicy& policy = AllocPolicy());
 
     FMatrix (size_t dim1,
              size_t dim2,
              size_t dim3,
              size_t dim4,
              size_t dim5,
-             size_t dim6);
+             size_t dim6,
+             const AllocPolicy& policy = AllocPolicy());
 
     FMatrix (size_t dim1,
              size_t dim2,
@@ -922,9 +1535,13 @@ public:
              size_t dim4,
              size_t dim5,
              size_t dim6,
-             size_t dim7);
+             size_t dim7,
+             const AllocPolicy& policy = AllocPolicy());
     
     FMatrix (const FMatrix& temp);
+
+    // Move constructor, leaves temp empty
+    FMatrix (FMatrix&& temp) noexcept;
     
     T& operator() (size_t i) const;
     
@@ -965,6 +1582,9 @@ public:
     // Overload copy assignment operator
     FMatrix& operator=(const FMatrix& temp);
 
+    // Overload move assignment operator, leaves temp empty
+    FMatrix& operator= (FMatrix&& temp) noexcept;
+
     // the length of the 1D storage array
     size_t size() const;
 
@@ -977,9 +1597,23 @@ public:
     //return pointer
     T* pointer() const;
 
+    // return a non-owning ViewFMatrix of the same data, it does not
+    // touch the reference count and is cheap to pass by value
+    ViewFMatrix <T> borrow() const;
+
     // Deconstructor
     ~FMatrix ();
 
+
+    // views of part of the array without a copy: slice() fixes dimension dim
+    // at index and drops it, subarray() takes a range per dimension (see
+    // SliceRange), both keep the array's strides
+    ViewStridedMatrix <T> slice(size_t dim, size_t index) const;
+
+    ViewStridedMatrix <T> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                   SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                   SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
 }; // End of FMatrix
 
 //---FMatrix class definitions---
@@ -989,6 +1623,7 @@ template <typename T>
 FMatrix<T>::FMatrix(){
     matrix_ = NULL;
     length_ = order_ = 0;
+    padded_dim_ = 0;
     for (int i = 0; i < 7; i++) {
         dims_[i] = 0;
     }
@@ -996,38 +1631,38 @@ FMatrix<T>::FMatrix(){
 
 //1D
 template <typename T>
-FMatrix<T>::FMatrix(size_t dim1)
+FMatrix<T>::FMatrix(size_t dim1,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     order_ = 1;
-    length_ = dim1;
-    matrix_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
 }
 
 //2D
 template <typename T>
 FMatrix<T>::FMatrix(size_t dim1,
-                    size_t dim2)
+                    size_t dim2,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     dims_[1] = dim2;
     order_ = 2;
-    length_ = dim1 * dim2;
-    matrix_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
 }
 
 //3D
 template <typename T>
 FMatrix<T>::FMatrix(size_t dim1,
                     size_t dim2,
-                    size_t dim3)
+                    size_t dim3,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     dims_[1] = dim2;
     dims_[2] = dim3;
     order_ = 3;
-    length_ = dim1 * dim2 * dim3;
-    matrix_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
 }
 
 //4D
@@ -1035,15 +1670,15 @@ template <typename T>
 FMatrix<T>::FMatrix(size_t dim1,
                     size_t dim2,
                     size_t dim3,
-                    size_t dim4)
+                    size_t dim4,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     dims_[1] = dim2;
     dims_[2] = dim3;
     dims_[3] = dim4;
     order_ = 4;
-    length_ = dim1 * dim2 * dim3 * dim4;
-    matrix_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
 }
 
 //5D
@@ -1052,7 +1687,8 @@ FMatrix<T>::FMatrix(size_t dim1,
                     size_t dim2,
                     size_t dim3,
                     size_t dim4,
-                    size_t dim5)
+                    size_t dim5,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     dims_[1] = dim2;
@@ -1060,8 +1696,7 @@ FMatrix<T>::FMatrix(size_t dim1,
     dims_[3] = dim4;
     dims_[4] = dim5;
     order_ = 5;
-    length_ = dim1 * dim2 * dim3 * dim4 * dim5;
-    matrix_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
 }
 
 //6D
@@ -1071,7 +1706,8 @@ FMatrix<T>::FMatrix(size_t dim1,
                     size_t dim3,
                     size_t dim4,
                     size_t dim5,
-                    size_t dim6)
+                    size_t dim6,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     dims_[1] = dim2;
@@ -1080,8 +1716,7 @@ FMatrix<T>::FMatrix(size_t dim1,
     dims_[4] = dim5;
     dims_[5] = dim6;
     order_ = 6;
-    length_ = dim1 * dim2 * dim3 * dim4 * dim5 * dim6;
-    matrix_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
 
 }
 
@@ -1092,7 +1727,8 @@ FMatrix<T>::FMatrix(size_t dim1,
                     size_t dim4,
                     size_t dim5,
                     size_t dim6,
-                    size_t dim7)
+                    size_t dim7,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     dims_[1] = dim2;
@@ -1102,11 +1738,22 @@ FMatrix<T>::FMatrix(size_t dim1,
     dims_[5] = dim6;
     dims_[6] = dim7;
     order_ = 7;
-    length_ = dim1 * dim2 * dim3 * dim4 * dim5 * dim6 * dim7;
-    matrix_ = std::shared_ptr <T []> (new T[length_]);
+    allocate(policy);
     
 }
 
+// the first dimension is rounded up to a multiple of policy.pad
+template <typename T>
+void FMatrix<T>::allocate(const AllocPolicy& policy) {
+    assert(policy.pad > 0 && "AllocPolicy pad must be positive in FMatrix!");
+    padded_dim_ = (dims_[0] + policy.pad - 1) / policy.pad * policy.pad;
+    length_ = padded_dim_;
+    for (size_t i = 1; i < order_; i++) {
+        length_ *= dims_[i];
+    }
+    matrix_ = aligned_allocate<T>(length_, policy);
+}
+
 template <typename T>
 FMatrix<T>::FMatrix(const FMatrix& temp) {
     
@@ -1119,6 +1766,7 @@ FMatrix<T>::FMatrix(const FMatrix& temp) {
         
         order_  = temp.order_;
         length_ = temp.length_;
+        padded_dim_ = temp.padded_dim_;
         matrix_ = temp.matrix_;
     } // end if
     
@@ -1144,7 +1792,7 @@ inline T& FMatrix<T>::operator() (size_t i,
     assert(order_ == 2 && "Tensor order (rank) does not match constructor in FMatrix 2D!");
     assert(i >= 1 && i <= dims_[0] && "i is out of bounds in FMatrix 2D!");
     assert(j >= 1 && j <= dims_[1] && "j is out of bounds in FMatrix 2D!");
-    return matrix_[(i - 1) + ((j - 1) * dims_[0])];
+    return matrix_[(i - 1) + ((j - 1) * padded_dim_)];
 }
 
 //3D
@@ -1157,8 +1805,8 @@ inline T& FMatrix<T>::operator() (size_t i,
     assert(i >= 1 && i <= dims_[0] && "i is out of bounds in FMatrix 3D!");
     assert(j >= 1 && j <= dims_[1] && "j is out of bounds in FMatrix 3D!");
     assert(k >= 1 && k <= dims_[2] && "k is out of bounds in FMatrix 3D!");
-    return matrix_[(i - 1) + ((j - 1) * dims_[0])
-                           + ((k - 1) * dims_[0] * dims_[1])];
+    return matrix_[(i - 1) + ((j - 1) * padded_dim_)
+                           + ((k - 1) * padded_dim_ * dims_[1])];
 }
 
 //4D
@@ -1173,9 +1821,9 @@ inline T& FMatrix<T>::operator() (size_t i,
     assert(j >= 1 && j <= dims_[1] && "j is out of bounds in FMatrix 4D!");
     assert(k >= 1 && k <= dims_[2] && "k is out of bounds in FMatrix 4D!");
     assert(l >= 1 && l <= dims_[3] && "l is out of bounds in FMatrix 4D!");
-    return matrix_[(i - 1) + ((j - 1) * dims_[0])
-                           + ((k - 1) * dims_[0] * dims_[1])
-                           + ((l - 1) * dims_[0] * dims_[1] * dims_[2])];
+    return matrix_[(i - 1) + ((j - 1) * padded_dim_)
+                           + ((k - 1) * padded_dim_ * dims_[1])
+                           + ((l - 1) * padded_dim_ * dims_[1] * dims_[2])];
 }
 
 //5D
@@ -1192,10 +1840,10 @@ inline T& FMatrix<T>::operator() (size_t i,
     assert(k >= 1 && k <= dims_[2] && "k is out of bounds in FMatrix 5D!");
     assert(l >= 1 && l <= dims_[3] && "l is out of bounds in FMatrix 5D!");
     assert(m >= 1 && m <= dims_[4] && "m is out of bounds in FMatrix 5D!");
-    return matrix_[(i - 1) + ((j - 1) * dims_[0])
-                           + ((k - 1) * dims_[0] * dims_[1])
-                           + ((l - 1) * dims_[0] * dims_[1] * dims_[2])
-                           + ((m - 1) * dims_[0] * dims_[1] * dims_[2] * dims_[3])];
+    return matrix_[(i - 1) + ((j - 1) * padded_dim_)
+                           + ((k - 1) * padded_dim_ * dims_[1])
+                           + ((l - 1) * padded_dim_ * dims_[1] * dims_[2])
+                           + ((m - 1) * padded_dim_ * dims_[1] * dims_[2] * dims_[3])];
 }
 
 //6D
@@ -1214,11 +1862,11 @@ inline T& FMatrix<T>::operator() (size_t i,
     assert(l >= 1 && l <= dims_[3] && "l is out of bounds in FMatrix 6D!");
     assert(m >= 1 && m <= dims_[4] && "m is out of bounds in FMatrix 6D!");
     assert(n >= 1 && n <= dims_[5] && "n is out of bounds in FMatrix 6D!");
-    return matrix_[(i - 1) + ((j - 1) * dims_[0])
-                           + ((k - 1) * dims_[0] * dims_[1])
-                           + ((l - 1) * dims_[0] * dims_[1] * dims_[2])
-                           + ((m - 1) * dims_[0] * dims_[1] * dims_[2] * dims_[3])
-                           + ((n - 1) * dims_[0] * dims_[1] * dims_[2] * dims_[3] * dims_[4])];
+    return matrix_[(i - 1) + ((j - 1) * padded_dim_)
+                           + ((k - 1) * padded_dim_ * dims_[1])
+                           + ((l - 1) * padded_dim_ * dims_[1] * dims_[2])
+                           + ((m - 1) * padded_dim_ * dims_[1] * dims_[2] * dims_[3])
+                           + ((n - 1) * padded_dim_ * dims_[1] * dims_[2] * dims_[3] * dims_[4])];
 }
 
 //7D
@@ -1239,12 +1887,12 @@ inline T& FMatrix<T>::operator() (size_t i,
     assert(m >= 1 && m <= dims_[4] && "m is out of bounds in FMatrix 7D!");
     assert(n >= 1 && n <= dims_[5] && "n is out of bounds in FMatrix 7D!");
     assert(o >= 1 && o <= dims_[6] && "o is out of bounds in FMatrix 7D!");
-    return matrix_[(i - 1) + ((j - 1) * dims_[0])
-                           + ((k - 1) * dims_[0] * dims_[1])
-                           + ((l - 1) * dims_[0] * dims_[1] * dims_[2])
-                           + ((m - 1) * dims_[0] * dims_[1] * dims_[2] * dims_[3])
-                           + ((n - 1) * dims_[0] * dims_[1] * dims_[2] * dims_[3] * dims_[4])
-                           + ((o - 1) * dims_[0] * dims_[1] * dims_[2] * dims_[3] * dims_[4] * dims_[5])];
+    return matrix_[(i - 1) + ((j - 1) * padded_dim_)
+                           + ((k - 1) * padded_dim_ * dims_[1])
+                           + ((l - 1) * padded_dim_ * dims_[1] * dims_[2])
+                           + ((m - 1) * padded_dim_ * dims_[1] * dims_[2] * dims_[3])
+                           + ((n - 1) * padded_dim_ * dims_[1] * dims_[2] * dims_[3] * dims_[4])
+                           + ((o - 1) * padded_dim_ * dims_[1] * dims_[2] * dims_[3] * dims_[4] * dims_[5])];
 }
 
 
@@ -1259,6 +1907,7 @@ inline FMatrix<T>& FMatrix<T>::operator= (const FMatrix& temp)
 
         order_  = temp.order_;
         length_ = temp.length_;
+        padded_dim_ = temp.padded_dim_;
     matrix_ = temp.matrix_;
     }
     
@@ -1288,19 +1937,80 @@ inline T* FMatrix<T>::pointer() const{
     return matrix_.get();
 }
 
+// Move constructor
 template <typename T>
-FMatrix<T>::~FMatrix() {}
+FMatrix<T>::FMatrix(FMatrix&& temp) noexcept {
+    for (int iter = 0; iter < 7; iter++){
+        dims_[iter] = temp.dims_[iter];
+        temp.dims_[iter] = 0;
+    } // end for
 
-//----end of FMatrix class definitions----
+    order_  = temp.order_;
+    length_ = temp.length_;
+    padded_dim_ = temp.padded_dim_;
+    matrix_ = std::move(temp.matrix_);
+    temp.order_ = temp.length_ = temp.padded_dim_ = 0;
+}
+
+// Move assignment
+template <typename T>
+FMatrix<T>& FMatrix<T>::operator= (FMatrix&& temp) noexcept {
+    if (this != &temp) {
+        for (int iter = 0; iter < 7; iter++){
+            dims_[iter] = temp.dims_[iter];
+            temp.dims_[iter] = 0;
+        } // end for
 
+        order_  = temp.order_;
+        length_ = temp.length_;
+        padded_dim_ = temp.padded_dim_;
+        matrix_ = std::move(temp.matrix_);
+        temp.order_ = temp.length_ = temp.padded_dim_ = 0;
+    }
+    return *this;
+}
 
-//4. ViewFMatrix
-//  indices are [1:N]
 template <typename T>
-class ViewFMatrix {
+inline ViewFMatrix<T> FMatrix<T>::borrow() const {
+    assert(padded_dim_ == dims_[0] && "borrow() of a padded FMatrix is not supported!");
+    switch (order_) {
+        case 1: return ViewFMatrix <T> (matrix_.get(), dims_[0]);
+        case 2: return ViewFMatrix <T> (matrix_.get(), dims_[0], dims_[1]);
+        case 3: return ViewFMatrix <T> (matrix_.get(), dims_[0], dims_[1], dims_[2]);
+        case 4: return ViewFMatrix <T> (matrix_.get(), dims_[0], dims_[1], dims_[2], dims_[3]);
+        case 5: return ViewFMatrix <T> (matrix_.get(), dims_[0], dims_[1], dims_[2], dims_[3], dims_[4]);
+        case 6: return ViewFMatrix <T> (matrix_.get(), dims_[0], dims_[1], dims_[2], dims_[3], dims_[4], dims_[5]);
+        case 7: return ViewFMatrix <T> (matrix_.get(), dims_[0], dims_[1], dims_[2], dims_[3], dims_[4], dims_[5], dims_[6]);
+    }
+    return ViewFMatrix <T> ();
+}
 
-private:
-    size_t dims_[7];
+template <typename T>
+FMatrix<T>::~FMatrix() {}
+
+template <typename T>
+ViewStridedMatrix <T> FMatrix<T>::slice(size_t dim, size_t index) const {
+    return ViewStridedMatrix <T>(matrix_.get(), slice_shape(dense_shape(order_, dims_, padded_dim_, false), dim, index, 1));
+}
+
+template <typename T>
+ViewStridedMatrix <T> FMatrix<T>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                           SliceRange r3, SliceRange r4,
+                                           SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedMatrix <T>(matrix_.get(), subarray_shape(dense_shape(order_, dims_, padded_dim_, false), ranges, 1));
+}
+
+//----end of FMatrix class definitions----
+
+
+//4. ViewFMatrix
+//  indices are [1:N]
+template <typename T>
+class ViewFMatrix {
+
+private:
+    size_t dims_[7];
     size_t length_; // Length of 1D array
     size_t order_;  // tensor order (rank)
     T * matrix_;
@@ -1405,6 +2115,16 @@ public:
     // return pointer
     T* pointer() const;
     
+
+    // views of part of the array without a copy: slice() fixes dimension dim
+    // at index and drops it, subarray() takes a range per dimension (see
+    // SliceRange), both keep the array's strides
+    ViewStridedMatrix <T> slice(size_t dim, size_t index) const;
+
+    ViewStridedMatrix <T> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                   SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                   SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
 }; // end of ViewFMatrix
 
 //constructors
@@ -1691,6 +2411,19 @@ template <typename T>
 inline T* ViewFMatrix<T>::pointer() const {
     return matrix_;
 }
+
+template <typename T>
+ViewStridedMatrix <T> ViewFMatrix<T>::slice(size_t dim, size_t index) const {
+    return ViewStridedMatrix <T>(matrix_, slice_shape(dense_shape(order_, dims_, dims_[0], false), dim, index, 1));
+}
+
+template <typename T>
+ViewStridedMatrix <T> ViewFMatrix<T>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                               SliceRange r3, SliceRange r4,
+                                               SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedMatrix <T>(matrix_, subarray_shape(dense_shape(order_, dims_, dims_[0], false), ranges, 1));
+}
 //-----end ViewFMatrix-----
 
 
@@ -1703,40 +2436,50 @@ private:
     size_t dims_[7];
     size_t length_; // Length of 1D array
     size_t order_;  // tensor order (rank)
+    size_t padded_dim_; // the fastest dimension padded by the AllocPolicy, the stride of the next index
     std::shared_ptr <T []> array_;
 
+    // pads the fastest dimension and allocates the storage
+    void allocate(const AllocPolicy& policy);
+
 public:
     // Default constructor
     CArray ();
 
     // --- 1D to 7D array ---
     
-    CArray (size_t dim0);
+    CArray (size_t dim0,
+            const AllocPolicy& policy = AllocPolicy());
 
     CArray (size_t dim0,
-            size_t dim1);
+            size_t dim1,
+            const AllocPolicy& policy = AllocPolicy());
 
     CArray (size_t dim0,
             size_t dim1,
-            size_t dim2);
+            size_t dim2,
+            const AllocPolicy& policy = AllocPolicy());
 
     CArray (size_t dim0,
             size_t dim1,
             size_t dim2,
-            size_t dim3);
+            size_t dim3,
+            const AllocPolicy& policy = AllocPolicy());
 
     CArray (size_t dim0,
             size_t dim1,
             size_t dim2,
             size_t dim3,
-            size_t dim4);
+            size_t dim4,
+            const AllocPolicy& policy = AllocPolicy());
 
     CArray (size_t dim0,
             size_t dim1,
             size_t dim2,
             size_t dim3,
             size_t dim4,
-            size_t dim5);
+            size_t dim5,
+            const AllocPolicy& policy = AllocPolicy());
 
     CArray (size_t dim0,
             size_t dim1,
@@ -1744,9 +2487,13 @@ public:
             size_t dim3,
             size_t dim4,
             size_t dim5,
-            size_t dim6);
+            size_t dim6,
+            const AllocPolicy& policy = AllocPolicy());
     
     CArray (const CArray& temp);
+
+    // Move constructor, leaves temp empty
+    CArray (CArray&& temp) noexcept;
     
     // Overload operator()
     T& operator() (size_t i) const;
@@ -1787,6 +2534,13 @@ public:
     // Overload copy assignment operator
     CArray& operator= (const CArray& temp);
 
+    // Overload move assignment operator, leaves temp empty
+    CArray& operator= (CArray&& temp) noexcept;
+
+    // evaluates an elementwise expression (expressions.h) into this array
+    template <typename E, typename = typename E::matar_expr>
+    CArray& operator= (const E& expr);
+
      //return array size
     size_t size() const;
 
@@ -1799,9 +2553,23 @@ public:
     //return pointer
     T* pointer() const;
 
+    // return a non-owning ViewCArray of the same data, it does not
+    // touch the reference count and is cheap to pass by value
+    ViewCArray <T> borrow() const;
+
     // Deconstructor
     ~CArray ();
 
+
+    // views of part of the array without a copy: slice() fixes dimension dim
+    // at index and drops it, subarray() takes a range per dimension (see
+    // SliceRange), both keep the array's strides
+    ViewStridedArray <T> slice(size_t dim, size_t index) const;
+
+    ViewStridedArray <T> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                  SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                  SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
 }; // End of CArray
 
 //---carray class declarations---
@@ -1813,6 +2581,7 @@ template <typename T>
 CArray<T>::CArray() {
     array_ = NULL;
     length_ = order_ = 0;
+    padded_dim_ = 0;
     for (int i = 0; i < 7; i++) {
         dims_[i] = 0;
     }
@@ -1820,38 +2589,38 @@ CArray<T>::CArray() {
 
 //1D
 template <typename T>
-CArray<T>::CArray(size_t dim0)
+CArray<T>::CArray(size_t dim0,
+                  const AllocPolicy& policy)
 {
     dims_[0] = dim0;
     order_ = 1;
-    length_ = dim0;
-    array_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
 }
 
 //2D
 template <typename T>
 CArray<T>::CArray(size_t dim0,
-                  size_t dim1)
+                  size_t dim1,
+                  const AllocPolicy& policy)
 {
     dims_[0] = dim0;
     dims_[1] = dim1;
     order_ = 2;
-    length_ = dim0 * dim1;
-    array_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
 }
 
 //3D
 template <typename T>
 CArray<T>::CArray(size_t dim0,
                   size_t dim1,
-                  size_t dim2)
+                  size_t dim2,
+                  const AllocPolicy& policy)
 {
     dims_[0] = dim0;
     dims_[1] = dim1;
     dims_[2] = dim2;
     order_ = 3;
-    length_ = dim0 * dim1 * dim2;
-    array_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
 }
 
 //4D
@@ -1859,15 +2628,15 @@ template <typename T>
 CArray<T>::CArray(size_t dim0,
                   size_t dim1,
                   size_t dim2,
-                  size_t dim3)
+                  size_t dim3,
+                  const AllocPolicy& policy)
 {
     dims_[0] = dim0;
     dims_[1] = dim1;
     dims_[2] = dim2;
     dims_[3] = dim3;
     order_ = 4;
-    length_ = dim0 * dim1 * dim2 * dim3;
-    array_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
 }
 
 //5D
@@ -1876,15 +2645,15 @@ CArray<T>::CArray(size_t dim0,
                   size_t dim1,
                   size_t dim2,
                   size_t dim3,
-                  size_t dim4) {
+                  size_t dim4,
+                  const AllocPolicy& policy) {
     dims_[0] = dim0;
     dims_[1] = dim1;
     dims_[2] = dim2;
     dims_[3] = dim3;
     dims_[4] = dim4;
     order_ = 5;
-    length_ = dim0 * dim1 * dim2 * dim3 * dim4;
-    array_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
 }
 
 //6D
@@ -1894,7 +2663,8 @@ CArray<T>::CArray(size_t dim0,
                   size_t dim2,
                   size_t dim3,
                   size_t dim4,
-                  size_t dim5) {
+                  size_t dim5,
+                  const AllocPolicy& policy) {
     dims_[0] = dim0;
     dims_[1] = dim1;
     dims_[2] = dim2;
@@ -1902,8 +2672,7 @@ CArray<T>::CArray(size_t dim0,
     dims_[4] = dim4;
     dims_[5] = dim5;
     order_ = 6;
-    length_ = dim0 * dim1 * dim2 * dim3 * dim4 * dim5;
-    array_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
 }
 
 //7D
@@ -1914,7 +2683,8 @@ CArray<T>::CArray(size_t dim0,
                   size_t dim3,
                   size_t dim4,
                   size_t dim5,
-                  size_t dim6) {
+                  size_t dim6,
+                  const AllocPolicy& policy) {
     dims_[0] = dim0;
     dims_[1] = dim1;
     dims_[2] = dim2;
@@ -1923,8 +2693,19 @@ CArray<T>::CArray(size_t dim0,
     dims_[5] = dim5;
     dims_[6] = dim6;
     order_ = 7;
-    length_ = dim0 * dim1 * dim2 * dim3 * dim4 * dim5 * dim6;
-    array_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
+}
+
+// the last dimension is rounded up to a multiple of policy.pad
+template <typename T>
+void CArray<T>::allocate(const AllocPolicy& policy) {
+    assert(policy.pad > 0 && "AllocPolicy pad must be positive in CArray!");
+    padded_dim_ = (dims_[order_-1] + policy.pad - 1) / policy.pad * policy.pad;
+    length_ = padded_dim_;
+    for (size_t i = 0; i + 1 < order_; i++) {
+        length_ *= dims_[i];
+    }
+    array_ = aligned_allocate<T>(length_, policy);
 }
 
 //Copy constructor
@@ -1941,6 +2722,7 @@ CArray<T>::CArray(const CArray& temp) {
         
         order_  = temp.order_;
         length_ = temp.length_;
+        padded_dim_ = temp.padded_dim_;
         array_ = temp.array_;
     } // end if
     
@@ -1968,7 +2750,7 @@ inline T& CArray<T>::operator() (size_t i,
     assert(i >= 0 && i < dims_[0] && "i is out of bounds in CArray 2D!");
     assert(j >= 0 && j < dims_[1] && "j is out of bounds in CArray 2D!");
     
-    return array_[j + (i *  dims_[1])];
+    return array_[j + (i *  padded_dim_)];
 }
 
 //3D
@@ -1982,8 +2764,8 @@ inline T& CArray<T>::operator() (size_t i,
     assert(j >= 0 && j < dims_[1] && "j is out of bounds in Carray 3D!");
     assert(k >= 0 && k < dims_[2] && "k is out of bounds in CArray 3D!");
     
-    return array_[k + (j * dims_[2])
-                    + (i * dims_[2] *  dims_[1])];
+    return array_[k + (j * padded_dim_)
+                    + (i * padded_dim_ *  dims_[1])];
 }
 
 //4D
@@ -1999,9 +2781,9 @@ inline T& CArray<T>::operator() (size_t i,
     assert(k >= 0 && k < dims_[2] && "k is out of bounds in CArray 4D");  // die if >= dim2
     assert(l >= 0 && l < dims_[3] && "l is out of bounds in CArray 4D");  // die if >= dim3
 
-    return array_[l + (k * dims_[3])
-                    + (j * dims_[3] * dims_[2])
-                    + (i * dims_[3] * dims_[2] *  dims_[1])];
+    return array_[l + (k * padded_dim_)
+                    + (j * padded_dim_ * dims_[2])
+                    + (i * padded_dim_ * dims_[2] *  dims_[1])];
 }
 
 //5D
@@ -2019,10 +2801,10 @@ inline T& CArray<T>::operator() (size_t i,
     assert(l >= 0 && l < dims_[3] && "l is out of bounds in CArray 5D!");
     assert(m >= 0 && m < dims_[4] && "m is out of bounds in CArray 5D!");
     
-    return array_[m + (l * dims_[4])
-                    + (k * dims_[4] * dims_[3])
-                    + (j * dims_[4] * dims_[3] * dims_[2])
-                    + (i * dims_[4] * dims_[3] * dims_[2] *  dims_[1])];
+    return array_[m + (l * padded_dim_)
+                    + (k * padded_dim_ * dims_[3])
+                    + (j * padded_dim_ * dims_[3] * dims_[2])
+                    + (i * padded_dim_ * dims_[3] * dims_[2] *  dims_[1])];
 }
 
 //6D
@@ -2042,11 +2824,11 @@ inline T& CArray<T>::operator() (size_t i,
     assert(m >= 0 && m < dims_[4] && "m is out of bounds in CArray 6D!");
     assert(n >= 0 && n < dims_[5] && "n is out of bounds in CArray 6D!");
     
-    return array_[n + (m * dims_[5])
-                    + (l * dims_[5] * dims_[4])
-                    + (k * dims_[5] * dims_[4] * dims_[3])
-                    + (j * dims_[5] * dims_[4] * dims_[3] * dims_[2])
-                    + (i * dims_[5] * dims_[4] * dims_[3] * dims_[2] *  dims_[1])];
+    return array_[n + (m * padded_dim_)
+                    + (l * padded_dim_ * dims_[4])
+                    + (k * padded_dim_ * dims_[4] * dims_[3])
+                    + (j * padded_dim_ * dims_[4] * dims_[3] * dims_[2])
+                    + (i * padded_dim_ * dims_[4] * dims_[3] * dims_[2] *  dims_[1])];
 }
 
 //7D
@@ -2068,12 +2850,12 @@ inline T& CArray<T>::operator() (size_t i,
     assert(n >= 0 && n < dims_[5] && "n is out of bounds in CArray 7D!");
     assert(o >= 0 && o < dims_[6] && "o is out of bounds in CArray 7D!");
     
-    return array_[o + (n * dims_[6])
-                    + (m * dims_[6] * dims_[5])
-                    + (l * dims_[6] * dims_[5] * dims_[4])
-                    + (k * dims_[6] * dims_[5] * dims_[4] * dims_[3])
-                    + (j * dims_[6] * dims_[5] * dims_[4] * dims_[3] * dims_[2])
-                    + (i * dims_[6] * dims_[5] * dims_[4] * dims_[3] * dims_[2] *  dims_[1])];
+    return array_[o + (n * padded_dim_)
+                    + (m * padded_dim_ * dims_[5])
+                    + (l * padded_dim_ * dims_[5] * dims_[4])
+                    + (k * padded_dim_ * dims_[5] * dims_[4] * dims_[3])
+                    + (j * padded_dim_ * dims_[5] * dims_[4] * dims_[3] * dims_[2])
+                    + (i * padded_dim_ * dims_[5] * dims_[4] * dims_[3] * dims_[2] *  dims_[1])];
     
 }
 
@@ -2091,6 +2873,7 @@ inline CArray<T>& CArray<T>::operator= (const CArray& temp)
 
         order_  = temp.order_;
         length_ = temp.length_;
+        padded_dim_ = temp.padded_dim_;
         array_  = temp.array_;
     }
     return *this;
@@ -2123,9 +2906,79 @@ inline T* CArray<T>::pointer() const{
 }
 
 //destructor
+// Move constructor
+template <typename T>
+CArray<T>::CArray(CArray&& temp) noexcept {
+    for (int iter = 0; iter < 7; iter++){
+        dims_[iter] = temp.dims_[iter];
+        temp.dims_[iter] = 0;
+    } // end for
+
+    order_  = temp.order_;
+    length_ = temp.length_;
+    padded_dim_ = temp.padded_dim_;
+    array_ = std::move(temp.array_);
+    temp.order_ = temp.length_ = temp.padded_dim_ = 0;
+}
+
+// Move assignment
+template <typename T>
+CArray<T>& CArray<T>::operator= (CArray&& temp) noexcept {
+    if (this != &temp) {
+        for (int iter = 0; iter < 7; iter++){
+            dims_[iter] = temp.dims_[iter];
+            temp.dims_[iter] = 0;
+        } // end for
+
+        order_  = temp.order_;
+        length_ = temp.length_;
+        padded_dim_ = temp.padded_dim_;
+        array_ = std::move(temp.array_);
+        temp.order_ = temp.length_ = temp.padded_dim_ = 0;
+    }
+    return *this;
+}
+
+// expression assignment
+template <typename T>
+template <typename E, typename>
+CArray<T>& CArray<T>::operator= (const E& expr)
+{
+    assign_expr(*this, expr);
+    return *this;
+}
+
+template <typename T>
+inline ViewCArray<T> CArray<T>::borrow() const {
+    assert((order_ == 0 || padded_dim_ == dims_[order_-1]) && "borrow() of a padded CArray is not supported!");
+    switch (order_) {
+        case 1: return ViewCArray <T> (array_.get(), dims_[0]);
+        case 2: return ViewCArray <T> (array_.get(), dims_[0], dims_[1]);
+        case 3: return ViewCArray <T> (array_.get(), dims_[0], dims_[1], dims_[2]);
+        case 4: return ViewCArray <T> (array_.get(), dims_[0], dims_[1], dims_[2], dims_[3]);
+        case 5: return ViewCArray <T> (array_.get(), dims_[0], dims_[1], dims_[2], dims_[3], dims_[4]);
+        case 6: return ViewCArray <T> (array_.get(), dims_[0], dims_[1], dims_[2], dims_[3], dims_[4], dims_[5]);
+        case 7: return ViewCArray <T> (array_.get(), dims_[0], dims_[1], dims_[2], dims_[3], dims_[4], dims_[5], dims_[6]);
+    }
+    return ViewCArray <T> ();
+}
+
 template <typename T>
 CArray<T>::~CArray() {}
 
+template <typename T>
+ViewStridedArray <T> CArray<T>::slice(size_t dim, size_t index) const {
+    return ViewStridedArray <T>(array_.get(), slice_shape(dense_shape(order_, dims_, padded_dim_, true), dim, index, 0));
+}
+
+template <typename T>
+ViewStridedArray <T> CArray<T>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                         SliceRange r3, SliceRange r4,
+                                         SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedArray <T>(array_.get(), subarray_shape(dense_shape(order_, dims_, padded_dim_, true), ranges, 0));
+}
+
 //----endof carray class definitions----
 
 
@@ -2238,6 +3091,16 @@ public:
     // return pointer
     T* pointer() const;
     
+
+    // views of part of the array without a copy: slice() fixes dimension dim
+    // at index and drops it, subarray() takes a range per dimension (see
+    // SliceRange), both keep the array's strides
+    ViewStridedArray <T> slice(size_t dim, size_t index) const;
+
+    ViewStridedArray <T> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                  SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                  SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
 }; // end of ViewCArray
 
 //class definitions
@@ -2546,6 +3409,19 @@ inline T* ViewCArray<T>::pointer() const {
     return array_;
 }
 
+template <typename T>
+ViewStridedArray <T> ViewCArray<T>::slice(size_t dim, size_t index) const {
+    return ViewStridedArray <T>(array_, slice_shape(dense_shape(order_, dims_, dims_[order_-1], true), dim, index, 0));
+}
+
+template <typename T>
+ViewStridedArray <T> ViewCArray<T>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                             SliceRange r3, SliceRange r4,
+                                             SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedArray <T>(array_, subarray_shape(dense_shape(order_, dims_, dims_[order_-1], true), ranges, 0));
+}
+
 //---end of ViewCArray class definitions----
 
 
@@ -2557,39 +3433,49 @@ private:
     size_t dims_[7];
     size_t length_; // Length of 1D array
     size_t order_;  // tensor order (rank)
+    size_t padded_dim_; // the fastest dimension padded by the AllocPolicy, the stride of the next index
     std::shared_ptr <T []> matrix_;
+
+    // pads the fastest dimension and allocates the storage
+    void allocate(const AllocPolicy& policy);
             
 public:
         
     // default constructor
     CMatrix();
 
-    CMatrix(size_t dim1);
+    CMatrix(size_t dim1,
+            const AllocPolicy& policy = AllocPolicy());
 
     CMatrix(size_t dim1,
-            size_t dim2);
+            size_t dim2,
+            const AllocPolicy& policy = AllocPolicy());
 
     CMatrix(size_t dim1,
             size_t dim2,
-            size_t dim3);
+            size_t dim3,
+            const AllocPolicy& policy = AllocPolicy());
 
     CMatrix(size_t dim1,
             size_t dim2,
             size_t dim3,
-            size_t dim4);
+            size_t dim4,
+            const AllocPolicy& policy = AllocPolicy());
 
     CMatrix(size_t dim1,
             size_t dim2,
             size_t dim3,
             size_t dim4,
-            size_t dim5);
+            size_t dim5,
+            const AllocPolicy& policy = AllocPolicy());
 
     CMatrix (size_t dim1,
             size_t dim2,
             size_t dim3,
             size_t dim4,
             size_t dim5,
-            size_t dim6);
+            size_t dim6,
+            const AllocPolicy& policy = AllocPolicy());
 
     CMatrix (size_t dim1,
             size_t dim2,
@@ -2597,9 +3483,13 @@ public:
             size_t dim4,
             size_t dim5,
             size_t dim6,
-            size_t dim7);
+            size_t dim7,
+            const AllocPolicy& policy = AllocPolicy());
 
     CMatrix(const CMatrix& temp);
+
+    // Move constructor, leaves temp empty
+    CMatrix (CMatrix&& temp) noexcept;
     
     //overload operators to access data
     T& operator()(size_t i) const;
@@ -2640,6 +3530,9 @@ public:
     //overload = operator
     CMatrix& operator= (const CMatrix &temp);
 
+    // Overload move assignment operator, leaves temp empty
+    CMatrix& operator= (CMatrix&& temp) noexcept;
+
     //return array size
     size_t size() const;
     
@@ -2651,10 +3544,24 @@ public:
 
     //return pointer
     T* pointer() const;
+
+    // return a non-owning ViewCMatrix of the same data, it does not
+    // touch the reference count and is cheap to pass by value
+    ViewCMatrix <T> borrow() const;
     
     // deconstructor
     ~CMatrix( );
         
+
+    // views of part of the array without a copy: slice() fixes dimension dim
+    // at index and drops it, subarray() takes a range per dimension (see
+    // SliceRange), both keep the array's strides
+    ViewStridedMatrix <T> slice(size_t dim, size_t index) const;
+
+    ViewStridedMatrix <T> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                   SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                   SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
 }; // end of CMatrix
 
 // CMatrix class definitions
@@ -2668,6 +3575,7 @@ template <typename T>
 CMatrix<T>::CMatrix() {
     matrix_ = NULL;
     length_ = order_ = 0;
+    padded_dim_ = 0;
     for (int i = 0; i < 7; i++) {
         dims_[i] = 0;
     }
@@ -2675,38 +3583,38 @@ CMatrix<T>::CMatrix() {
 
 //1D
 template <typename T>
-CMatrix<T>::CMatrix(size_t dim1)
+CMatrix<T>::CMatrix(size_t dim1,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     order_ = 1;
-    length_ = dim1;
-    matrix_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
 }
 
 //2D
 template <typename T>
 CMatrix<T>::CMatrix(size_t dim1,
-                    size_t dim2)
+                    size_t dim2,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     dims_[1] = dim2;
     order_ = 2;
-    length_ = dim1 * dim2;
-    matrix_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
 }
 
 //3D
 template <typename T>
 CMatrix<T>::CMatrix(size_t dim1,
                     size_t dim2,
-                    size_t dim3)
+                    size_t dim3,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     dims_[1] = dim2;
     dims_[2] = dim3;
     order_ = 3;
-    length_ = dim1 * dim2 * dim3;
-    matrix_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
 }
 
 //4D
@@ -2714,15 +3622,15 @@ template <typename T>
 CMatrix<T>::CMatrix(size_t dim1,
                     size_t dim2,
                     size_t dim3,
-                    size_t dim4)
+                    size_t dim4,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     dims_[1] = dim2;
     dims_[2] = dim3;
     dims_[3] = dim4;
     order_ = 4;
-    length_ = dim1 * dim2 * dim3 * dim4;
-    matrix_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
 }
 
 //5D
@@ -2731,7 +3639,8 @@ CMatrix<T>::CMatrix(size_t dim1,
                     size_t dim2,
                     size_t dim3,
                     size_t dim4,
-                    size_t dim5)
+                    size_t dim5,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     dims_[1] = dim2;
@@ -2739,8 +3648,7 @@ CMatrix<T>::CMatrix(size_t dim1,
     dims_[3] = dim4;
     dims_[4] = dim5;
     order_ = 5;
-    length_ = dim1 * dim2 * dim3 * dim4 * dim5;
-    matrix_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
 }
 
 //6D
@@ -2750,7 +3658,8 @@ CMatrix<T>::CMatrix(size_t dim1,
                     size_t dim3,
                     size_t dim4,
                     size_t dim5,
-                    size_t dim6)
+                    size_t dim6,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     dims_[1] = dim2;
@@ -2759,8 +3668,7 @@ CMatrix<T>::CMatrix(size_t dim1,
     dims_[4] = dim5;
     dims_[5] = dim6;
     order_ = 6;
-    length_ = dim1 * dim2 * dim3 * dim4 * dim5 * dim6;
-    matrix_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
 }
 
 //7D
@@ -2771,7 +3679,8 @@ CMatrix<T>::CMatrix(size_t dim1,
                     size_t dim4,
                     size_t dim5,
                     size_t dim6,
-                    size_t dim7)
+                    size_t dim7,
+                    const AllocPolicy& policy)
 {
     dims_[0] = dim1;
     dims_[1] = dim2;
@@ -2781,8 +3690,19 @@ CMatrix<T>::CMatrix(size_t dim1,
     dims_[5] = dim6;
     dims_[6] = dim7;
     order_ = 7;
-    length_ = dim1 * dim2 * dim3 * dim4 * dim5 * dim6 * dim7;
-    matrix_ = std::shared_ptr <T[]> (new T[length_]);
+    allocate(policy);
+}
+
+// the last dimension is rounded up to a multiple of policy.pad
+template <typename T>
+void CMatrix<T>::allocate(const AllocPolicy& policy) {
+    assert(policy.pad > 0 && "AllocPolicy pad must be positive in CMatrix!");
+    padded_dim_ = (dims_[order_-1] + policy.pad - 1) / policy.pad * policy.pad;
+    length_ = padded_dim_;
+    for (size_t i = 0; i + 1 < order_; i++) {
+        length_ *= dims_[i];
+    }
+    matrix_ = aligned_allocate<T>(length_, policy);
 }
 
 template <typename T>
@@ -2797,6 +3717,7 @@ CMatrix<T>::CMatrix(const CMatrix& temp) {
         
         order_  = temp.order_;
         length_ = temp.length_;
+        padded_dim_ = temp.padded_dim_;
         matrix_ = temp.matrix_;
     } // end if
     
@@ -2823,7 +3744,7 @@ T& CMatrix<T>::operator()(size_t i,
     assert(i >= 1 && i <= dims_[0] && "i is out of bounds in CMatrix 2D!");
     assert(j >= 1 && j <= dims_[1] && "j is out of bounds in CMatrix 2D!");
     
-    return matrix_[(j-1) + (i-1)*dims_[1]];
+    return matrix_[(j-1) + (i-1)*padded_dim_];
 }
 
 //3D
@@ -2837,8 +3758,8 @@ T& CMatrix<T>::operator()(size_t i,
     assert(j >= 1 && j <= dims_[1] && "j is out of bounds in CMatrix 3D!");
     assert(k >= 1 && k <= dims_[2] && "k is out of bounds in CMatrix 3D!");
     
-    return matrix_[(k-1) + (j-1)*dims_[2]
-                         + (i-1)*dims_[2]*dims_[1]];
+    return matrix_[(k-1) + (j-1)*padded_dim_
+                         + (i-1)*padded_dim_*dims_[1]];
 }
 
 //4D
@@ -2854,9 +3775,9 @@ T& CMatrix<T>::operator()(size_t i,
     assert(k >= 1 && k <= dims_[2] && "k is out of bounds in CMatrix 4D");  // die if >= dim2
     assert(l >= 1 && l <= dims_[3] && "l is out of bounds in CMatrix 4D");  // die if >= dim3
     
-    return matrix_[(l-1) + (k-1)*dims_[3]
-                         + (j-1)*dims_[3]*dims_[2]
-                         + (i-1)*dims_[3]*dims_[2]*dims_[1]];
+    return matrix_[(l-1) + (k-1)*padded_dim_
+                         + (j-1)*padded_dim_*dims_[2]
+                         + (i-1)*padded_dim_*dims_[2]*dims_[1]];
 }
 
 //5D
@@ -2874,10 +3795,10 @@ T& CMatrix<T>::operator()(size_t i,
     assert(l >= 1 && l <= dims_[3] && "l is out of bounds in CMatrix 5D!");
     assert(m >= 1 && m <= dims_[4] && "m is out of bounds in CMatrix 5D!");
     
-    return matrix_[(m-1) + (l-1)*dims_[4]
-                         + (k-1)*dims_[4]*dims_[3]
-                         + (j-1)*dims_[4]*dims_[3]*dims_[2]
-                         + (i-1)*dims_[4]*dims_[3]*dims_[2]*dims_[1]];
+    return matrix_[(m-1) + (l-1)*padded_dim_
+                         + (k-1)*padded_dim_*dims_[3]
+                         + (j-1)*padded_dim_*dims_[3]*dims_[2]
+                         + (i-1)*padded_dim_*dims_[3]*dims_[2]*dims_[1]];
 }
 
 //6D
@@ -2897,11 +3818,11 @@ T& CMatrix<T>::operator()(size_t i,
     assert(m >= 1 && m <= dims_[4] && "m is out of bounds in CMatrix 6D!");
     assert(n >= 1 && n <= dims_[5] && "n is out of bounds in CMatrix 6D!");
     
-    return matrix_[ (n-1) + (m-1)*dims_[5]
-                          + (l-1)*dims_[5]*dims_[4]
-                          + (k-1)*dims_[5]*dims_[4]*dims_[3]
-                          + (j-1)*dims_[5]*dims_[4]*dims_[3]*dims_[2]
-                          + (i-1)*dims_[5]*dims_[4]*dims_[3]*dims_[2]*dims_[1]];
+    return matrix_[ (n-1) + (m-1)*padded_dim_
+                          + (l-1)*padded_dim_*dims_[4]
+                          + (k-1)*padded_dim_*dims_[4]*dims_[3]
+                          + (j-1)*padded_dim_*dims_[4]*dims_[3]*dims_[2]
+                          + (i-1)*padded_dim_*dims_[4]*dims_[3]*dims_[2]*dims_[1]];
 }
 
 //7D
@@ -2923,12 +3844,12 @@ T& CMatrix<T>::operator()(size_t i,
     assert(n >= 1 && n <= dims_[5] && "n is out of bounds in CMatrix 7D!");
     assert(o >= 1 && o <= dims_[6] && "o is out of bounds in CMatrix 7D!");
     
-    return matrix_[(o-1) + (n-1)*dims_[6]
-                         + (m-1)*dims_[6]*dims_[5]
-                         + (l-1)*dims_[6]*dims_[5]*dims_[4]
-                         + (k-1)*dims_[6]*dims_[5]*dims_[4]*dims_[3]
-                         + (j-1)*dims_[6]*dims_[5]*dims_[4]*dims_[3]*dims_[2]
-                         + (i-1)*dims_[6]*dims_[5]*dims_[4]*dims_[3]*dims_[2]*dims_[1]];
+    return matrix_[(o-1) + (n-1)*padded_dim_
+                         + (m-1)*padded_dim_*dims_[5]
+                         + (l-1)*padded_dim_*dims_[5]*dims_[4]
+                         + (k-1)*padded_dim_*dims_[5]*dims_[4]*dims_[3]
+                         + (j-1)*padded_dim_*dims_[5]*dims_[4]*dims_[3]*dims_[2]
+                         + (i-1)*padded_dim_*dims_[5]*dims_[4]*dims_[3]*dims_[2]*dims_[1]];
 }
 
 //overload = operator
@@ -2942,6 +3863,7 @@ CMatrix<T> &CMatrix<T>::operator= (const CMatrix &temp) {
 
         order_  = temp.order_;
         length_ = temp.length_;
+        padded_dim_ = temp.padded_dim_;
         matrix_ = temp.matrix_;
     }
   return *this;
@@ -2970,10 +3892,71 @@ inline T* CMatrix<T>::pointer() const{
     return matrix_.get();
 }
 
+// Move constructor
+template <typename T>
+CMatrix<T>::CMatrix(CMatrix&& temp) noexcept {
+    for (int iter = 0; iter < 7; iter++){
+        dims_[iter] = temp.dims_[iter];
+        temp.dims_[iter] = 0;
+    } // end for
+
+    order_  = temp.order_;
+    length_ = temp.length_;
+    padded_dim_ = temp.padded_dim_;
+    matrix_ = std::move(temp.matrix_);
+    temp.order_ = temp.length_ = temp.padded_dim_ = 0;
+}
+
+// Move assignment
+template <typename T>
+CMatrix<T>& CMatrix<T>::operator= (CMatrix&& temp) noexcept {
+    if (this != &temp) {
+        for (int iter = 0; iter < 7; iter++){
+            dims_[iter] = temp.dims_[iter];
+            temp.dims_[iter] = 0;
+        } // end for
+
+        order_  = temp.order_;
+        length_ = temp.length_;
+        padded_dim_ = temp.padded_dim_;
+        matrix_ = std::move(temp.matrix_);
+        temp.order_ = temp.length_ = temp.padded_dim_ = 0;
+    }
+    return *this;
+}
+
+template <typename T>
+inline ViewCMatrix<T> CMatrix<T>::borrow() const {
+    assert((order_ == 0 || padded_dim_ == dims_[order_-1]) && "borrow() of a padded CMatrix is not supported!");
+    switch (order_) {
+        case 1: return ViewCMatrix <T> (matrix_.get(), dims_[0]);
+        case 2: return ViewCMatrix <T> (matrix_.get(), dims_[0], dims_[1]);
+        case 3: return ViewCMatrix <T> (matrix_.get(), dims_[0], dims_[1], dims_[2]);
+        case 4: return ViewCMatrix <T> (matrix_.get(), dims_[0], dims_[1], dims_[2], dims_[3]);
+        case 5: return ViewCMatrix <T> (matrix_.get(), dims_[0], dims_[1], dims_[2], dims_[3], dims_[4]);
+        case 6: return ViewCMatrix <T> (matrix_.get(), dims_[0], dims_[1], dims_[2], dims_[3], dims_[4], dims_[5]);
+        case 7: return ViewCMatrix <T> (matrix_.get(), dims_[0], dims_[1], dims_[2], dims_[3], dims_[4], dims_[5], dims_[6]);
+    }
+    return ViewCMatrix <T> ();
+}
+
 // Destructor
 template <typename T>
 CMatrix<T>::~CMatrix(){}
 
+template <typename T>
+ViewStridedMatrix <T> CMatrix<T>::slice(size_t dim, size_t index) const {
+    return ViewStridedMatrix <T>(matrix_.get(), slice_shape(dense_shape(order_, dims_, padded_dim_, true), dim, index, 1));
+}
+
+template <typename T>
+ViewStridedMatrix <T> CMatrix<T>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                           SliceRange r3, SliceRange r4,
+                                           SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedMatrix <T>(matrix_.get(), subarray_shape(dense_shape(order_, dims_, padded_dim_, true), ranges, 1));
+}
+
 //----end of CMatrix class definitions----
 
 
@@ -3088,6 +4071,16 @@ public:
     // return pointer
     T* pointer() const;
     
+
+    // views of part of the array without a copy: slice() fixes dimension dim
+    // at index and drops it, subarray() takes a range per dimension (see
+    // SliceRange), both keep the array's strides
+    ViewStridedMatrix <T> slice(size_t dim, size_t index) const;
+
+    ViewStridedMatrix <T> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                   SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                   SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
 }; // end of ViewCMatrix
 
 //class definitions
@@ -3380,6 +4373,19 @@ inline T* ViewCMatrix<T>::pointer() const {
     return matrix_;
 }
 
+template <typename T>
+ViewStridedMatrix <T> ViewCMatrix<T>::slice(size_t dim, size_t index) const {
+    return ViewStridedMatrix <T>(matrix_, slice_shape(dense_shape(order_, dims_, dims_[order_-1], true), dim, index, 1));
+}
+
+template <typename T>
+ViewStridedMatrix <T> ViewCMatrix<T>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                               SliceRange r3, SliceRange r4,
+                                               SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedMatrix <T>(matrix_, subarray_shape(dense_shape(order_, dims_, dims_[order_-1], true), ranges, 1));
+}
+
 
 //----end of ViewCMatrix class definitions----
 
@@ -3414,6 +4420,9 @@ public:
 
     // Copy constructor
     RaggedRightArray (const RaggedRightArray& temp);
+
+    // Move constructor, leaves temp empty
+    RaggedRightArray (RaggedRightArray&& temp) noexcept;
     
     // A method to return the stride size
     size_t stride(size_t i) const;
@@ -3431,16 +4440,26 @@ public:
     // method to return total size
     size_t size() const;
 
+    // number of rows
+    size_t dim1() const;
+
     //return pointer
     T* pointer() const;
     
     //get row starts array
     size_t* get_starts() const;
 
+    // return a non-owning ViewRaggedRightArray of the same data, it does
+    // not touch the reference count and is cheap to pass by value
+    ViewRaggedRightArray <T> borrow() const;
+
     RaggedRightArray& operator+= (const size_t i);
 
     RaggedRightArray& operator= (const RaggedRightArray &temp);
 
+    // Overload move assignment operator, leaves temp empty
+    RaggedRightArray& operator= (RaggedRightArray&& temp) noexcept;
+
     // Destructor
     ~RaggedRightArray ( );
 }; // End of RaggedRightArray
@@ -3466,12 +4485,13 @@ RaggedRightArray<T>::RaggedRightArray (CArray<size_t> &strides_array){
     
     // Loop over to find the total length of the 1D array to
     // represent the ragged-right array and set the starting 1D index
-    size_t count = 0;
-    for (size_t i = 0; i < dim1_; i++){
+    length_ = par_scan(size_t(0), dim1_, size_t(0),
+                       [&](const size_t i, size_t& count, const bool final) {
         count += strides_array(i);
-        start_index_[(i + 1)] = count;
-    } // end for i
-    length_ = count;
+        if (final) {
+            start_index_[(i + 1)] = count;
+        }
+    });
     
     array_ = std::shared_ptr <T[]> (new T[length_]);
 } // End constructor
@@ -3488,12 +4508,13 @@ RaggedRightArray<T>::RaggedRightArray (ViewCArray<size_t> &strides_array) {
     
     // Loop over to find the total length of the 1D array to
     // represent the ragged-right array and set the starting 1D index
-    size_t count = 0;
-    for (size_t i = 0; i < dim1_; i++){
+    length_ = par_scan(size_t(0), dim1_, size_t(0),
+                       [&](const size_t i, size_t& count, const bool final) {
         count += strides_array(i);
-        start_index_[(i + 1)] = count;
-    } // end for i
-    length_ = count;
+        if (final) {
+            start_index_[(i + 1)] = count;
+        }
+    });
 
     array_ = std::shared_ptr <T []> (new T[length_]);
 } // End constructor
@@ -3510,12 +4531,13 @@ RaggedRightArray<T>::RaggedRightArray (size_t *strides_array, size_t dim1){
     
     // Loop over to find the total length of the 1D array to
     // represent the ragged-right array and set the starting 1D index
-    size_t count = 0;
-    for (size_t i = 0; i < dim1_; i++){
+    length_ = par_scan(size_t(0), dim1_, size_t(0),
+                       [&](const size_t i, size_t& count, const bool final) {
         count += strides_array[i];
-        start_index_[(i + 1)] = count;
-    } // end for i
-    length_ = count;
+        if (final) {
+            start_index_[(i + 1)] = count;
+        }
+    });
 
     array_ = std::shared_ptr <T []> (new T[length_]);
 } // End constructor
@@ -3592,6 +4614,11 @@ size_t RaggedRightArray<T>::size() const {
     return length_;
 }
 
+template <typename T>
+inline size_t RaggedRightArray<T>::dim1() const {
+    return dim1_;
+}
+
 template <typename T>
 RaggedRightArray<T> & RaggedRightArray<T>::operator+= (const size_t i) {
     this->num_saved_ ++;
@@ -3626,24 +4653,154 @@ inline size_t* RaggedRightArray<T>::get_starts() const{
     return start_index_.get();
 }
 
+// Move constructor
+template <typename T>
+RaggedRightArray<T>::RaggedRightArray (RaggedRightArray&& temp) noexcept {
+    dim1_ = temp.dim1_;
+    length_ = temp.length_;
+    num_saved_ = temp.num_saved_;
+
+    // shared pointer
+    start_index_ = std::move(temp.start_index_);
+    array_ = std::move(temp.array_);
+    temp.dim1_ = temp.length_ = temp.num_saved_ = 0;
+}
+
+// Move assignment
+template <typename T>
+RaggedRightArray<T>& RaggedRightArray<T>::operator= (RaggedRightArray&& temp) noexcept {
+    if (this != &temp) {
+        dim1_ = temp.dim1_;
+        length_ = temp.length_;
+        num_saved_ = temp.num_saved_;
+
+        // shared pointer
+        start_index_ = std::move(temp.start_index_);
+        array_ = std::move(temp.array_);
+        temp.dim1_ = temp.length_ = temp.num_saved_ = 0;
+    }
+    return *this;
+}
+
+template <typename T>
+inline ViewRaggedRightArray<T> RaggedRightArray<T>::borrow() const {
+    return ViewRaggedRightArray <T> (array_.get(), start_index_.get(), dim1_);
+}
+
 // Destructor
 template <typename T>
 RaggedRightArray<T>::~RaggedRightArray () {}
 
 //----end of RaggedRightArray class definitions----
 
-//9. RaggedRightArrayofVectors
+//9a. ViewRaggedRightArray
+// non-owning handle to the data of a RaggedRightArray
 template <typename T>
-class RaggedRightArrayofVectors {
+class ViewRaggedRightArray {
 private:
-    std::shared_ptr <T[]> start_index_;
-    std::shared_ptr <T[]> array_;
-    
-    size_t dim1_, length_, vector_dim_;
-    size_t num_saved_; // the number saved in the 1D array
-    
-public:
-    // Default constructor
+    size_t * start_index_;
+    T * array_;
+
+    size_t dim1_, length_;
+
+public:
+    // Default constructor
+    ViewRaggedRightArray ();
+
+    // start_index holds dim1+1 entries, as returned by get_starts()
+    ViewRaggedRightArray (T *some_array, size_t *start_index, size_t some_dim1);
+
+    // A method to return the stride size
+    size_t stride(size_t i) const;
+
+    // Overload operator() to access data as array(i,j)
+    // where i=[0:N-1], j=[stride(i)]
+    T& operator()(size_t i, size_t j) const;
+
+    // method to return total size
+    size_t size() const;
+
+    // number of rows
+    size_t dim1() const;
+
+    //return pointer
+    T* pointer() const;
+
+    //get row starts array
+    size_t* get_starts() const;
+
+}; // End of ViewRaggedRightArray
+
+// Default constructor
+template <typename T>
+ViewRaggedRightArray<T>::ViewRaggedRightArray () {
+    array_ = NULL;
+    start_index_ = NULL;
+    length_ = dim1_ = 0;
+}
+
+template <typename T>
+ViewRaggedRightArray<T>::ViewRaggedRightArray (T *some_array, size_t *start_index, size_t some_dim1) {
+    array_ = some_array;
+    start_index_ = start_index;
+    dim1_ = some_dim1;
+    length_ = start_index_[dim1_];
+}
+
+template <typename T>
+inline size_t ViewRaggedRightArray<T>::stride(size_t i) const {
+    // Ensure that i is within bounds
+    assert(i < dim1_ && "i is greater than dim1_ in ViewRaggedRightArray");
+
+    return start_index_[(i + 1)] - start_index_[i];
+}
+
+template <typename T>
+inline T& ViewRaggedRightArray<T>::operator()(size_t i, size_t j) const {
+    // get the 1D array index
+    size_t start = start_index_[i];
+
+    // asserts
+    assert(i < dim1_ && "i is out of dim1 bounds in ViewRaggedRightArray");  // die if >= dim1
+    assert(j+start < length_ && "j+start is out of bounds in ViewRaggedRightArray");  // die if >= 1D array length)
+
+    return array_[j + start];
+}
+
+template <typename T>
+inline size_t ViewRaggedRightArray<T>::size() const {
+    return length_;
+}
+
+template <typename T>
+inline size_t ViewRaggedRightArray<T>::dim1() const {
+    return dim1_;
+}
+
+template <typename T>
+inline T* ViewRaggedRightArray<T>::pointer() const {
+    return array_;
+}
+
+template <typename T>
+inline size_t* ViewRaggedRightArray<T>::get_starts() const {
+    return start_index_;
+}
+
+//----end of ViewRaggedRightArray class definitions----
+
+//9. RaggedRightArrayofVectors
+template <typename T>
+class RaggedRightArrayofVectors {
+private:
+    std::shared_ptr <size_t[]> start_index_;
+    std::shared_ptr <T[]> array_;
+    
+    size_t dim1_, length_, vector_dim_;
+    size_t num_saved_; // the number saved in the 1D array
+    
+public:
+    // Default constructor
     RaggedRightArrayofVectors ();
     
     //--- 3D array access of a ragged right array storing a vector of size vector_dim_ at each (i,j)---
@@ -3663,6 +4820,9 @@ public:
 
     // Copy constructor
     RaggedRightArrayofVectors (const RaggedRightArrayofVectors& temp);
+
+    // Move constructor, leaves temp empty
+    RaggedRightArrayofVectors (RaggedRightArrayofVectors&& temp) noexcept;
     
     // A method to return the stride size
     size_t stride(size_t i) const;
@@ -3693,6 +4853,9 @@ public:
 
     RaggedRightArrayofVectors& operator= (const RaggedRightArrayofVectors &temp);
 
+    // Overload move assignment operator, leaves temp empty
+    RaggedRightArrayofVectors& operator= (RaggedRightArrayofVectors&& temp) noexcept;
+
     // Destructor
     ~RaggedRightArrayofVectors ( );
 }; // End of RaggedRightArray
@@ -3719,12 +4882,13 @@ RaggedRightArrayofVectors<T>::RaggedRightArrayofVectors (CArray<size_t> &strides
     
     // Loop over to find the total length of the 1D array to
     // represent the ragged-right array and set the starting 1D index
-    size_t count = 0;
-    for (size_t i = 0; i < dim1_; i++){
+    length_ = par_scan(size_t(0), dim1_, size_t(0),
+                       [&](const size_t i, size_t& count, const bool final) {
         count += strides_array(i)*vector_dim_;
-        start_index_[(i + 1)] = count;
-    } // end for i
-    length_ = count;
+        if (final) {
+            start_index_[(i + 1)] = count;
+        }
+    });
     
     array_ = std::shared_ptr <T []> (new T[length_]);
 } // End constructor
@@ -3742,12 +4906,13 @@ RaggedRightArrayofVectors<T>::RaggedRightArrayofVectors (ViewCArray<size_t> &str
     
     // Loop over to find the total length of the 1D array to
     // represent the ragged-right array and set the starting 1D index
-    size_t count = 0;
-    for (size_t i = 0; i < dim1_; i++){
+    length_ = par_scan(size_t(0), dim1_, size_t(0),
+                       [&](const size_t i, size_t& count, const bool final) {
         count += strides_array(i)*vector_dim_;
-        start_index_[(i + 1)] = count;
-    } // end for i
-    length_ = count;
+        if (final) {
+            start_index_[(i + 1)] = count;
+        }
+    });
 
     array_ = std::shared_ptr <T []> (new T[length_]);
 } // End constructor
@@ -3765,12 +4930,13 @@ RaggedRightArrayofVectors<T>::RaggedRightArrayofVectors (size_t *strides_array,
     
     // Loop over to find the total length of the 1D array to
     // represent the ragged-right array of vectors and set the starting 1D index
-    size_t count = 0;
-    for (size_t i = 0; i < dim1_; i++){
+    length_ = par_scan(size_t(0), dim1_, size_t(0),
+                       [&](const size_t i, size_t& count, const bool final) {
         count += strides_array[i]*vector_dim_;
-        start_index_[(i + 1)] = count;
-    } // end for i
-    length_ = count;
+        if (final) {
+            start_index_[(i + 1)] = count;
+        }
+    });
    
     array_ = std::shared_ptr <T []> (new T[length_]);
 } // End constructor
@@ -3806,7 +4972,7 @@ RaggedRightArrayofVectors<T>::RaggedRightArrayofVectors (const RaggedRightArrayo
         
         // shared pointer
         start_index_ = temp.start_index_;
-        array_ = temp.start_index_;
+        array_ = temp.array_;
     }
 } // end copy constructor
 
@@ -3868,7 +5034,7 @@ RaggedRightArrayofVectors<T> & RaggedRightArrayofVectors<T>::operator= (const Ra
         
         // shared pointer
         start_index_ = temp.start_index_;
-        array_ = temp.start_index_;
+        array_ = temp.array_;
     }
     
     return *this;
@@ -3884,6 +5050,37 @@ inline size_t* RaggedRightArrayofVectors<T>::get_starts() const{
     return start_index_.get();
 }
 
+// Move constructor
+template <typename T>
+RaggedRightArrayofVectors<T>::RaggedRightArrayofVectors (RaggedRightArrayofVectors&& temp) noexcept {
+    dim1_ = temp.dim1_;
+    vector_dim_ = temp.vector_dim_;
+    length_ = temp.length_;
+    num_saved_ = temp.num_saved_;
+
+    // shared pointer
+    start_index_ = std::move(temp.start_index_);
+    array_ = std::move(temp.array_);
+    temp.dim1_ = temp.length_ = temp.num_saved_ = 0;
+}
+
+// Move assignment
+template <typename T>
+RaggedRightArrayofVectors<T>& RaggedRightArrayofVectors<T>::operator= (RaggedRightArrayofVectors&& temp) noexcept {
+    if (this != &temp) {
+        dim1_ = temp.dim1_;
+        vector_dim_ = temp.vector_dim_;
+        length_ = temp.length_;
+        num_saved_ = temp.num_saved_;
+
+        // shared pointer
+        start_index_ = std::move(temp.start_index_);
+        array_ = std::move(temp.array_);
+        temp.dim1_ = temp.length_ = temp.num_saved_ = 0;
+    }
+    return *this;
+}
+
 // Destructor
 template <typename T>
 RaggedRightArrayofVectors<T>::~RaggedRightArrayofVectors () {}
@@ -3921,6 +5118,9 @@ public:
 
     // Copy constructor
     RaggedDownArray (const RaggedDownArray& temp);
+
+    // Move constructor, leaves temp empty
+    RaggedDownArray (RaggedDownArray&& temp) noexcept;
     
     //method to return stride size
     size_t stride(size_t j);
@@ -3943,9 +5143,16 @@ public:
     //get row starts array
     size_t* get_starts() const;
 
+    // return a non-owning ViewRaggedDownArray of the same data, it does
+    // not touch the reference count and is cheap to pass by value
+    ViewRaggedDownArray <T> borrow() const;
+
     //overload = operator
     RaggedDownArray& operator= (const RaggedDownArray &temp);
 
+    // Overload move assignment operator, leaves temp empty
+    RaggedDownArray& operator= (RaggedDownArray&& temp) noexcept;
+
     //destructor
     ~RaggedDownArray();
 
@@ -3963,23 +5170,20 @@ RaggedDownArray<T>::RaggedDownArray() {
 template <typename T>
 RaggedDownArray<T>::RaggedDownArray( CArray <size_t> &strides_array) {
     // Length of stride array
-    //dim2_ = strides_array.size();
+    dim2_ = strides_array.size();
 
     // Create and initialize startding indices
     start_index_ = std::shared_ptr <size_t[]> (new size_t[(dim2_ + 1)]); // note the dim2+1
     start_index_[0] = 0; //1D array starts at 0
 
-        
-    //length of strides
-    dim2_ = strides_array.size();
-
     // Loop to find total length of 1D array
-    size_t count = 0;
-    for(size_t j = 0; j < dim2_ ; j++) {
+    length_ = par_scan(size_t(0), dim2_, size_t(0),
+                       [&](const size_t j, size_t& count, const bool final) {
         count += strides_array(j);
-        start_index_[j+1] = count;
-    }
-    length_ = count;
+        if (final) {
+            start_index_[j+1] = count;
+        }
+    });
 
     array_ = std::shared_ptr <T[]> (new T[length_]);
 
@@ -3989,19 +5193,20 @@ RaggedDownArray<T>::RaggedDownArray( CArray <size_t> &strides_array) {
 template <typename T>
 RaggedDownArray<T>::RaggedDownArray( ViewCArray <size_t> &strides_array) {
     // Length of strides
-    //dim2_ = strides_array.size();
+    dim2_ = strides_array.size();
 
     //create array for holding start indices
     start_index_ = std::shared_ptr <size_t[]> (new size_t[(dim2_ + 1)]); // note the dim2+1
     start_index_[0] = 0;
 
-    size_t count = 0;
     // Loop over to get total length of 1D array
-    for(size_t j = 0; j < dim2_ ;j++ ) {
+    length_ = par_scan(size_t(0), dim2_, size_t(0),
+                       [&](const size_t j, size_t& count, const bool final) {
         count += strides_array(j);
-        start_index_[j+1] = count;
-    }
-    length_ = count;
+        if (final) {
+            start_index_[j+1] = count;
+        }
+    });
     array_ = std::shared_ptr <T []> (new T[length_]);
 
 } // End constructor
@@ -4018,12 +5223,13 @@ RaggedDownArray<T>::RaggedDownArray( size_t *strides_array, size_t dim2){
 
     // Loop over to find length of 1D array
     // Represent ragged down array and set 1D index
-    size_t count = 0;
-    for(size_t j = 0; j < dim2_; j++) {
+    length_ = par_scan(size_t(0), dim2_, size_t(0),
+                       [&](const size_t j, size_t& count, const bool final) {
         count += strides_array[j];
-        start_index_[j+1] = count;
-    }
-    length_ = count;
+        if (final) {
+            start_index_[j+1] = count;
+        }
+    });
     array_ = std::shared_ptr <T[]> (new T[length_]);
 
 } //end construnctor
@@ -4128,6 +5334,40 @@ inline size_t* RaggedDownArray<T>::get_starts() const{
     return start_index_.get();
 }
 
+// Move constructor
+template <typename T>
+RaggedDownArray<T>::RaggedDownArray (RaggedDownArray&& temp) noexcept {
+    dim2_ = temp.dim2_;
+    length_ = temp.length_;
+    num_saved_ = temp.num_saved_;
+
+    // shared pointer
+    start_index_ = std::move(temp.start_index_);
+    array_ = std::move(temp.array_);
+    temp.dim2_ = temp.length_ = temp.num_saved_ = 0;
+}
+
+// Move assignment
+template <typename T>
+RaggedDownArray<T>& RaggedDownArray<T>::operator= (RaggedDownArray&& temp) noexcept {
+    if (this != &temp) {
+        dim2_ = temp.dim2_;
+        length_ = temp.length_;
+        num_saved_ = temp.num_saved_;
+
+        // shared pointer
+        start_index_ = std::move(temp.start_index_);
+        array_ = std::move(temp.array_);
+        temp.dim2_ = temp.length_ = temp.num_saved_ = 0;
+    }
+    return *this;
+}
+
+template <typename T>
+inline ViewRaggedDownArray<T> RaggedDownArray<T>::borrow() const {
+    return ViewRaggedDownArray <T> (array_.get(), start_index_.get(), dim2_);
+}
+
 // Destructor
 template <typename T>
 RaggedDownArray<T>::~RaggedDownArray() {}
@@ -4136,6 +5376,94 @@ RaggedDownArray<T>::~RaggedDownArray() {}
 
 //----end of RaggedDownArray----
 
+//10a. ViewRaggedDownArray
+// non-owning handle to the data of a RaggedDownArray
+template <typename T>
+class ViewRaggedDownArray {
+private:
+    size_t * start_index_;
+    T * array_;
+
+    size_t dim2_;
+    size_t length_;
+
+public:
+    // Default constructor
+    ViewRaggedDownArray ();
+
+    // start_index holds dim2+1 entries, as returned by get_starts()
+    ViewRaggedDownArray (T *some_array, size_t *start_index, size_t some_dim2);
+
+    //method to return stride size
+    size_t stride(size_t j) const;
+
+    //overload () operator to access data as array (i,j)
+    T& operator()(size_t i, size_t j) const;
+
+    // method to return total size
+    size_t size() const;
+
+    //return pointer
+    T* pointer() const;
+
+    //get column starts array
+    size_t* get_starts() const;
+
+}; // End of ViewRaggedDownArray
+
+// Default constructor
+template <typename T>
+ViewRaggedDownArray<T>::ViewRaggedDownArray () {
+    array_ = NULL;
+    start_index_ = NULL;
+    length_ = dim2_ = 0;
+}
+
+template <typename T>
+ViewRaggedDownArray<T>::ViewRaggedDownArray (T *some_array, size_t *start_index, size_t some_dim2) {
+    array_ = some_array;
+    start_index_ = start_index;
+    dim2_ = some_dim2;
+    length_ = start_index_[dim2_];
+}
+
+template <typename T>
+inline size_t ViewRaggedDownArray<T>::stride(size_t j) const {
+    assert(j < dim2_ && "j is greater than dim2_ in ViewRaggedDownArray");
+
+    return start_index_[j+1] - start_index_[j];
+}
+
+// Note: i = 0:stride(j), j = 0:N-1
+template <typename T>
+inline T& ViewRaggedDownArray<T>::operator()(size_t i, size_t j) const {
+    size_t start = start_index_[j];
+
+    // Make sure we are within array bounds
+    assert(i < stride(j) && "i is out of bounds in ViewRaggedDownArray");
+    assert(j < dim2_ && "j is out of dim2_ bounds in ViewRaggedDownArray");
+    assert(i+start < length_ && "i+start is out of bounds in ViewRaggedDownArray");  // die if >= 1D array length)
+
+    return array_[i + start];
+}
+
+template <typename T>
+inline size_t ViewRaggedDownArray<T>::size() const {
+    return length_;
+}
+
+template <typename T>
+inline T* ViewRaggedDownArray<T>::pointer() const {
+    return array_;
+}
+
+template <typename T>
+inline size_t* ViewRaggedDownArray<T>::get_starts() const {
+    return start_index_;
+}
+
+//----end of ViewRaggedDownArray----
+
 
 //11. DynamicRaggedRightArray
 
@@ -4161,6 +5489,9 @@ public:
     // Copy constructor
     DynamicRaggedRightArray (const DynamicRaggedRightArray& temp);
 
+    // Move constructor, leaves temp empty
+    DynamicRaggedRightArray (DynamicRaggedRightArray&& temp) noexcept;
+
     // A method to return or set the stride size
     size_t& stride(size_t i) const;
     
@@ -4176,6 +5507,9 @@ public:
     
     // Overload copy assignment operator
     DynamicRaggedRightArray& operator= (const DynamicRaggedRightArray &temp);
+
+    // Overload move assignment operator, leaves temp empty
+    DynamicRaggedRightArray& operator= (DynamicRaggedRightArray&& temp) noexcept;
     
     // Destructor
     ~DynamicRaggedRightArray ();
@@ -4272,6 +5606,35 @@ inline T* DynamicRaggedRightArray<T>::pointer() const{
     return array_.get();
 }
 
+// Move constructor
+template <typename T>
+DynamicRaggedRightArray<T>::DynamicRaggedRightArray (DynamicRaggedRightArray&& temp) noexcept {
+    dim1_ = temp.dim1_;
+    dim2_ = temp.dim2_;
+    length_ = temp.length_;
+
+    // shared pointer
+    stride_ = std::move(temp.stride_);
+    array_ = std::move(temp.array_);
+    temp.dim1_ = temp.dim2_ = temp.length_ = 0;
+}
+
+// Move assignment
+template <typename T>
+DynamicRaggedRightArray<T>& DynamicRaggedRightArray<T>::operator= (DynamicRaggedRightArray&& temp) noexcept {
+    if (this != &temp) {
+        dim1_ = temp.dim1_;
+        dim2_ = temp.dim2_;
+        length_ = temp.length_;
+
+        // shared pointer
+        stride_ = std::move(temp.stride_);
+        array_ = std::move(temp.array_);
+        temp.dim1_ = temp.dim2_ = temp.length_ = 0;
+    }
+    return *this;
+}
+
 // Destructor
 template <typename T>
 DynamicRaggedRightArray<T>::~DynamicRaggedRightArray() {}
@@ -4305,6 +5668,9 @@ public:
    
     // Copy constructor
     DynamicRaggedDownArray (const DynamicRaggedDownArray& temp);
+
+    // Move constructor, leaves temp empty
+    DynamicRaggedDownArray (DynamicRaggedDownArray&& temp) noexcept;
  
     // A method to return or set the stride size
     size_t& stride(size_t j) const;
@@ -4319,6 +5685,9 @@ public:
     // Overload copy assignment operator
     DynamicRaggedDownArray& operator= (const DynamicRaggedDownArray &temp);
 
+    // Overload move assignment operator, leaves temp empty
+    DynamicRaggedDownArray& operator= (DynamicRaggedDownArray&& temp) noexcept;
+
     //return pointer
     T* pointer() const;
     
@@ -4419,6 +5788,35 @@ inline T* DynamicRaggedDownArray<T>::pointer() const{
     return array_.get();
 }
 
+// Move constructor
+template <typename T>
+DynamicRaggedDownArray<T>::DynamicRaggedDownArray (DynamicRaggedDownArray&& temp) noexcept {
+    dim1_ = temp.dim1_;
+    dim2_ = temp.dim2_;
+    length_ = temp.length_;
+
+    // shared pointer
+    stride_ = std::move(temp.stride_);
+    array_ = std::move(temp.array_);
+    temp.dim1_ = temp.dim2_ = temp.length_ = 0;
+}
+
+// Move assignment
+template <typename T>
+DynamicRaggedDownArray<T>& DynamicRaggedDownArray<T>::operator= (DynamicRaggedDownArray&& temp) noexcept {
+    if (this != &temp) {
+        dim1_ = temp.dim1_;
+        dim2_ = temp.dim2_;
+        length_ = temp.length_;
+
+        // shared pointer
+        stride_ = std::move(temp.stride_);
+        array_ = std::move(temp.array_);
+        temp.dim1_ = temp.dim2_ = temp.length_ = 0;
+    }
+    return *this;
+}
+
 // Destructor
 template <typename T>
 DynamicRaggedDownArray<T>::~DynamicRaggedDownArray() {}
@@ -4426,28 +5824,210 @@ DynamicRaggedDownArray<T>::~DynamicRaggedDownArray() {}
 //----end of DynamicRaggedDownArray class definitions-----
 
 
-// 15CSRArrayy
-template <typename T>
-class CSRArray {
-  private: // What ought to be private ?
-    size_t dim1_, dim2_; // dim1_ is number of rows dim2_ is number of columns
-    size_t nnz_;
-    std::shared_ptr <T []> array_;
-    std::shared_ptr <size_t[]> column_index_;
-    std::shared_ptr <size_t[]> start_index_;
-    
-  public:
-    
-    /**
-     * @brief Construct a new Sparse Row Array object
-     *
-     */
-    CSRArray();
+// Helpers for the compressed sparse types.  The column indices of a CSR row
+// (and the row indices of a CSC column) are kept sorted so that finding an
+// entry is a binary search instead of a scan of the whole row.
 
+// Returns the position of key in the sorted index[begin, end), or not_found.
+// The loop has no data dependent branch, the compare becomes a conditional move.
+SPARSE_INLINE_FUNCTION
+size_t sorted_index_find(const size_t *index, size_t begin, size_t end, size_t key, size_t not_found) {
+    size_t length = end - begin;
+    if(length == 0){
+        return not_found;
+    }
+    const size_t *base = index + begin;
+    while(length > 1){
+        size_t half = length / 2;
+        base = (base[half] <= key) ? base + half : base;
+        length -= half;
+    }
+    return (*base == key) ? (size_t)(base - index) : not_found;
+}
 
+// Sorts index[begin, end) in place and moves values[begin, end) with it.
+// Shell sort, so it needs no scratch memory and also runs inside a kernel.
+template <typename T>
+SPARSE_INLINE_FUNCTION
+void sorted_index_sort(T *values, size_t *index, size_t begin, size_t end) {
+    size_t k;
+    for(k = begin + 1; k < end; k++){
+        if(index[k-1] > index[k]) break;
+    }
+    if(k >= end) return; // already sorted, the usual case
+
+    size_t length = end - begin;
+    size_t gap = 1;
+    while(gap < length / 3){
+        gap = 3*gap + 1;
+    }
+    for(; gap > 0; gap /= 3){
+        for(size_t a = begin + gap; a < end; a++){
+            size_t key = index[a];
+            T val = values[a];
+            size_t b = a;
+            while(b >= begin + gap && index[b - gap] > key){
+                index[b] = index[b - gap];
+                values[b] = values[b - gap];
+                b -= gap;
+            }
+            index[b] = key;
+            values[b] = val;
+        }
+    }
+}
+
+// Open addressing table of flat indices for one long row.  Empty slots hold
+// hashed_index_empty, and a table is at most half full so a probe always ends.
+const size_t hashed_index_empty = (size_t) -1;
+
+inline size_t hashed_index_slot(size_t key, size_t mask) {
+    return ((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+inline size_t hashed_index_find(const size_t *slots, size_t slot_begin, size_t slot_end,
+                                const size_t *index, size_t key, size_t not_found) {
+    size_t mask = slot_end - slot_begin - 1;
+    size_t slot = hashed_index_slot(key, mask);
+    while(true){
+        size_t k = slots[slot_begin + slot];
+        if(k == hashed_index_empty){
+            return not_found;
+        }
+        if(index[k] == key){
+            return k;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+
+// Number of row blocks for sparse_transpose.  Every block keeps a count per
+// output row, so small matrices use one block rather than one per thread.
+inline size_t sparse_transpose_blocks([[maybe_unused]] size_t nnz) {
+#if defined(HAVE_THREAD_POOL) && !defined(HAVE_KOKKOS)
+    size_t num_blocks = nnz / 4096;
+    size_t num_threads = ThreadPool::current().num_threads();
+    num_blocks = num_blocks < num_threads ? num_blocks : num_threads;
+    return num_blocks > 0 ? num_blocks : 1;
+#else
+    return 1;
+#endif
+}
+
+// Calls fcn(b) for every block b in [0, num_blocks), one block per thread
+// when the thread pool is enabled.
+template <typename F>
+void sparse_for_blocks(size_t num_blocks, const F& fcn) {
+#if defined(HAVE_THREAD_POOL) && !defined(HAVE_KOKKOS)
+    ThreadPool::current().run([&](size_t thread_id, size_t num_threads) {
+        for(size_t b = thread_id; b < num_blocks; b += num_threads){
+            fcn(b);
+        }
+    });
+#else
+    for(size_t b = 0; b < num_blocks; b++){
+        fcn(b);
+    }
+#endif
+}
+
+// Transposes a compressed sparse matrix with dim1 rows (CSR to CSC, or CSC to
+// CSR with the roles of rows and columns swapped).  out_starts must hold dim2+1
+// entries, out_index and out_values starts[dim1] entries.
+//
+// The rows are split into contiguous blocks.  Each block counts its entries per
+// output row, a prefix sum over (output row, block) gives every block its own
+// window in each output row, and each block then scatters its rows in order, so
+// the output indices come out sorted without atomics.
+template <typename T>
+void sparse_transpose(size_t dim1, size_t dim2,
+                      const size_t *starts, const size_t *index, const T *values,
+                      size_t *out_starts, size_t *out_index, T *out_values) {
+    size_t nnz = starts[dim1];
+    size_t num_blocks = sparse_transpose_blocks(nnz);
+
+    // counts[b*dim2 + j] is the number of entries block b has in output row j,
+    // and after the prefix sum where block b writes its next entry of row j
+    std::unique_ptr<size_t[]> counts(new size_t[num_blocks * dim2]);
+    std::unique_ptr<size_t[]> block_sums(new size_t[num_blocks + 1]);
+
+    sparse_for_blocks(num_blocks, [&](size_t b) {
+        size_t *count = counts.get() + b*dim2;
+        for(size_t j = 0; j < dim2; j++){
+            count[j] = 0;
+        }
+        for(size_t k = starts[dim1*b/num_blocks]; k < starts[dim1*(b+1)/num_blocks]; k++){
+            count[index[k]]++;
+        }
+    });
+
+    // prefix sum, each block takes a range of output rows
+    sparse_for_blocks(num_blocks, [&](size_t b) {
+        size_t sum = 0;
+        for(size_t j = dim2*b/num_blocks; j < dim2*(b+1)/num_blocks; j++){
+            for(size_t q = 0; q < num_blocks; q++){
+                sum += counts[q*dim2 + j];
+            }
+        }
+        block_sums[b+1] = sum;
+    });
+    block_sums[0] = 0;
+    for(size_t b = 0; b < num_blocks; b++){
+        block_sums[b+1] += block_sums[b];
+    }
+    sparse_for_blocks(num_blocks, [&](size_t b) {
+        size_t offset = block_sums[b];
+        for(size_t j = dim2*b/num_blocks; j < dim2*(b+1)/num_blocks; j++){
+            out_starts[j] = offset;
+            for(size_t q = 0; q < num_blocks; q++){
+                size_t count = counts[q*dim2 + j];
+                counts[q*dim2 + j] = offset;
+                offset += count;
+            }
+        }
+    });
+    out_starts[dim2] = nnz;
+
+    sparse_for_blocks(num_blocks, [&](size_t b) {
+        size_t *next = counts.get() + b*dim2;
+        for(size_t i = dim1*b/num_blocks; i < dim1*(b+1)/num_blocks; i++){
+            for(size_t k = starts[i]; k < starts[i+1]; k++){
+                size_t pos = next[index[k]]++;
+                out_index[pos] = i;
+                out_values[pos] = values[k];
+            }
+        }
+    });
+}
+
+
+// 15CSRArrayy
+template <typename T>
+class CSRArray {
+  private: // What ought to be private ?
+    size_t dim1_, dim2_; // dim1_ is number of rows dim2_ is number of columns
+    size_t nnz_;
+    std::shared_ptr <T []> array_;
+    std::shared_ptr <size_t[]> column_index_;
+    std::shared_ptr <size_t[]> start_index_;
+    std::shared_ptr <size_t[]> hash_start_; // optional, see build_hash_index()
+    std::shared_ptr <size_t[]> hash_slots_;
+
+    template <typename U> friend class CSCArray; // for the CSCArray(const CSRArray&) transpose
+    
+  public:
+    
     /**
      * @brief Construct a new Sparse Row Array object
      *
+     */
+    CSRArray();
+
+
+    /**
+     * @brief Construct a new Sparse Row Array object. The entries of each row are sorted by column
+     *
      * @param array 1d array of data values in order read left to right top to bottom
      * @param column_index_ 1d array specifying for each data value what column it is found
      * @param start_index_  1d array that marks the index for array and column where each row starts
@@ -4470,6 +6050,13 @@ class CSRArray {
      */
     CSRArray(const CSRArray &temp);
 
+    /**
+     * @brief Move constructor, leaves temp empty
+     *
+     * @param temp array to move from
+     */
+    CSRArray(CSRArray &&temp) noexcept;
+
     /**
      * @brief Access A(i,j). Returns a dummy address with value 0 if A(i,j) is not alocated
      *
@@ -4495,6 +6082,22 @@ class CSRArray {
      * @return CSRArray&
      */
     CSRArray& operator=(const CSRArray &temp);
+
+    /**
+     * @brief Move assignment operator, leaves temp empty
+     *
+     * @param temp CSRArray to move from
+     * @return CSRArray&
+     */
+    CSRArray& operator=(CSRArray &&temp) noexcept;
+
+    /**
+     * @brief Non-owning handle to the same data. It does not touch the reference
+     * count and is cheap to pass by value into kernels
+     *
+     * @return ViewCSRArray<T>
+     */
+    ViewCSRArray<T> borrow() const;
     
     /**
      * @brief get start of array_ data
@@ -4510,6 +6113,13 @@ class CSRArray {
      */
     size_t* get_starts() const;
 
+    /**
+     * @brief Get the column_index_ object, the column of each stored value
+     *
+     * @return size_t*
+     */
+    size_t* get_columns() const;
+
     void printer(); //debugging tool
 
     /**
@@ -4564,9 +6174,27 @@ class CSRArray {
     T& get_val_flat(size_t k);
     size_t get_col_flat(size_t k);
     // reverse map function from A(i,j) to what element of data/col_pt_ it corersponds to
-    size_t flat_index(size_t i, size_t j);
-    // Convertor
-    int toCSC(CArray<T> &array, CArray<size_t> &start_index, CArray<size_t> &row_index);
+    // binary search of row i, or a hash lookup if row i has a hash index. Returns nnz() if A(i,j) is not stored
+    size_t flat_index(size_t i, size_t j) const;
+
+    /**
+     * @brief Build a hash index for every row with at least min_row_nnz non zeros, so A(i,j) in a long row
+     * is found in O(1) instead of O(log nnz(i)). Copies and borrow() share the index. The sparsity pattern
+     * is fixed in this class, so the index stays valid
+     *
+     * @param min_row_nnz rows shorter than this keep the binary search
+     */
+    void build_hash_index(size_t min_row_nnz = 64);
+    /**
+     * @brief Transpose into CSC form, in parallel when the thread pool is enabled. The row indices
+     * of each column come out sorted, so the result can be handed straight to the CSCArray constructor
+     *
+     * @param array nnz() values, column by column
+     * @param start_index dim2()+1 entries, where each column starts in array and row_index
+     * @param row_index nnz() entries, the row of each value
+     * @return 0
+     */
+    int toCSC(CArray<T> &array, CArray<size_t> &start_index, CArray<size_t> &row_index) const;
     
     void to_dense(CArray<T>& A);
     //destructor
@@ -4580,6 +6208,7 @@ CSRArray<T>::CSRArray(){
     dim1_ = dim2_ = nnz_ = 0;
     array_ = NULL;
     column_index_ = start_index_ = NULL;
+    hash_start_ = hash_slots_ = NULL;
 }
 
 template <typename T>
@@ -4599,76 +6228,86 @@ CSRArray<T>::CSRArray(CArray<T> array, CArray<size_t> column_index, CArray<size_
         start_index_[i] = start_index(i);
     }
     nnz_ = nnz;
+    for(i = 0; i < dim1_; i++){
+        sorted_index_sort(array_.get(), column_index_.get(), start_index_[i], start_index_[i+1]);
+    }
 }
 
 template<typename T>
 CSRArray<T>::CSRArray(const CSRArray<T> &temp){
-    if(this != temp) {
-        nnz_ = temp.nnz_;
-        dim1_ = temp.dim1_;
-        dim2_ = temp.dim2_;
-        
-        start_index_ = temp.start_index_;
-        column_index_ = temp.column_index_;
-        array_ = temp.array_;
-    }
+    nnz_ = temp.nnz_;
+    dim1_ = temp.dim1_;
+    dim2_ = temp.dim2_;
+
+    start_index_ = temp.start_index_;
+    column_index_ = temp.column_index_;
+    array_ = temp.array_;
+    hash_start_ = temp.hash_start_;
+    hash_slots_ = temp.hash_slots_;
+}
+
+template<typename T>
+CSRArray<T>::CSRArray(CSRArray<T> &&temp) noexcept {
+    nnz_ = temp.nnz_;
+    dim1_ = temp.dim1_;
+    dim2_ = temp.dim2_;
+
+    start_index_ = std::move(temp.start_index_);
+    column_index_ = std::move(temp.column_index_);
+    array_ = std::move(temp.array_);
+    hash_start_ = std::move(temp.hash_start_);
+    hash_slots_ = std::move(temp.hash_slots_);
+    temp.nnz_ = temp.dim1_ = temp.dim2_ = 0;
 }
 
 template<typename T>
 CSRArray<T>::CSRArray(CArray<T> dense){
     dim1_ = dense.dims(0);
     dim2_ = dense.dims(1);
-    nnz_ = dense.size();
+    size_t i,j;
     start_index_ = std::shared_ptr<size_t []> (new size_t[dim1_ + 1]);
+    start_index_[0] = 0;
+    for(i = 0; i < dim1_; i++){
+        start_index_[i+1] = start_index_[i];
+        for(j = 0; j < dim2_; j++){
+            if(dense(i,j) != 0){
+                start_index_[i+1] += 1;
+            }
+        }
+    }
+    nnz_ = start_index_[dim1_];
     array_ = std::shared_ptr<T []> (new T[nnz_ + 1]);
     column_index_ = std::shared_ptr<size_t []> (new size_t[nnz_]);
-    size_t i,j;
+    // columns are visited in order, so each row is already sorted
     size_t cur = 0;
     for(i = 0; i < dim1_; i++){
-        for(j = 0; i < dim2_; j++){
-            if(j != 0){
-                    start_index_[i+1] += 1;
-                    column_index_[cur] = j;
-                    array_[cur] = dense(i,j);
-                    cur++;
+        for(j = 0; j < dim2_; j++){
+            if(dense(i,j) != 0){
+                column_index_[cur] = j;
+                array_[cur] = dense(i,j);
+                cur++;
             }
         }
     }
-    start_index_[0] = 0;
-    for(i = 1; i <= dim1_; i++){
-        start_index_[i] = start_index_[i] + start_index_[i+1];
-    }
-
-
 }
 
 template<typename T>
 T& CSRArray<T>::operator()(size_t i, size_t j) const {
-    size_t row_start = start_index_[i];
-    size_t row_end = start_index_[i+1];
-    size_t k;
-    for(k = 0; k < row_end - row_start; k++){
-        if(column_index_[row_start + k] == j){
-            return array_[row_start + k];
-        }
+    size_t k = flat_index(i, j);
+    if(k == nnz_){
+        array_[nnz_] = (T) NULL;
     }
-    array_[nnz_] = (T) NULL;
-    return array_[nnz_];
+    return array_[k];
 }
 
 
 template<typename T>
 T& CSRArray<T>::value(size_t i, size_t j) const {
-    size_t row_start = start_index_[i];
-    size_t row_end = start_index_[i+1];
-    size_t k;
-    for(k = 0; k < row_end - row_start; k++){
-        if(column_index_[row_start + k] == j){
-            return array_[row_start + k];
-        }
+    size_t k = flat_index(i, j);
+    if(k == nnz_){
+        array_[nnz_] = (T) NULL;
     }
-    array_[nnz_] = (T) NULL;
-    return array_[nnz_];
+    return array_[k];
 }
 
 template<typename T>
@@ -4681,9 +6320,14 @@ size_t* CSRArray<T>::get_starts() const {
     return start_index_.get();
 }
 
+template<typename T>
+size_t* CSRArray<T>::get_columns() const {
+    return column_index_.get();
+}
+
 template<typename T>
 CSRArray<T>& CSRArray<T>::operator=(const CSRArray &temp){
-    if(this != temp) {
+    if(this != &temp) {
         nnz_ = temp.nnz_;
         dim1_ = temp.dim1_;
         dim2_ = temp.dim2_;
@@ -4691,10 +6335,35 @@ CSRArray<T>& CSRArray<T>::operator=(const CSRArray &temp){
         start_index_ = temp.start_index_;
         column_index_ = temp.column_index_;
         array_ = temp.array_;
+        hash_start_ = temp.hash_start_;
+        hash_slots_ = temp.hash_slots_;
+    }
+    return *this;
+}
+
+template<typename T>
+CSRArray<T>& CSRArray<T>::operator=(CSRArray &&temp) noexcept {
+    if(this != &temp) {
+        nnz_ = temp.nnz_;
+        dim1_ = temp.dim1_;
+        dim2_ = temp.dim2_;
+
+        start_index_ = std::move(temp.start_index_);
+        column_index_ = std::move(temp.column_index_);
+        array_ = std::move(temp.array_);
+        hash_start_ = std::move(temp.hash_start_);
+        hash_slots_ = std::move(temp.hash_slots_);
+        temp.nnz_ = temp.dim1_ = temp.dim2_ = 0;
     }
     return *this;
 }
 
+template<typename T>
+ViewCSRArray<T> CSRArray<T>::borrow() const {
+    return ViewCSRArray<T>(array_.get(), column_index_.get(), start_index_.get(), dim1_, dim2_,
+                           hash_start_.get(), hash_slots_.get());
+}
+
 //debugging tool primarily
 template <typename T>
 void CSRArray<T>::printer(){
@@ -4720,8 +6389,8 @@ void CSRArray<T>::to_dense(CArray<T>& A){
 
 template<typename T>
 size_t CSRArray<T>::stride(size_t i) const {
-   assert(i <= dim1_ && "Index i out of bounds in CSRArray.stride()");
-   return start_index_[i+i] - start_index_[i];
+   assert(i < dim1_ && "Index i out of bounds in CSRArray.stride()");
+   return start_index_[i+1] - start_index_[i];
 
 }
 
@@ -4789,16 +6458,54 @@ size_t CSRArray<T>::get_col_flat(size_t k){
 
 
 template<typename T>
-size_t CSRArray<T>::flat_index(size_t i, size_t j){
-    size_t k;
-    size_t row_start = start_index_[i];
-    size_t row_end = start_index_[i+1];
-    for(k = 0; k < row_end - row_start; k++){
-        if(column_index_[row_start+k] == j){
-            return row_start+k;
+size_t CSRArray<T>::flat_index(size_t i, size_t j) const {
+    assert(i < dim1_ && "i is out of bounds in CSRArray.flat_index()");
+    if(hash_start_ != NULL && hash_start_[i] != hash_start_[i+1]){
+        return hashed_index_find(hash_slots_.get(), hash_start_[i], hash_start_[i+1],
+                                 column_index_.get(), j, nnz_);
+    }
+    return sorted_index_find(column_index_.get(), start_index_[i], start_index_[i+1], j, nnz_);
+}
+
+template<typename T>
+void CSRArray<T>::build_hash_index(size_t min_row_nnz){
+    size_t i, k;
+    // a table per long row, a power of 2 at least twice the row length
+    hash_start_ = std::shared_ptr<size_t []> (new size_t[dim1_ + 1]);
+    hash_start_[0] = 0;
+    for(i = 0; i < dim1_; i++){
+        size_t row_nnz = start_index_[i+1] - start_index_[i];
+        size_t table_size = 0;
+        if(row_nnz > 0 && row_nnz >= min_row_nnz){
+            table_size = 1;
+            while(table_size < 2*row_nnz){
+                table_size *= 2;
+            }
+        }
+        hash_start_[i+1] = hash_start_[i] + table_size;
+    }
+
+    size_t num_slots = hash_start_[dim1_];
+    if(num_slots == 0){
+        hash_start_ = hash_slots_ = NULL;
+        return;
+    }
+    hash_slots_ = std::shared_ptr<size_t []> (new size_t[num_slots]);
+    for(k = 0; k < num_slots; k++){
+        hash_slots_[k] = hashed_index_empty;
+    }
+    for(i = 0; i < dim1_; i++){
+        size_t slot_begin = hash_start_[i];
+        if(hash_start_[i+1] == slot_begin) continue;
+        size_t mask = hash_start_[i+1] - slot_begin - 1;
+        for(k = start_index_[i]; k < start_index_[i+1]; k++){
+            size_t slot = hashed_index_slot(column_index_[k], mask);
+            while(hash_slots_[slot_begin + slot] != hashed_index_empty){
+                slot = (slot + 1) & mask;
+            }
+            hash_slots_[slot_begin + slot] = k;
         }
     }
-    return  nnz_;
 }
 
 // Assumes that data, col_ptrs, and row_ptrs
@@ -4806,44 +6513,12 @@ size_t CSRArray<T>::flat_index(size_t i, size_t j){
 // Returns the data in this csr format but as represented as the appropriatte vectors
 // for a csc format
 template<typename T>
-int CSRArray<T>::toCSC(CArray<T> &data, CArray<size_t> &col_ptrs, CArray<size_t> &row_ptrs ){
-    int nnz_cols[dim2_ + 1];
-    int col_counts[dim2_];
-    int i = 0;
-    // How many elements are each column
-    for(i =0 ; i < dim2_; i++){
-        nnz_cols[i] = 0;
-        col_counts[i] = 0;
-    }
-    nnz_cols[dim2_] = 0;
-    col_ptrs(0) = 0;
-    for(i =0; i < nnz_; i++){
-        nnz_cols[column_index_[i] + 1] += 1;
-    }
-    // What we actually care about is how many elements are
-    // in all the  columns preceeding this column.
-    for(i = 1; i <= dim2_; i++){
-        nnz_cols[i] = nnz_cols[i-1] + nnz_cols[i];
-        col_ptrs(i) = nnz_cols[i];
-    }
-    size_t row = 1;
-    // if b is at A(i,j)  stored in csr format
-    // it needs to go where the where the ith column starts
-    // + how many things we have put in the "window"
-    // we allocated for this column already
-    // For row we simply keep track of what row we are currently in
-    // as we scan through the 1d array of data.
-    for(i = 0; i < nnz_; i++){
-        if(i >= start_index_[row]){
-            row++;
-        }
-        int idx = nnz_cols[column_index_[i]] + col_counts[column_index_[i]];
-        col_counts[column_index_[i]] += 1;
-        data(idx) = array_[i];
-        row_ptrs(idx) = row - 1;
-    }
-    // I return an int because I thought I might need to return an error code
-    // Not sure that is true
+int CSRArray<T>::toCSC(CArray<T> &data, CArray<size_t> &col_ptrs, CArray<size_t> &row_ptrs) const {
+    assert(data.size() >= nnz_ && "data is too small in CSRArray.toCSC()");
+    assert(col_ptrs.size() >= dim2_ + 1 && "col_ptrs needs dim2+1 entries in CSRArray.toCSC()");
+    assert(row_ptrs.size() >= nnz_ && "row_ptrs is too small in CSRArray.toCSC()");
+    sparse_transpose(dim1_, dim2_, start_index_.get(), column_index_.get(), array_.get(),
+                     col_ptrs.pointer(), row_ptrs.pointer(), data.pointer());
     return 0;
 }
 
@@ -4852,108 +6527,331 @@ CSRArray<T>::~CSRArray() {}
 
 // EndCSRArrayy
 
-// 16 CSCArray
+// 15a ViewCSRArray
+// non-owning handle to the data of a CSRArray
 template <typename T>
-class CSCArray
-{
-private: // What ought to be private ?
-    size_t dim1_, dim2_;
+class ViewCSRArray {
+  private:
+    size_t dim1_, dim2_; // dim1_ is number of rows dim2_ is number of columns
     size_t nnz_;
-    std::shared_ptr <T []> array_;
-    std::shared_ptr <size_t[]> start_index_;
-    std::shared_ptr <size_t[]> row_index_;
-    
+    T * array_;
+    size_t * column_index_;
+    size_t * start_index_;
+    const size_t * hash_start_;
+    const size_t * hash_slots_;
+
   public:
 
-      /**
-       * @brief Construct a new empty Sparse Col Array object
-       *
-       */
-      CSCArray();
+    /**
+     * @brief Construct an empty view
+     *
+     */
+    ViewCSRArray();
 
-      /**
-      * @brief Construct a new Sparse Col Array object
-      *
-      * @param array: 1d array of data values in order as read top to bottom, left to right
-      * @param row_index: 1d array that marks what row each element is in
-      * @param start_index: 1d array that marks where the first element of each column starts
-      * @param dim1: number of rows the matrix should have
-      * @param dim2: number of columns the matrix should have
-      */
-      CSCArray(CArray<T> array, CArray<size_t> row_index, CArray<size_t> start_index, size_t dim1, size_t dim2);
+    /**
+     * @brief View existing compressed row data, e.g. from CSRArray::borrow()
+     *
+     * @param array nnz+1 values, the last one is the dummy returned for entries that are not stored
+     * @param column_index column of each stored value
+     * @param start_index dim1+1 offsets where each row starts
+     * @param dim1 number of rows
+     * @param dim2 number of columns
+     * @param hash_start optional per row hash tables, see CSRArray::build_hash_index()
+     * @param hash_slots optional per row hash tables, see CSRArray::build_hash_index()
+     */
+    ViewCSRArray(T *array, size_t *column_index, size_t *start_index, size_t dim1, size_t dim2,
+                 const size_t *hash_start = NULL, const size_t *hash_slots = NULL);
 
-      /**
-       * @brief Access A(i,j). Returns a dummy address with value 0 if A(i,j) is not allocated
-       *
-       * @param i : row
-       * @param j : column
-       * @return T& : address of array_ that corresponds to A(i,j)
-       */
-      T &operator()(size_t i, size_t j) const;
+    /**
+     * @brief Access A(i,j). Returns a dummy address with value 0 if A(i,j) is not alocated
+     */
+    T& operator()(size_t i, size_t j) const;
 
-      /**
-       * @brief Overloaded copy operator
-       *
-       * @param temp : Array to copy
-       * @return CSCArray&
-       */
-      CSCArray &operator=(const CSCArray &temp);
+    T& value(size_t i, size_t j) const;
 
-      T *pointer() const;
+    T* pointer() const;
 
-      /**
-       * @brief Same functionality as nnz(i) included for compatibility with the rest of matar
-       *
-       * @param i : row
-       * @return size_t
-       */
-      size_t stride(size_t i) const;
-      
-      /**
-       * @brief Same functionality as operator() included for compatibility with the rest of matar
-       *
-       * @param i: row
-       * @param j: column
-       * @return T&
-       */
-      T &value(size_t i, size_t j) const;
+    size_t* get_starts() const;
 
-      /**
-       * @brief Get the start_index array
-       *
-       * @return size_t* : returns start_index_
-       */
-      size_t *get_starts() const;
+    size_t* get_columns() const;
 
-      /**
-       * @brief Get number of rows
-       *
-       * @return size_t  number of rows
-       */
-      size_t dim1() const;
-      
-      /**
-       * @brief Get number of columns
-       *
-       * @return size_t number of columns
-       */
-      size_t dim2() const;
+    size_t stride(size_t i) const;
 
-      /**
-       * @brief iterator notation for iterating through the non zeros values of row i.
-       *
-       * @param i : row
-       * @return T*
-       */
-      T *begin(size_t i);
- 
-       /**
-       * @brief iterator notation for iterating through the non zeros values of row i.
-       *
-       * @param i : row
-       * @return T*
-       */
-      T *end(size_t i);
+    size_t dim1() const;
+
+    size_t dim2() const;
+
+    size_t begin_index(size_t i) const;
+    size_t end_index(size_t i) const;
+
+    size_t nnz(size_t i) const;
+    size_t nnz() const;
+
+    T& get_val_flat(size_t k) const;
+    size_t get_col_flat(size_t k) const;
+    size_t flat_index(size_t i, size_t j) const;
+};
+
+template<typename T>
+ViewCSRArray<T>::ViewCSRArray(){
+    dim1_ = dim2_ = nnz_ = 0;
+    array_ = NULL;
+    column_index_ = start_index_ = NULL;
+    hash_start_ = hash_slots_ = NULL;
+}
+
+template<typename T>
+ViewCSRArray<T>::ViewCSRArray(T *array, size_t *column_index, size_t *start_index, size_t dim1, size_t dim2,
+                              const size_t *hash_start, const size_t *hash_slots){
+    dim1_ = dim1;
+    dim2_ = dim2;
+    array_ = array;
+    column_index_ = column_index;
+    start_index_ = start_index;
+    hash_start_ = hash_start;
+    hash_slots_ = hash_slots;
+    nnz_ = start_index_[dim1_];
+}
+
+template<typename T>
+inline T& ViewCSRArray<T>::operator()(size_t i, size_t j) const {
+    size_t k = flat_index(i, j);
+    if(k == nnz_){
+        array_[nnz_] = (T) NULL;
+    }
+    return array_[k];
+}
+
+template<typename T>
+inline T& ViewCSRArray<T>::value(size_t i, size_t j) const {
+    return (*this)(i, j);
+}
+
+template<typename T>
+inline T* ViewCSRArray<T>::pointer() const {
+    return array_;
+}
+
+template<typename T>
+inline size_t* ViewCSRArray<T>::get_starts() const {
+    return start_index_;
+}
+
+template<typename T>
+inline size_t* ViewCSRArray<T>::get_columns() const {
+    return column_index_;
+}
+
+template<typename T>
+inline size_t ViewCSRArray<T>::stride(size_t i) const {
+    assert(i < dim1_ && "Index i out of bounds in ViewCSRArray.stride()");
+    return start_index_[i+1] - start_index_[i];
+}
+
+template<typename T>
+inline size_t ViewCSRArray<T>::dim1() const {
+    return dim1_;
+}
+
+template<typename T>
+inline size_t ViewCSRArray<T>::dim2() const {
+    return dim2_;
+}
+
+template<typename T>
+inline size_t ViewCSRArray<T>::begin_index(size_t i) const {
+    assert(i <= dim1_ && "i is out of bounds in ViewCSRArray.begin_index()");
+    return start_index_[i];
+}
+
+template<typename T>
+inline size_t ViewCSRArray<T>::end_index(size_t i) const {
+    assert(i <= dim1_ && "i is out of bounds in ViewCSRArray.end_index()");
+    return start_index_[i+1];
+}
+
+template<typename T>
+inline size_t ViewCSRArray<T>::nnz(size_t i) const {
+    assert(i < dim1_ && "Index i out of bounds in ViewCSRArray.nnz()");
+    return start_index_[i+1] - start_index_[i];
+}
+
+template<typename T>
+inline size_t ViewCSRArray<T>::nnz() const {
+    return nnz_;
+}
+
+template<typename T>
+inline T& ViewCSRArray<T>::get_val_flat(size_t k) const {
+    assert(k < nnz_ && "Index k is out of bounds in ViewCSRArray.get_val_flat()");
+    return array_[k];
+}
+
+template<typename T>
+inline size_t ViewCSRArray<T>::get_col_flat(size_t k) const {
+    assert(k < nnz_ && "Index k is out of bounds in ViewCSRArray.get_col_flat()");
+    return column_index_[k];
+}
+
+// returns nnz() when A(i,j) is not stored
+template<typename T>
+inline size_t ViewCSRArray<T>::flat_index(size_t i, size_t j) const {
+    assert(i < dim1_ && "i is out of bounds in ViewCSRArray.flat_index()");
+    if(hash_start_ != NULL && hash_start_[i] != hash_start_[i+1]){
+        return hashed_index_find(hash_slots_, hash_start_[i], hash_start_[i+1], column_index_, j, nnz_);
+    }
+    return sorted_index_find(column_index_, start_index_[i], start_index_[i+1], j, nnz_);
+}
+
+// End ViewCSRArray
+
+// 16 CSCArray
+template <typename T>
+class CSCArray
+{
+private: // What ought to be private ?
+    size_t dim1_, dim2_;
+    size_t nnz_;
+    std::shared_ptr <T []> array_;
+    std::shared_ptr <size_t[]> start_index_;
+    std::shared_ptr <size_t[]> row_index_;
+    
+  public:
+
+      /**
+       * @brief Construct a new empty Sparse Col Array object
+       *
+       */
+      CSCArray();
+
+      /**
+      * @brief Construct a new Sparse Col Array object. The entries of each column are sorted by row
+      *
+      * @param array: 1d array of data values in order as read top to bottom, left to right
+      * @param row_index: 1d array that marks what row each element is in
+      * @param start_index: 1d array that marks where the first element of each column starts
+      * @param dim1: number of rows the matrix should have
+      * @param dim2: number of columns the matrix should have
+      */
+      CSCArray(CArray<T> array, CArray<size_t> row_index, CArray<size_t> start_index, size_t dim1, size_t dim2);
+
+      /**
+       * @brief Construct a new Sparse Col Array object holding the same matrix as a CSRArray.
+       * Transposes the storage directly into the new arrays, see CSRArray::toCSC()
+       *
+       * @param csr : matrix to convert
+       */
+      CSCArray(const CSRArray<T> &csr);
+
+      /**
+       * @brief Copy constructor, shares the data of temp
+       *
+       * @param temp : Array to copy
+       */
+      CSCArray(const CSCArray &temp);
+
+      /**
+       * @brief Move constructor, leaves temp empty
+       *
+       * @param temp : Array to move from
+       */
+      CSCArray(CSCArray &&temp) noexcept;
+
+      /**
+       * @brief Access A(i,j). Returns a dummy address with value 0 if A(i,j) is not allocated
+       *
+       * @param i : row
+       * @param j : column
+       * @return T& : address of array_ that corresponds to A(i,j)
+       */
+      T &operator()(size_t i, size_t j) const;
+
+      /**
+       * @brief Overloaded copy operator
+       *
+       * @param temp : Array to copy
+       * @return CSCArray&
+       */
+      CSCArray &operator=(const CSCArray &temp);
+
+      /**
+       * @brief Move assignment operator, leaves temp empty
+       *
+       * @param temp : Array to move from
+       * @return CSCArray&
+       */
+      CSCArray &operator=(CSCArray &&temp) noexcept;
+
+      /**
+       * @brief Non-owning handle to the same data. It does not touch the reference
+       * count and is cheap to pass by value into kernels
+       *
+       * @return ViewCSCArray<T>
+       */
+      ViewCSCArray<T> borrow() const;
+
+      T *pointer() const;
+
+      /**
+       * @brief Same functionality as nnz(i) included for compatibility with the rest of matar
+       *
+       * @param i : row
+       * @return size_t
+       */
+      size_t stride(size_t i) const;
+      
+      /**
+       * @brief Same functionality as operator() included for compatibility with the rest of matar
+       *
+       * @param i: row
+       * @param j: column
+       * @return T&
+       */
+      T &value(size_t i, size_t j) const;
+
+      /**
+       * @brief Get the start_index array
+       *
+       * @return size_t* : returns start_index_
+       */
+      size_t *get_starts() const;
+
+      /**
+       * @brief Get the row_index array, the row of each stored value
+       *
+       * @return size_t* : returns row_index_
+       */
+      size_t *get_rows() const;
+
+      /**
+       * @brief Get number of rows
+       *
+       * @return size_t  number of rows
+       */
+      size_t dim1() const;
+      
+      /**
+       * @brief Get number of columns
+       *
+       * @return size_t number of columns
+       */
+      size_t dim2() const;
+
+      /**
+       * @brief iterator notation for iterating through the non zeros values of row i.
+       *
+       * @param i : row
+       * @return T*
+       */
+      T *begin(size_t i);
+ 
+       /**
+       * @brief iterator notation for iterating through the non zeros values of row i.
+       *
+       * @param i : row
+       * @return T*
+       */
+      T *end(size_t i);
 
       // iterator for the raw data at row i
       // i.e. return the index each element is the index in the 1 array
@@ -4981,8 +6879,16 @@ private: // What ought to be private ?
       size_t get_row_flat(size_t k);
       // reverse map function from A(i,j) to what element of data/col_pt_ it corersponds to
       int flat_index(size_t i, size_t j);
-      // Convertor
-      int toCSR(CArray<T> &data, CArray<size_t> &row_ptrs, CArray<size_t> &col_ptrs);
+      /**
+       * @brief Transpose into CSR form, in parallel when the thread pool is enabled. The column indices
+       * of each row come out sorted
+       *
+       * @param data : nnz() values, row by row
+       * @param col_ptrs : nnz() entries, the column of each value
+       * @param row_ptrs : dim1()+1 entries, where each row starts in data and col_ptrs
+       * @return 0
+       */
+      int toCSR(CArray<T> &data, CArray<size_t> &col_ptrs, CArray<size_t> &row_ptrs) const;
       void to_dense(FArray<T> &A);
       // destructor
       ~CSCArray();
@@ -5012,21 +6918,54 @@ CSCArray<T>::CSCArray(CArray<T> array, CArray<size_t> row_index, CArray<size_t>
         start_index_[i] = start_index(i);
     }
     nnz_ = nnz;
+    for(i = 0; i < dim2_; i++){
+        sorted_index_sort(array_.get(), row_index_.get(), start_index_[i], start_index_[i+1]);
+    }
+}
+
+template <typename T>
+CSCArray<T>::CSCArray(const CSRArray<T> &csr){
+    dim1_ = csr.dim1_;
+    dim2_ = csr.dim2_;
+    nnz_ = csr.nnz_;
+    start_index_ = std::shared_ptr<size_t []> (new size_t[dim2_ + 1]);
+    array_ = std::shared_ptr<T []> (new T[nnz_+1]);
+    row_index_ = std::shared_ptr<size_t []> (new size_t[nnz_]);
+    sparse_transpose(dim1_, dim2_, csr.start_index_.get(), csr.column_index_.get(), csr.array_.get(),
+                     start_index_.get(), row_index_.get(), array_.get());
+}
+
+template<typename T>
+CSCArray<T>::CSCArray(const CSCArray<T> &temp){
+    nnz_ = temp.nnz_;
+    dim1_ = temp.dim1_;
+    dim2_ = temp.dim2_;
+
+    start_index_ = temp.start_index_;
+    row_index_ = temp.row_index_;
+    array_ = temp.array_;
+}
+
+template<typename T>
+CSCArray<T>::CSCArray(CSCArray<T> &&temp) noexcept {
+    nnz_ = temp.nnz_;
+    dim1_ = temp.dim1_;
+    dim2_ = temp.dim2_;
+
+    start_index_ = std::move(temp.start_index_);
+    row_index_ = std::move(temp.row_index_);
+    array_ = std::move(temp.array_);
+    temp.nnz_ = temp.dim1_ = temp.dim2_ = 0;
 }
 
 
 template<typename T>
 T& CSCArray<T>::operator()(size_t i, size_t j) const {
-    size_t col_start = start_index_[j];
-    size_t col_end = start_index_[j + 1];
-    size_t k;
-    for(k =0; k < col_end - col_start;k++){
-        if(row_index_[col_start + k] == i){
-                return array_[col_start + k];
-        }
+    size_t k = sorted_index_find(row_index_.get(), start_index_[j], start_index_[j+1], i, nnz_);
+    if(k == nnz_){
+        array_[nnz_] = (T) NULL;
     }
-    array_[nnz_] = (T) NULL;
-    return array_[nnz_];
+    return array_[k];
 }
 
 template<typename T>
@@ -5036,16 +6975,11 @@ T* CSCArray<T>::pointer() const {
 
 template<typename T>
 T& CSCArray<T>::value(size_t i, size_t j) const {
-    size_t col_start = start_index_[j];
-    size_t col_end = start_index_[j + 1];
-    size_t k;
-    for(k =0; k < col_end - col_start;k++){
-        if(row_index_[col_start + k] == i){
-                return array_[col_start + k];
-        }
+    size_t k = sorted_index_find(row_index_.get(), start_index_[j], start_index_[j+1], i, nnz_);
+    if(k == nnz_){
+        array_[nnz_] = (T) NULL;
     }
-    array_[nnz_] = (T) NULL;
-    return array_[nnz_];
+    return array_[k];
 }
 
 template<typename T>
@@ -5053,20 +6987,45 @@ size_t* CSCArray<T>::get_starts() const{
     return &start_index_[0];
 }
 
+template<typename T>
+size_t* CSCArray<T>::get_rows() const{
+    return row_index_.get();
+}
+
 template<typename T>
 CSCArray<T>& CSCArray<T>::operator=(const CSCArray &temp){
-    if(this != temp) {
+    if(this != &temp) {
         nnz_ = temp.nnz_;
         dim2_ = temp.dim2_;
-        dim1_ = temp.dim1_;;
+        dim1_ = temp.dim1_;
         
         start_index_ = temp.start_index_;
-        row_index_ = temp.row_row_index_;
+        row_index_ = temp.row_index_;
         array_ = temp.array_;
     }
     return *this;
 }
 
+template<typename T>
+CSCArray<T>& CSCArray<T>::operator=(CSCArray &&temp) noexcept {
+    if(this != &temp) {
+        nnz_ = temp.nnz_;
+        dim2_ = temp.dim2_;
+        dim1_ = temp.dim1_;
+
+        start_index_ = std::move(temp.start_index_);
+        row_index_ = std::move(temp.row_index_);
+        array_ = std::move(temp.array_);
+        temp.nnz_ = temp.dim1_ = temp.dim2_ = 0;
+    }
+    return *this;
+}
+
+template<typename T>
+ViewCSCArray<T> CSCArray<T>::borrow() const {
+    return ViewCSCArray<T>(array_.get(), row_index_.get(), start_index_.get(), dim1_, dim2_);
+}
+
 template<typename T>
 size_t CSCArray<T>::stride(size_t i) const{
     assert(i < dim2_ && "i is out of bounds in CSCArray.stride()");
@@ -5143,16 +7102,8 @@ size_t CSCArray<T>::get_row_flat(size_t k){
 
 template<typename T>
 int CSCArray<T>::flat_index(size_t i, size_t j){
-    size_t col_start = start_index_[j];
-    size_t col_end = start_index_[j+1];
-    size_t k;
-    for (k = 0; k < col_end - col_start; k++)
-    {
-        if(row_index_[col_start + k] == i){
-                return col_start + k;
-        }
-    }
-    return  -1;
+    size_t k = sorted_index_find(row_index_.get(), start_index_[j], start_index_[j+1], i, nnz_);
+    return (k == nnz_) ? -1 : (int) k;
 }
 
 // Assumes that data, col_ptrs, and row_ptrs
@@ -5160,44 +7111,12 @@ int CSCArray<T>::flat_index(size_t i, size_t j){
 // Returns the data in this csr format but as represented as the appropriatte vectors
 // for a csc format
 template<typename T>
-int CSCArray<T>::toCSR(CArray<T> &data, CArray<size_t> &col_ptrs, CArray<size_t> &row_ptrs ){
-    int nnz_rows[dim1_ + 1];
-    int row_counts[dim1_];
-    int i = 0;
-    // How many elements are each column
-    for(i =0 ; i < dim1_; i++){
-        nnz_rows[i] = 0;
-        row_counts[i] = 0;
-    }
-    nnz_rows[dim1_] = 0;
-    row_ptrs(i) = 0 ;
-    for(i =0; i < nnz_; i++){
-        nnz_rows[row_index_[i] + 1] += 1;
-    }
-    // What we actually care about is how many elements are
-    // in all the columns preceeding this column.
-    for(i = 1; i < dim1_; i++){
-        nnz_rows[i] = nnz_rows[i-1] + nnz_rows[i];
-        row_ptrs(i) = nnz_rows[i];
-    }
-    size_t col = 1;
-    // if b is at A(i,j)  stored in csr format
-    // it needs to go where the where the ith column starts
-    // + how many things we have put in the "window"
-    // we allocated for this column already
-    // For row we simply keep track of what row we are currently in
-    // as we scan through the 1d array of data.
-    for(i = 0; i < nnz_; i++){
-        if(i >= start_index_[col]){
-            col++;
-        }
-        int idx = nnz_rows[row_index_[i]] + row_counts[row_index_[i]];
-        row_counts[row_index_[i]] += 1;
-        data(idx) = array_[i];
-        col_ptrs(idx) = col - 1;
-    }
-    // I return an int because I thought I might need to return an error code
-    // Not sure that is true
+int CSCArray<T>::toCSR(CArray<T> &data, CArray<size_t> &col_ptrs, CArray<size_t> &row_ptrs) const {
+    assert(data.size() >= nnz_ && "data is too small in CSCArray.toCSR()");
+    assert(col_ptrs.size() >= nnz_ && "col_ptrs is too small in CSCArray.toCSR()");
+    assert(row_ptrs.size() >= dim1_ + 1 && "row_ptrs needs dim1+1 entries in CSCArray.toCSR()");
+    sparse_transpose(dim2_, dim1_, start_index_.get(), row_index_.get(), array_.get(),
+                     row_ptrs.pointer(), col_ptrs.pointer(), data.pointer());
     return 0;
 }
 
@@ -5206,12 +7125,2487 @@ CSCArray<T>::~CSCArray() {}
 
 // End of CSCArray
 
+// 16a ViewCSCArray
+// non-owning handle to the data of a CSCArray
+template <typename T>
+class ViewCSCArray {
+  private:
+    size_t dim1_, dim2_;
+    size_t nnz_;
+    T * array_;
+    size_t * start_index_;
+    size_t * row_index_;
 
-//=======================================================================
+  public:
+
+    /**
+     * @brief Construct an empty view
+     *
+     */
+    ViewCSCArray();
+
+    /**
+     * @brief View existing compressed column data, e.g. from CSCArray::borrow()
+     *
+     * @param array nnz+1 values, the last one is the dummy returned for entries that are not stored
+     * @param row_index row of each stored value
+     * @param start_index dim2+1 offsets where each column starts
+     * @param dim1 number of rows
+     * @param dim2 number of columns
+     */
+    ViewCSCArray(T *array, size_t *row_index, size_t *start_index, size_t dim1, size_t dim2);
+
+    /**
+     * @brief Access A(i,j). Returns a dummy address with value 0 if A(i,j) is not allocated
+     */
+    T &operator()(size_t i, size_t j) const;
+
+    T &value(size_t i, size_t j) const;
+
+    T *pointer() const;
+
+    size_t *get_starts() const;
+
+    size_t *get_rows() const;
+
+    size_t stride(size_t i) const;
+
+    size_t dim1() const;
+
+    size_t dim2() const;
+
+    size_t begin_index(size_t i) const;
+    size_t end_index(size_t i) const;
+
+    size_t nnz(size_t i) const;
+    size_t nnz() const;
+
+    T &get_val_flat(size_t k) const;
+    size_t get_row_flat(size_t k) const;
+    int flat_index(size_t i, size_t j) const;
+};
+
+template<typename T>
+ViewCSCArray<T>::ViewCSCArray(){
+    dim1_ = dim2_ = nnz_ = 0;
+    array_ = NULL;
+    row_index_ = start_index_ = NULL;
+}
+
+template<typename T>
+ViewCSCArray<T>::ViewCSCArray(T *array, size_t *row_index, size_t *start_index, size_t dim1, size_t dim2){
+    dim1_ = dim1;
+    dim2_ = dim2;
+    array_ = array;
+    row_index_ = row_index;
+    start_index_ = start_index;
+    nnz_ = start_index_[dim2_];
+}
+
+template<typename T>
+inline T& ViewCSCArray<T>::operator()(size_t i, size_t j) const {
+    int k = flat_index(i, j);
+    if(k < 0){
+        array_[nnz_] = (T) NULL;
+        return array_[nnz_];
+    }
+    return array_[k];
+}
+
+template<typename T>
+inline T& ViewCSCArray<T>::value(size_t i, size_t j) const {
+    return (*this)(i, j);
+}
+
+template<typename T>
+inline T* ViewCSCArray<T>::pointer() const {
+    return array_;
+}
+
+template<typename T>
+inline size_t* ViewCSCArray<T>::get_starts() const {
+    return start_index_;
+}
+
+template<typename T>
+inline size_t* ViewCSCArray<T>::get_rows() const {
+    return row_index_;
+}
+
+template<typename T>
+inline size_t ViewCSCArray<T>::stride(size_t i) const {
+    assert(i < dim2_ && "i is out of bounds in ViewCSCArray.stride()");
+    return start_index_[i+1] - start_index_[i];
+}
+
+template<typename T>
+inline size_t ViewCSCArray<T>::dim1() const {
+    return dim1_;
+}
+
+template<typename T>
+inline size_t ViewCSCArray<T>::dim2() const {
+    return dim2_;
+}
+
+template<typename T>
+inline size_t ViewCSCArray<T>::begin_index(size_t i) const {
+    assert(i <= dim2_ && "index i out of bounds at ViewCSCArray.begin_index()");
+    return start_index_[i];
+}
+
+template<typename T>
+inline size_t ViewCSCArray<T>::end_index(size_t i) const {
+    assert(i <= dim2_ && "index i out of bounds at ViewCSCArray.end_index()");
+    return start_index_[i+1];
+}
+
+template<typename T>
+inline size_t ViewCSCArray<T>::nnz(size_t i) const {
+    return start_index_[i+1] - start_index_[i];
+}
+
+template<typename T>
+inline size_t ViewCSCArray<T>::nnz() const {
+    return nnz_;
+}
+
+template<typename T>
+inline T& ViewCSCArray<T>::get_val_flat(size_t k) const {
+    return array_[k];
+}
+
+template<typename T>
+inline size_t ViewCSCArray<T>::get_row_flat(size_t k) const {
+    return row_index_[k];
+}
+
+template<typename T>
+inline int ViewCSCArray<T>::flat_index(size_t i, size_t j) const {
+    size_t k = sorted_index_find(row_index_, start_index_[j], start_index_[j+1], i, nnz_);
+    return (k == nnz_) ? -1 : (int) k;
+}
+
+// End of ViewCSCArray
+
+
+// 16b SELLArray
+// Sliced ELLPACK (SELL-C-sigma).  The rows are sorted by length, longest first,
+// within windows of sigma rows and cut into chunks of C rows.  A chunk is stored
+// entry by entry, entry k of its C rows next to each other, and is padded to its
+// longest row with zeros, so a product works on the C rows of a chunk in SIMD
+// lanes.  Sorting puts rows of about the same length in a chunk, which keeps the
+// padding small; sigma = 1 keeps the row order.  C is a template parameter so
+// the lane loops have a constant trip count, e.g.
+//     SELLArray <double> A(csr);        // C = MATAR_SELL_CHUNK, sigma = 32*C
+//     SELLArray <double,4> B(csr, 64);
+// A(i,j) takes the original row numbers.
+
+#ifndef MATAR_SELL_CHUNK
+#define MATAR_SELL_CHUNK 8 // rows per SELLArray chunk, an AVX-512 register of doubles
+#endif
+
+// The SELL-C-sigma layout of compressed rows: the row at each sorted position,
+// the sorted position of each row, the lengths by sorted position and where each
+// chunk starts.  Returns the number of values with the padding.
+inline size_t sell_layout(const size_t *starts, size_t dim1, size_t chunk, size_t sigma,
+                          size_t *row_order, size_t *row_slot, size_t *row_lengths, size_t *chunk_starts) {
+    for(size_t i = 0; i < dim1; i++){
+        row_order[i] = i;
+    }
+    for(size_t w = 0; w < dim1; w += sigma){
+        size_t w_end = w + sigma < dim1 ? w + sigma : dim1;
+        std::stable_sort(row_order + w, row_order + w_end, [starts](size_t a, size_t b) {
+            return starts[a+1] - starts[a] > starts[b+1] - starts[b];
+        });
+    }
+    size_t num_chunks = (dim1 + chunk - 1)/chunk;
+    chunk_starts[0] = 0;
+    for(size_t c = 0; c < num_chunks; c++){
+        size_t width = 0;
+        for(size_t s = c*chunk; s < (c+1)*chunk && s < dim1; s++){
+            size_t i = row_order[s];
+            row_slot[i] = s;
+            row_lengths[s] = starts[i+1] - starts[i];
+            width = row_lengths[s] > width ? row_lengths[s] : width;
+        }
+        chunk_starts[c+1] = chunk_starts[c] + width*chunk;
+    }
+    return chunk_starts[num_chunks];
+}
+
+// Copies compressed rows into the layout from sell_layout.  A padding entry has
+// the value 0 and the last column of its row, so it reads x where the row does.
+template <typename T>
+void sell_fill(const size_t *starts, const size_t *columns, const T *values, size_t dim1, size_t chunk,
+               const size_t *row_order, const size_t *chunk_starts, size_t *sell_columns, T *sell_values) {
+    size_t num_chunks = (dim1 + chunk - 1)/chunk;
+    for(size_t c = 0; c < num_chunks; c++){
+        size_t width = (chunk_starts[c+1] - chunk_starts[c])/chunk;
+        for(size_t r = 0; r < chunk; r++){
+            size_t s = c*chunk + r;
+            size_t begin = 0, length = 0, pad_column = 0;
+            if(s < dim1){
+                begin = starts[row_order[s]];
+                length = starts[row_order[s]+1] - begin;
+                pad_column = length > 0 ? columns[begin + length - 1] : 0;
+            }
+            for(size_t k = 0; k < width; k++){
+                size_t pos = chunk_starts[c] + k*chunk + r;
+                sell_columns[pos] = k < length ? columns[begin + k] : pad_column;
+                sell_values[pos] = k < length ? values[begin + k] : T(0);
+            }
+        }
+    }
+}
+
+// Position of column key among the length sorted columns of a SELL row, which
+// are stride apart from base, or not_found
+SPARSE_INLINE_FUNCTION
+size_t sell_find(const size_t *columns, size_t base, size_t length, size_t stride, size_t key, size_t not_found) {
+    size_t lo = 0;
+    size_t hi = length;
+    while(lo < hi){
+        size_t mid = (lo + hi)/2;
+        if(columns[base + mid*stride] < key){
+            lo = mid + 1;
+        }
+        else{
+            hi = mid;
+        }
+    }
+    return (lo < length && columns[base + lo*stride] == key) ? base + lo*stride : not_found;
+}
+
+template <typename T, size_t C = MATAR_SELL_CHUNK>
+class SELLArray {
+
+    static_assert(C >= 1, "SELLArray chunk height must be at least 1");
+
+  private:
+    size_t dim1_, dim2_;
+    size_t nnz_;        // stored values, without the padding
+    size_t padded_nnz_; // with the padding
+    size_t num_chunks_;
+    size_t sigma_;
+    std::shared_ptr <T []> array_; // padded_nnz_ values and the dummy
+    std::shared_ptr <size_t[]> column_index_;
+    std::shared_ptr <size_t[]> chunk_starts_;
+    std::shared_ptr <size_t[]> row_order_;
+    std::shared_ptr <size_t[]> row_slot_;
+    std::shared_ptr <size_t[]> row_lengths_;
+
+  public:
+
+    /**
+     * @brief Construct an empty SELLArray
+     *
+     */
+    SELLArray();
+
+    /**
+     * @brief Convert a CSRArray
+     *
+     * @param csr the matrix
+     * @param sigma rows sorted together by length, best a multiple of C
+     */
+    SELLArray(const CSRArray<T> &csr, size_t sigma = 32*C);
+
+    /**
+     * @brief Access A(i,j). Returns a dummy address with value 0 if A(i,j) is not stored
+     */
+    T& operator()(size_t i, size_t j) const;
+
+    T& value(size_t i, size_t j) const;
+
+    size_t dim1() const;
+
+    size_t dim2() const;
+
+    size_t nnz() const;
+
+    size_t nnz(size_t i) const;
+
+    /**
+     * @brief Number of stored values with the padding, padded_nnz()/nnz() is the fill overhead
+     */
+    size_t padded_nnz() const;
+
+    size_t num_chunks() const;
+
+    size_t sigma() const;
+
+    static constexpr size_t chunk_height() { return C; }
+
+    // the raw layout, as described above the class
+    T* pointer() const;
+    size_t* get_columns() const;
+    size_t* get_chunk_starts() const;
+    size_t* get_row_order() const;
+    size_t* get_row_lengths() const;
+};
+
+template <typename T, size_t C>
+SELLArray<T,C>::SELLArray() {
+    dim1_ = dim2_ = nnz_ = padded_nnz_ = num_chunks_ = 0;
+    sigma_ = 1;
+}
+
+template <typename T, size_t C>
+SELLArray<T,C>::SELLArray(const CSRArray<T> &csr, size_t sigma) {
+    assert(sigma >= 1 && "sigma must be at least 1 in SELLArray");
+    ViewCSRArray<T> view = csr.borrow();
+    dim1_ = view.dim1();
+    dim2_ = view.dim2();
+    nnz_ = view.nnz();
+    sigma_ = sigma;
+    num_chunks_ = (dim1_ + C - 1)/C;
+    chunk_starts_ = std::shared_ptr<size_t []> (new size_t[num_chunks_ + 1]);
+    row_order_ = std::shared_ptr<size_t []> (new size_t[dim1_ + 1]);
+    row_slot_ = std::shared_ptr<size_t []> (new size_t[dim1_ + 1]);
+    row_lengths_ = std::shared_ptr<size_t []> (new size_t[dim1_ + 1]);
+    padded_nnz_ = sell_layout(view.get_starts(), dim1_, C, sigma_, row_order_.get(), row_slot_.get(),
+                              row_lengths_.get(), chunk_starts_.get());
+    array_ = std::shared_ptr<T []> (new T[padded_nnz_ + 1]);
+    column_index_ = std::shared_ptr<size_t []> (new size_t[padded_nnz_ + 1]);
+    sell_fill(view.get_starts(), view.get_columns(), view.pointer(), dim1_, C, row_order_.get(),
+              chunk_starts_.get(), column_index_.get(), array_.get());
+}
+
+template <typename T, size_t C>
+inline T& SELLArray<T,C>::operator()(size_t i, size_t j) const {
+    assert(i < dim1_ && "i is out of bounds in SELLArray");
+    assert(j < dim2_ && "j is out of bounds in SELLArray");
+    size_t s = row_slot_[i];
+    size_t k = sell_find(column_index_.get(), chunk_starts_[s/C] + s%C, row_lengths_[s], C, j, padded_nnz_);
+    if(k == padded_nnz_){
+        array_[padded_nnz_] = (T) NULL;
+    }
+    return array_[k];
+}
+
+template <typename T, size_t C>
+inline T& SELLArray<T,C>::value(size_t i, size_t j) const {
+    return (*this)(i,j);
+}
+
+template <typename T, size_t C>
+inline size_t SELLArray<T,C>::dim1() const {
+    return dim1_;
+}
+
+template <typename T, size_t C>
+inline size_t SELLArray<T,C>::dim2() const {
+    return dim2_;
+}
+
+template <typename T, size_t C>
+inline size_t SELLArray<T,C>::nnz() const {
+    return nnz_;
+}
+
+template <typename T, size_t C>
+inline size_t SELLArray<T,C>::nnz(size_t i) const {
+    assert(i < dim1_ && "i is out of bounds in SELLArray.nnz()");
+    return row_lengths_[row_slot_[i]];
+}
+
+template <typename T, size_t C>
+inline size_t SELLArray<T,C>::padded_nnz() const {
+    return padded_nnz_;
+}
+
+template <typename T, size_t C>
+inline size_t SELLArray<T,C>::num_chunks() const {
+    return num_chunks_;
+}
+
+template <typename T, size_t C>
+inline size_t SELLArray<T,C>::sigma() const {
+    return sigma_;
+}
+
+template <typename T, size_t C>
+inline T* SELLArray<T,C>::pointer() const {
+    return array_.get();
+}
+
+template <typename T, size_t C>
+inline size_t* SELLArray<T,C>::get_columns() const {
+    return column_index_.get();
+}
+
+template <typename T, size_t C>
+inline size_t* SELLArray<T,C>::get_chunk_starts() const {
+    return chunk_starts_.get();
+}
+
+template <typename T, size_t C>
+inline size_t* SELLArray<T,C>::get_row_order() const {
+    return row_order_.get();
+}
+
+template <typename T, size_t C>
+inline size_t* SELLArray<T,C>::get_row_lengths() const {
+    return row_lengths_.get();
+}
+
+// End of SELLArray
+
+
+// 16c BSRArray
+// Block compressed sparse rows.  The matrix is made of B x B dense blocks and
+// each stored block has one column index, so a 3 x 3 elasticity system keeps
+// one index per 9 values instead of one per value.  The blocks of a block row
+// are sorted by block column, and the values of a block are row major, block k
+// at pointer() + k*B*B.  B is a template parameter so the loops over a block
+// unroll, e.g.
+//     BSRArray <double,3> K(nodes_in_node, num_nodes);   // from connectivity
+//     K.add_block(i, j, k_local);                        // assembly
+//     BSRArray <double,3> A(csr);                        // from a CSRArray
+// A(ib, jb, bi, bj) is row ib*B + bi and column jb*B + bj of the matrix.
+
+// Counts, then fills, the block columns of a BSR pattern.  visit(ib, add)
+// calls add(jb) for each block column of block row ib, repeats allowed.
+// block_starts holds num_block_rows+1 entries and marker block_dim2 entries;
+// with block_columns NULL only block_starts is filled.  Returns the number of
+// blocks.
+template <typename F>
+size_t bsr_pattern(size_t num_block_rows, size_t block_dim2, const F& visit,
+                   size_t *block_starts, size_t *block_columns, size_t *marker) {
+    for(size_t jb = 0; jb < block_dim2; jb++){
+        marker[jb] = num_block_rows;
+    }
+    block_starts[0] = 0;
+    size_t count = 0;
+    for(size_t ib = 0; ib < num_block_rows; ib++){
+        visit(ib, [&](size_t jb) {
+            assert(jb < block_dim2 && "block column is out of bounds in BSRArray");
+            if(marker[jb] != ib){
+                marker[jb] = ib;
+                if(block_columns != NULL){
+                    block_columns[count] = jb;
+                }
+                count++;
+            }
+        });
+        if(block_columns != NULL){
+            std::sort(block_columns + block_starts[ib], block_columns + count);
+        }
+        block_starts[ib+1] = count;
+    }
+    return count;
+}
+
+// Copies compressed rows into the blocks of a BSR pattern from bsr_pattern,
+// which must hold every stored value.  block_values is zeroed first.
+template <typename T>
+void bsr_fill(const size_t *starts, const size_t *columns, const T *values, size_t dim1, size_t block_size,
+              const size_t *block_starts, const size_t *block_columns, T *block_values) {
+    size_t bb = block_size*block_size;
+    size_t num_block_rows = dim1/block_size;
+    for(size_t k = 0; k < block_starts[num_block_rows]*bb; k++){
+        block_values[k] = T(0);
+    }
+    for(size_t i = 0; i < dim1; i++){
+        size_t ib = i/block_size;
+        for(size_t k = starts[i]; k < starts[i+1]; k++){
+            size_t kb = sorted_index_find(block_columns, block_starts[ib], block_starts[ib+1],
+                                          columns[k]/block_size, block_starts[num_block_rows]);
+            block_values[(kb*block_size + i%block_size)*block_size + columns[k]%block_size] = values[k];
+        }
+    }
+}
+
+template <typename T, size_t B>
+class BSRArray {
+
+    static_assert(B >= 1, "BSRArray block size must be at least 1");
+
+  private:
+    size_t block_dim1_, block_dim2_; // number of block rows and block columns
+    size_t nnzb_;                    // number of stored blocks
+    std::shared_ptr <T []> array_;   // nnzb_*B*B values and the dummy
+    std::shared_ptr <size_t[]> column_index_;
+    std::shared_ptr <size_t[]> start_index_;
+
+  public:
+
+    /**
+     * @brief Construct an empty BSRArray
+     *
+     */
+    BSRArray();
+
+    /**
+     * @brief Construct a zero BSRArray with the pattern of a connectivity graph, such as
+     * the nodes around each node, one block per graph edge
+     *
+     * @param connectivity row ib lists the block columns of block row ib, repeats allowed
+     * @param block_dim2 number of block columns
+     * @param with_diagonal also store block (ib,ib), which a graph without self edges lacks
+     */
+    BSRArray(const RaggedRightArray<size_t> &connectivity, size_t block_dim2, bool with_diagonal = true);
+
+    /**
+     * @brief Convert a CSRArray, whose dims must be multiples of B. A block is stored if any
+     * of its values is
+     *
+     * @param csr the matrix
+     */
+    BSRArray(const CSRArray<T> &csr);
+
+    /**
+     * @brief Access value (bi,bj) of block (ib,jb). Returns a dummy address with value 0 if
+     * the block is not stored
+     */
+    T& operator()(size_t ib, size_t jb, size_t bi, size_t bj) const;
+
+    T& value(size_t ib, size_t jb, size_t bi, size_t bj) const;
+
+    /**
+     * @brief Position of block (ib,jb) among the stored blocks, nnzb() if it is not stored
+     */
+    size_t block_index(size_t ib, size_t jb) const;
+
+    /**
+     * @brief Add a B x B matrix into block (ib,jb), which must be stored. Not safe when
+     * two threads add to the same block, so a parallel assembly colors the elements
+     *
+     * @param local any type indexed local(bi,bj), e.g. CArray or CArrayFixed
+     */
+    template <typename M>
+    void add_block(size_t ib, size_t jb, const M &local) const;
+
+    /**
+     * @brief Set every stored value, e.g. to 0 before assembling again
+     */
+    void set_values(T val) const;
+
+    // scalar rows and columns
+    size_t dim1() const;
+    size_t dim2() const;
+
+    size_t block_dim1() const;
+    size_t block_dim2() const;
+
+    // stored blocks, in all and in block row ib
+    size_t nnzb() const;
+    size_t nnzb(size_t ib) const;
+
+    // stored values, nnzb()*B*B
+    size_t nnz() const;
+
+    static constexpr size_t block_size() { return B; }
+
+    // the raw layout, as described above the class
+    T* pointer() const;
+    size_t* get_starts() const;
+    size_t* get_columns() const;
+};
+
+template <typename T, size_t B>
+BSRArray<T,B>::BSRArray() {
+    block_dim1_ = block_dim2_ = nnzb_ = 0;
+}
+
+template <typename T, size_t B>
+BSRArray<T,B>::BSRArray(const RaggedRightArray<size_t> &connectivity, size_t block_dim2, bool with_diagonal) {
+    ViewRaggedRightArray<size_t> graph = connectivity.borrow();
+    block_dim1_ = graph.dim1();
+    block_dim2_ = block_dim2;
+    assert((!with_diagonal || block_dim1_ <= block_dim2_) && "BSRArray diagonal blocks need block_dim2 >= block_dim1");
+    auto visit = [&](size_t ib, const auto &add) {
+        for(size_t k = 0; k < graph.stride(ib); k++){
+            add(graph(ib, k));
+        }
+        if(with_diagonal){
+            add(ib);
+        }
+    };
+    start_index_ = std::shared_ptr<size_t []> (new size_t[block_dim1_ + 1]);
+    std::unique_ptr<size_t []> marker(new size_t[block_dim2_ + 1]);
+    nnzb_ = bsr_pattern(block_dim1_, block_dim2_, visit, start_index_.get(), NULL, marker.get());
+    column_index_ = std::shared_ptr<size_t []> (new size_t[nnzb_ + 1]);
+    bsr_pattern(block_dim1_, block_dim2_, visit, start_index_.get(), column_index_.get(), marker.get());
+    array_ = std::shared_ptr<T []> (new T[nnzb_*B*B + 1]);
+    set_values(T(0));
+}
+
+template <typename T, size_t B>
+BSRArray<T,B>::BSRArray(const CSRArray<T> &csr) {
+    ViewCSRArray<T> view = csr.borrow();
+    assert(view.dim1() % B == 0 && view.dim2() % B == 0 && "BSRArray needs dims that are multiples of B");
+    block_dim1_ = view.dim1()/B;
+    block_dim2_ = view.dim2()/B;
+    const size_t *starts = view.get_starts();
+    const size_t *columns = view.get_columns();
+    auto visit = [&](size_t ib, const auto &add) {
+        for(size_t k = starts[ib*B]; k < starts[(ib+1)*B]; k++){
+            add(columns[k]/B);
+        }
+    };
+    start_index_ = std::shared_ptr<size_t []> (new size_t[block_dim1_ + 1]);
+    std::unique_ptr<size_t []> marker(new size_t[block_dim2_ + 1]);
+    nnzb_ = bsr_pattern(block_dim1_, block_dim2_, visit, start_index_.get(), NULL, marker.get());
+    column_index_ = std::shared_ptr<size_t []> (new size_t[nnzb_ + 1]);
+    bsr_pattern(block_dim1_, block_dim2_, visit, start_index_.get(), column_index_.get(), marker.get());
+    array_ = std::shared_ptr<T []> (new T[nnzb_*B*B + 1]);
+    bsr_fill(starts, columns, view.pointer(), view.dim1(), B, start_index_.get(), column_index_.get(), array_.get());
+}
+
+template <typename T, size_t B>
+inline size_t BSRArray<T,B>::block_index(size_t ib, size_t jb) const {
+    assert(ib < block_dim1_ && "ib is out of bounds in BSRArray");
+    assert(jb < block_dim2_ && "jb is out of bounds in BSRArray");
+    return sorted_index_find(column_index_.get(), start_index_[ib], start_index_[ib+1], jb, nnzb_);
+}
+
+template <typename T, size_t B>
+inline T& BSRArray<T,B>::operator()(size_t ib, size_t jb, size_t bi, size_t bj) const {
+    assert(bi < B && bj < B && "bi or bj is out of the block in BSRArray");
+    size_t k = block_index(ib, jb);
+    if(k == nnzb_){
+        array_[nnzb_*B*B] = (T) NULL;
+        return array_[nnzb_*B*B];
+    }
+    return array_[(k*B + bi)*B + bj];
+}
+
+template <typename T, size_t B>
+inline T& BSRArray<T,B>::value(size_t ib, size_t jb, size_t bi, size_t bj) const {
+    return (*this)(ib, jb, bi, bj);
+}
+
+template <typename T, size_t B>
+template <typename M>
+inline void BSRArray<T,B>::add_block(size_t ib, size_t jb, const M &local) const {
+    size_t k = block_index(ib, jb);
+    assert(k < nnzb_ && "block (ib,jb) is not stored in BSRArray");
+    T *block = array_.get() + k*B*B;
+    for(size_t bi = 0; bi < B; bi++){
+        for(size_t bj = 0; bj < B; bj++){
+            block[bi*B + bj] += local(bi, bj);
+        }
+    }
+}
+
+template <typename T, size_t B>
+void BSRArray<T,B>::set_values(T val) const {
+    for(size_t k = 0; k < nnzb_*B*B; k++){
+        array_[k] = val;
+    }
+}
+
+template <typename T, size_t B>
+inline size_t BSRArray<T,B>::dim1() const {
+    return block_dim1_*B;
+}
+
+template <typename T, size_t B>
+inline size_t BSRArray<T,B>::dim2() const {
+    return block_dim2_*B;
+}
+
+template <typename T, size_t B>
+inline size_t BSRArray<T,B>::block_dim1() const {
+    return block_dim1_;
+}
+
+template <typename T, size_t B>
+inline size_t BSRArray<T,B>::block_dim2() const {
+    return block_dim2_;
+}
+
+template <typename T, size_t B>
+inline size_t BSRArray<T,B>::nnzb() const {
+    return nnzb_;
+}
+
+template <typename T, size_t B>
+inline size_t BSRArray<T,B>::nnzb(size_t ib) const {
+    assert(ib < block_dim1_ && "ib is out of bounds in BSRArray.nnzb()");
+    return start_index_[ib+1] - start_index_[ib];
+}
+
+template <typename T, size_t B>
+inline size_t BSRArray<T,B>::nnz() const {
+    return nnzb_*B*B;
+}
+
+template <typename T, size_t B>
+inline T* BSRArray<T,B>::pointer() const {
+    return array_.get();
+}
+
+template <typename T, size_t B>
+inline size_t* BSRArray<T,B>::get_starts() const {
+    return start_index_.get();
+}
+
+template <typename T, size_t B>
+inline size_t* BSRArray<T,B>::get_columns() const {
+    return column_index_.get();
+}
+
+// End of BSRArray
+
+
+//=======================================================================
 //    end of standard MATAR data-types
 //========================================================================
 
 
+//=======================================================================
+//    fixed-rank MATAR data-types
+//========================================================================
+// Same layouts and index bases as the types above, but the rank is a
+// template parameter and the strides are computed once at construction,
+// so operator() is a plain multiply-add over the indices with no runtime
+// order check, e.g.
+//     CArrayND <double,4> stress(num_elems, num_gauss, 3, 3);
+//     stress(elem, gauss, i, j) = 0.0;
+
+//33. FArrayND
+// indicies are [0:N-1]
+template <typename T, size_t Rank>
+class FArrayND {
+
+    static_assert(Rank >= 1 && Rank <= 7, "FArrayND rank must be between 1 and 7");
+
+private:
+    size_t dims_[Rank];
+    size_t strides_[Rank]; // precomputed in the constructor
+    size_t length_; // Length of 1D array
+    std::shared_ptr <T []> array_;
+
+    void set_strides();
+
+    template <size_t... R>
+    size_t offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const;
+
+    template <size_t... R>
+    ViewFArrayND <T,Rank> borrow(std::index_sequence<R...>) const;
+
+public:
+
+    // Default constructor
+    FArrayND ();
+
+    // --- one dimension per rank ---
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    FArrayND (Dims... dim);
+
+    FArrayND (const FArrayND& temp);
+
+    // Move constructor, leaves temp empty
+    FArrayND (FArrayND&& temp) noexcept;
+
+    // Overload operator(), one index per rank
+    template <typename... Indices>
+    T& operator() (Indices... indices) const;
+
+    // Overload copy assignment operator
+    FArrayND& operator= (const FArrayND& temp);
+
+    // Overload move assignment operator, leaves temp empty
+    FArrayND& operator= (FArrayND&& temp) noexcept;
+
+    //return array size
+    size_t size() const;
+
+    // return array dims
+    size_t dims(size_t i) const;
+
+    // return array order (rank)
+    size_t order() const;
+
+    //return pointer
+    T* pointer() const;
+
+    // return a non-owning ViewFArrayND of the same data, it does not
+    // touch the reference count and is cheap to pass by value
+    ViewFArrayND <T,Rank> borrow() const;
+
+    // Deconstructor
+    ~FArrayND ();
+
+}; // End of FArrayND
+
+//---FArrayND class definitions----
+
+//no dim
+template <typename T, size_t Rank>
+FArrayND<T,Rank>::FArrayND() {
+    array_ = NULL;
+    length_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = 0;
+        strides_[r] = 0;
+    }
+}
+
+// one dimension per rank
+template <typename T, size_t Rank>
+template <typename... Dims, typename>
+FArrayND<T,Rank>::FArrayND(Dims... dim) {
+    static_assert(sizeof...(Dims) == Rank, "Number of dims does not match the rank of FArrayND!");
+    const size_t dims_in[Rank] = {static_cast<size_t>(dim)...};
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = dims_in[r];
+    }
+    set_strides();
+    array_ = std::shared_ptr <T[]> (new T[length_]);
+}
+
+// copy constructor
+template <typename T, size_t Rank>
+FArrayND<T,Rank>::FArrayND(const FArrayND& temp) {
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = temp.dims_[r];
+        strides_[r] = temp.strides_[r];
+    }
+    length_ = temp.length_;
+    array_ = temp.array_;
+}
+
+// move constructor
+template <typename T, size_t Rank>
+FArrayND<T,Rank>::FArrayND(FArrayND&& temp) noexcept {
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = temp.dims_[r];
+        strides_[r] = temp.strides_[r];
+        temp.dims_[r] = temp.strides_[r] = 0;
+    }
+    length_ = temp.length_;
+    array_ = std::move(temp.array_);
+    temp.length_ = 0;
+}
+
+// column-major: the first index is contiguous
+template <typename T, size_t Rank>
+inline void FArrayND<T,Rank>::set_strides() {
+    length_ = 1;
+    for (size_t r = 0; r < Rank; r++) {
+        strides_[r] = length_;
+        length_ *= dims_[r];
+    }
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+inline T& FArrayND<T,Rank>::operator() (Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of FArrayND!");
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] < dims_[r] && "index is out of bounds in FArrayND!");
+    }
+    return array_[offset(idx, std::make_index_sequence<Rank-1>())];
+}
+
+// unrolled at compile time, the first index has unit stride
+template <typename T, size_t Rank>
+template <size_t... R>
+inline size_t FArrayND<T,Rank>::offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const {
+    return idx[0] + ((idx[R+1] * strides_[R+1]) + ... + 0);
+}
+
+template <typename T, size_t Rank>
+inline FArrayND<T,Rank>& FArrayND<T,Rank>::operator= (const FArrayND& temp) {
+    if (this != &temp) {
+        for (size_t r = 0; r < Rank; r++) {
+            dims_[r] = temp.dims_[r];
+            strides_[r] = temp.strides_[r];
+        }
+        length_ = temp.length_;
+        array_ = temp.array_;
+    }
+    return *this;
+}
+
+template <typename T, size_t Rank>
+inline FArrayND<T,Rank>& FArrayND<T,Rank>::operator= (FArrayND&& temp) noexcept {
+    if (this != &temp) {
+        for (size_t r = 0; r < Rank; r++) {
+            dims_[r] = temp.dims_[r];
+            strides_[r] = temp.strides_[r];
+            temp.dims_[r] = temp.strides_[r] = 0;
+        }
+        length_ = temp.length_;
+        array_ = std::move(temp.array_);
+        temp.length_ = 0;
+    }
+    return *this;
+}
+
+//return size
+template <typename T, size_t Rank>
+inline size_t FArrayND<T,Rank>::size() const {
+    return length_;
+}
+
+template <typename T, size_t Rank>
+inline size_t FArrayND<T,Rank>::dims(size_t i) const {
+    assert(i < Rank && "FArrayND order (rank) does not match constructor, dim[i] does not exist!");
+    assert(dims_[i]>0 && "Access to FArrayND dims is out of bounds!");
+    return dims_[i];
+}
+
+template <typename T, size_t Rank>
+inline size_t FArrayND<T,Rank>::order() const {
+    return Rank;
+}
+
+template <typename T, size_t Rank>
+inline T* FArrayND<T,Rank>::pointer() const {
+    return array_.get();
+}
+
+template <typename T, size_t Rank>
+inline ViewFArrayND<T,Rank> FArrayND<T,Rank>::borrow() const {
+    return borrow(std::make_index_sequence<Rank>());
+}
+
+template <typename T, size_t Rank>
+template <size_t... R>
+inline ViewFArrayND<T,Rank> FArrayND<T,Rank>::borrow(std::index_sequence<R...>) const {
+    return ViewFArrayND <T,Rank> (array_.get(), dims_[R]...);
+}
+
+//destructor
+template <typename T, size_t Rank>
+FArrayND<T,Rank>::~FArrayND() {}
+
+// End of FArrayND
+
+
+//34. ViewFArrayND
+// indicies are [0:N-1]
+template <typename T, size_t Rank>
+class ViewFArrayND {
+
+    static_assert(Rank >= 1 && Rank <= 7, "ViewFArrayND rank must be between 1 and 7");
+
+private:
+    size_t dims_[Rank];
+    size_t strides_[Rank]; // precomputed in the constructor
+    size_t length_; // Length of 1D array
+    T * array_;
+
+    void set_strides();
+
+    template <size_t... R>
+    size_t offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const;
+
+public:
+
+    // Default constructor
+    ViewFArrayND ();
+
+    // --- one dimension per rank ---
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    ViewFArrayND (T *some_array, Dims... dim);
+
+    // Overload operator(), one index per rank
+    template <typename... Indices>
+    T& operator() (Indices... indices) const;
+
+    //return array size
+    size_t size() const;
+
+    // return array dims
+    size_t dims(size_t i) const;
+
+    // return array order (rank)
+    size_t order() const;
+
+    //return pointer
+    T* pointer() const;
+
+}; // End of ViewFArrayND
+
+//---ViewFArrayND class definitions----
+
+//no dim
+template <typename T, size_t Rank>
+ViewFArrayND<T,Rank>::ViewFArrayND() {
+    array_ = NULL;
+    length_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = 0;
+        strides_[r] = 0;
+    }
+}
+
+// one dimension per rank
+template <typename T, size_t Rank>
+template <typename... Dims, typename>
+ViewFArrayND<T,Rank>::ViewFArrayND(T *some_array, Dims... dim) {
+    static_assert(sizeof...(Dims) == Rank, "Number of dims does not match the rank of ViewFArrayND!");
+    const size_t dims_in[Rank] = {static_cast<size_t>(dim)...};
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = dims_in[r];
+    }
+    set_strides();
+    array_ = some_array;
+}
+
+// column-major: the first index is contiguous
+template <typename T, size_t Rank>
+inline void ViewFArrayND<T,Rank>::set_strides() {
+    length_ = 1;
+    for (size_t r = 0; r < Rank; r++) {
+        strides_[r] = length_;
+        length_ *= dims_[r];
+    }
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+inline T& ViewFArrayND<T,Rank>::operator() (Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of ViewFArrayND!");
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] < dims_[r] && "index is out of bounds in ViewFArrayND!");
+    }
+    return array_[offset(idx, std::make_index_sequence<Rank-1>())];
+}
+
+// unrolled at compile time, the first index has unit stride
+template <typename T, size_t Rank>
+template <size_t... R>
+inline size_t ViewFArrayND<T,Rank>::offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const {
+    return idx[0] + ((idx[R+1] * strides_[R+1]) + ... + 0);
+}
+
+//return size
+template <typename T, size_t Rank>
+inline size_t ViewFArrayND<T,Rank>::size() const {
+    return length_;
+}
+
+template <typename T, size_t Rank>
+inline size_t ViewFArrayND<T,Rank>::dims(size_t i) const {
+    assert(i < Rank && "ViewFArrayND order (rank) does not match constructor, dim[i] does not exist!");
+    assert(dims_[i]>0 && "Access to ViewFArrayND dims is out of bounds!");
+    return dims_[i];
+}
+
+template <typename T, size_t Rank>
+inline size_t ViewFArrayND<T,Rank>::order() const {
+    return Rank;
+}
+
+template <typename T, size_t Rank>
+inline T* ViewFArrayND<T,Rank>::pointer() const {
+    return array_;
+}
+
+// End of ViewFArrayND
+
+
+//35. FMatrixND
+// indicies are [1:N]
+template <typename T, size_t Rank>
+class FMatrixND {
+
+    static_assert(Rank >= 1 && Rank <= 7, "FMatrixND rank must be between 1 and 7");
+
+private:
+    size_t dims_[Rank];
+    size_t strides_[Rank]; // precomputed in the constructor
+    size_t base_;          // sum of strides_, removes the 1-based shift
+    size_t length_; // Length of 1D array
+    std::shared_ptr <T []> matrix_;
+
+    void set_strides();
+
+    template <size_t... R>
+    size_t offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const;
+
+    template <size_t... R>
+    ViewFMatrixND <T,Rank> borrow(std::index_sequence<R...>) const;
+
+public:
+
+    // Default constructor
+    FMatrixND ();
+
+    // --- one dimension per rank ---
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    FMatrixND (Dims... dim);
+
+    FMatrixND (const FMatrixND& temp);
+
+    // Move constructor, leaves temp empty
+    FMatrixND (FMatrixND&& temp) noexcept;
+
+    // Overload operator(), one index per rank
+    template <typename... Indices>
+    T& operator() (Indices... indices) const;
+
+    // Overload copy assignment operator
+    FMatrixND& operator= (const FMatrixND& temp);
+
+    // Overload move assignment operator, leaves temp empty
+    FMatrixND& operator= (FMatrixND&& temp) noexcept;
+
+    //return array size
+    size_t size() const;
+
+    // return array dims
+    size_t dims(size_t i) const;
+
+    // return array order (rank)
+    size_t order() const;
+
+    //return pointer
+    T* pointer() const;
+
+    // return a non-owning ViewFMatrixND of the same data, it does not
+    // touch the reference count and is cheap to pass by value
+    ViewFMatrixND <T,Rank> borrow() const;
+
+    // Deconstructor
+    ~FMatrixND ();
+
+}; // End of FMatrixND
+
+//---FMatrixND class definitions----
+
+//no dim
+template <typename T, size_t Rank>
+FMatrixND<T,Rank>::FMatrixND() {
+    matrix_ = NULL;
+    length_ = 0;
+    base_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = 0;
+        strides_[r] = 0;
+    }
+}
+
+// one dimension per rank
+template <typename T, size_t Rank>
+template <typename... Dims, typename>
+FMatrixND<T,Rank>::FMatrixND(Dims... dim) {
+    static_assert(sizeof...(Dims) == Rank, "Number of dims does not match the rank of FMatrixND!");
+    const size_t dims_in[Rank] = {static_cast<size_t>(dim)...};
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = dims_in[r];
+    }
+    set_strides();
+    matrix_ = std::shared_ptr <T[]> (new T[length_]);
+}
+
+// copy constructor
+template <typename T, size_t Rank>
+FMatrixND<T,Rank>::FMatrixND(const FMatrixND& temp) {
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = temp.dims_[r];
+        strides_[r] = temp.strides_[r];
+    }
+    base_ = temp.base_;
+    length_ = temp.length_;
+    matrix_ = temp.matrix_;
+}
+
+// move constructor
+template <typename T, size_t Rank>
+FMatrixND<T,Rank>::FMatrixND(FMatrixND&& temp) noexcept {
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = temp.dims_[r];
+        strides_[r] = temp.strides_[r];
+        temp.dims_[r] = temp.strides_[r] = 0;
+    }
+    base_ = temp.base_;
+    length_ = temp.length_;
+    matrix_ = std::move(temp.matrix_);
+    temp.length_ = 0;
+}
+
+// column-major: the first index is contiguous
+template <typename T, size_t Rank>
+inline void FMatrixND<T,Rank>::set_strides() {
+    length_ = 1;
+    for (size_t r = 0; r < Rank; r++) {
+        strides_[r] = length_;
+        length_ *= dims_[r];
+    }
+    base_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        base_ += strides_[r];
+    }
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+inline T& FMatrixND<T,Rank>::operator() (Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of FMatrixND!");
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] >= 1 && idx[r] <= dims_[r] && "index is out of bounds in FMatrixND!");
+    }
+    return matrix_[offset(idx, std::make_index_sequence<Rank-1>()) - base_];
+}
+
+// unrolled at compile time, the first index has unit stride
+template <typename T, size_t Rank>
+template <size_t... R>
+inline size_t FMatrixND<T,Rank>::offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const {
+    return idx[0] + ((idx[R+1] * strides_[R+1]) + ... + 0);
+}
+
+template <typename T, size_t Rank>
+inline FMatrixND<T,Rank>& FMatrixND<T,Rank>::operator= (const FMatrixND& temp) {
+    if (this != &temp) {
+        for (size_t r = 0; r < Rank; r++) {
+            dims_[r] = temp.dims_[r];
+            strides_[r] = temp.strides_[r];
+        }
+        base_ = temp.base_;
+        length_ = temp.length_;
+        matrix_ = temp.matrix_;
+    }
+    return *this;
+}
+
+template <typename T, size_t Rank>
+inline FMatrixND<T,Rank>& FMatrixND<T,Rank>::operator= (FMatrixND&& temp) noexcept {
+    if (this != &temp) {
+        for (size_t r = 0; r < Rank; r++) {
+            dims_[r] = temp.dims_[r];
+            strides_[r] = temp.strides_[r];
+            temp.dims_[r] = temp.strides_[r] = 0;
+        }
+        base_ = temp.base_;
+        length_ = temp.length_;
+        matrix_ = std::move(temp.matrix_);
+        temp.length_ = 0;
+    }
+    return *this;
+}
+
+//return size
+template <typename T, size_t Rank>
+inline size_t FMatrixND<T,Rank>::size() const {
+    return length_;
+}
+
+template <typename T, size_t Rank>
+inline size_t FMatrixND<T,Rank>::dims(size_t i) const {
+    i--; // i starts at 1
+    assert(i < Rank && "FMatrixND order (rank) does not match constructor, dim[i] does not exist!");
+    assert(dims_[i]>0 && "Access to FMatrixND dims is out of bounds!");
+    return dims_[i];
+}
+
+template <typename T, size_t Rank>
+inline size_t FMatrixND<T,Rank>::order() const {
+    return Rank;
+}
+
+template <typename T, size_t Rank>
+inline T* FMatrixND<T,Rank>::pointer() const {
+    return matrix_.get();
+}
+
+template <typename T, size_t Rank>
+inline ViewFMatrixND<T,Rank> FMatrixND<T,Rank>::borrow() const {
+    return borrow(std::make_index_sequence<Rank>());
+}
+
+template <typename T, size_t Rank>
+template <size_t... R>
+inline ViewFMatrixND<T,Rank> FMatrixND<T,Rank>::borrow(std::index_sequence<R...>) const {
+    return ViewFMatrixND <T,Rank> (matrix_.get(), dims_[R]...);
+}
+
+//destructor
+template <typename T, size_t Rank>
+FMatrixND<T,Rank>::~FMatrixND() {}
+
+// End of FMatrixND
+
+
+//36. ViewFMatrixND
+// indicies are [1:N]
+template <typename T, size_t Rank>
+class ViewFMatrixND {
+
+    static_assert(Rank >= 1 && Rank <= 7, "ViewFMatrixND rank must be between 1 and 7");
+
+private:
+    size_t dims_[Rank];
+    size_t strides_[Rank]; // precomputed in the constructor
+    size_t base_;          // sum of strides_, removes the 1-based shift
+    size_t length_; // Length of 1D array
+    T * matrix_;
+
+    void set_strides();
+
+    template <size_t... R>
+    size_t offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const;
+
+public:
+
+    // Default constructor
+    ViewFMatrixND ();
+
+    // --- one dimension per rank ---
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    ViewFMatrixND (T *some_matrix, Dims... dim);
+
+    // Overload operator(), one index per rank
+    template <typename... Indices>
+    T& operator() (Indices... indices) const;
+
+    //return array size
+    size_t size() const;
+
+    // return array dims
+    size_t dims(size_t i) const;
+
+    // return array order (rank)
+    size_t order() const;
+
+    //return pointer
+    T* pointer() const;
+
+}; // End of ViewFMatrixND
+
+//---ViewFMatrixND class definitions----
+
+//no dim
+template <typename T, size_t Rank>
+ViewFMatrixND<T,Rank>::ViewFMatrixND() {
+    matrix_ = NULL;
+    length_ = 0;
+    base_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = 0;
+        strides_[r] = 0;
+    }
+}
+
+// one dimension per rank
+template <typename T, size_t Rank>
+template <typename... Dims, typename>
+ViewFMatrixND<T,Rank>::ViewFMatrixND(T *some_matrix, Dims... dim) {
+    static_assert(sizeof...(Dims) == Rank, "Number of dims does not match the rank of ViewFMatrixND!");
+    const size_t dims_in[Rank] = {static_cast<size_t>(dim)...};
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = dims_in[r];
+    }
+    set_strides();
+    matrix_ = some_matrix;
+}
+
+// column-major: the first index is contiguous
+template <typename T, size_t Rank>
+inline void ViewFMatrixND<T,Rank>::set_strides() {
+    length_ = 1;
+    for (size_t r = 0; r < Rank; r++) {
+        strides_[r] = length_;
+        length_ *= dims_[r];
+    }
+    base_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        base_ += strides_[r];
+    }
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+inline T& ViewFMatrixND<T,Rank>::operator() (Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of ViewFMatrixND!");
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] >= 1 && idx[r] <= dims_[r] && "index is out of bounds in ViewFMatrixND!");
+    }
+    return matrix_[offset(idx, std::make_index_sequence<Rank-1>()) - base_];
+}
+
+// unrolled at compile time, the first index has unit stride
+template <typename T, size_t Rank>
+template <size_t... R>
+inline size_t ViewFMatrixND<T,Rank>::offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const {
+    return idx[0] + ((idx[R+1] * strides_[R+1]) + ... + 0);
+}
+
+//return size
+template <typename T, size_t Rank>
+inline size_t ViewFMatrixND<T,Rank>::size() const {
+    return length_;
+}
+
+template <typename T, size_t Rank>
+inline size_t ViewFMatrixND<T,Rank>::dims(size_t i) const {
+    i--; // i starts at 1
+    assert(i < Rank && "ViewFMatrixND order (rank) does not match constructor, dim[i] does not exist!");
+    assert(dims_[i]>0 && "Access to ViewFMatrixND dims is out of bounds!");
+    return dims_[i];
+}
+
+template <typename T, size_t Rank>
+inline size_t ViewFMatrixND<T,Rank>::order() const {
+    return Rank;
+}
+
+template <typename T, size_t Rank>
+inline T* ViewFMatrixND<T,Rank>::pointer() const {
+    return matrix_;
+}
+
+// End of ViewFMatrixND
+
+
+//37. CArrayND
+// indicies are [0:N-1]
+template <typename T, size_t Rank>
+class CArrayND {
+
+    static_assert(Rank >= 1 && Rank <= 7, "CArrayND rank must be between 1 and 7");
+
+private:
+    size_t dims_[Rank];
+    size_t strides_[Rank]; // precomputed in the constructor
+    size_t length_; // Length of 1D array
+    std::shared_ptr <T []> array_;
+
+    void set_strides();
+
+    template <size_t... R>
+    size_t offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const;
+
+    template <size_t... R>
+    ViewCArrayND <T,Rank> borrow(std::index_sequence<R...>) const;
+
+public:
+
+    // Default constructor
+    CArrayND ();
+
+    // --- one dimension per rank ---
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    CArrayND (Dims... dim);
+
+    CArrayND (const CArrayND& temp);
+
+    // Move constructor, leaves temp empty
+    CArrayND (CArrayND&& temp) noexcept;
+
+    // Overload operator(), one index per rank
+    template <typename... Indices>
+    T& operator() (Indices... indices) const;
+
+    // Overload copy assignment operator
+    CArrayND& operator= (const CArrayND& temp);
+
+    // Overload move assignment operator, leaves temp empty
+    CArrayND& operator= (CArrayND&& temp) noexcept;
+
+    //return array size
+    size_t size() const;
+
+    // return array dims
+    size_t dims(size_t i) const;
+
+    // return array order (rank)
+    size_t order() const;
+
+    //return pointer
+    T* pointer() const;
+
+    // return a non-owning ViewCArrayND of the same data, it does not
+    // touch the reference count and is cheap to pass by value
+    ViewCArrayND <T,Rank> borrow() const;
+
+    // Deconstructor
+    ~CArrayND ();
+
+}; // End of CArrayND
+
+//---CArrayND class definitions----
+
+//no dim
+template <typename T, size_t Rank>
+CArrayND<T,Rank>::CArrayND() {
+    array_ = NULL;
+    length_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = 0;
+        strides_[r] = 0;
+    }
+}
+
+// one dimension per rank
+template <typename T, size_t Rank>
+template <typename... Dims, typename>
+CArrayND<T,Rank>::CArrayND(Dims... dim) {
+    static_assert(sizeof...(Dims) == Rank, "Number of dims does not match the rank of CArrayND!");
+    const size_t dims_in[Rank] = {static_cast<size_t>(dim)...};
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = dims_in[r];
+    }
+    set_strides();
+    array_ = std::shared_ptr <T[]> (new T[length_]);
+}
+
+// copy constructor
+template <typename T, size_t Rank>
+CArrayND<T,Rank>::CArrayND(const CArrayND& temp) {
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = temp.dims_[r];
+        strides_[r] = temp.strides_[r];
+    }
+    length_ = temp.length_;
+    array_ = temp.array_;
+}
+
+// move constructor
+template <typename T, size_t Rank>
+CArrayND<T,Rank>::CArrayND(CArrayND&& temp) noexcept {
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = temp.dims_[r];
+        strides_[r] = temp.strides_[r];
+        temp.dims_[r] = temp.strides_[r] = 0;
+    }
+    length_ = temp.length_;
+    array_ = std::move(temp.array_);
+    temp.length_ = 0;
+}
+
+// row-major: the last index is contiguous
+template <typename T, size_t Rank>
+inline void CArrayND<T,Rank>::set_strides() {
+    length_ = 1;
+    for (size_t r = Rank; r-- > 0; ) {
+        strides_[r] = length_;
+        length_ *= dims_[r];
+    }
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+inline T& CArrayND<T,Rank>::operator() (Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of CArrayND!");
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] < dims_[r] && "index is out of bounds in CArrayND!");
+    }
+    return array_[offset(idx, std::make_index_sequence<Rank-1>())];
+}
+
+// unrolled at compile time, the last index has unit stride
+template <typename T, size_t Rank>
+template <size_t... R>
+inline size_t CArrayND<T,Rank>::offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const {
+    return idx[Rank-1] + ((idx[R] * strides_[R]) + ... + 0);
+}
+
+template <typename T, size_t Rank>
+inline CArrayND<T,Rank>& CArrayND<T,Rank>::operator= (const CArrayND& temp) {
+    if (this != &temp) {
+        for (size_t r = 0; r < Rank; r++) {
+            dims_[r] = temp.dims_[r];
+            strides_[r] = temp.strides_[r];
+        }
+        length_ = temp.length_;
+        array_ = temp.array_;
+    }
+    return *this;
+}
+
+template <typename T, size_t Rank>
+inline CArrayND<T,Rank>& CArrayND<T,Rank>::operator= (CArrayND&& temp) noexcept {
+    if (this != &temp) {
+        for (size_t r = 0; r < Rank; r++) {
+            dims_[r] = temp.dims_[r];
+            strides_[r] = temp.strides_[r];
+            temp.dims_[r] = temp.strides_[r] = 0;
+        }
+        length_ = temp.length_;
+        array_ = std::move(temp.array_);
+        temp.length_ = 0;
+    }
+    return *this;
+}
+
+//return size
+template <typename T, size_t Rank>
+inline size_t CArrayND<T,Rank>::size() const {
+    return length_;
+}
+
+template <typename T, size_t Rank>
+inline size_t CArrayND<T,Rank>::dims(size_t i) const {
+    assert(i < Rank && "CArrayND order (rank) does not match constructor, dim[i] does not exist!");
+    assert(dims_[i]>0 && "Access to CArrayND dims is out of bounds!");
+    return dims_[i];
+}
+
+template <typename T, size_t Rank>
+inline size_t CArrayND<T,Rank>::order() const {
+    return Rank;
+}
+
+template <typename T, size_t Rank>
+inline T* CArrayND<T,Rank>::pointer() const {
+    return array_.get();
+}
+
+template <typename T, size_t Rank>
+inline ViewCArrayND<T,Rank> CArrayND<T,Rank>::borrow() const {
+    return borrow(std::make_index_sequence<Rank>());
+}
+
+template <typename T, size_t Rank>
+template <size_t... R>
+inline ViewCArrayND<T,Rank> CArrayND<T,Rank>::borrow(std::index_sequence<R...>) const {
+    return ViewCArrayND <T,Rank> (array_.get(), dims_[R]...);
+}
+
+//destructor
+template <typename T, size_t Rank>
+CArrayND<T,Rank>::~CArrayND() {}
+
+// End of CArrayND
+
+
+//38. ViewCArrayND
+// indicies are [0:N-1]
+template <typename T, size_t Rank>
+class ViewCArrayND {
+
+    static_assert(Rank >= 1 && Rank <= 7, "ViewCArrayND rank must be between 1 and 7");
+
+private:
+    size_t dims_[Rank];
+    size_t strides_[Rank]; // precomputed in the constructor
+    size_t length_; // Length of 1D array
+    T * array_;
+
+    void set_strides();
+
+    template <size_t... R>
+    size_t offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const;
+
+public:
+
+    // Default constructor
+    ViewCArrayND ();
+
+    // --- one dimension per rank ---
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    ViewCArrayND (T *some_array, Dims... dim);
+
+    // Overload operator(), one index per rank
+    template <typename... Indices>
+    T& operator() (Indices... indices) const;
+
+    //return array size
+    size_t size() const;
+
+    // return array dims
+    size_t dims(size_t i) const;
+
+    // return array order (rank)
+    size_t order() const;
+
+    //return pointer
+    T* pointer() const;
+
+}; // End of ViewCArrayND
+
+//---ViewCArrayND class definitions----
+
+//no dim
+template <typename T, size_t Rank>
+ViewCArrayND<T,Rank>::ViewCArrayND() {
+    array_ = NULL;
+    length_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = 0;
+        strides_[r] = 0;
+    }
+}
+
+// one dimension per rank
+template <typename T, size_t Rank>
+template <typename... Dims, typename>
+ViewCArrayND<T,Rank>::ViewCArrayND(T *some_array, Dims... dim) {
+    static_assert(sizeof...(Dims) == Rank, "Number of dims does not match the rank of ViewCArrayND!");
+    const size_t dims_in[Rank] = {static_cast<size_t>(dim)...};
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = dims_in[r];
+    }
+    set_strides();
+    array_ = some_array;
+}
+
+// row-major: the last index is contiguous
+template <typename T, size_t Rank>
+inline void ViewCArrayND<T,Rank>::set_strides() {
+    length_ = 1;
+    for (size_t r = Rank; r-- > 0; ) {
+        strides_[r] = length_;
+        length_ *= dims_[r];
+    }
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+inline T& ViewCArrayND<T,Rank>::operator() (Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of ViewCArrayND!");
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] < dims_[r] && "index is out of bounds in ViewCArrayND!");
+    }
+    return array_[offset(idx, std::make_index_sequence<Rank-1>())];
+}
+
+// unrolled at compile time, the last index has unit stride
+template <typename T, size_t Rank>
+template <size_t... R>
+inline size_t ViewCArrayND<T,Rank>::offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const {
+    return idx[Rank-1] + ((idx[R] * strides_[R]) + ... + 0);
+}
+
+//return size
+template <typename T, size_t Rank>
+inline size_t ViewCArrayND<T,Rank>::size() const {
+    return length_;
+}
+
+template <typename T, size_t Rank>
+inline size_t ViewCArrayND<T,Rank>::dims(size_t i) const {
+    assert(i < Rank && "ViewCArrayND order (rank) does not match constructor, dim[i] does not exist!");
+    assert(dims_[i]>0 && "Access to ViewCArrayND dims is out of bounds!");
+    return dims_[i];
+}
+
+template <typename T, size_t Rank>
+inline size_t ViewCArrayND<T,Rank>::order() const {
+    return Rank;
+}
+
+template <typename T, size_t Rank>
+inline T* ViewCArrayND<T,Rank>::pointer() const {
+    return array_;
+}
+
+// End of ViewCArrayND
+
+
+//39. CMatrixND
+// indicies are [1:N]
+template <typename T, size_t Rank>
+class CMatrixND {
+
+    static_assert(Rank >= 1 && Rank <= 7, "CMatrixND rank must be between 1 and 7");
+
+private:
+    size_t dims_[Rank];
+    size_t strides_[Rank]; // precomputed in the constructor
+    size_t base_;          // sum of strides_, removes the 1-based shift
+    size_t length_; // Length of 1D array
+    std::shared_ptr <T []> matrix_;
+
+    void set_strides();
+
+    template <size_t... R>
+    size_t offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const;
+
+    template <size_t... R>
+    ViewCMatrixND <T,Rank> borrow(std::index_sequence<R...>) const;
+
+public:
+
+    // Default constructor
+    CMatrixND ();
+
+    // --- one dimension per rank ---
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    CMatrixND (Dims... dim);
+
+    CMatrixND (const CMatrixND& temp);
+
+    // Move constructor, leaves temp empty
+    CMatrixND (CMatrixND&& temp) noexcept;
+
+    // Overload operator(), one index per rank
+    template <typename... Indices>
+    T& operator() (Indices... indices) const;
+
+    // Overload copy assignment operator
+    CMatrixND& operator= (const CMatrixND& temp);
+
+    // Overload move assignment operator, leaves temp empty
+    CMatrixND& operator= (CMatrixND&& temp) noexcept;
+
+    //return array size
+    size_t size() const;
+
+    // return array dims
+    size_t dims(size_t i) const;
+
+    // return array order (rank)
+    size_t order() const;
+
+    //return pointer
+    T* pointer() const;
+
+    // return a non-owning ViewCMatrixND of the same data, it does not
+    // touch the reference count and is cheap to pass by value
+    ViewCMatrixND <T,Rank> borrow() const;
+
+    // Deconstructor
+    ~CMatrixND ();
+
+}; // End of CMatrixND
+
+//---CMatrixND class definitions----
+
+//no dim
+template <typename T, size_t Rank>
+CMatrixND<T,Rank>::CMatrixND() {
+    matrix_ = NULL;
+    length_ = 0;
+    base_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = 0;
+        strides_[r] = 0;
+    }
+}
+
+// one dimension per rank
+template <typename T, size_t Rank>
+template <typename... Dims, typename>
+CMatrixND<T,Rank>::CMatrixND(Dims... dim) {
+    static_assert(sizeof...(Dims) == Rank, "Number of dims does not match the rank of CMatrixND!");
+    const size_t dims_in[Rank] = {static_cast<size_t>(dim)...};
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = dims_in[r];
+    }
+    set_strides();
+    matrix_ = std::shared_ptr <T[]> (new T[length_]);
+}
+
+// copy constructor
+template <typename T, size_t Rank>
+CMatrixND<T,Rank>::CMatrixND(const CMatrixND& temp) {
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = temp.dims_[r];
+        strides_[r] = temp.strides_[r];
+    }
+    base_ = temp.base_;
+    length_ = temp.length_;
+    matrix_ = temp.matrix_;
+}
+
+// move constructor
+template <typename T, size_t Rank>
+CMatrixND<T,Rank>::CMatrixND(CMatrixND&& temp) noexcept {
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = temp.dims_[r];
+        strides_[r] = temp.strides_[r];
+        temp.dims_[r] = temp.strides_[r] = 0;
+    }
+    base_ = temp.base_;
+    length_ = temp.length_;
+    matrix_ = std::move(temp.matrix_);
+    temp.length_ = 0;
+}
+
+// row-major: the last index is contiguous
+template <typename T, size_t Rank>
+inline void CMatrixND<T,Rank>::set_strides() {
+    length_ = 1;
+    for (size_t r = Rank; r-- > 0; ) {
+        strides_[r] = length_;
+        length_ *= dims_[r];
+    }
+    base_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        base_ += strides_[r];
+    }
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+inline T& CMatrixND<T,Rank>::operator() (Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of CMatrixND!");
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] >= 1 && idx[r] <= dims_[r] && "index is out of bounds in CMatrixND!");
+    }
+    return matrix_[offset(idx, std::make_index_sequence<Rank-1>()) - base_];
+}
+
+// unrolled at compile time, the last index has unit stride
+template <typename T, size_t Rank>
+template <size_t... R>
+inline size_t CMatrixND<T,Rank>::offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const {
+    return idx[Rank-1] + ((idx[R] * strides_[R]) + ... + 0);
+}
+
+template <typename T, size_t Rank>
+inline CMatrixND<T,Rank>& CMatrixND<T,Rank>::operator= (const CMatrixND& temp) {
+    if (this != &temp) {
+        for (size_t r = 0; r < Rank; r++) {
+            dims_[r] = temp.dims_[r];
+            strides_[r] = temp.strides_[r];
+        }
+        base_ = temp.base_;
+        length_ = temp.length_;
+        matrix_ = temp.matrix_;
+    }
+    return *this;
+}
+
+template <typename T, size_t Rank>
+inline CMatrixND<T,Rank>& CMatrixND<T,Rank>::operator= (CMatrixND&& temp) noexcept {
+    if (this != &temp) {
+        for (size_t r = 0; r < Rank; r++) {
+            dims_[r] = temp.dims_[r];
+            strides_[r] = temp.strides_[r];
+            temp.dims_[r] = temp.strides_[r] = 0;
+        }
+        base_ = temp.base_;
+        length_ = temp.length_;
+        matrix_ = std::move(temp.matrix_);
+        temp.length_ = 0;
+    }
+    return *this;
+}
+
+//return size
+template <typename T, size_t Rank>
+inline size_t CMatrixND<T,Rank>::size() const {
+    return length_;
+}
+
+template <typename T, size_t Rank>
+inline size_t CMatrixND<T,Rank>::dims(size_t i) const {
+    i--; // i starts at 1
+    assert(i < Rank && "CMatrixND order (rank) does not match constructor, dim[i] does not exist!");
+    assert(dims_[i]>0 && "Access to CMatrixND dims is out of bounds!");
+    return dims_[i];
+}
+
+template <typename T, size_t Rank>
+inline size_t CMatrixND<T,Rank>::order() const {
+    return Rank;
+}
+
+template <typename T, size_t Rank>
+inline T* CMatrixND<T,Rank>::pointer() const {
+    return matrix_.get();
+}
+
+template <typename T, size_t Rank>
+inline ViewCMatrixND<T,Rank> CMatrixND<T,Rank>::borrow() const {
+    return borrow(std::make_index_sequence<Rank>());
+}
+
+template <typename T, size_t Rank>
+template <size_t... R>
+inline ViewCMatrixND<T,Rank> CMatrixND<T,Rank>::borrow(std::index_sequence<R...>) const {
+    return ViewCMatrixND <T,Rank> (matrix_.get(), dims_[R]...);
+}
+
+//destructor
+template <typename T, size_t Rank>
+CMatrixND<T,Rank>::~CMatrixND() {}
+
+// End of CMatrixND
+
+
+//40. ViewCMatrixND
+// indicies are [1:N]
+template <typename T, size_t Rank>
+class ViewCMatrixND {
+
+    static_assert(Rank >= 1 && Rank <= 7, "ViewCMatrixND rank must be between 1 and 7");
+
+private:
+    size_t dims_[Rank];
+    size_t strides_[Rank]; // precomputed in the constructor
+    size_t base_;          // sum of strides_, removes the 1-based shift
+    size_t length_; // Length of 1D array
+    T * matrix_;
+
+    void set_strides();
+
+    template <size_t... R>
+    size_t offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const;
+
+public:
+
+    // Default constructor
+    ViewCMatrixND ();
+
+    // --- one dimension per rank ---
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    ViewCMatrixND (T *some_matrix, Dims... dim);
+
+    // Overload operator(), one index per rank
+    template <typename... Indices>
+    T& operator() (Indices... indices) const;
+
+    //return array size
+    size_t size() const;
+
+    // return array dims
+    size_t dims(size_t i) const;
+
+    // return array order (rank)
+    size_t order() const;
+
+    //return pointer
+    T* pointer() const;
+
+}; // End of ViewCMatrixND
+
+//---ViewCMatrixND class definitions----
+
+//no dim
+template <typename T, size_t Rank>
+ViewCMatrixND<T,Rank>::ViewCMatrixND() {
+    matrix_ = NULL;
+    length_ = 0;
+    base_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = 0;
+        strides_[r] = 0;
+    }
+}
+
+// one dimension per rank
+template <typename T, size_t Rank>
+template <typename... Dims, typename>
+ViewCMatrixND<T,Rank>::ViewCMatrixND(T *some_matrix, Dims... dim) {
+    static_assert(sizeof...(Dims) == Rank, "Number of dims does not match the rank of ViewCMatrixND!");
+    const size_t dims_in[Rank] = {static_cast<size_t>(dim)...};
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = dims_in[r];
+    }
+    set_strides();
+    matrix_ = some_matrix;
+}
+
+// row-major: the last index is contiguous
+template <typename T, size_t Rank>
+inline void ViewCMatrixND<T,Rank>::set_strides() {
+    length_ = 1;
+    for (size_t r = Rank; r-- > 0; ) {
+        strides_[r] = length_;
+        length_ *= dims_[r];
+    }
+    base_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        base_ += strides_[r];
+    }
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+inline T& ViewCMatrixND<T,Rank>::operator() (Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of ViewCMatrixND!");
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] >= 1 && idx[r] <= dims_[r] && "index is out of bounds in ViewCMatrixND!");
+    }
+    return matrix_[offset(idx, std::make_index_sequence<Rank-1>()) - base_];
+}
+
+// unrolled at compile time, the last index has unit stride
+template <typename T, size_t Rank>
+template <size_t... R>
+inline size_t ViewCMatrixND<T,Rank>::offset(const size_t (&idx)[Rank], std::index_sequence<R...>) const {
+    return idx[Rank-1] + ((idx[R] * strides_[R]) + ... + 0);
+}
+
+//return size
+template <typename T, size_t Rank>
+inline size_t ViewCMatrixND<T,Rank>::size() const {
+    return length_;
+}
+
+template <typename T, size_t Rank>
+inline size_t ViewCMatrixND<T,Rank>::dims(size_t i) const {
+    i--; // i starts at 1
+    assert(i < Rank && "ViewCMatrixND order (rank) does not match constructor, dim[i] does not exist!");
+    assert(dims_[i]>0 && "Access to ViewCMatrixND dims is out of bounds!");
+    return dims_[i];
+}
+
+template <typename T, size_t Rank>
+inline size_t ViewCMatrixND<T,Rank>::order() const {
+    return Rank;
+}
+
+template <typename T, size_t Rank>
+inline T* ViewCMatrixND<T,Rank>::pointer() const {
+    return matrix_;
+}
+
+// End of ViewCMatrixND
+
+//=======================================================================
+//    end of fixed-rank MATAR data-types
+//========================================================================
+
+
+//=======================================================================
+//    fixed-size MATAR data-types
+//========================================================================
+// Small dense arrays whose extents are template parameters.  The data is
+// a member T[N] rather than a heap allocation, so they have no reference
+// count, copy by value, and can be declared inside a FOR_ALL body on the
+// host or the device.  The strides are compile-time constants, so with
+// small extents the compiler can unroll the index math and keep the
+// values in registers.  The commas in the template arguments would split
+// the arguments of the loop macros, so name the type outside the body, e.g.
+//     using Tensor3x3 = CArrayFixed <double,3,3>;
+//     FOR_ALL (elem, 0, num_elems, {
+//         Tensor3x3 stress(0.0);
+//         stress(i,j) += ...;
+//     });
+
+//45. FArrayFixed
+// indicies are [0:N-1]
+template <typename T, size_t... Dims>
+class FArrayFixed {
+
+    static_assert(sizeof...(Dims) >= 1 && sizeof...(Dims) <= 7, "FArrayFixed rank must be between 1 and 7");
+    static_assert(((Dims > 0) && ...), "FArrayFixed dims must be greater than zero");
+
+    static constexpr size_t Rank = sizeof...(Dims);
+    static constexpr size_t Length = (Dims * ...);
+
+private:
+    T array_[Length];
+
+    // product of the dims before r, the first index has unit stride
+    FIXED_INLINE_FUNCTION
+    static constexpr size_t stride(size_t r);
+
+    template <size_t... R>
+    FIXED_INLINE_FUNCTION
+    static constexpr size_t offset(const size_t (&idx)[Rank], std::index_sequence<R...>);
+
+public:
+
+    // Default constructor, the values are uninitialized like a C array
+    FArrayFixed () = default;
+
+    // every value set to val
+    FIXED_INLINE_FUNCTION
+    explicit FArrayFixed (const T& val);
+
+    // Overload operator(), one index per rank
+    template <typename... Indices>
+    FIXED_INLINE_FUNCTION
+    T& operator() (Indices... indices);
+
+    template <typename... Indices>
+    FIXED_INLINE_FUNCTION
+    const T& operator() (Indices... indices) const;
+
+    // set every value to val
+    FIXED_INLINE_FUNCTION
+    void set_values(const T& val);
+
+    //return array size
+    FIXED_INLINE_FUNCTION
+    static constexpr size_t size();
+
+    // return array dims
+    FIXED_INLINE_FUNCTION
+    static constexpr size_t dims(size_t i);
+
+    // return array order (rank)
+    FIXED_INLINE_FUNCTION
+    static constexpr size_t order();
+
+    //return pointer
+    FIXED_INLINE_FUNCTION
+    T* pointer();
+
+    FIXED_INLINE_FUNCTION
+    const T* pointer() const;
+
+}; // End of FArrayFixed
+
+//---FArrayFixed class definitions----
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+FArrayFixed<T,Dims...>::FArrayFixed(const T& val) {
+    set_values(val);
+}
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+constexpr size_t FArrayFixed<T,Dims...>::stride(size_t r) {
+    const size_t dims_in[Rank] = {Dims...};
+    size_t s = 1;
+    for (size_t n = 0; n < r; n++) {
+        s *= dims_in[n];
+    }
+    return s;
+}
+
+// each stride is a template argument, so it is folded at compile time
+template <typename T, size_t... Dims>
+template <size_t... R>
+FIXED_INLINE_FUNCTION
+constexpr size_t FArrayFixed<T,Dims...>::offset(const size_t (&idx)[Rank], std::index_sequence<R...>) {
+    return ((idx[R] * std::integral_constant<size_t, stride(R)>::value) + ...);
+}
+
+template <typename T, size_t... Dims>
+template <typename... Indices>
+FIXED_INLINE_FUNCTION
+T& FArrayFixed<T,Dims...>::operator() (Indices... indices) {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of FArrayFixed!");
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] < dims(r) && "index is out of bounds in FArrayFixed!");
+    }
+    return array_[offset(idx, std::make_index_sequence<Rank>())];
+}
+
+template <typename T, size_t... Dims>
+template <typename... Indices>
+FIXED_INLINE_FUNCTION
+const T& FArrayFixed<T,Dims...>::operator() (Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of FArrayFixed!");
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] < dims(r) && "index is out of bounds in FArrayFixed!");
+    }
+    return array_[offset(idx, std::make_index_sequence<Rank>())];
+}
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+void FArrayFixed<T,Dims...>::set_values(const T& val) {
+    for (size_t n = 0; n < Length; n++) {
+        array_[n] = val;
+    }
+}
+
+//return size
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+constexpr size_t FArrayFixed<T,Dims...>::size() {
+    return Length;
+}
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+constexpr size_t FArrayFixed<T,Dims...>::dims(size_t i) {
+    assert(i < Rank && "FArrayFixed order (rank) does not match the template, dim[i] does not exist!");
+    const size_t dims_in[Rank] = {Dims...};
+    return dims_in[i];
+}
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+constexpr size_t FArrayFixed<T,Dims...>::order() {
+    return Rank;
+}
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+T* FArrayFixed<T,Dims...>::pointer() {
+    return array_;
+}
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+const T* FArrayFixed<T,Dims...>::pointer() const {
+    return array_;
+}
+
+// End of FArrayFixed
+
+
+//46. CArrayFixed
+// indicies are [0:N-1]
+template <typename T, size_t... Dims>
+class CArrayFixed {
+
+    static_assert(sizeof...(Dims) >= 1 && sizeof...(Dims) <= 7, "CArrayFixed rank must be between 1 and 7");
+    static_assert(((Dims > 0) && ...), "CArrayFixed dims must be greater than zero");
+
+    static constexpr size_t Rank = sizeof...(Dims);
+    static constexpr size_t Length = (Dims * ...);
+
+private:
+    T array_[Length];
+
+    // product of the dims after r, the last index has unit stride
+    FIXED_INLINE_FUNCTION
+    static constexpr size_t stride(size_t r);
+
+    template <size_t... R>
+    FIXED_INLINE_FUNCTION
+    static constexpr size_t offset(const size_t (&idx)[Rank], std::index_sequence<R...>);
+
+public:
+
+    // Default constructor, the values are uninitialized like a C array
+    CArrayFixed () = default;
+
+    // every value set to val
+    FIXED_INLINE_FUNCTION
+    explicit CArrayFixed (const T& val);
+
+    // Overload operator(), one index per rank
+    template <typename... Indices>
+    FIXED_INLINE_FUNCTION
+    T& operator() (Indices... indices);
+
+    template <typename... Indices>
+    FIXED_INLINE_FUNCTION
+    const T& operator() (Indices... indices) const;
+
+    // set every value to val
+    FIXED_INLINE_FUNCTION
+    void set_values(const T& val);
+
+    //return array size
+    FIXED_INLINE_FUNCTION
+    static constexpr size_t size();
+
+    // return array dims
+    FIXED_INLINE_FUNCTION
+    static constexpr size_t dims(size_t i);
+
+    // return array order (rank)
+    FIXED_INLINE_FUNCTION
+    static constexpr size_t order();
+
+    //return pointer
+    FIXED_INLINE_FUNCTION
+    T* pointer();
+
+    FIXED_INLINE_FUNCTION
+    const T* pointer() const;
+
+}; // End of CArrayFixed
+
+//---CArrayFixed class definitions----
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+CArrayFixed<T,Dims...>::CArrayFixed(const T& val) {
+    set_values(val);
+}
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+constexpr size_t CArrayFixed<T,Dims...>::stride(size_t r) {
+    const size_t dims_in[Rank] = {Dims...};
+    size_t s = 1;
+    for (size_t n = r+1; n < Rank; n++) {
+        s *= dims_in[n];
+    }
+    return s;
+}
+
+// each stride is a template argument, so it is folded at compile time
+template <typename T, size_t... Dims>
+template <size_t... R>
+FIXED_INLINE_FUNCTION
+constexpr size_t CArrayFixed<T,Dims...>::offset(const size_t (&idx)[Rank], std::index_sequence<R...>) {
+    return ((idx[R] * std::integral_constant<size_t, stride(R)>::value) + ...);
+}
+
+template <typename T, size_t... Dims>
+template <typename... Indices>
+FIXED_INLINE_FUNCTION
+T& CArrayFixed<T,Dims...>::operator() (Indices... indices) {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of CArrayFixed!");
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] < dims(r) && "index is out of bounds in CArrayFixed!");
+    }
+    return array_[offset(idx, std::make_index_sequence<Rank>())];
+}
+
+template <typename T, size_t... Dims>
+template <typename... Indices>
+FIXED_INLINE_FUNCTION
+const T& CArrayFixed<T,Dims...>::operator() (Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of CArrayFixed!");
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] < dims(r) && "index is out of bounds in CArrayFixed!");
+    }
+    return array_[offset(idx, std::make_index_sequence<Rank>())];
+}
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+void CArrayFixed<T,Dims...>::set_values(const T& val) {
+    for (size_t n = 0; n < Length; n++) {
+        array_[n] = val;
+    }
+}
+
+//return size
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+constexpr size_t CArrayFixed<T,Dims...>::size() {
+    return Length;
+}
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+constexpr size_t CArrayFixed<T,Dims...>::dims(size_t i) {
+    assert(i < Rank && "CArrayFixed order (rank) does not match the template, dim[i] does not exist!");
+    const size_t dims_in[Rank] = {Dims...};
+    return dims_in[i];
+}
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+constexpr size_t CArrayFixed<T,Dims...>::order() {
+    return Rank;
+}
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+T* CArrayFixed<T,Dims...>::pointer() {
+    return array_;
+}
+
+template <typename T, size_t... Dims>
+FIXED_INLINE_FUNCTION
+const T* CArrayFixed<T,Dims...>::pointer() const {
+    return array_;
+}
+
+// End of CArrayFixed
+
+//=======================================================================
+//    end of fixed-size MATAR data-types
+//========================================================================
+
+
 } // end namespace
 
 
@@ -43,6 +43,7 @@
 #ifdef HAVE_KOKKOS
 #include <Kokkos_Core.hpp>
 #include <Kokkos_DualView.hpp>
+#include <vector>
 
 using HostSpace    = Kokkos::HostSpace;
 using MemoryUnmanaged = Kokkos::MemoryUnmanaged;
@@ -118,6 +119,587 @@ using SHArray1D     = Kokkos::View<size_t *,DefaultLayout,Kokkos::HostSpace>;
 namespace mtr
 {
 
+// An execution space instance for the _ASYNC loops and the async dual updates,
+// with kokkos this is a stream on a GPU or a partition of the host backend
+using ExecInstance = DefaultExecSpace;
+
+// splits the default execution space into num_partitions instances of equal weight
+inline std::vector<ExecInstance> partition_exec_space(size_t num_partitions) {
+    assert(num_partitions > 0 && "num_partitions must be positive in partition_exec_space!");
+    return Kokkos::Experimental::partition_space(DefaultExecSpace(), std::vector<int>(num_partitions, 1));
+}
+
+// Memory from kokkos_malloc in MemSpace, the upstream allocator of a pool or an arena
+// (allocators.h) for the scratch constructors of CArrayKokkos and FArrayKokkos, e.g.
+//     KokkosAllocator <> device("device");
+//     ArenaAllocator arena("step", &device);
+//     ArenaScope scope(arena);
+//     CArrayKokkos <double> flux(arena, num_faces, 3);
+template <typename MemSpace = DefaultMemSpace>
+class KokkosAllocator : public Allocator {
+
+private:
+    std::mutex mutex_;
+
+public:
+    explicit KokkosAllocator(const std::string& name = "kokkos") : Allocator(name) {}
+
+    // kokkos_malloc aligns to at least 64 bytes
+    void* allocate(size_t bytes, [[maybe_unused]] size_t alignment) override {
+        assert(alignment <= 64 && "KokkosAllocator alignment must be at most 64 bytes!");
+        void* ptr = Kokkos::kokkos_malloc<MemSpace>(name_, bytes);
+        std::lock_guard<std::mutex> lock(mutex_);
+        count_allocation(bytes, false);
+        stats_.upstream_allocations++;
+        stats_.upstream_bytes += bytes;
+        return ptr;
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t /*alignment*/) override {
+        Kokkos::kokkos_free<MemSpace>(ptr);
+        std::lock_guard<std::mutex> lock(mutex_);
+        count_deallocation(bytes);
+        stats_.upstream_bytes -= bytes;
+    }
+
+}; // end of KokkosAllocator
+
+// The storage of the Kokkos constructors that take an ArrayInit.  zero is the
+// usual zero-filled View, none and first_touch skip Kokkos' serial fill, and
+// first_touch then writes T() with a RangePolicy over the flat storage on the
+// View's execution space.  With OpenMP that gives each thread the contiguous
+// block a FOR_ALL over the array gives it, so the pages land on its socket.
+template <typename ViewType>
+void first_touch_view(const ViewType& view, size_t length) {
+    using value_type = typename ViewType::non_const_value_type;
+    using exec_space = typename ViewType::execution_space;
+    Kokkos::parallel_for("first_touch", Kokkos::RangePolicy<exec_space>(0, length),
+                         KOKKOS_LAMBDA(const size_t n) { view(n) = value_type(); });
+}
+
+template <typename ViewType>
+ViewType init_view(ArrayInit init, const std::string& tag_string, size_t length) {
+    if (init == ArrayInit::zero) {
+        return ViewType(tag_string, length);
+    }
+    ViewType view(Kokkos::view_alloc(tag_string, Kokkos::WithoutInitializing), length);
+    if (init == ArrayInit::first_touch) {
+        first_touch_view(view, length);
+    }
+    return view;
+}
+
+// the same for a DualView, the host side is touched too when it is separate memory
+template <typename DualViewType>
+DualViewType init_dual_view(ArrayInit init, const std::string& tag_string, size_t length) {
+    if (init == ArrayInit::zero) {
+        return DualViewType(tag_string, length);
+    }
+    DualViewType view(Kokkos::view_alloc(tag_string, Kokkos::WithoutInitializing), length);
+    if (init == ArrayInit::first_touch) {
+        first_touch_view(view.d_view, length);
+        if (view.h_view.data() != view.d_view.data()) {
+            first_touch_view(view.h_view, length);
+        }
+    }
+    return view;
+}
+
+// A value and its index, the variable and result of the REDUCE_MINLOC and
+// REDUCE_MAXLOC MACROS
+template <typename T, typename I = int>
+using ValLoc = Kokkos::ValLocScalar<T, I>;
+
+// A Kokkos reducer for the REDUCE_CUSTOM MACROS.  T is a user type whose default
+// constructor gives the identity and whose join(const T&) member combines two
+// partial results, both marked KOKKOS_INLINE_FUNCTION.
+template <typename T, typename Space = Kokkos::HostSpace>
+struct JoinReducer {
+public:
+    using reducer = JoinReducer<T, Space>;
+    using value_type = std::remove_cv_t<T>;
+    using result_view_type = Kokkos::View<value_type, Space>;
+
+private:
+    result_view_type value_;
+    bool references_scalar_;
+
+public:
+    KOKKOS_INLINE_FUNCTION
+    JoinReducer(value_type& value) : value_(&value), references_scalar_(true) {}
+
+    KOKKOS_INLINE_FUNCTION
+    JoinReducer(const result_view_type& value) : value_(value), references_scalar_(false) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void join(value_type& dest, const value_type& src) const { dest.join(src); }
+
+    KOKKOS_INLINE_FUNCTION
+    void init(value_type& value) const { value = value_type(); }
+
+    KOKKOS_INLINE_FUNCTION
+    value_type& reference() const { return *value_.data(); }
+
+    KOKKOS_INLINE_FUNCTION
+    result_view_type view() const { return value_; }
+
+    KOKKOS_INLINE_FUNCTION
+    bool references_scalar() const { return references_scalar_; }
+};
+
+// Calls to update_host()/update_device() on the dual types, split into the ones
+// that copied data and the ones skipped because the destination was current
+struct DualSyncCounts {
+    size_t transfers = 0;
+    size_t skipped = 0;
+};
+
+inline DualSyncCounts& dual_sync_counts() {
+    static DualSyncCounts counts;
+    return counts;
+}
+
+inline void reset_dual_sync_counts() {
+    dual_sync_counts() = DualSyncCounts();
+}
+
+/*! \brief Records which side of a dual type was written since the last sync.
+ *
+ *  The flags live in a small host view, so every copy of a dual array shares
+ *  them.  An array is tracked once modify_host() or modify_device() has been
+ *  called on it, after that an update is skipped when the destination is
+ *  current.  An untracked array copies on every update, as it always has.
+ */
+class DualSyncState {
+
+    // tracked, host modified, device modified
+    using TFlags = Kokkos::View<unsigned*, Kokkos::HostSpace>;
+
+private:
+    TFlags flags_;
+
+public:
+    DualSyncState() {}
+
+    DualSyncState(const std::string& tag_string) {
+        flags_ = TFlags(tag_string + "sync_state", 3);
+    }
+
+    void modify_host() {
+        if (flags_.data() == NULL) return;
+        flags_(0) = 1;
+        flags_(1) = 1;
+    }
+
+    void modify_device() {
+        if (flags_.data() == NULL) return;
+        flags_(0) = 1;
+        flags_(2) = 1;
+    }
+
+    bool host_is_current() const {
+        return flags_.data() != NULL && flags_(0) && !flags_(2);
+    }
+
+    bool device_is_current() const {
+        return flags_.data() != NULL && flags_(0) && !flags_(1);
+    }
+
+    // called by an update that copied the data, both sides now match
+    void mark_synced() {
+        if (flags_.data() != NULL) {
+            flags_(1) = 0;
+            flags_(2) = 0;
+        }
+        dual_sync_counts().transfers++;
+    }
+
+    // called by an update that found the destination current
+    void mark_skipped() {
+        dual_sync_counts().skipped++;
+    }
+};
+
+/*! \brief Half open index range [begin, end) of one dimension, used by the
+ *  block versions of update_host() and update_device() on the dual arrays.
+ *
+ *  A default constructed range covers the whole dimension.
+ */
+struct DualRange {
+    size_t begin;
+    size_t end;
+
+    DualRange() : begin(0), end((size_t) -1) {}
+
+    template <typename B, typename E>
+    DualRange(B range_begin, E range_end) : begin((size_t) range_begin), end((size_t) range_end) {}
+};
+
+// Walks a block of a dense array in memory order.  extent_ and stride_ are
+// ordered slowest to fastest, flat(b) is the array index of block element b
+struct DualBlock {
+    size_t order_;
+    size_t offset_;
+    size_t size_;
+    size_t extent_[7];
+    size_t stride_[7];
+
+    KOKKOS_INLINE_FUNCTION
+    size_t flat(size_t b) const {
+        size_t index = offset_;
+        for (size_t d = order_; d-- > 0;) {
+            index += (b % extent_[d]) * stride_[d];
+            b /= extent_[d];
+        }
+        return index;
+    }
+};
+
+// Copies the block ranges[0] x ... x ranges[order-1] of a dense dual array
+// between its host and device data.  c_layout is true when the last index is
+// contiguous.  A block that is a single run of memory is one deep_copy, any
+// other block is packed into a contiguous buffer on the source side, copied,
+// and unpacked on the destination side.
+template <typename T, typename ExecSpace>
+void dual_update_block(T* host_ptr, T* device_ptr, const size_t* dims, size_t order,
+                       bool c_layout, bool to_host, const DualRange* ranges) {
+
+    using HostView   = Kokkos::View<T*, HostSpace, MemoryUnmanaged>;
+    using DeviceView = Kokkos::View<T*, ExecSpace, MemoryUnmanaged>;
+    using DeviceBuf  = Kokkos::View<T*, ExecSpace>;
+
+    DualBlock block;
+    block.order_ = order;
+    block.offset_ = 0;
+    block.size_ = 1;
+    size_t length = 1;
+    for (size_t d = 0; d < order; d++) {
+        length *= dims[d];
+    }
+
+    size_t stride = 1;
+    for (size_t n = order; n-- > 0;) {
+        // n counts down from the fastest walked dimension
+        size_t d = c_layout ? n : order - 1 - n;
+        size_t begin = ranges[d].begin;
+        size_t end = (ranges[d].end == (size_t) -1) ? dims[d] : ranges[d].end;
+        assert(begin < end && end <= dims[d] && "Block range is out of bounds in update_host/update_device");
+        block.extent_[n] = end - begin;
+        block.stride_[n] = stride;
+        block.offset_ += begin * stride;
+        block.size_ *= end - begin;
+        stride *= dims[d];
+    }
+    for (size_t d = order; d < 7; d++) {
+        assert(ranges[d].end == (size_t) -1 && "More block ranges than the order of the array in update_host/update_device");
+    }
+
+    dual_sync_counts().transfers++;
+    if (host_ptr == device_ptr) return; // the host and device share memory
+
+    HostView host(host_ptr, length);
+    DeviceView device(device_ptr, length);
+
+    // contiguous when every dimension faster than the slowest partial one is whole
+    size_t first = 0;
+    while (first < order && block.extent_[first] == 1) {
+        first++;
+    }
+    bool contiguous = true;
+    for (size_t n = first + 1; n < order; n++) {
+        size_t d = c_layout ? n : order - 1 - n;
+        contiguous = contiguous && (block.extent_[n] == dims[d]);
+    }
+
+    Kokkos::pair<size_t, size_t> run(block.offset_, block.offset_ + block.size_);
+    if (contiguous) {
+        if (to_host) {
+            Kokkos::deep_copy(Kokkos::subview(host, run), Kokkos::subview(device, run));
+        }
+        else {
+            Kokkos::deep_copy(Kokkos::subview(device, run), Kokkos::subview(host, run));
+        }
+        return;
+    }
+
+    DeviceBuf device_buf("dual_update_block", block.size_);
+    typename DeviceBuf::HostMirror host_buf = Kokkos::create_mirror_view(device_buf);
+    Kokkos::RangePolicy<typename DeviceBuf::execution_space> policy(0, block.size_);
+
+    if (to_host) {
+        Kokkos::parallel_for("DualBlockPack", policy, KOKKOS_LAMBDA(const size_t b) {
+            device_buf(b) = device(block.flat(b));
+        });
+        Kokkos::deep_copy(host_buf, device_buf);
+        for (size_t b = 0; b < block.size_; b++) {
+            host(block.flat(b)) = host_buf(b);
+        }
+    }
+    else {
+        for (size_t b = 0; b < block.size_; b++) {
+            host_buf(b) = host(block.flat(b));
+        }
+        Kokkos::deep_copy(device_buf, host_buf);
+        Kokkos::parallel_for("DualBlockUnpack", policy, KOKKOS_LAMBDA(const size_t b) {
+            device(block.flat(b)) = device_buf(b);
+        });
+        Kokkos::fence();
+    }
+}
+
+/*! \brief A strided view of a dense Kokkos type.
+ *
+ *  The Kokkos version of ViewStrided, made by slice() and subarray() of the
+ *  dense Kokkos types on the host and indexed in kernels.  It holds a
+ *  Kokkos::subview of the array's storage from the view's first element to
+ *  its last, so a view of a managed array keeps the data alive, and applies
+ *  its own per-dimension strides inside that span.  The dual types slice
+ *  their device data, slice their host member for the host side.
+ */
+template <typename T, size_t Base, typename ExecSpace = DefaultExecSpace>
+class ViewStridedKokkos {
+
+    using TArray1D = Kokkos::View<T*, Kokkos::LayoutRight, ExecSpace>;
+
+private:
+    TArray1D this_array_;
+    StridedShape shape_;
+
+public:
+    ViewStridedKokkos();
+
+    // a view of part of the 1D storage of a managed array
+    template <typename ViewType>
+    ViewStridedKokkos(const ViewType& some_view, const StridedShape& shape);
+
+    // a view of part of unmanaged storage
+    ViewStridedKokkos(T* some_array, const StridedShape& shape);
+
+    KOKKOS_INLINE_FUNCTION
+    T& operator()(size_t i) const;
+
+    KOKKOS_INLINE_FUNCTION
+    T& operator()(size_t i, size_t j) const;
+
+    KOKKOS_INLINE_FUNCTION
+    T& operator()(size_t i, size_t j, size_t k) const;
+
+    KOKKOS_INLINE_FUNCTION
+    T& operator()(size_t i, size_t j, size_t k, size_t l) const;
+
+    KOKKOS_INLINE_FUNCTION
+    T& operator()(size_t i, size_t j, size_t k, size_t l, size_t m) const;
+
+    KOKKOS_INLINE_FUNCTION
+    T& operator()(size_t i, size_t j, size_t k, size_t l, size_t m, size_t n) const;
+
+    KOKKOS_INLINE_FUNCTION
+    T& operator()(size_t i, size_t j, size_t k, size_t l, size_t m, size_t n, size_t o) const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t size() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t dims(size_t i) const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t stride(size_t i) const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t order() const;
+
+    KOKKOS_INLINE_FUNCTION
+    T* pointer() const;
+
+    // the subview, from the first element of the view to its last
+    TArray1D get_kokkos_view() const;
+
+    ViewStridedKokkos slice(size_t dim, size_t index) const;
+
+    ViewStridedKokkos subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                               SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                               SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
+}; // end of ViewStridedKokkos
+
+template <typename T, typename ExecSpace = DefaultExecSpace>
+using ViewStridedArrayKokkos = ViewStridedKokkos<T, 0, ExecSpace>;
+
+template <typename T, typename ExecSpace = DefaultExecSpace>
+using ViewStridedMatrixKokkos = ViewStridedKokkos<T, 1, ExecSpace>;
+
+template <typename T, size_t Base, typename ExecSpace>
+ViewStridedKokkos<T,Base,ExecSpace>::ViewStridedKokkos() {}
+
+template <typename T, size_t Base, typename ExecSpace>
+template <typename ViewType>
+ViewStridedKokkos<T,Base,ExecSpace>::ViewStridedKokkos(const ViewType& some_view, const StridedShape& shape)
+    : shape_(shape) {
+    size_t span = strided_span(shape);
+    this_array_ = Kokkos::subview(some_view, std::make_pair(shape.offset, shape.offset + span));
+    shape_.offset = 0;
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+ViewStridedKokkos<T,Base,ExecSpace>::ViewStridedKokkos(T* some_array, const StridedShape& shape)
+    : shape_(shape) {
+    this_array_ = TArray1D(some_array + shape.offset, strided_span(shape));
+    shape_.offset = 0;
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+KOKKOS_INLINE_FUNCTION
+T& ViewStridedKokkos<T,Base,ExecSpace>::operator()(size_t i) const {
+    assert(shape_.order == 1 && "Tensor order (rank) does not match the view in ViewStridedKokkos 1D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStridedKokkos 1D!");
+    return this_array_((i - Base)*shape_.strides[0]);
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+KOKKOS_INLINE_FUNCTION
+T& ViewStridedKokkos<T,Base,ExecSpace>::operator()(size_t i, size_t j) const {
+    assert(shape_.order == 2 && "Tensor order (rank) does not match the view in ViewStridedKokkos 2D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStridedKokkos 2D!");
+    assert(j >= Base && j < shape_.dims[1] + Base && "j is out of bounds in ViewStridedKokkos 2D!");
+    return this_array_((i - Base)*shape_.strides[0] + (j - Base)*shape_.strides[1]);
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+KOKKOS_INLINE_FUNCTION
+T& ViewStridedKokkos<T,Base,ExecSpace>::operator()(size_t i, size_t j, size_t k) const {
+    assert(shape_.order == 3 && "Tensor order (rank) does not match the view in ViewStridedKokkos 3D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStridedKokkos 3D!");
+    assert(j >= Base && j < shape_.dims[1] + Base && "j is out of bounds in ViewStridedKokkos 3D!");
+    assert(k >= Base && k < shape_.dims[2] + Base && "k is out of bounds in ViewStridedKokkos 3D!");
+    return this_array_((i - Base)*shape_.strides[0]
+                       + (j - Base)*shape_.strides[1]
+                       + (k - Base)*shape_.strides[2]);
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+KOKKOS_INLINE_FUNCTION
+T& ViewStridedKokkos<T,Base,ExecSpace>::operator()(size_t i, size_t j, size_t k, size_t l) const {
+    assert(shape_.order == 4 && "Tensor order (rank) does not match the view in ViewStridedKokkos 4D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStridedKokkos 4D!");
+    assert(j >= Base && j < shape_.dims[1] + Base && "j is out of bounds in ViewStridedKokkos 4D!");
+    assert(k >= Base && k < shape_.dims[2] + Base && "k is out of bounds in ViewStridedKokkos 4D!");
+    assert(l >= Base && l < shape_.dims[3] + Base && "l is out of bounds in ViewStridedKokkos 4D!");
+    return this_array_((i - Base)*shape_.strides[0]
+                       + (j - Base)*shape_.strides[1]
+                       + (k - Base)*shape_.strides[2]
+                       + (l - Base)*shape_.strides[3]);
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+KOKKOS_INLINE_FUNCTION
+T& ViewStridedKokkos<T,Base,ExecSpace>::operator()(size_t i, size_t j, size_t k, size_t l, size_t m) const {
+    assert(shape_.order == 5 && "Tensor order (rank) does not match the view in ViewStridedKokkos 5D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStridedKokkos 5D!");
+    assert(j >= Base && j < shape_.dims[1] + Base && "j is out of bounds in ViewStridedKokkos 5D!");
+    assert(k >= Base && k < shape_.dims[2] + Base && "k is out of bounds in ViewStridedKokkos 5D!");
+    assert(l >= Base && l < shape_.dims[3] + Base && "l is out of bounds in ViewStridedKokkos 5D!");
+    assert(m >= Base && m < shape_.dims[4] + Base && "m is out of bounds in ViewStridedKokkos 5D!");
+    return this_array_((i - Base)*shape_.strides[0]
+                       + (j - Base)*shape_.strides[1]
+                       + (k - Base)*shape_.strides[2]
+                       + (l - Base)*shape_.strides[3]
+                       + (m - Base)*shape_.strides[4]);
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+KOKKOS_INLINE_FUNCTION
+T& ViewStridedKokkos<T,Base,ExecSpace>::operator()(size_t i, size_t j, size_t k, size_t l, size_t m, size_t n) const {
+    assert(shape_.order == 6 && "Tensor order (rank) does not match the view in ViewStridedKokkos 6D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStridedKokkos 6D!");
+    assert(j >= Base && j < shape_.dims[1] + Base && "j is out of bounds in ViewStridedKokkos 6D!");
+    assert(k >= Base && k < shape_.dims[2] + Base && "k is out of bounds in ViewStridedKokkos 6D!");
+    assert(l >= Base && l < shape_.dims[3] + Base && "l is out of bounds in ViewStridedKokkos 6D!");
+    assert(m >= Base && m < shape_.dims[4] + Base && "m is out of bounds in ViewStridedKokkos 6D!");
+    assert(n >= Base && n < shape_.dims[5] + Base && "n is out of bounds in ViewStridedKokkos 6D!");
+    return this_array_((i - Base)*shape_.strides[0]
+                       + (j - Base)*shape_.strides[1]
+                       + (k - Base)*shape_.strides[2]
+                       + (l - Base)*shape_.strides[3]
+                       + (m - Base)*shape_.strides[4]
+                       + (n - Base)*shape_.strides[5]);
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+KOKKOS_INLINE_FUNCTION
+T& ViewStridedKokkos<T,Base,ExecSpace>::operator()(size_t i, size_t j, size_t k, size_t l, size_t m, size_t n, size_t o) const {
+    assert(shape_.order == 7 && "Tensor order (rank) does not match the view in ViewStridedKokkos 7D!");
+    assert(i >= Base && i < shape_.dims[0] + Base && "i is out of bounds in ViewStridedKokkos 7D!");
+    assert(j >= Base && j < shape_.dims[1] + Base && "j is out of bounds in ViewStridedKokkos 7D!");
+    assert(k >= Base && k < shape_.dims[2] + Base && "k is out of bounds in ViewStridedKokkos 7D!");
+    assert(l >= Base && l < shape_.dims[3] + Base && "l is out of bounds in ViewStridedKokkos 7D!");
+    assert(m >= Base && m < shape_.dims[4] + Base && "m is out of bounds in ViewStridedKokkos 7D!");
+    assert(n >= Base && n < shape_.dims[5] + Base && "n is out of bounds in ViewStridedKokkos 7D!");
+    assert(o >= Base && o < shape_.dims[6] + Base && "o is out of bounds in ViewStridedKokkos 7D!");
+    return this_array_((i - Base)*shape_.strides[0]
+                       + (j - Base)*shape_.strides[1]
+                       + (k - Base)*shape_.strides[2]
+                       + (l - Base)*shape_.strides[3]
+                       + (m - Base)*shape_.strides[4]
+                       + (n - Base)*shape_.strides[5]
+                       + (o - Base)*shape_.strides[6]);
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+KOKKOS_INLINE_FUNCTION
+size_t ViewStridedKokkos<T,Base,ExecSpace>::size() const {
+    size_t length = 1;
+    for (size_t d = 0; d < shape_.order; d++) {
+        length *= shape_.dims[d];
+    }
+    return length;
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+KOKKOS_INLINE_FUNCTION
+size_t ViewStridedKokkos<T,Base,ExecSpace>::dims(size_t i) const {
+    assert(i < shape_.order && "ViewStridedKokkos order (rank) does not match constructor, dim[i] does not exist!");
+    return shape_.dims[i];
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+KOKKOS_INLINE_FUNCTION
+size_t ViewStridedKokkos<T,Base,ExecSpace>::stride(size_t i) const {
+    assert(i < shape_.order && "ViewStridedKokkos order (rank) does not match constructor, stride[i] does not exist!");
+    return shape_.strides[i];
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+KOKKOS_INLINE_FUNCTION
+size_t ViewStridedKokkos<T,Base,ExecSpace>::order() const {
+    return shape_.order;
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+KOKKOS_INLINE_FUNCTION
+T* ViewStridedKokkos<T,Base,ExecSpace>::pointer() const {
+    return this_array_.data();
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+typename ViewStridedKokkos<T,Base,ExecSpace>::TArray1D ViewStridedKokkos<T,Base,ExecSpace>::get_kokkos_view() const {
+    return this_array_;
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+ViewStridedKokkos<T,Base,ExecSpace> ViewStridedKokkos<T,Base,ExecSpace>::slice(size_t dim, size_t index) const {
+    return ViewStridedKokkos(this_array_, slice_shape(shape_, dim, index, Base));
+}
+
+template <typename T, size_t Base, typename ExecSpace>
+ViewStridedKokkos<T,Base,ExecSpace> ViewStridedKokkos<T,Base,ExecSpace>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                SliceRange r3, SliceRange r4,
+                                                                                SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedKokkos(this_array_, subarray_shape(shape_, ranges, Base));
+}
+
+//---end of ViewStridedKokkos class definitions----
+
 /*! \brief Kokkos version of the serial FArray class.
  *
  *  This is the Kokkos version of the serial FArray class.
@@ -183,6 +765,23 @@ public:
     FArrayKokkos(size_t dim0, size_t sone_dim2, size_t dim2,
                  size_t dim3, size_t dim4, size_t dim5,
                  size_t dim6, const std::string& tag_string = DEFAULTSTRINGARRAY);
+
+    // storage initialized as init says (see ArrayInit), e.g.
+    //     FArrayKokkos <double> stress(ArrayInit::first_touch, num_elems, 3);
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    FArrayKokkos(ArrayInit init, Dims... dim);
+
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    FArrayKokkos(ArrayInit init, const std::string& tag_string, Dims... dim);
+
+    // scratch storage from a scoped allocator, an ArenaAllocator over a
+    // KokkosAllocator of ExecSpace's memory.  It is not zero-filled and is
+    // valid until the arena scope that made it ends
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    FArrayKokkos(Allocator& allocator, Dims... dim);
     
     // Overload operator() to acces data
     // from 1D to 6D
@@ -216,6 +815,11 @@ public:
     KOKKOS_INLINE_FUNCTION
     FArrayKokkos& operator= (const FArrayKokkos<T,Layout,ExecSpace,MemoryTraits> &temp);
 
+    // evaluates an elementwise expression (expressions.h) into this array
+    // on ExecSpace, called on the host
+    template <typename E, typename = typename E::matar_expr>
+    FArrayKokkos& operator= (const E& expr);
+
     KOKKOS_INLINE_FUNCTION
     size_t size() const;
     
@@ -235,6 +839,15 @@ public:
     KOKKOS_INLINE_FUNCTION
     TArray1D get_kokkos_view() const;
 
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedArrayKokkos <T,ExecSpace> slice(size_t dim, size_t index) const;
+
+    ViewStridedArrayKokkos <T,ExecSpace> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                                  SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                                  SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     // Destructor
     KOKKOS_INLINE_FUNCTION
     ~FArrayKokkos();
@@ -362,6 +975,43 @@ FArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::FArrayKokkos(size_t dim0, size_t
     this_array_ = TArray1D(tag_string, length_);
 }
 
+// scratch constructor
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+FArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::FArrayKokkos(Allocator& allocator, Dims... dim) {
+    static_assert(sizeof...(Dims) >= 1 && sizeof...(Dims) <= 7, "FArrayKokkos scratch constructor takes 1 to 7 dims!");
+    assert(allocator.scoped() && "FArrayKokkos scratch storage must come from a scoped allocator (an ArenaAllocator)!");
+    const size_t dims_in[] = {static_cast<size_t>(dim)...};
+    order_ = sizeof...(Dims);
+    length_ = 1;
+    for (size_t i = 0; i < 7; i++) {
+        dims_[i] = (i < order_) ? dims_in[i] : 0;
+        length_ *= (i < order_) ? dims_in[i] : 1;
+    }
+    T* data = static_cast<T*>(allocator.allocate(length_ * sizeof(T), alignof(T)));
+    this_array_ = TArray1D(data, length_);
+}
+
+// ArrayInit constructors
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+FArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::FArrayKokkos(ArrayInit init, Dims... dim)
+    : FArrayKokkos(init, DEFAULTSTRINGARRAY, dim...) {}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+FArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::FArrayKokkos(ArrayInit init, const std::string& tag_string, Dims... dim) {
+    static_assert(sizeof...(Dims) >= 1 && sizeof...(Dims) <= 7, "FArrayKokkos takes 1 to 7 dims!");
+    const size_t dims_in[] = {static_cast<size_t>(dim)...};
+    order_ = sizeof...(Dims);
+    length_ = 1;
+    for (size_t i = 0; i < 7; i++) {
+        dims_[i] = (i < order_) ? dims_in[i] : 0;
+        length_ *= (i < order_) ? dims_in[i] : 1;
+    }
+    this_array_ = init_view<TArray1D>(init, tag_string, length_);
+}
+
 // Definitions of overload operator()
 // for 1D to 7D
 // Note: the indices for array all start at 0
@@ -487,6 +1137,14 @@ FArrayKokkos<T,Layout,ExecSpace,MemoryTraits>& FArrayKokkos<T,Layout,ExecSpace,M
     return *this;
 }
 
+// expression assignment
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename E, typename>
+FArrayKokkos<T,Layout,ExecSpace,MemoryTraits>& FArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::operator= (const E& expr) {
+    assign_expr(*this, expr);
+    return *this;
+}
+
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 size_t FArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::size() const {
@@ -531,6 +1189,19 @@ template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits
 KOKKOS_INLINE_FUNCTION
 FArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::~FArrayKokkos() {}
 
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedArrayKokkos <T,ExecSpace> FArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::slice(size_t dim, size_t index) const {
+    return ViewStridedArrayKokkos <T,ExecSpace>(this_array_, slice_shape(dense_shape(order_, dims_, dims_[0], false), dim, index, 0));
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedArrayKokkos <T,ExecSpace> FArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                             SliceRange r3, SliceRange r4,
+                                                                                             SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedArrayKokkos <T,ExecSpace>(this_array_, subarray_shape(dense_shape(order_, dims_, dims_[0], false), ranges, 0));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // End of FArrayKokkos
 ////////////////////////////////////////////////////////////////////////////////
@@ -617,6 +1288,15 @@ public:
     KOKKOS_INLINE_FUNCTION
     T* pointer() const;
 
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedArrayKokkos <T> slice(size_t dim, size_t index) const;
+
+    ViewStridedArrayKokkos <T> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                        SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                        SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     KOKKOS_INLINE_FUNCTION
     ~ViewFArrayKokkos();
 
@@ -870,6 +1550,19 @@ template <typename T>
 KOKKOS_INLINE_FUNCTION
 ViewFArrayKokkos<T>::~ViewFArrayKokkos() {}
 
+template <typename T>
+ViewStridedArrayKokkos <T> ViewFArrayKokkos<T>::slice(size_t dim, size_t index) const {
+    return ViewStridedArrayKokkos <T>(this_array_, slice_shape(dense_shape(order_, dims_, dims_[0], false), dim, index, 0));
+}
+
+template <typename T>
+ViewStridedArrayKokkos <T> ViewFArrayKokkos<T>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                         SliceRange r3, SliceRange r4,
+                                                         SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedArrayKokkos <T>(this_array_, subarray_shape(dense_shape(order_, dims_, dims_[0], false), ranges, 0));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // End of ViewFArrayKokkos
 ////////////////////////////////////////////////////////////////////////////////
@@ -956,6 +1649,15 @@ public:
     KOKKOS_INLINE_FUNCTION
     TArray1D get_kokkos_view() const;
 
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedMatrixKokkos <T,ExecSpace> slice(size_t dim, size_t index) const;
+
+    ViewStridedMatrixKokkos <T,ExecSpace> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                                   SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                                   SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     KOKKOS_INLINE_FUNCTION
     ~FMatrixKokkos();
 
@@ -1234,6 +1936,19 @@ template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits
 KOKKOS_INLINE_FUNCTION
 FMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::~FMatrixKokkos() {}
 
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedMatrixKokkos <T,ExecSpace> FMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::slice(size_t dim, size_t index) const {
+    return ViewStridedMatrixKokkos <T,ExecSpace>(this_matrix_, slice_shape(dense_shape(order_, dims_, dims_[0], false), dim, index, 1));
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedMatrixKokkos <T,ExecSpace> FMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                               SliceRange r3, SliceRange r4,
+                                                                                               SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedMatrixKokkos <T,ExecSpace>(this_matrix_, subarray_shape(dense_shape(order_, dims_, dims_[0], false), ranges, 1));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // End of FMatrixKokkos
 ////////////////////////////////////////////////////////////////////////////////
@@ -1322,6 +2037,15 @@ public:
     KOKKOS_INLINE_FUNCTION
     T* pointer() const;
 
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedMatrixKokkos <T> slice(size_t dim, size_t index) const;
+
+    ViewStridedMatrixKokkos <T> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                         SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                         SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     KOKKOS_INLINE_FUNCTION
     ~ViewFMatrixKokkos();
     
@@ -1578,6 +2302,19 @@ template <typename T>
 KOKKOS_INLINE_FUNCTION
 ViewFMatrixKokkos<T>::~ViewFMatrixKokkos() {}
 
+template <typename T>
+ViewStridedMatrixKokkos <T> ViewFMatrixKokkos<T>::slice(size_t dim, size_t index) const {
+    return ViewStridedMatrixKokkos <T>(this_matrix_, slice_shape(dense_shape(order_, dims_, dims_[0], false), dim, index, 1));
+}
+
+template <typename T>
+ViewStridedMatrixKokkos <T> ViewFMatrixKokkos<T>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                           SliceRange r3, SliceRange r4,
+                                                           SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedMatrixKokkos <T>(this_matrix_, subarray_shape(dense_shape(order_, dims_, dims_[0], false), ranges, 1));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // End of ViewFMatrixKokkos
 ////////////////////////////////////////////////////////////////////////////////
@@ -1597,6 +2334,7 @@ private:
     size_t length_;
     size_t order_;  // tensor order (rank)
     TArray1D this_array_;
+    DualSyncState sync_state_;
 
 public:
     // Data member to access host view
@@ -1622,6 +2360,16 @@ public:
     DFArrayKokkos(size_t dim0, size_t dim1, size_t dim2,
                  size_t dim3, size_t dim4, size_t dim5,
                  size_t dim6, const std::string& tag_string = DEFAULTSTRINGARRAY);
+
+    // storage initialized as init says (see ArrayInit), e.g.
+    //     DFArrayKokkos <double> velocity(ArrayInit::first_touch, num_elems, 3);
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    DFArrayKokkos(ArrayInit init, Dims... dim);
+
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    DFArrayKokkos(ArrayInit init, const std::string& tag_string, Dims... dim);
     
     KOKKOS_INLINE_FUNCTION
     T& operator()(size_t i) const;
@@ -1673,12 +2421,52 @@ public:
     KOKKOS_INLINE_FUNCTION
     T* host_pointer() const;
 
-    // Method that update host view
+    // Method that update host view, skipped if the host is already current
     void update_host();
 
-    // Method that update device view
+    // Method that update device view, skipped if the device is already current
     void update_device();
 
+    // Methods that update only a block of the host or device view, one index range
+    // per dimension. Missing ranges cover the whole dimension, so for a 3D array
+    // update_host({k0, k1}) copies the planes k0 to k1-1
+    void update_host(DualRange r0, DualRange r1 = DualRange(), DualRange r2 = DualRange(),
+                     DualRange r3 = DualRange(), DualRange r4 = DualRange(),
+                     DualRange r5 = DualRange(), DualRange r6 = DualRange());
+
+    void update_device(DualRange r0, DualRange r1 = DualRange(), DualRange r2 = DualRange(),
+                       DualRange r3 = DualRange(), DualRange r4 = DualRange(),
+                       DualRange r5 = DualRange(), DualRange r6 = DualRange());
+
+    // Methods that start the update on an execution space instance and return without
+    // waiting. The copy is ordered with the other work on exec and is done once the
+    // returned instance is fenced
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_host_async(const ExecSpaceInstance& exec);
+
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_device_async(const ExecSpaceInstance& exec);
+
+    // Methods that record a write to the host or device data, this turns on
+    // the tracking that lets update_host() and update_device() skip copies
+    void modify_host();
+
+    void modify_device();
+
+    // Methods that report whether each side is known to be current
+    bool host_is_current() const;
+
+    bool device_is_current() const;
+
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedArrayKokkos <T,ExecSpace> slice(size_t dim, size_t index) const;
+
+    ViewStridedArrayKokkos <T,ExecSpace> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                                  SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                                  SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     // Deconstructor
     KOKKOS_INLINE_FUNCTION
     ~DFArrayKokkos ();
@@ -1702,6 +2490,7 @@ DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DFArrayKokkos(size_t dim0, const
     order_ = 1;
     length_ = dim0;
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFArray
     host = ViewFArray <T> (this_array_.h_view.data(), dim0);
 }
@@ -1715,6 +2504,7 @@ DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DFArrayKokkos(size_t dim0, size_
     order_ = 2;
     length_ = (dim0 * dim1);
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFArray
     host = ViewFArray <T> (this_array_.h_view.data(), dim0, dim1);
 }
@@ -1729,6 +2519,7 @@ DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DFArrayKokkos(size_t dim0, size_
     order_ = 3;
     length_ = (dim0 * dim1 * dim2);
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFArray
     host = ViewFArray <T> (this_array_.h_view.data(), dim0, dim1, dim2);
 }
@@ -1744,6 +2535,7 @@ DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DFArrayKokkos(size_t dim0, size_
     order_ = 4;
     length_ = (dim0 * dim1 * dim2 * dim3);
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFArray
     host = ViewFArray <T> (this_array_.h_view.data(), dim0, dim1, dim2, dim3);
 }
@@ -1761,6 +2553,7 @@ DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DFArrayKokkos(size_t dim0, size_
     order_ = 5;
     length_ = (dim0 * dim1 * dim2 * dim3 * dim4);
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFArray
     host = ViewFArray <T> (this_array_.h_view.data(), dim0, dim1, dim2, dim3, dim4);
 }
@@ -1779,6 +2572,7 @@ DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DFArrayKokkos(size_t dim0, size_
     order_ = 6;
     length_ = (dim0 * dim1 * dim2 * dim3 * dim4 * dim5);
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFArray
     host = ViewFArray <T> (this_array_.h_view.data(), dim0, dim1, dim2, dim3, dim4, dim5);
 }
@@ -1799,17 +2593,41 @@ DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DFArrayKokkos(size_t dim0, size_
     order_ = 7;
     length_ = (dim0 * dim1 * dim2 * dim3 * dim4 * dim5 * dim6);
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFArray
     host = ViewFArray <T> (this_array_.h_view.data(), dim0, dim1, dim2, dim3, dim4, dim5, dim6);
 }
 
+// ArrayInit constructors
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
-KOKKOS_INLINE_FUNCTION
-T& DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::operator()(size_t i) const {
-    assert(order_ == 1 && "Tensor order (rank) does not match constructor in DFArrayKokkos 1D!");
-    assert(i >= 0 && i < dims_[0] && "i is out of bounds in DFArrayKokkos 1D!");
-    return this_array_.d_view(i);
-}
+template <typename... Dims, typename>
+DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DFArrayKokkos(ArrayInit init, Dims... dim)
+    : DFArrayKokkos(init, DEFAULTSTRINGARRAY, dim...) {}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DFArrayKokkos(ArrayInit init, const std::string& tag_string, Dims... dim) {
+    static_assert(sizeof...(Dims) >= 1 && sizeof...(Dims) <= 7, "DFArrayKokkos takes 1 to 7 dims!");
+    const size_t dims_in[] = {static_cast<size_t>(dim)...};
+    order_ = sizeof...(Dims);
+    length_ = 1;
+    for (size_t i = 0; i < 7; i++) {
+        dims_[i] = (i < order_) ? dims_in[i] : 0;
+        length_ *= (i < order_) ? dims_in[i] : 1;
+    }
+    this_array_ = init_dual_view<TArray1D>(init, tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
+    // Create host ViewFArray
+    host = ViewFArray <T> (this_array_.h_view.data(), static_cast<size_t>(dim)...);
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+T& DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::operator()(size_t i) const {
+    assert(order_ == 1 && "Tensor order (rank) does not match constructor in DFArrayKokkos 1D!");
+    assert(i >= 0 && i < dims_[0] && "i is out of bounds in DFArrayKokkos 1D!");
+    return this_array_.d_view(i);
+}
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
@@ -1912,6 +2730,7 @@ DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>& DFArrayKokkos<T,Layout,ExecSpace
         length_ = temp.length_;
         this_array_ = temp.this_array_;
     host = temp.host;
+        sync_state_ = temp.sync_state_;
     }
     
     return *this;
@@ -1958,21 +2777,100 @@ T* DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::host_pointer() const {
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host() {
-
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     this_array_.template modify<typename TArray1D::execution_space>();
     this_array_.template sync<typename TArray1D::host_mirror_space>();
+    sync_state_.mark_synced();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device() {
-
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     this_array_.template modify<typename TArray1D::host_mirror_space>();
     this_array_.template sync<typename TArray1D::execution_space>();
+    sync_state_.mark_synced();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host(DualRange r0, DualRange r1, DualRange r2,
+                                                                 DualRange r3, DualRange r4, DualRange r5, DualRange r6) {
+    const DualRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    dual_update_block<T, typename TArray1D::execution_space>(host_pointer(), device_pointer(), dims_, order_, false, true, ranges);
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device(DualRange r0, DualRange r1, DualRange r2,
+                                                                   DualRange r3, DualRange r4, DualRange r5, DualRange r6) {
+    const DualRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    dual_update_block<T, typename TArray1D::execution_space>(host_pointer(), device_pointer(), dims_, order_, false, false, ranges);
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_array_.h_view, this_array_.d_view);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_array_.d_view, this_array_.h_view);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_host() {
+    sync_state_.modify_host();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_device() {
+    sync_state_.modify_device();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::host_is_current() const {
+    return sync_state_.host_is_current();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::device_is_current() const {
+    return sync_state_.device_is_current();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::~DFArrayKokkos() {}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedArrayKokkos <T,ExecSpace> DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::slice(size_t dim, size_t index) const {
+    return ViewStridedArrayKokkos <T,ExecSpace>(this_array_.d_view, slice_shape(dense_shape(order_, dims_, dims_[0], false), dim, index, 0));
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedArrayKokkos <T,ExecSpace> DFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                              SliceRange r3, SliceRange r4,
+                                                                                              SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedArrayKokkos <T,ExecSpace>(this_array_.d_view, subarray_shape(dense_shape(order_, dims_, dims_[0], false), ranges, 0));
+}
 // End DFArrayKokkos
 
 
@@ -1997,6 +2895,7 @@ private:
     size_t length_;
     size_t order_;  // tensor order (rank)
     TArray1D this_array_;
+    DualSyncState sync_state_;
     TArray1DHost this_array_host_;
     T * temp_inp_array_;
 
@@ -2075,12 +2974,52 @@ public:
     // Data member to access host view
     ViewFArray <T> host;
 
-    // Method that update host view
+    // Method that update host view, skipped if the host is already current
     void update_host();
 
-    // Method that update device view
+    // Method that update device view, skipped if the device is already current
     void update_device();
 
+    // Methods that update only a block of the host or device view, one index range
+    // per dimension. Missing ranges cover the whole dimension, so for a 3D array
+    // update_host({k0, k1}) copies the planes k0 to k1-1
+    void update_host(DualRange r0, DualRange r1 = DualRange(), DualRange r2 = DualRange(),
+                     DualRange r3 = DualRange(), DualRange r4 = DualRange(),
+                     DualRange r5 = DualRange(), DualRange r6 = DualRange());
+
+    void update_device(DualRange r0, DualRange r1 = DualRange(), DualRange r2 = DualRange(),
+                       DualRange r3 = DualRange(), DualRange r4 = DualRange(),
+                       DualRange r5 = DualRange(), DualRange r6 = DualRange());
+
+    // Methods that start the update on an execution space instance and return without
+    // waiting. The copy is ordered with the other work on exec and is done once the
+    // returned instance is fenced
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_host_async(const ExecSpaceInstance& exec);
+
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_device_async(const ExecSpaceInstance& exec);
+
+    // Methods that record a write to the host or device data, this turns on
+    // the tracking that lets update_host() and update_device() skip copies
+    void modify_host();
+
+    void modify_device();
+
+    // Methods that report whether each side is known to be current
+    bool host_is_current() const;
+
+    bool device_is_current() const;
+
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedArrayKokkos <T,ExecSpace> slice(size_t dim, size_t index) const;
+
+    ViewStridedArrayKokkos <T,ExecSpace> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                                  SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                                  SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     // Deconstructor
     KOKKOS_INLINE_FUNCTION
     ~DViewFArrayKokkos ();
@@ -2112,6 +3051,7 @@ DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFArray. Note: inp_array and this_array_host_.data() are the same pointer
     host = ViewFArray <T> (inp_array, dim0);
 }
@@ -2133,6 +3073,7 @@ DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFArray
     host = ViewFArray <T> (inp_array, dim0, dim1);
 }
@@ -2153,6 +3094,7 @@ DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFArray
     host = ViewFArray <T> (inp_array, dim0, dim1, dim2);
 }
@@ -2174,6 +3116,7 @@ DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFArray
     host = ViewFArray <T> (inp_array, dim0, dim1, dim2, dim3);
 }
@@ -2198,6 +3141,7 @@ DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFArray
     host = ViewFArray <T> (inp_array, dim0, dim1, dim2, dim3, dim4);
 }
@@ -2222,6 +3166,7 @@ DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFArray
     host = ViewFArray <T> (inp_array, dim0, dim1, dim2, dim3, dim4, dim5);
 }
@@ -2248,6 +3193,7 @@ DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFArray
     host = ViewFArray <T> (inp_array, dim0, dim1, dim2, dim3, dim4, dim5, dim6);
 }
@@ -2363,6 +3309,7 @@ DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>& DViewFArrayKokkos<T,Layout,E
         this_array_host_ = temp.this_array_host_;
         this_array_ = temp.this_array_;
         host = temp.host;
+        sync_state_ = temp.sync_state_;
     }
     
     return *this;
@@ -2409,19 +3356,100 @@ T* DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::host_pointer() const {
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host() {
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     // Deep copy of device view to host view
     deep_copy(this_array_host_, this_array_);
+    sync_state_.mark_synced();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device() {
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     // Deep copy of host view to device view
     deep_copy(this_array_, this_array_host_);
+    sync_state_.mark_synced();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host(DualRange r0, DualRange r1, DualRange r2,
+                                                                     DualRange r3, DualRange r4, DualRange r5, DualRange r6) {
+    const DualRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    dual_update_block<T, typename TArray1D::execution_space>(host_pointer(), device_pointer(), dims_, order_, false, true, ranges);
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device(DualRange r0, DualRange r1, DualRange r2,
+                                                                       DualRange r3, DualRange r4, DualRange r5, DualRange r6) {
+    const DualRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    dual_update_block<T, typename TArray1D::execution_space>(host_pointer(), device_pointer(), dims_, order_, false, false, ranges);
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_array_host_, this_array_);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_array_, this_array_host_);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_host() {
+    sync_state_.modify_host();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_device() {
+    sync_state_.modify_device();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::host_is_current() const {
+    return sync_state_.host_is_current();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::device_is_current() const {
+    return sync_state_.device_is_current();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::~DViewFArrayKokkos() {}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedArrayKokkos <T,ExecSpace> DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::slice(size_t dim, size_t index) const {
+    return ViewStridedArrayKokkos <T,ExecSpace>(this_array_, slice_shape(dense_shape(order_, dims_, dims_[0], false), dim, index, 0));
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedArrayKokkos <T,ExecSpace> DViewFArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                                  SliceRange r3, SliceRange r4,
+                                                                                                  SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedArrayKokkos <T,ExecSpace>(this_array_, subarray_shape(dense_shape(order_, dims_, dims_[0], false), ranges, 0));
+}
 // End DViewFArrayKokkos
 
 
@@ -2439,6 +3467,7 @@ private:
     size_t length_;
     size_t order_;  // tensor order (rank)
     TArray1D this_matrix_;
+    DualSyncState sync_state_;
 
 public:
     DFMatrixKokkos();
@@ -2515,12 +3544,41 @@ public:
     // Data member to access host view
     ViewFMatrix <T> host;
 
-    // Method that update host view
+    // Method that update host view, skipped if the host is already current
     void update_host();
 
-    // Method that update device view
+    // Method that update device view, skipped if the device is already current
     void update_device();
 
+    // Methods that start the update on an execution space instance and return without
+    // waiting. The copy is ordered with the other work on exec and is done once the
+    // returned instance is fenced
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_host_async(const ExecSpaceInstance& exec);
+
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_device_async(const ExecSpaceInstance& exec);
+
+    // Methods that record a write to the host or device data, this turns on
+    // the tracking that lets update_host() and update_device() skip copies
+    void modify_host();
+
+    void modify_device();
+
+    // Methods that report whether each side is known to be current
+    bool host_is_current() const;
+
+    bool device_is_current() const;
+
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedMatrixKokkos <T,ExecSpace> slice(size_t dim, size_t index) const;
+
+    ViewStridedMatrixKokkos <T,ExecSpace> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                                   SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                                   SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     // Deconstructor
     KOKKOS_INLINE_FUNCTION
     ~DFMatrixKokkos ();
@@ -2543,6 +3601,7 @@ DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DFMatrixKokkos(size_t dim1, con
     order_ = 1;
     length_ = dim1;
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (this_matrix_.h_view.data(), dim1);
 }
@@ -2556,6 +3615,7 @@ DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DFMatrixKokkos(size_t dim1, siz
     order_ = 2;
     length_ = (dim1 * dim2);
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (this_matrix_.h_view.data(), dim1, dim2);
 }
@@ -2570,6 +3630,7 @@ DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DFMatrixKokkos(size_t dim1, siz
     order_ = 3;
     length_ = (dim1 * dim2 * dim3);
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (this_matrix_.h_view.data(), dim1, dim2, dim3);
 }
@@ -2585,6 +3646,7 @@ DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DFMatrixKokkos(size_t dim1, siz
     order_ = 4;
     length_ = (dim1 * dim2 * dim3 * dim4);
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (this_matrix_.h_view.data(), dim1, dim2, dim3, dim4);
 }
@@ -2602,6 +3664,7 @@ DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DFMatrixKokkos(size_t dim1, siz
     order_ = 5;
     length_ = (dim1 * dim2 * dim3 * dim4 * dim5);
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (this_matrix_.h_view.data(), dim1, dim2, dim3, dim4, dim5);
 }
@@ -2620,6 +3683,7 @@ DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DFMatrixKokkos(size_t dim1, siz
     order_ = 6;
     length_ = (dim1 * dim2 * dim3 * dim4 * dim5 * dim6);
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (this_matrix_.h_view.data(), dim1, dim2, dim3, dim4, dim5, dim6);
 }
@@ -2640,6 +3704,7 @@ DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DFMatrixKokkos(size_t dim1, siz
     order_ = 7;
     length_ = (dim1 * dim2 * dim3 * dim4 * dim5 * dim6 * dim7);
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (this_matrix_.h_view.data(), dim1, dim2, dim3, dim4, dim5, dim6, dim7);
 }
@@ -2753,6 +3818,7 @@ DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>& DFMatrixKokkos<T,Layout,ExecSpa
         length_ = temp.length_;
         this_matrix_ = temp.this_matrix_;
     host = temp.host;
+        sync_state_ = temp.sync_state_;
     }
     
     return *this;
@@ -2800,21 +3866,86 @@ T* DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::host_pointer() const {
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host() {
-
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     this_matrix_.template modify<typename TArray1D::execution_space>();
     this_matrix_.template sync<typename TArray1D::host_mirror_space>();
+    sync_state_.mark_synced();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device() {
-
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     this_matrix_.template modify<typename TArray1D::host_mirror_space>();
     this_matrix_.template sync<typename TArray1D::execution_space>();
+    sync_state_.mark_synced();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_matrix_.h_view, this_matrix_.d_view);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_matrix_.d_view, this_matrix_.h_view);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_host() {
+    sync_state_.modify_host();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_device() {
+    sync_state_.modify_device();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::host_is_current() const {
+    return sync_state_.host_is_current();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::device_is_current() const {
+    return sync_state_.device_is_current();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::~DFMatrixKokkos() {}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedMatrixKokkos <T,ExecSpace> DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::slice(size_t dim, size_t index) const {
+    return ViewStridedMatrixKokkos <T,ExecSpace>(this_matrix_.d_view, slice_shape(dense_shape(order_, dims_, dims_[0], false), dim, index, 1));
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedMatrixKokkos <T,ExecSpace> DFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                                SliceRange r3, SliceRange r4,
+                                                                                                SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedMatrixKokkos <T,ExecSpace>(this_matrix_.d_view, subarray_shape(dense_shape(order_, dims_, dims_[0], false), ranges, 1));
+}
 // End DFMatrixKokkos
 
 
@@ -2834,6 +3965,7 @@ private:
     size_t length_;
     size_t order_;  // tensor order (rank)
     TArray1D this_matrix_;
+    DualSyncState sync_state_;
     TArray1DHost this_matrix_host_;
     T * temp_inp_matrix_;
 
@@ -2912,12 +4044,41 @@ public:
     // Data member to access host view
     ViewFMatrix <T> host;
 
-    // Method that update host view
+    // Method that update host view, skipped if the host is already current
     void update_host();
 
-    // Method that update device view
+    // Method that update device view, skipped if the device is already current
     void update_device();
 
+    // Methods that start the update on an execution space instance and return without
+    // waiting. The copy is ordered with the other work on exec and is done once the
+    // returned instance is fenced
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_host_async(const ExecSpaceInstance& exec);
+
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_device_async(const ExecSpaceInstance& exec);
+
+    // Methods that record a write to the host or device data, this turns on
+    // the tracking that lets update_host() and update_device() skip copies
+    void modify_host();
+
+    void modify_device();
+
+    // Methods that report whether each side is known to be current
+    bool host_is_current() const;
+
+    bool device_is_current() const;
+
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedMatrixKokkos <T,ExecSpace> slice(size_t dim, size_t index) const;
+
+    ViewStridedMatrixKokkos <T,ExecSpace> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                                   SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                                   SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     // Deconstructor
     KOKKOS_INLINE_FUNCTION
     ~DViewFMatrixKokkos ();
@@ -2947,6 +4108,7 @@ DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFMatrix. Note: inp_matrix and this_matrix_host_.data() are the same pointer
     host = ViewFMatrix <T> (inp_matrix, dim1);
 }
@@ -2965,6 +4127,7 @@ DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (inp_matrix, dim1, dim2);
 }
@@ -2984,6 +4147,7 @@ DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (inp_matrix, dim1, dim2, dim3);
 }
@@ -3004,6 +4168,7 @@ DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (inp_matrix, dim1, dim2, dim3, dim4);
 }
@@ -3026,6 +4191,7 @@ DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (inp_matrix, dim1, dim2, dim3, dim4, dim5);
 }
@@ -3049,6 +4215,7 @@ DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (inp_matrix, dim1, dim2, dim3, dim4, dim5, dim6);
 }
@@ -3074,6 +4241,7 @@ DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewFMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewFMatrix
     host = ViewFMatrix <T> (inp_matrix, dim1, dim2, dim3, dim4, dim5, dim6, dim7);
 }
@@ -3189,6 +4357,7 @@ DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>& DViewFMatrixKokkos<T,Layout
         this_matrix_host_ = temp.this_matrix_host_;
         this_matrix_ = temp.this_matrix_;
     host = temp.host;
+        sync_state_ = temp.sync_state_;
     }
     
     return *this;
@@ -3236,19 +4405,86 @@ T* DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::host_pointer() const {
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host() {
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     // Deep copy of device view to host view
     deep_copy(this_matrix_host_, this_matrix_);
+    sync_state_.mark_synced();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device() {
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     // Deep copy of host view to device view
     deep_copy(this_matrix_, this_matrix_host_);
+    sync_state_.mark_synced();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_matrix_host_, this_matrix_);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_matrix_, this_matrix_host_);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_host() {
+    sync_state_.modify_host();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_device() {
+    sync_state_.modify_device();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::host_is_current() const {
+    return sync_state_.host_is_current();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::device_is_current() const {
+    return sync_state_.device_is_current();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::~DViewFMatrixKokkos() {}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedMatrixKokkos <T,ExecSpace> DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::slice(size_t dim, size_t index) const {
+    return ViewStridedMatrixKokkos <T,ExecSpace>(this_matrix_, slice_shape(dense_shape(order_, dims_, dims_[0], false), dim, index, 1));
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedMatrixKokkos <T,ExecSpace> DViewFMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                                    SliceRange r3, SliceRange r4,
+                                                                                                    SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedMatrixKokkos <T,ExecSpace>(this_matrix_, subarray_shape(dense_shape(order_, dims_, dims_[0], false), ranges, 1));
+}
 // End DViewFMatrixKokkos
 
 
@@ -3287,6 +4523,23 @@ public:
     CArrayKokkos(size_t dim0, size_t dim1, size_t dim2,
                  size_t dim3, size_t dim4, size_t dim5,
                  size_t dim6, const std::string& tag_string = DEFAULTSTRINGARRAY);
+
+    // storage initialized as init says (see ArrayInit), e.g.
+    //     CArrayKokkos <double> flux(ArrayInit::first_touch, num_elems, 3);
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    CArrayKokkos(ArrayInit init, Dims... dim);
+
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    CArrayKokkos(ArrayInit init, const std::string& tag_string, Dims... dim);
+
+    // scratch storage from a scoped allocator, an ArenaAllocator over a
+    // KokkosAllocator of ExecSpace's memory.  It is not zero-filled and is
+    // valid until the arena scope that made it ends
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    CArrayKokkos(Allocator& allocator, Dims... dim);
     
     KOKKOS_INLINE_FUNCTION
     T& operator()(size_t i) const;
@@ -3314,6 +4567,11 @@ public:
     KOKKOS_INLINE_FUNCTION
     CArrayKokkos& operator=(const CArrayKokkos& temp);
 
+    // evaluates an elementwise expression (expressions.h) into this array
+    // on ExecSpace, called on the host
+    template <typename E, typename = typename E::matar_expr>
+    CArrayKokkos& operator= (const E& expr);
+
     // GPU Method
     // Method that returns size
     KOKKOS_INLINE_FUNCTION
@@ -3338,6 +4596,15 @@ public:
     KOKKOS_INLINE_FUNCTION
     TArray1D get_kokkos_view() const;
 
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedArrayKokkos <T,ExecSpace> slice(size_t dim, size_t index) const;
+
+    ViewStridedArrayKokkos <T,ExecSpace> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                                  SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                                  SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     // Deconstructor
     KOKKOS_INLINE_FUNCTION
     ~CArrayKokkos ();
@@ -3455,6 +4722,43 @@ CArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::CArrayKokkos(size_t dim0, size_t
     this_array_ = TArray1D(tag_string, length_);
 }
 
+// scratch constructor
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+CArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::CArrayKokkos(Allocator& allocator, Dims... dim) {
+    static_assert(sizeof...(Dims) >= 1 && sizeof...(Dims) <= 7, "CArrayKokkos scratch constructor takes 1 to 7 dims!");
+    assert(allocator.scoped() && "CArrayKokkos scratch storage must come from a scoped allocator (an ArenaAllocator)!");
+    const size_t dims_in[] = {static_cast<size_t>(dim)...};
+    order_ = sizeof...(Dims);
+    length_ = 1;
+    for (size_t i = 0; i < 7; i++) {
+        dims_[i] = (i < order_) ? dims_in[i] : 0;
+        length_ *= (i < order_) ? dims_in[i] : 1;
+    }
+    T* data = static_cast<T*>(allocator.allocate(length_ * sizeof(T), alignof(T)));
+    this_array_ = TArray1D(data, length_);
+}
+
+// ArrayInit constructors
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+CArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::CArrayKokkos(ArrayInit init, Dims... dim)
+    : CArrayKokkos(init, DEFAULTSTRINGARRAY, dim...) {}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+CArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::CArrayKokkos(ArrayInit init, const std::string& tag_string, Dims... dim) {
+    static_assert(sizeof...(Dims) >= 1 && sizeof...(Dims) <= 7, "CArrayKokkos takes 1 to 7 dims!");
+    const size_t dims_in[] = {static_cast<size_t>(dim)...};
+    order_ = sizeof...(Dims);
+    length_ = 1;
+    for (size_t i = 0; i < 7; i++) {
+        dims_[i] = (i < order_) ? dims_in[i] : 0;
+        length_ *= (i < order_) ? dims_in[i] : 1;
+    }
+    this_array_ = init_view<TArray1D>(init, tag_string, length_);
+}
+
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 T& CArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::operator()(size_t i) const {
@@ -3569,6 +4873,14 @@ CArrayKokkos<T,Layout,ExecSpace,MemoryTraits>& CArrayKokkos<T,Layout,ExecSpace,M
     return *this;
 }
 
+// expression assignment
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename E, typename>
+CArrayKokkos<T,Layout,ExecSpace,MemoryTraits>& CArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::operator= (const E& expr) {
+    assign_expr(*this, expr);
+    return *this;
+}
+
 // Return size
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
@@ -3613,6 +4925,19 @@ template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits
 KOKKOS_INLINE_FUNCTION
 CArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::~CArrayKokkos() {}
 
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedArrayKokkos <T,ExecSpace> CArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::slice(size_t dim, size_t index) const {
+    return ViewStridedArrayKokkos <T,ExecSpace>(this_array_, slice_shape(dense_shape(order_, dims_, dims_[order_-1], true), dim, index, 0));
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedArrayKokkos <T,ExecSpace> CArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                             SliceRange r3, SliceRange r4,
+                                                                                             SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedArrayKokkos <T,ExecSpace>(this_array_, subarray_shape(dense_shape(order_, dims_, dims_[order_-1], true), ranges, 0));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // End of CArrayKokkos
 ////////////////////////////////////////////////////////////////////////////////
@@ -3699,6 +5024,15 @@ public:
     KOKKOS_INLINE_FUNCTION
     T* pointer() const;
 
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedArrayKokkos <T> slice(size_t dim, size_t index) const;
+
+    ViewStridedArrayKokkos <T> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                        SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                        SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     KOKKOS_INLINE_FUNCTION
     ~ViewCArrayKokkos();
     
@@ -3950,6 +5284,19 @@ template <typename T>
 KOKKOS_INLINE_FUNCTION
 ViewCArrayKokkos<T>::~ViewCArrayKokkos() {}
 
+template <typename T>
+ViewStridedArrayKokkos <T> ViewCArrayKokkos<T>::slice(size_t dim, size_t index) const {
+    return ViewStridedArrayKokkos <T>(this_array_, slice_shape(dense_shape(order_, dims_, dims_[order_-1], true), dim, index, 0));
+}
+
+template <typename T>
+ViewStridedArrayKokkos <T> ViewCArrayKokkos<T>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                         SliceRange r3, SliceRange r4,
+                                                         SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedArrayKokkos <T>(this_array_, subarray_shape(dense_shape(order_, dims_, dims_[order_-1], true), ranges, 0));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // End of ViewCArrayKokkos
 ////////////////////////////////////////////////////////////////////////////////
@@ -4035,6 +5382,15 @@ public:
     KOKKOS_INLINE_FUNCTION
     TArray1D get_kokkos_view() const;
 
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedMatrixKokkos <T,ExecSpace> slice(size_t dim, size_t index) const;
+
+    ViewStridedMatrixKokkos <T,ExecSpace> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                                   SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                                   SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     KOKKOS_INLINE_FUNCTION
     ~CMatrixKokkos();
 
@@ -4317,6 +5673,19 @@ template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits
 KOKKOS_INLINE_FUNCTION
 CMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::~CMatrixKokkos() {}
 
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedMatrixKokkos <T,ExecSpace> CMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::slice(size_t dim, size_t index) const {
+    return ViewStridedMatrixKokkos <T,ExecSpace>(this_matrix_, slice_shape(dense_shape(order_, dims_, dims_[order_-1], true), dim, index, 1));
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedMatrixKokkos <T,ExecSpace> CMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                               SliceRange r3, SliceRange r4,
+                                                                                               SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedMatrixKokkos <T,ExecSpace>(this_matrix_, subarray_shape(dense_shape(order_, dims_, dims_[order_-1], true), ranges, 1));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // End of CMatrixKokkos
 ////////////////////////////////////////////////////////////////////////////////
@@ -4398,6 +5767,15 @@ public:
     KOKKOS_INLINE_FUNCTION
     T* pointer() const;
 
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedMatrixKokkos <T> slice(size_t dim, size_t index) const;
+
+    ViewStridedMatrixKokkos <T> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                         SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                         SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     KOKKOS_INLINE_FUNCTION
     ~ViewCMatrixKokkos();
 
@@ -4646,6 +6024,19 @@ template <typename T>
 KOKKOS_INLINE_FUNCTION
 ViewCMatrixKokkos<T>::~ViewCMatrixKokkos() {}
 
+template <typename T>
+ViewStridedMatrixKokkos <T> ViewCMatrixKokkos<T>::slice(size_t dim, size_t index) const {
+    return ViewStridedMatrixKokkos <T>(this_matrix_, slice_shape(dense_shape(order_, dims_, dims_[order_-1], true), dim, index, 1));
+}
+
+template <typename T>
+ViewStridedMatrixKokkos <T> ViewCMatrixKokkos<T>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                           SliceRange r3, SliceRange r4,
+                                                           SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedMatrixKokkos <T>(this_matrix_, subarray_shape(dense_shape(order_, dims_, dims_[order_-1], true), ranges, 1));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // End of ViewCMatrixKokkos
 ////////////////////////////////////////////////////////////////////////////////
@@ -4664,6 +6055,7 @@ private:
     size_t length_;
     size_t order_;  // tensor order (rank)
     TArray1D this_array_;
+    DualSyncState sync_state_;
 
 public:
     // Data member to access host view
@@ -4689,6 +6081,16 @@ public:
     DCArrayKokkos(size_t dim0, size_t dim1, size_t dim2,
                  size_t dim3, size_t dim4, size_t dim5,
                  size_t dim6, const std::string& tag_string = DEFAULTSTRINGARRAY);
+
+    // storage initialized as init says (see ArrayInit), e.g.
+    //     DCArrayKokkos <double> velocity(ArrayInit::first_touch, num_elems, 3);
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    DCArrayKokkos(ArrayInit init, Dims... dim);
+
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    DCArrayKokkos(ArrayInit init, const std::string& tag_string, Dims... dim);
     
     KOKKOS_INLINE_FUNCTION
     T& operator()(size_t i) const;
@@ -4744,12 +6146,52 @@ public:
     KOKKOS_INLINE_FUNCTION
     TArray1D get_kokkos_dual_view() const;
 
-    // Method that update host view
+    // Method that update host view, skipped if the host is already current
     void update_host();
 
-    // Method that update device view
+    // Method that update device view, skipped if the device is already current
     void update_device();
 
+    // Methods that update only a block of the host or device view, one index range
+    // per dimension. Missing ranges cover the whole dimension, so for a 3D array
+    // update_host({k0, k1}) copies the planes k0 to k1-1
+    void update_host(DualRange r0, DualRange r1 = DualRange(), DualRange r2 = DualRange(),
+                     DualRange r3 = DualRange(), DualRange r4 = DualRange(),
+                     DualRange r5 = DualRange(), DualRange r6 = DualRange());
+
+    void update_device(DualRange r0, DualRange r1 = DualRange(), DualRange r2 = DualRange(),
+                       DualRange r3 = DualRange(), DualRange r4 = DualRange(),
+                       DualRange r5 = DualRange(), DualRange r6 = DualRange());
+
+    // Methods that start the update on an execution space instance and return without
+    // waiting. The copy is ordered with the other work on exec and is done once the
+    // returned instance is fenced
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_host_async(const ExecSpaceInstance& exec);
+
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_device_async(const ExecSpaceInstance& exec);
+
+    // Methods that record a write to the host or device data, this turns on
+    // the tracking that lets update_host() and update_device() skip copies
+    void modify_host();
+
+    void modify_device();
+
+    // Methods that report whether each side is known to be current
+    bool host_is_current() const;
+
+    bool device_is_current() const;
+
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedArrayKokkos <T,ExecSpace> slice(size_t dim, size_t index) const;
+
+    ViewStridedArrayKokkos <T,ExecSpace> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                                  SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                                  SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     // Deconstructor
     KOKKOS_INLINE_FUNCTION
     ~DCArrayKokkos ();
@@ -4773,6 +6215,7 @@ DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DCArrayKokkos(size_t dim0, const
     order_ = 1;
     length_ = dim0;
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCArray
     host = ViewCArray <T> (this_array_.h_view.data(), dim0);
 }
@@ -4786,6 +6229,7 @@ DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DCArrayKokkos(size_t dim0, size_
     order_ = 2;
     length_ = (dim0 * dim1);
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCArray
     host = ViewCArray <T> (this_array_.h_view.data(), dim0, dim1);
 }
@@ -4800,6 +6244,7 @@ DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DCArrayKokkos(size_t dim0, size_
     order_ = 3;
     length_ = (dim0 * dim1 * dim2);
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCArray
     host = ViewCArray <T> (this_array_.h_view.data(), dim0, dim1, dim2);
 }
@@ -4815,6 +6260,7 @@ DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DCArrayKokkos(size_t dim0, size_
     order_ = 4;
     length_ = (dim0 * dim1 * dim2 * dim3);
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCArray
     host = ViewCArray <T> (this_array_.h_view.data(), dim0, dim1, dim2, dim3);
 }
@@ -4832,6 +6278,7 @@ DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DCArrayKokkos(size_t dim0, size_
     order_ = 5;
     length_ = (dim0 * dim1 * dim2 * dim3 * dim4);
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCArray
     host = ViewCArray <T> (this_array_.h_view.data(), dim0, dim1, dim2, dim3, dim4);
 }
@@ -4850,6 +6297,7 @@ DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DCArrayKokkos(size_t dim0, size_
     order_ = 6;
     length_ = (dim0 * dim1 * dim2 * dim3 * dim4 * dim5);
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCArray
     host = ViewCArray <T> (this_array_.h_view.data(), dim0, dim1, dim2, dim3, dim4, dim5);
 }
@@ -4870,10 +6318,34 @@ DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DCArrayKokkos(size_t dim0, size_
     order_ = 7;
     length_ = (dim0 * dim1 * dim2 * dim3 * dim4 * dim5 * dim6);
     this_array_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCArray
     host = ViewCArray <T> (this_array_.h_view.data(), dim0, dim1, dim2, dim3, dim4, dim5, dim6);
 }
 
+// ArrayInit constructors
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DCArrayKokkos(ArrayInit init, Dims... dim)
+    : DCArrayKokkos(init, DEFAULTSTRINGARRAY, dim...) {}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DCArrayKokkos(ArrayInit init, const std::string& tag_string, Dims... dim) {
+    static_assert(sizeof...(Dims) >= 1 && sizeof...(Dims) <= 7, "DCArrayKokkos takes 1 to 7 dims!");
+    const size_t dims_in[] = {static_cast<size_t>(dim)...};
+    order_ = sizeof...(Dims);
+    length_ = 1;
+    for (size_t i = 0; i < 7; i++) {
+        dims_[i] = (i < order_) ? dims_in[i] : 0;
+        length_ *= (i < order_) ? dims_in[i] : 1;
+    }
+    this_array_ = init_dual_view<TArray1D>(init, tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
+    // Create host ViewCArray
+    host = ViewCArray <T> (this_array_.h_view.data(), static_cast<size_t>(dim)...);
+}
+
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 T& DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::operator()(size_t i) const {
@@ -4983,6 +6455,7 @@ DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>& DCArrayKokkos<T,Layout,ExecSpace
         length_ = temp.length_;
         this_array_ = temp.this_array_;
         host = temp.host;
+        sync_state_ = temp.sync_state_;
     }
     
     return *this;
@@ -5035,32 +6508,111 @@ Kokkos::DualView <T*, Layout, ExecSpace, MemoryTraits> DCArrayKokkos<T,Layout,Ex
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host() {
-
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     this_array_.template modify<typename TArray1D::execution_space>();
     this_array_.template sync<typename TArray1D::host_mirror_space>();
+    sync_state_.mark_synced();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device() {
-
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     this_array_.template modify<typename TArray1D::host_mirror_space>();
     this_array_.template sync<typename TArray1D::execution_space>();
+    sync_state_.mark_synced();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
-KOKKOS_INLINE_FUNCTION
-DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::~DCArrayKokkos() {}
-// End DCArrayKokkos
+void DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host(DualRange r0, DualRange r1, DualRange r2,
+                                                                 DualRange r3, DualRange r4, DualRange r5, DualRange r6) {
+    const DualRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    dual_update_block<T, typename TArray1D::execution_space>(host_pointer(), device_pointer(), dims_, order_, true, true, ranges);
+}
 
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device(DualRange r0, DualRange r1, DualRange r2,
+                                                                   DualRange r3, DualRange r4, DualRange r5, DualRange r6) {
+    const DualRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    dual_update_block<T, typename TArray1D::execution_space>(host_pointer(), device_pointer(), dims_, order_, true, false, ranges);
+}
 
-/////////////////////////
-// DViewCArrayKokkos
-/////////////////////////
-template <typename T, typename Layout = DefaultLayout, typename ExecSpace = DefaultExecSpace, typename MemoryTraits = void>
-class DViewCArrayKokkos {
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_array_.h_view, this_array_.d_view);
+    sync_state_.mark_synced();
+    return exec;
+}
 
-    // this is always unmanaged
-    using TArray1DHost = Kokkos::View<T*, Layout, HostSpace, MemoryUnmanaged>;
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_array_.d_view, this_array_.h_view);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_host() {
+    sync_state_.modify_host();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_device() {
+    sync_state_.modify_device();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::host_is_current() const {
+    return sync_state_.host_is_current();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::device_is_current() const {
+    return sync_state_.device_is_current();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::~DCArrayKokkos() {}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedArrayKokkos <T,ExecSpace> DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::slice(size_t dim, size_t index) const {
+    return ViewStridedArrayKokkos <T,ExecSpace>(this_array_.d_view, slice_shape(dense_shape(order_, dims_, dims_[order_-1], true), dim, index, 0));
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedArrayKokkos <T,ExecSpace> DCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                              SliceRange r3, SliceRange r4,
+                                                                                              SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedArrayKokkos <T,ExecSpace>(this_array_.d_view, subarray_shape(dense_shape(order_, dims_, dims_[order_-1], true), ranges, 0));
+}
+// End DCArrayKokkos
+
+
+/////////////////////////
+// DViewCArrayKokkos
+/////////////////////////
+template <typename T, typename Layout = DefaultLayout, typename ExecSpace = DefaultExecSpace, typename MemoryTraits = void>
+class DViewCArrayKokkos {
+
+    // this is always unmanaged
+    using TArray1DHost = Kokkos::View<T*, Layout, HostSpace, MemoryUnmanaged>;
     // this is manage
     using TArray1D     = Kokkos::View<T*, Layout, ExecSpace, MemoryTraits>;
     
@@ -5069,6 +6621,7 @@ private:
     size_t length_;
     size_t order_;  // tensor order (rank)
     TArray1D this_array_;
+    DualSyncState sync_state_;
     TArray1DHost this_array_host_;
     T * temp_inp_array_;
     //typename Kokkos::View<T*, Layout, ExecSpace>::HostMirror  h_this_array_;
@@ -5148,12 +6701,52 @@ public:
     // Data member to access host view
     ViewCArray <T> host;
 
-    // Method that update host view
+    // Method that update host view, skipped if the host is already current
     void update_host();
 
-    // Method that update device view
+    // Method that update device view, skipped if the device is already current
     void update_device();
 
+    // Methods that update only a block of the host or device view, one index range
+    // per dimension. Missing ranges cover the whole dimension, so for a 3D array
+    // update_host({k0, k1}) copies the planes k0 to k1-1
+    void update_host(DualRange r0, DualRange r1 = DualRange(), DualRange r2 = DualRange(),
+                     DualRange r3 = DualRange(), DualRange r4 = DualRange(),
+                     DualRange r5 = DualRange(), DualRange r6 = DualRange());
+
+    void update_device(DualRange r0, DualRange r1 = DualRange(), DualRange r2 = DualRange(),
+                       DualRange r3 = DualRange(), DualRange r4 = DualRange(),
+                       DualRange r5 = DualRange(), DualRange r6 = DualRange());
+
+    // Methods that start the update on an execution space instance and return without
+    // waiting. The copy is ordered with the other work on exec and is done once the
+    // returned instance is fenced
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_host_async(const ExecSpaceInstance& exec);
+
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_device_async(const ExecSpaceInstance& exec);
+
+    // Methods that record a write to the host or device data, this turns on
+    // the tracking that lets update_host() and update_device() skip copies
+    void modify_host();
+
+    void modify_device();
+
+    // Methods that report whether each side is known to be current
+    bool host_is_current() const;
+
+    bool device_is_current() const;
+
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedArrayKokkos <T,ExecSpace> slice(size_t dim, size_t index) const;
+
+    ViewStridedArrayKokkos <T,ExecSpace> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                                  SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                                  SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     // Deconstructor
     KOKKOS_INLINE_FUNCTION
     ~DViewCArrayKokkos ();
@@ -5185,6 +6778,7 @@ DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCArray. Note: inp_array and this_array_host_.data() are the same pointer
     host = ViewCArray <T> (inp_array, dim0);
 }
@@ -5206,6 +6800,7 @@ DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCArray
     host = ViewCArray <T> (inp_array, dim0, dim1);
 }
@@ -5226,6 +6821,7 @@ DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCArray
     host = ViewCArray <T> (inp_array, dim0, dim1, dim2);
 }
@@ -5247,6 +6843,7 @@ DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCArray
     host = ViewCArray <T> (inp_array, dim0, dim1, dim2, dim3);
 }
@@ -5271,6 +6868,7 @@ DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCArray
     host = ViewCArray <T> (inp_array, dim0, dim1, dim2, dim3, dim4);
 }
@@ -5295,6 +6893,7 @@ DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCArray
     host = ViewCArray <T> (inp_array, dim0, dim1, dim2, dim3, dim4, dim5);
 }
@@ -5321,6 +6920,7 @@ DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCArrayKokkos(T * inp_ar
     temp_inp_array_ = inp_array;
     // Create a device copy of that host view
     this_array_ = create_mirror_view_and_copy(ExecSpace(), this_array_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCArray
     host = ViewCArray <T> (inp_array, dim0, dim1, dim2, dim3, dim4, dim5, dim6);
 }
@@ -5437,6 +7037,7 @@ DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>& DViewCArrayKokkos<T,Layout,E
         this_array_host_ = temp.this_array_host_;
         this_array_ = temp.this_array_;
         host = temp.host;
+        sync_state_ = temp.sync_state_;
     }
     
     return *this;
@@ -5483,19 +7084,100 @@ T* DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::host_pointer() const {
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host() {
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     // Deep copy of device view to host view
     deep_copy(this_array_host_, this_array_);
+    sync_state_.mark_synced();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device() {
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     // Deep copy of host view to device view
     deep_copy(this_array_, this_array_host_);
+    sync_state_.mark_synced();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host(DualRange r0, DualRange r1, DualRange r2,
+                                                                     DualRange r3, DualRange r4, DualRange r5, DualRange r6) {
+    const DualRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    dual_update_block<T, typename TArray1D::execution_space>(host_pointer(), device_pointer(), dims_, order_, true, true, ranges);
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device(DualRange r0, DualRange r1, DualRange r2,
+                                                                       DualRange r3, DualRange r4, DualRange r5, DualRange r6) {
+    const DualRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    dual_update_block<T, typename TArray1D::execution_space>(host_pointer(), device_pointer(), dims_, order_, true, false, ranges);
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_array_host_, this_array_);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_array_, this_array_host_);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_host() {
+    sync_state_.modify_host();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_device() {
+    sync_state_.modify_device();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::host_is_current() const {
+    return sync_state_.host_is_current();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::device_is_current() const {
+    return sync_state_.device_is_current();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::~DViewCArrayKokkos() {}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedArrayKokkos <T,ExecSpace> DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::slice(size_t dim, size_t index) const {
+    return ViewStridedArrayKokkos <T,ExecSpace>(this_array_, slice_shape(dense_shape(order_, dims_, dims_[order_-1], true), dim, index, 0));
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedArrayKokkos <T,ExecSpace> DViewCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                                  SliceRange r3, SliceRange r4,
+                                                                                                  SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedArrayKokkos <T,ExecSpace>(this_array_, subarray_shape(dense_shape(order_, dims_, dims_[order_-1], true), ranges, 0));
+}
 // End DViewCArrayKokkos
 
 
@@ -5513,6 +7195,7 @@ private:
     size_t length_;
     size_t order_;  // tensor order (rank)
     TArray1D this_matrix_;
+    DualSyncState sync_state_;
 
 public:
     // Data member to access host view
@@ -5589,12 +7272,41 @@ public:
     KOKKOS_INLINE_FUNCTION
     T* host_pointer() const;
 
-    // Method that update host view
+    // Method that update host view, skipped if the host is already current
     void update_host();
 
-    // Method that update device view
+    // Method that update device view, skipped if the device is already current
     void update_device();
 
+    // Methods that start the update on an execution space instance and return without
+    // waiting. The copy is ordered with the other work on exec and is done once the
+    // returned instance is fenced
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_host_async(const ExecSpaceInstance& exec);
+
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_device_async(const ExecSpaceInstance& exec);
+
+    // Methods that record a write to the host or device data, this turns on
+    // the tracking that lets update_host() and update_device() skip copies
+    void modify_host();
+
+    void modify_device();
+
+    // Methods that report whether each side is known to be current
+    bool host_is_current() const;
+
+    bool device_is_current() const;
+
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedMatrixKokkos <T,ExecSpace> slice(size_t dim, size_t index) const;
+
+    ViewStridedMatrixKokkos <T,ExecSpace> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                                   SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                                   SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     // Deconstructor
     KOKKOS_INLINE_FUNCTION
     ~DCMatrixKokkos ();
@@ -5618,6 +7330,7 @@ DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DCMatrixKokkos(size_t dim1, con
     order_ = 1;
     length_ = dim1;
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (this_matrix_.h_view.data(), dim1);
 }
@@ -5631,6 +7344,7 @@ DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DCMatrixKokkos(size_t dim1, siz
     order_ = 2;
     length_ = (dim1 * dim2);
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (this_matrix_.h_view.data(), dim1, dim2);
 }
@@ -5645,6 +7359,7 @@ DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DCMatrixKokkos(size_t dim1, siz
     order_ = 3;
     length_ = (dim1 * dim2 * dim3);
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (this_matrix_.h_view.data(), dim1, dim2, dim3);
 }
@@ -5660,6 +7375,7 @@ DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DCMatrixKokkos(size_t dim1, siz
     order_ = 4;
     length_ = (dim1 * dim2 * dim3 * dim4);
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (this_matrix_.h_view.data(), dim1, dim2, dim3, dim4);
 }
@@ -5677,6 +7393,7 @@ DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DCMatrixKokkos(size_t dim1, siz
     order_ = 5;
     length_ = (dim1 * dim2 * dim3 * dim4 * dim5);
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (this_matrix_.h_view.data(), dim1, dim2, dim3, dim4, dim5);
 }
@@ -5695,6 +7412,7 @@ DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DCMatrixKokkos(size_t dim1, siz
     order_ = 6;
     length_ = (dim1 * dim2 * dim3 * dim4 * dim5 * dim6);
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (this_matrix_.h_view.data(), dim1, dim2, dim3, dim4, dim5, dim6);
 }
@@ -5715,6 +7433,7 @@ DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DCMatrixKokkos(size_t dim1, siz
     order_ = 7;
     length_ = (dim1 * dim2 * dim3 * dim4 * dim5 * dim6 * dim7);
     this_matrix_ = TArray1D(tag_string, length_);
+    sync_state_ = DualSyncState(tag_string);
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (this_matrix_.h_view.data(), dim1, dim2, dim3, dim4, dim5, dim6, dim7);
 }
@@ -5828,6 +7547,7 @@ DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>& DCMatrixKokkos<T,Layout,ExecSpa
         length_ = temp.length_;
         this_matrix_ = temp.this_matrix_;
         host = temp.host;
+        sync_state_ = temp.sync_state_;
     }
     
     return *this;
@@ -5875,21 +7595,86 @@ T* DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::host_pointer() const {
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host() {
-
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     this_matrix_.template modify<typename TArray1D::execution_space>();
     this_matrix_.template sync<typename TArray1D::host_mirror_space>();
+    sync_state_.mark_synced();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device() {
-
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     this_matrix_.template modify<typename TArray1D::host_mirror_space>();
     this_matrix_.template sync<typename TArray1D::execution_space>();
+    sync_state_.mark_synced();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_matrix_.h_view, this_matrix_.d_view);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_matrix_.d_view, this_matrix_.h_view);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_host() {
+    sync_state_.modify_host();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_device() {
+    sync_state_.modify_device();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::host_is_current() const {
+    return sync_state_.host_is_current();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::device_is_current() const {
+    return sync_state_.device_is_current();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::~DCMatrixKokkos() {}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedMatrixKokkos <T,ExecSpace> DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::slice(size_t dim, size_t index) const {
+    return ViewStridedMatrixKokkos <T,ExecSpace>(this_matrix_.d_view, slice_shape(dense_shape(order_, dims_, dims_[order_-1], true), dim, index, 1));
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedMatrixKokkos <T,ExecSpace> DCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                                SliceRange r3, SliceRange r4,
+                                                                                                SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedMatrixKokkos <T,ExecSpace>(this_matrix_.d_view, subarray_shape(dense_shape(order_, dims_, dims_[order_-1], true), ranges, 1));
+}
 // End DCMatrixKokkos
 
 
@@ -5909,6 +7694,7 @@ private:
     size_t length_;
     size_t order_;  // tensor order (rank)
     TArray1D this_matrix_;
+    DualSyncState sync_state_;
     TArray1DHost this_matrix_host_;
     T * temp_inp_matrix_;
 
@@ -5987,12 +7773,41 @@ public:
     // Data member to access host view
     ViewCMatrix <T> host;
 
-    // Method that update host view
+    // Method that update host view, skipped if the host is already current
     void update_host();
 
-    // Method that update device view
+    // Method that update device view, skipped if the device is already current
     void update_device();
 
+    // Methods that start the update on an execution space instance and return without
+    // waiting. The copy is ordered with the other work on exec and is done once the
+    // returned instance is fenced
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_host_async(const ExecSpaceInstance& exec);
+
+    template <typename ExecSpaceInstance>
+    ExecSpaceInstance update_device_async(const ExecSpaceInstance& exec);
+
+    // Methods that record a write to the host or device data, this turns on
+    // the tracking that lets update_host() and update_device() skip copies
+    void modify_host();
+
+    void modify_device();
+
+    // Methods that report whether each side is known to be current
+    bool host_is_current() const;
+
+    bool device_is_current() const;
+
+    // views of part of the array without a copy, made on the host: slice()
+    // fixes dimension dim at index and drops it, subarray() takes a range per
+    // dimension (see SliceRange).  Both are a Kokkos::subview of the storage
+    ViewStridedMatrixKokkos <T,ExecSpace> slice(size_t dim, size_t index) const;
+
+    ViewStridedMatrixKokkos <T,ExecSpace> subarray(SliceRange r0, SliceRange r1 = SliceRange(), SliceRange r2 = SliceRange(),
+                                                   SliceRange r3 = SliceRange(), SliceRange r4 = SliceRange(),
+                                                   SliceRange r5 = SliceRange(), SliceRange r6 = SliceRange()) const;
+
     // Deconstructor
     KOKKOS_INLINE_FUNCTION
     ~DViewCMatrixKokkos ();
@@ -6022,6 +7837,7 @@ DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCMatrix. Note: inp_matrix and this_matrix_host_.data() are the same pointer
     host = ViewCMatrix <T> (inp_matrix, dim1);
 }
@@ -6040,6 +7856,7 @@ DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (inp_matrix, dim1, dim2);
 }
@@ -6059,6 +7876,7 @@ DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (inp_matrix, dim1, dim2, dim3);
 }
@@ -6079,6 +7897,7 @@ DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (inp_matrix, dim1, dim2, dim3, dim4);
 }
@@ -6101,6 +7920,7 @@ DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (inp_matrix, dim1, dim2, dim3, dim4, dim5);
 }
@@ -6124,6 +7944,7 @@ DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (inp_matrix, dim1, dim2, dim3, dim4, dim5, dim6);
 }
@@ -6149,6 +7970,7 @@ DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::DViewCMatrixKokkos(T * inp_
     temp_inp_matrix_ = inp_matrix;
     // Create a device copy of that host view
     this_matrix_ = create_mirror_view_and_copy(ExecSpace(), this_matrix_host_);
+    sync_state_ = DualSyncState("dual_view_");
     // Create host ViewCMatrix
     host = ViewCMatrix <T> (inp_matrix, dim1, dim2, dim3, dim4, dim5, dim6, dim7);
 }
@@ -6264,6 +8086,7 @@ DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>& DViewCMatrixKokkos<T,Layout
         this_matrix_host_ = temp.this_matrix_host_;
         this_matrix_ = temp.this_matrix_;
         host = temp.host;
+        sync_state_ = temp.sync_state_;
     }
     
     return *this;
@@ -6311,19 +8134,86 @@ T* DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::host_pointer() const {
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host() {
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     // Deep copy of device view to host view
     deep_copy(this_matrix_host_, this_matrix_);
+    sync_state_.mark_synced();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 void DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device() {
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return;
+    }
     // Deep copy of host view to device view
     deep_copy(this_matrix_, this_matrix_host_);
+    sync_state_.mark_synced();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_host_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.host_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_matrix_host_, this_matrix_);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename ExecSpaceInstance>
+ExecSpaceInstance DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::update_device_async(const ExecSpaceInstance& exec) {
+    if (sync_state_.device_is_current()) {
+        sync_state_.mark_skipped();
+        return exec;
+    }
+    Kokkos::deep_copy(exec, this_matrix_, this_matrix_host_);
+    sync_state_.mark_synced();
+    return exec;
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_host() {
+    sync_state_.modify_host();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+void DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::modify_device() {
+    sync_state_.modify_device();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::host_is_current() const {
+    return sync_state_.host_is_current();
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+bool DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::device_is_current() const {
+    return sync_state_.device_is_current();
 }
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::~DViewCMatrixKokkos() {}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedMatrixKokkos <T,ExecSpace> DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::slice(size_t dim, size_t index) const {
+    return ViewStridedMatrixKokkos <T,ExecSpace>(this_matrix_, slice_shape(dense_shape(order_, dims_, dims_[order_-1], true), dim, index, 1));
+}
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+ViewStridedMatrixKokkos <T,ExecSpace> DViewCMatrixKokkos<T,Layout,ExecSpace,MemoryTraits>::subarray(SliceRange r0, SliceRange r1, SliceRange r2,
+                                                                                                    SliceRange r3, SliceRange r4,
+                                                                                                    SliceRange r5, SliceRange r6) const {
+    const SliceRange ranges[7] = {r0, r1, r2, r3, r4, r5, r6};
+    return ViewStridedMatrixKokkos <T,ExecSpace>(this_matrix_, subarray_shape(dense_shape(order_, dims_, dims_[order_-1], true), ranges, 1));
+}
 // End DViewCMatrixKokkos
 
 
@@ -6389,6 +8279,10 @@ public:
     size_t size(){
       return length_;
     }
+
+    // number of rows
+    KOKKOS_INLINE_FUNCTION
+    size_t dim1() const;
     
     //setup start indices
     void data_setup(const std::string& tag_string);
@@ -6537,28 +8431,17 @@ void RaggedRightArrayKokkos<T,Layout,ExecSpace,MemoryTraits,ILayout>::data_setup
     Kokkos::parallel_for("StartValuesInit", dim1_+1,execution_functor);
     #endif
 
+    // the scan sets the start indices and its total is the length of the storage
     #ifdef HAVE_CLASS_LAMBDA
-    Kokkos::parallel_scan("StartValuesSetup", dim1_, KOKKOS_CLASS_LAMBDA(const int i, int& update, const bool final) {
-            // Load old value in case we update it before accumulating
-            const size_t count = mystrides_(i);
-            update += count;
-            if (final) {
-                start_index_((i+1)) = update;
-            }
-
-        });
+    size_t count = 0;
+    FOR_SCAN_CLASS(i, 0, dim1_,
+                   count, mystrides_(i),
+                   { start_index_(i+1) = count; }, length_);
     #else
     setup_start_indices_functor setup_execution_functor(start_index_, mystrides_);
     Kokkos::parallel_scan("StartValuesSetup", dim1_,setup_execution_functor);
-    #endif
 
     //compute length of the storage
-    #ifdef HAVE_CLASS_LAMBDA
-    Kokkos::parallel_reduce("LengthSetup", dim1_, KOKKOS_CLASS_LAMBDA(const int i, int& update) {
-            // Load old value in case we update it before accumulating
-            update += mystrides_(i);
-        }, length_);
-    #else
     setup_length_functor length_functor(mystrides_);
     Kokkos::parallel_reduce("LengthSetup", dim1_, length_functor, length_);
     #endif
@@ -6589,15 +8472,11 @@ KOKKOS_INLINE_FUNCTION
 void RaggedRightArrayKokkos<T,Layout,ExecSpace,MemoryTraits,ILayout>::stride_finalize() const {
     
     #ifdef HAVE_CLASS_LAMBDA
-    Kokkos::parallel_scan("StartValues", dim1_, KOKKOS_CLASS_LAMBDA(const int i, int& update, const bool final) {
-            // Load old value in case we update it before accumulating
-            const size_t count = start_index_(i+1);
-            update += count;
-            if (final) {
-                start_index_((i+1)) = update;
-            }
-
-        });
+    // in place, start_index_(i+1) holds the stride of i until it is scanned
+    size_t count = 0;
+    FOR_SCAN_CLASS(i, 0, dim1_,
+                   count, start_index_(i+1),
+                   { start_index_(i+1) = count; });
     #else
     finalize_stride_functor execution_functor(start_index_);
     Kokkos::parallel_scan("StartValues", dim1_,execution_functor);
@@ -6621,6 +8500,12 @@ T& RaggedRightArrayKokkos<T,Layout,ExecSpace,MemoryTraits,ILayout>::operator()(s
     return array_(j + start);
 } // End operator()
 
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits, typename ILayout>
+KOKKOS_INLINE_FUNCTION
+size_t RaggedRightArrayKokkos<T,Layout,ExecSpace,MemoryTraits,ILayout>::dim1() const {
+    return dim1_;
+}
+
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits, typename ILayout>
 KOKKOS_INLINE_FUNCTION
 T* RaggedRightArrayKokkos<T,Layout,ExecSpace,MemoryTraits,ILayout>::pointer() {
@@ -6946,28 +8831,17 @@ void RaggedRightArrayofVectorsKokkos<T,Layout,ExecSpace,MemoryTraits,ILayout>::d
     Kokkos::parallel_for("StartValuesInit", dim1_+1,execution_functor);
     #endif
 
+    // the scan sets the start indices and its total is the length of the storage
     #ifdef HAVE_CLASS_LAMBDA
-    Kokkos::parallel_scan("StartValuesSetup", dim1_, KOKKOS_CLASS_LAMBDA(const int i, int& update, const bool final) {
-            // Load old value in case we update it before accumulating
-            const size_t count = mystrides_(i)*vector_dim_;
-            update += count;
-            if (final) {
-                start_index_((i+1)) = update;
-            }
-
-        });
+    size_t count = 0;
+    FOR_SCAN_CLASS(i, 0, dim1_,
+                   count, mystrides_(i)*vector_dim_,
+                   { start_index_(i+1) = count; }, length_);
     #else
     setup_start_indices_functor setup_execution_functor(start_index_, mystrides_, vector_dim_);
     Kokkos::parallel_scan("StartValuesSetup", dim1_,setup_execution_functor);
-    #endif
 
     //compute length of the storage
-    #ifdef HAVE_CLASS_LAMBDA
-    Kokkos::parallel_reduce("LengthSetup", dim1_, KOKKOS_CLASS_LAMBDA(const int i, int& update) {
-            // Load old value in case we update it before accumulating
-            update += mystrides_(i)*vector_dim_;
-        }, length_);
-    #else
     setup_length_functor length_functor(mystrides_, vector_dim_);
     Kokkos::parallel_reduce("LengthSetup", dim1_, length_functor,length_);
     #endif
@@ -6998,15 +8872,11 @@ KOKKOS_INLINE_FUNCTION
 void RaggedRightArrayofVectorsKokkos<T,Layout,ExecSpace,MemoryTraits,ILayout>::stride_finalize() const {
     
     #ifdef HAVE_CLASS_LAMBDA
-    Kokkos::parallel_scan("StartValues", dim1_, KOKKOS_CLASS_LAMBDA(const int i, int& update, const bool final) {
-            // Load old value in case we update it before accumulating
-            const size_t count = start_index_(i+1);
-            update += count;
-            if (final) {
-                start_index_((i+1)) = update;
-            }
-
-        });
+    // in place, start_index_(i+1) holds the stride of i until it is scanned
+    size_t count = 0;
+    FOR_SCAN_CLASS(i, 0, dim1_,
+                   count, start_index_(i+1),
+                   { start_index_(i+1) = count; });
     #else
     finalize_stride_functor execution_functor(start_index_);
     Kokkos::parallel_scan("StartValues", dim1_,execution_functor);
@@ -7237,28 +9107,17 @@ void RaggedDownArrayKokkos<T,Layout,ExecSpace,MemoryTraits,ILayout>::data_setup(
     Kokkos::parallel_for("StartValuesInit", dim2_+1,execution_functor);
     #endif
 
+    // the scan sets the start indices and its total is the length of the storage
     #ifdef HAVE_CLASS_LAMBDA
-    Kokkos::parallel_scan("StartValuesSetup", dim2_, KOKKOS_CLASS_LAMBDA(const int i, int& update, const bool final) {
-            // Load old value in case we update it before accumulating
-            const size_t count = mystrides_(i);
-            update += count;
-            if (final) {
-                start_index_((i+1)) = update;
-            }
-
-        });
+    size_t count = 0;
+    FOR_SCAN_CLASS(i, 0, dim2_,
+                   count, mystrides_(i),
+                   { start_index_(i+1) = count; }, length_);
     #else
     setup_start_indices_functor setup_execution_functor(start_index_, mystrides_);
     Kokkos::parallel_scan("StartValuesSetup", dim2_,setup_execution_functor);
-    #endif
 
     //compute length of the storage
-    #ifdef HAVE_CLASS_LAMBDA
-    Kokkos::parallel_reduce("LengthSetup", dim2_, KOKKOS_CLASS_LAMBDA(const int i, int& update) {
-            // Load old value in case we update it before accumulating
-            update += mystrides_(i);
-        }, length_);
-    #else
     setup_length_functor length_functor(mystrides_);
     Kokkos::parallel_reduce("LengthSetup", dim2_, length_functor, length_);
     #endif
@@ -7513,7 +9372,7 @@ DynamicRaggedRightArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DynamicRaggedRig
     stride_ = SArray1D(strides_tag_string, dim1_);
     #ifdef HAVE_CLASS_LAMBDA
     Kokkos::parallel_for("StridesInit", dim1_, KOKKOS_CLASS_LAMBDA(const int i) {
-      strides_((i) = 0;
+      stride_(i) = 0;
     });
     #else
     set_strides_functor execution_functor(0, stride_);
@@ -7690,7 +9549,7 @@ DynamicRaggedDownArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::DynamicRaggedDown
     stride_ = SArray1D(strides_tag_string, dim2_);
     #ifdef HAVE_CLASS_LAMBDA
     Kokkos::parallel_for("StridesInit", dim2_, KOKKOS_CLASS_LAMBDA(const int i) {
-      strides_((i) = 0;
+      stride_(i) = 0;
     });
     #else
     set_strides_functor execution_functor(0, stride_);
@@ -7796,6 +9655,10 @@ class CSRArrayKokkos {
     CSRArrayKokkos();
     //CSRArray(CArray<T> data, CArray<T> col_ptrs, CArray<T> row_ptrs, size_t rows, size_t cols);
 
+   /**
+    * @brief Construct a new Sparse Row Array Kokkos object from existing data. The entries of
+    * each row are sorted by column in place, so that A(i,j) is found with a binary search
+    */
    CSRArrayKokkos(
                CArrayKokkos<T, Layout, ExecSpace, MemoryTraits> &array,
                CArrayKokkos<size_t, Layout, ExecSpace, MemoryTraits> &start_index,
@@ -7853,6 +9716,13 @@ class CSRArrayKokkos {
     KOKKOS_INLINE_FUNCTION
     size_t* get_starts() const;
 
+    /**
+     * @brief Get the beginning of the column_index_ array
+     *
+     */
+    KOKKOS_INLINE_FUNCTION
+    size_t* get_columns() const;
+
      
     /**
      * @brief Number of columns
@@ -7934,10 +9804,23 @@ class CSRArrayKokkos {
     KOKKOS_INLINE_FUNCTION
     size_t get_col_flat(size_t k) const;
     // reverse map function from A(i,j) to what element of data/col_pt_ it corersponds to
+    // binary search of row i, returns -1 if A(i,j) is not stored
+    KOKKOS_INLINE_FUNCTION
     int flat_index(size_t i, size_t j);
-    // Convertor
-    
-    // int toCSC(CArray<T> &data, CArray<size_t> &col_ptrs, CArray<size_t> &row_ptrs);
+
+    /**
+     * @brief Transpose into CSC form on the device: a histogram of the columns, a parallel prefix
+     * sum for the column starts, then a scatter. The arrays can be passed straight to the
+     * CSCArrayKokkos constructor
+     *
+     * @param array nnz() values, column by column
+     * @param start_index dim2()+1 entries, where each column starts in array and row_index
+     * @param row_index nnz() entries, the row of each value
+     * @return 0
+     */
+    int toCSC(CArrayKokkos<T, Layout, ExecSpace, MemoryTraits> &array,
+              CArrayKokkos<size_t, Layout, ExecSpace, MemoryTraits> &start_index,
+              CArrayKokkos<size_t, Layout, ExecSpace, MemoryTraits> &row_index) const;
 
     void to_dense(CArrayKokkos<T,Layout, ExecSpace, MemoryTraits>& A);
     
@@ -7976,6 +9859,14 @@ CSRArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::CSRArrayKokkos(
     column_index_ = colum_index.get_kokkos_view();
     nnz_ = colum_index.extent();
     miss_ = TArray1D("miss", 1);
+
+    TArray1D values = array_;
+    SArray1D columns = column_index_;
+    SArray1D starts = start_index_;
+    Kokkos::parallel_for("CSRSortRows", Kokkos::RangePolicy<ExecSpace, Kokkos::IndexType<size_t>>(0, dim1_),
+                         KOKKOS_LAMBDA(const size_t i) {
+        sorted_index_sort(values.data(), columns.data(), starts(i), starts(i+1));
+    });
 }
 
 /*
@@ -8045,32 +9936,24 @@ void CSRArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::data_setup(const std::stri
 template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 T& CSRArrayKokkos<T, Layout, ExecSpace, MemoryTraits>::operator()(size_t i, size_t j) const {
-    size_t row_start = start_index_[i];
-    size_t row_end = start_index_[i+1];
-    size_t k;
-    for(k = 0; k < row_end - row_start; k++){
-        if(column_index_[row_start + k] == j){
-            return array_.data()[row_start + k];
-        }
+    size_t k = sorted_index_find(column_index_.data(), start_index_(i), start_index_(i+1), j, nnz_);
+    if(k == nnz_){
+        miss_(0) = (T) NULL;
+        return miss_(0);
     }
-    miss_[0] = (T) NULL;
-    return miss_[0];
+    return array_.data()[k];
 }
 
 
 template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 T& CSRArrayKokkos<T, Layout, ExecSpace, MemoryTraits>::value(size_t i, size_t j) const {
-    size_t row_start = start_index_[i];
-    size_t row_end = start_index_[i+1];
-    size_t k;
-    for(k = 0; k < row_end - row_start; k++){
-        if(column_index_[row_start + k] == j){
-            return array_.data()[row_start + k];
-        }
+    size_t k = sorted_index_find(column_index_.data(), start_index_(i), start_index_(i+1), j, nnz_);
+    if(k == nnz_){
+        miss_(0) = (T) NULL;
+        return miss_(0);
     }
-    miss_[0] = (T) NULL;
-    return miss_[0];
+    return array_.data()[k];
 }
 
 template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
@@ -8085,10 +9968,16 @@ size_t* CSRArrayKokkos<T, Layout, ExecSpace, MemoryTraits>::get_starts() const {
     return start_index_.data();
 }
 
+template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t* CSRArrayKokkos<T, Layout, ExecSpace, MemoryTraits>::get_columns() const {
+    return column_index_.data();
+}
+
 template<typename T,typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 CSRArrayKokkos<T,Layout, ExecSpace, MemoryTraits>& CSRArrayKokkos<T, Layout, ExecSpace, MemoryTraits>::operator=(const CSRArrayKokkos<T, Layout,ExecSpace,MemoryTraits> &temp){
-    if(this != temp) {
+    if(this != &temp) {
         nnz_ = temp.nnz_;
         dim1_ = temp.dim1_;
         dim2_ = temp.dim2_;
@@ -8096,6 +9985,7 @@ CSRArrayKokkos<T,Layout, ExecSpace, MemoryTraits>& CSRArrayKokkos<T, Layout, Exe
         start_index_ = temp.start_index_;
         column_index_ = temp.column_index_;
         array_ = temp.array_;
+        miss_ = temp.miss_;
     }
     return *this;
 }
@@ -8113,8 +10003,8 @@ void CSRArrayKokkos<T,Layout, ExecSpace, MemoryTraits>::to_dense(CArrayKokkos<T,
 template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 size_t CSRArrayKokkos<T, Layout, ExecSpace, MemoryTraits>::stride(size_t i) const {
-   assert(i <= dim1_ && "Index i out of bounds in CSRArray.stride()");
-   return start_index_.data()[i+i] - start_index_.data()[i];
+   assert(i < dim1_ && "Index i out of bounds in CSRArray.stride()");
+   return start_index_.data()[i+1] - start_index_.data()[i];
 }
 
 
@@ -8188,16 +10078,10 @@ size_t CSRArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::get_col_flat(size_t k) c
 
 
 template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
 int CSRArrayKokkos<T,Layout, ExecSpace, MemoryTraits>::flat_index(size_t i, size_t j){
-    size_t k;
-    size_t row_start = start_index_.data()[i];
-    size_t row_end = start_index_.data()[i+1];
-    for(k = 0; k < row_end - row_start; k++){
-        if(column_index_.data()[row_start+k] == j){
-            return row_start+k;
-        }
-    }
-    return  -1;
+    size_t k = sorted_index_find(column_index_.data(), start_index_.data()[i], start_index_.data()[i+1], j, nnz_);
+    return (k == nnz_) ? -1 : (int) k;
 }
 
 //template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
@@ -8205,48 +10089,50 @@ int CSRArrayKokkos<T,Layout, ExecSpace, MemoryTraits>::flat_index(size_t i, size
 //                    CArrayKokkos<T, Layout, ExecSpace, MemoryTraits> &columns,
 //                    CArrayKokkos<T, Layout, ExecSpace, MemoryTraits> &array);
 
-                    /*
-int CSRArray<T>::toCSC(CArray<T> &data, CArray<size_t> &col_ptrs, CArray<size_t> &row_ptrs ){
-    int nnz_cols[ncols_ + 1];
-    int col_counts[ncols_];
-    int i = 0;
-    // How many elements are each column
-    for(i =0 ; i < ncols_; i++){
-        nnz_cols[i] = 0;
-        col_counts[i] = 0;
-    }
-    nnz_cols[ncols_] = 0;
-    col_ptrs(0) = 0;
-    for(i =0; i < nnz_; i++){
-        nnz_cols[column_index_[i] + 1] += 1;
-    }
-    // What we actually care about is how many elements are
-    // in all the  columns preceeding this column.
-    for(i = 1; i <= ncols_; i++){
-        nnz_cols[i] = nnz_cols[i-1] + nnz_cols[i];
-        col_ptrs(i) = nnz_cols[i];
-    }
-    size_t row = 1;
-    // if b is at A(i,j)  stored in csr format
-    // it needs to go where the where the ith column starts
-    // + how many things we have put in the "window"
-    // we allocated for this column already
-    // For row we simply keep track of what row we are currently in
-    // as we scan through the 1d array of data.
-    for(i = 0; i < nnz_; i++){
-        if(i >= start_index_[row]){
-            row++;
+template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+int CSRArrayKokkos<T,Layout, ExecSpace, MemoryTraits>::toCSC(CArrayKokkos<T, Layout, ExecSpace, MemoryTraits> &array,
+                                                            CArrayKokkos<size_t, Layout, ExecSpace, MemoryTraits> &start_index,
+                                                            CArrayKokkos<size_t, Layout, ExecSpace, MemoryTraits> &row_index) const {
+    assert(array.extent() >= nnz_ && "array is too small in CSRArrayKokkos.toCSC()");
+    assert(start_index.extent() >= dim2_ + 1 && "start_index needs dim2+1 entries in CSRArrayKokkos.toCSC()");
+    assert(row_index.extent() >= nnz_ && "row_index is too small in CSRArrayKokkos.toCSC()");
+
+    TArray1D values = array_;
+    SArray1D columns = column_index_;
+    SArray1D starts = start_index_;
+    TArray1D csc_values = array.get_kokkos_view();
+    SArray1D csc_starts = start_index.get_kokkos_view();
+    SArray1D csc_rows = row_index.get_kokkos_view();
+    // size_t indices, nnz_ may pass 2^31
+    using size_range = Kokkos::RangePolicy<ExecSpace, Kokkos::IndexType<size_t>>;
+
+    // counts(j+1) is the number of entries in column j
+    SArray1D counts("CSRtoCSCCounts", dim2_ + 1);
+    Kokkos::parallel_for("CSRtoCSCHistogram", size_range(0, nnz_), KOKKOS_LAMBDA(const size_t k) {
+        Kokkos::atomic_increment(&counts(columns(k) + 1));
+    });
+    size_t offset = 0;
+    FOR_SCAN(j, 0, dim2_ + 1,
+             offset, counts(j),
+             { csc_starts(j) = offset; });
+
+    // counts(j) is now the number of entries already placed in column j
+    Kokkos::deep_copy(counts, 0);
+    Kokkos::parallel_for("CSRtoCSCScatter", size_range(0, dim1_), KOKKOS_LAMBDA(const size_t i) {
+        for(size_t k = starts(i); k < starts(i+1); k++){
+            size_t j = columns(k);
+            size_t pos = csc_starts(j) + Kokkos::atomic_fetch_add(&counts(j), (size_t) 1);
+            csc_rows(pos) = i;
+            csc_values(pos) = values(k);
         }
-        int idx = nnz_cols[column_index_[i]] + col_counts[column_index_[i]];
-        col_counts[column_index_[i]] += 1;
-        data(idx) = array_[i];
-        row_ptrs(idx) = row - 1;
-    }
-    // I return an int because I thought I might need to return an error code
-    // Not sure that is true
-    return 0;
+    });
+
+    // the atomics place the rows of a column in any order
+    Kokkos::parallel_for("CSRtoCSCSortColumns", size_range(0, dim2_), KOKKOS_LAMBDA(const size_t j) {
+        sorted_index_sort(csc_values.data(), csc_rows.data(), csc_starts(j), csc_starts(j+1));
+    });
+    return 0;
 }
-*/
 
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 CSRArrayKokkos<T, Layout, ExecSpace, MemoryTraits>::~CSRArrayKokkos() {}
@@ -8275,7 +10161,8 @@ private: // What ought to be private ?
       CSCArrayKokkos();
 
       /**
-      * @brief Construct a new Sparse Col Array object
+      * @brief Construct a new Sparse Col Array object. The entries of each column are sorted
+      * by row in place, so that A(i,j) is found with a binary search
       *
       * @param array: 1d array of data values in order as read top to bottom, left to right
       * @param row_index: 1d array that marks what row each element is in
@@ -8343,6 +10230,14 @@ private: // What ought to be private ?
       KOKKOS_INLINE_FUNCTION
       size_t *get_starts() const;
 
+      /**
+       * @brief Get the row_index array
+       *
+       * @return size_t* : returns row_index_
+       */
+      KOKKOS_INLINE_FUNCTION
+      size_t *get_rows() const;
+
       /**
        * @brief Get number of rows
        *
@@ -8443,23 +10338,26 @@ CSCArrayKokkos<T, Layout, ExecSpace, MemoryTraits>::CSCArrayKokkos(
     row_index_ = row_index.get_kokkos_view();
     nnz_ = row_index.extent();
     miss_ = TArray1D("miss", 1);
+
+    TArray1D values = array_;
+    SArray1D rows = row_index_;
+    SArray1D starts = start_index_;
+    Kokkos::parallel_for("CSCSortColumns", Kokkos::RangePolicy<ExecSpace, Kokkos::IndexType<size_t>>(0, dim2_),
+                         KOKKOS_LAMBDA(const size_t j) {
+        sorted_index_sort(values.data(), rows.data(), starts(j), starts(j+1));
+    });
 }
 
 
 template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 T& CSCArrayKokkos<T, Layout, ExecSpace, MemoryTraits>::operator()(size_t i, size_t j) const {
-    size_t col_start = start_index_[j];
-    size_t col_end = start_index_[j + 1];
-    size_t k;
-    for(k =0; k < col_end - col_start;k++){
-        if(row_index_[col_start + k] == i){
-                return array_.data()[col_start + k];
-        }
+    size_t k = sorted_index_find(row_index_.data(), start_index_(j), start_index_(j+1), i, nnz_);
+    if(k == nnz_){
+        miss_(0) = (T) NULL;
+        return miss_(0);
     }
-    //return array_.data()[nnz_];
-    miss_[0] = (T) NULL;
-    return miss_[0];
+    return array_.data()[k];
 }
 
 template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
@@ -8472,16 +10370,12 @@ T* CSCArrayKokkos<T,Layout, ExecSpace, MemoryTraits>::pointer() const {
 template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 T& CSCArrayKokkos<T,Layout, ExecSpace, MemoryTraits>::value(size_t i, size_t j) const {
-    size_t col_start = start_index_.data()[j];
-    size_t col_end = start_index_.data()[j + 1];
-    size_t k;
-    for(k =0; k < col_end - col_start;k++){
-        if(row_index_.data()[col_start + k] == i){
-                return array_.data()[col_start + k];
-        }
+    size_t k = sorted_index_find(row_index_.data(), start_index_.data()[j], start_index_.data()[j+1], i, nnz_);
+    if(k == nnz_){
+        miss_(0) = (T) NULL;
+        return miss_(0);
     }
-    miss_[0] = (T) NULL;
-    return miss_[0];
+    return array_.data()[k];
 }
 
 template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
@@ -8490,17 +10384,24 @@ size_t* CSCArrayKokkos<T,Layout, ExecSpace, MemoryTraits>::get_starts() const{
     return &start_index_.data()[0];
 }
 
+template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t* CSCArrayKokkos<T,Layout, ExecSpace, MemoryTraits>::get_rows() const{
+    return row_index_.data();
+}
+
 template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 CSCArrayKokkos<T,Layout, ExecSpace, MemoryTraits>& CSCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::operator=(const CSCArrayKokkos<T,Layout,ExecSpace,MemoryTraits> &temp){
-    if(this != temp) {
+    if(this != &temp) {
         nnz_ = temp.nnz_;
         dim2_ = temp.dim2_;
-        dim1_ = temp.dim1_;;
+        dim1_ = temp.dim1_;
         
         start_index_ = temp.start_index_;
-        row_index_ = temp.row_row_index_;
+        row_index_ = temp.row_index_;
         array_ = temp.array_;
+        miss_ = temp.miss_;
     }
     return *this;
 }
@@ -8582,16 +10483,8 @@ size_t CSCArrayKokkos<T,Layout, ExecSpace, MemoryTraits>::get_row_flat(size_t k)
 template<typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 KOKKOS_INLINE_FUNCTION
 int CSCArrayKokkos<T,Layout, ExecSpace, MemoryTraits>::flat_index(size_t i, size_t j){
-    size_t col_start = start_index_.data()[j];
-    size_t col_end = start_index_.data()[j+1];
-    size_t k;
-    for (k = 0; k < col_end - col_start; k++)
-    {
-        if(row_index_.data()[col_start + k] == i){
-                return col_start + k;
-        }
-    }
-    return  -1;
+    size_t k = sorted_index_find(row_index_.data(), start_index_.data()[j], start_index_.data()[j+1], i, nnz_);
+    return (k == nnz_) ? -1 : (int) k;
 }
 
 // Assumes that data, col_ptrs, and row_ptrs
@@ -8644,6 +10537,923 @@ int CSCArray<T>::toCSR(CArray<T> &data, CArray<size_t> &col_ptrs, CArray<size_t>
 template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
 CSCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>::~CSCArrayKokkos() {}
 
+// 16b SELLArrayKokkos
+// SELLArray (host_types.h) with the data in Kokkos Views.  The conversion from a
+// CSRArrayKokkos sorts the rows on the host, so it copies the matrix there and
+// the result back once; the product and A(i,j) run on the device.
+template <typename T, size_t C = MATAR_SELL_CHUNK, typename Layout = DefaultLayout, typename ExecSpace = DefaultExecSpace, typename MemoryTraits = void>
+class SELLArrayKokkos {
+
+    static_assert(C >= 1, "SELLArrayKokkos chunk height must be at least 1");
+
+    using TArray1D = Kokkos::View<T*, Layout, ExecSpace, MemoryTraits>;
+    using SArray1D = Kokkos::View<size_t*, Layout, ExecSpace, MemoryTraits>;
+
+  private:
+    size_t dim1_, dim2_;
+    size_t nnz_;
+    size_t padded_nnz_;
+    size_t num_chunks_;
+    size_t sigma_;
+    TArray1D array_;
+    SArray1D column_index_;
+    SArray1D chunk_starts_;
+    SArray1D row_order_;
+    SArray1D row_slot_;
+    SArray1D row_lengths_;
+    TArray1D miss_;
+
+  public:
+
+    /**
+     * @brief Construct an empty SELLArrayKokkos
+     *
+     */
+    SELLArrayKokkos();
+
+    /**
+     * @brief Convert a CSRArrayKokkos
+     *
+     * @param csr the matrix
+     * @param sigma rows sorted together by length, best a multiple of C
+     */
+    SELLArrayKokkos(const CSRArrayKokkos<T, Layout, ExecSpace, MemoryTraits> &csr, size_t sigma = 32*C,
+                    const std::string & tag_string = DEFAULTSTRINGARRAY);
+
+    /**
+     * @brief Access A(i,j). Returns a dummy address with value 0 if A(i,j) is not stored
+     */
+    KOKKOS_INLINE_FUNCTION
+    T& operator()(size_t i, size_t j) const;
+
+    KOKKOS_INLINE_FUNCTION
+    T& value(size_t i, size_t j) const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t dim1() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t dim2() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t nnz() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t nnz(size_t i) const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t padded_nnz() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t num_chunks() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t sigma() const;
+
+    KOKKOS_INLINE_FUNCTION
+    static constexpr size_t chunk_height() { return C; }
+
+    // the raw layout, as for SELLArray
+    KOKKOS_INLINE_FUNCTION
+    T* pointer() const;
+    KOKKOS_INLINE_FUNCTION
+    size_t* get_columns() const;
+    KOKKOS_INLINE_FUNCTION
+    size_t* get_chunk_starts() const;
+    KOKKOS_INLINE_FUNCTION
+    size_t* get_row_order() const;
+    KOKKOS_INLINE_FUNCTION
+    size_t* get_row_lengths() const;
+};
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::SELLArrayKokkos() {
+    dim1_ = dim2_ = nnz_ = padded_nnz_ = num_chunks_ = 0;
+    sigma_ = 1;
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::SELLArrayKokkos(
+               const CSRArrayKokkos<T, Layout, ExecSpace, MemoryTraits> &csr, size_t sigma,
+               const std::string & tag_string) {
+    assert(sigma >= 1 && "sigma must be at least 1 in SELLArrayKokkos");
+    dim1_ = csr.dim1();
+    dim2_ = csr.dim2();
+    nnz_ = csr.nnz();
+    sigma_ = sigma;
+    num_chunks_ = (dim1_ + C - 1)/C;
+
+    // the compressed rows on the host
+    using SArrayUnmanaged = Kokkos::View<size_t*, Layout, ExecSpace, MemoryUnmanaged>;
+    using TArrayUnmanaged = Kokkos::View<T*, Layout, ExecSpace, MemoryUnmanaged>;
+    auto starts = Kokkos::create_mirror_view_and_copy(HostSpace(), SArrayUnmanaged(csr.get_starts(), dim1_ + 1));
+    auto columns = Kokkos::create_mirror_view_and_copy(HostSpace(), SArrayUnmanaged(csr.get_columns(), nnz_));
+    auto values = Kokkos::create_mirror_view_and_copy(HostSpace(), TArrayUnmanaged(csr.pointer(), nnz_));
+
+    chunk_starts_ = SArray1D(tag_string + " chunk_starts", num_chunks_ + 1);
+    row_order_ = SArray1D(tag_string + " row_order", dim1_ + 1);
+    row_slot_ = SArray1D(tag_string + " row_slot", dim1_ + 1);
+    row_lengths_ = SArray1D(tag_string + " row_lengths", dim1_ + 1);
+    auto chunk_starts = Kokkos::create_mirror_view(chunk_starts_);
+    auto row_order = Kokkos::create_mirror_view(row_order_);
+    auto row_slot = Kokkos::create_mirror_view(row_slot_);
+    auto row_lengths = Kokkos::create_mirror_view(row_lengths_);
+    padded_nnz_ = sell_layout(starts.data(), dim1_, C, sigma_, row_order.data(), row_slot.data(),
+                              row_lengths.data(), chunk_starts.data());
+
+    array_ = TArray1D(tag_string, padded_nnz_ + 1);
+    column_index_ = SArray1D(tag_string + " columns", padded_nnz_ + 1);
+    miss_ = TArray1D("miss", 1);
+    auto array = Kokkos::create_mirror_view(array_);
+    auto column_index = Kokkos::create_mirror_view(column_index_);
+    sell_fill(starts.data(), columns.data(), values.data(), dim1_, C, row_order.data(),
+              chunk_starts.data(), column_index.data(), array.data());
+
+    Kokkos::deep_copy(chunk_starts_, chunk_starts);
+    Kokkos::deep_copy(row_order_, row_order);
+    Kokkos::deep_copy(row_slot_, row_slot);
+    Kokkos::deep_copy(row_lengths_, row_lengths);
+    Kokkos::deep_copy(array_, array);
+    Kokkos::deep_copy(column_index_, column_index);
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+T& SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::operator()(size_t i, size_t j) const {
+    assert(i < dim1_ && "i is out of bounds in SELLArrayKokkos");
+    assert(j < dim2_ && "j is out of bounds in SELLArrayKokkos");
+    size_t s = row_slot_.data()[i];
+    size_t k = sell_find(column_index_.data(), chunk_starts_.data()[s/C] + s%C, row_lengths_.data()[s], C, j, padded_nnz_);
+    if(k == padded_nnz_){
+        miss_(0) = (T) NULL;
+        return miss_(0);
+    }
+    return array_.data()[k];
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+T& SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::value(size_t i, size_t j) const {
+    return (*this)(i,j);
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::dim1() const {
+    return dim1_;
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::dim2() const {
+    return dim2_;
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::nnz() const {
+    return nnz_;
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::nnz(size_t i) const {
+    assert(i < dim1_ && "i is out of bounds in SELLArrayKokkos.nnz()");
+    return row_lengths_.data()[row_slot_.data()[i]];
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::padded_nnz() const {
+    return padded_nnz_;
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::num_chunks() const {
+    return num_chunks_;
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::sigma() const {
+    return sigma_;
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+T* SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::pointer() const {
+    return array_.data();
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t* SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::get_columns() const {
+    return column_index_.data();
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t* SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::get_chunk_starts() const {
+    return chunk_starts_.data();
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t* SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::get_row_order() const {
+    return row_order_.data();
+}
+
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t* SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>::get_row_lengths() const {
+    return row_lengths_.data();
+}
+
+////// END SELLArrayKokkos
+
+// 16c BSRArrayKokkos
+// BSRArray (host_types.h) with the data in Kokkos Views.  The pattern is built
+// on the host from a RaggedRightArrayKokkos connectivity or a CSRArrayKokkos,
+// so those are copied there once; access, add_block and the products run on
+// the device, and add_block uses atomic adds so elements that share a node can
+// be assembled in the same parallel loop.
+template <typename T, size_t B, typename Layout = DefaultLayout, typename ExecSpace = DefaultExecSpace, typename MemoryTraits = void>
+class BSRArrayKokkos {
+
+    static_assert(B >= 1, "BSRArrayKokkos block size must be at least 1");
+
+    using TArray1D = Kokkos::View<T*, Layout, ExecSpace, MemoryTraits>;
+    using SArray1D = Kokkos::View<size_t*, Layout, ExecSpace, MemoryTraits>;
+
+  private:
+    size_t block_dim1_, block_dim2_;
+    size_t nnzb_;
+    TArray1D array_;
+    SArray1D column_index_;
+    SArray1D start_index_;
+    TArray1D miss_;
+
+    void data_setup(const size_t *starts, const size_t *columns, const std::string& tag_string);
+
+  public:
+
+    /**
+     * @brief Construct an empty BSRArrayKokkos
+     *
+     */
+    BSRArrayKokkos();
+
+    /**
+     * @brief Construct a zero BSRArrayKokkos with the pattern of a connectivity graph
+     *
+     * @param connectivity row ib lists the block columns of block row ib, repeats allowed
+     * @param block_dim2 number of block columns
+     * @param with_diagonal also store block (ib,ib)
+     */
+    BSRArrayKokkos(const RaggedRightArrayKokkos<size_t, Layout, ExecSpace, MemoryTraits> &connectivity,
+                   size_t block_dim2, bool with_diagonal = true, const std::string & tag_string = DEFAULTSTRINGARRAY);
+
+    /**
+     * @brief Convert a CSRArrayKokkos, whose dims must be multiples of B
+     */
+    BSRArrayKokkos(const CSRArrayKokkos<T, Layout, ExecSpace, MemoryTraits> &csr,
+                   const std::string & tag_string = DEFAULTSTRINGARRAY);
+
+    /**
+     * @brief Access value (bi,bj) of block (ib,jb). Returns a dummy address with value 0 if
+     * the block is not stored
+     */
+    KOKKOS_INLINE_FUNCTION
+    T& operator()(size_t ib, size_t jb, size_t bi, size_t bj) const;
+
+    KOKKOS_INLINE_FUNCTION
+    T& value(size_t ib, size_t jb, size_t bi, size_t bj) const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t block_index(size_t ib, size_t jb) const;
+
+    /**
+     * @brief Atomically add a B x B matrix into block (ib,jb), which must be stored
+     *
+     * @param local any type indexed local(bi,bj), e.g. CArrayFixed or ViewCArrayKokkos
+     */
+    template <typename M>
+    KOKKOS_INLINE_FUNCTION
+    void add_block(size_t ib, size_t jb, const M &local) const;
+
+    void set_values(T val) const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t dim1() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t dim2() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t block_dim1() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t block_dim2() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t nnzb() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t nnzb(size_t ib) const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t nnz() const;
+
+    KOKKOS_INLINE_FUNCTION
+    static constexpr size_t block_size() { return B; }
+
+    // the raw layout, as for BSRArray
+    KOKKOS_INLINE_FUNCTION
+    T* pointer() const;
+    KOKKOS_INLINE_FUNCTION
+    size_t* get_starts() const;
+    KOKKOS_INLINE_FUNCTION
+    size_t* get_columns() const;
+};
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::BSRArrayKokkos() {
+    block_dim1_ = block_dim2_ = nnzb_ = 0;
+}
+
+// copies the host pattern to the device and allocates the values
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+void BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::data_setup(const size_t *starts, const size_t *columns,
+                                                                   const std::string& tag_string) {
+    start_index_ = SArray1D(tag_string + " starts", block_dim1_ + 1);
+    column_index_ = SArray1D(tag_string + " columns", nnzb_ + 1);
+    auto start_index = Kokkos::create_mirror_view(start_index_);
+    auto column_index = Kokkos::create_mirror_view(column_index_);
+    for(size_t ib = 0; ib < block_dim1_ + 1; ib++){
+        start_index(ib) = starts[ib];
+    }
+    for(size_t k = 0; k < nnzb_; k++){
+        column_index(k) = columns[k];
+    }
+    Kokkos::deep_copy(start_index_, start_index);
+    Kokkos::deep_copy(column_index_, column_index);
+    array_ = TArray1D(tag_string, nnzb_*B*B + 1);
+    miss_ = TArray1D("miss", 1);
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::BSRArrayKokkos(
+               const RaggedRightArrayKokkos<size_t, Layout, ExecSpace, MemoryTraits> &connectivity,
+               size_t block_dim2, bool with_diagonal, const std::string & tag_string) {
+    RaggedRightArrayKokkos<size_t, Layout, ExecSpace, MemoryTraits> graph = connectivity;
+    block_dim1_ = graph.dim1();
+    block_dim2_ = block_dim2;
+    assert((!with_diagonal || block_dim1_ <= block_dim2_) && "BSRArrayKokkos diagonal blocks need block_dim2 >= block_dim1");
+
+    // the connectivity on the host
+    using SArrayUnmanaged = Kokkos::View<size_t*, Layout, ExecSpace, MemoryUnmanaged>;
+    auto starts = Kokkos::create_mirror_view_and_copy(HostSpace(), graph.start_index_);
+    auto adjacency = Kokkos::create_mirror_view_and_copy(HostSpace(), SArrayUnmanaged(graph.pointer(), starts(block_dim1_)));
+    auto visit = [&](size_t ib, const auto &add) {
+        for(size_t k = starts(ib); k < starts(ib+1); k++){
+            add(adjacency(k));
+        }
+        if(with_diagonal){
+            add(ib);
+        }
+    };
+    std::unique_ptr<size_t []> block_starts(new size_t[block_dim1_ + 1]);
+    std::unique_ptr<size_t []> marker(new size_t[block_dim2_ + 1]);
+    nnzb_ = bsr_pattern(block_dim1_, block_dim2_, visit, block_starts.get(), NULL, marker.get());
+    std::unique_ptr<size_t []> block_columns(new size_t[nnzb_ + 1]);
+    bsr_pattern(block_dim1_, block_dim2_, visit, block_starts.get(), block_columns.get(), marker.get());
+
+    data_setup(block_starts.get(), block_columns.get(), tag_string);
+    set_values(T(0));
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::BSRArrayKokkos(
+               const CSRArrayKokkos<T, Layout, ExecSpace, MemoryTraits> &csr, const std::string & tag_string) {
+    assert(csr.dim1() % B == 0 && csr.dim2() % B == 0 && "BSRArrayKokkos needs dims that are multiples of B");
+    block_dim1_ = csr.dim1()/B;
+    block_dim2_ = csr.dim2()/B;
+
+    // the compressed rows on the host
+    using SArrayUnmanaged = Kokkos::View<size_t*, Layout, ExecSpace, MemoryUnmanaged>;
+    using TArrayUnmanaged = Kokkos::View<T*, Layout, ExecSpace, MemoryUnmanaged>;
+    size_t nnz = csr.nnz();
+    auto starts = Kokkos::create_mirror_view_and_copy(HostSpace(), SArrayUnmanaged(csr.get_starts(), csr.dim1() + 1));
+    auto columns = Kokkos::create_mirror_view_and_copy(HostSpace(), SArrayUnmanaged(csr.get_columns(), nnz));
+    auto values = Kokkos::create_mirror_view_and_copy(HostSpace(), TArrayUnmanaged(csr.pointer(), nnz));
+    auto visit = [&](size_t ib, const auto &add) {
+        for(size_t k = starts(ib*B); k < starts((ib+1)*B); k++){
+            add(columns(k)/B);
+        }
+    };
+    std::unique_ptr<size_t []> block_starts(new size_t[block_dim1_ + 1]);
+    std::unique_ptr<size_t []> marker(new size_t[block_dim2_ + 1]);
+    nnzb_ = bsr_pattern(block_dim1_, block_dim2_, visit, block_starts.get(), NULL, marker.get());
+    std::unique_ptr<size_t []> block_columns(new size_t[nnzb_ + 1]);
+    bsr_pattern(block_dim1_, block_dim2_, visit, block_starts.get(), block_columns.get(), marker.get());
+
+    data_setup(block_starts.get(), block_columns.get(), tag_string);
+    auto array = Kokkos::create_mirror_view(array_);
+    bsr_fill(starts.data(), columns.data(), values.data(), csr.dim1(), B, block_starts.get(), block_columns.get(),
+             array.data());
+    Kokkos::deep_copy(array_, array);
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::block_index(size_t ib, size_t jb) const {
+    assert(ib < block_dim1_ && "ib is out of bounds in BSRArrayKokkos");
+    assert(jb < block_dim2_ && "jb is out of bounds in BSRArrayKokkos");
+    return sorted_index_find(column_index_.data(), start_index_(ib), start_index_(ib+1), jb, nnzb_);
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+T& BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::operator()(size_t ib, size_t jb, size_t bi, size_t bj) const {
+    assert(bi < B && bj < B && "bi or bj is out of the block in BSRArrayKokkos");
+    size_t k = block_index(ib, jb);
+    if(k == nnzb_){
+        miss_(0) = (T) NULL;
+        return miss_(0);
+    }
+    return array_((k*B + bi)*B + bj);
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+T& BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::value(size_t ib, size_t jb, size_t bi, size_t bj) const {
+    return (*this)(ib, jb, bi, bj);
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+template <typename M>
+KOKKOS_INLINE_FUNCTION
+void BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::add_block(size_t ib, size_t jb, const M &local) const {
+    size_t k = block_index(ib, jb);
+    assert(k < nnzb_ && "block (ib,jb) is not stored in BSRArrayKokkos");
+    T *block = array_.data() + k*B*B;
+    for(size_t bi = 0; bi < B; bi++){
+        for(size_t bj = 0; bj < B; bj++){
+            Kokkos::atomic_add(&block[bi*B + bj], (T) local(bi, bj));
+        }
+    }
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+void BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::set_values(T val) const {
+    Kokkos::deep_copy(array_, val);
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::dim1() const {
+    return block_dim1_*B;
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::dim2() const {
+    return block_dim2_*B;
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::block_dim1() const {
+    return block_dim1_;
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::block_dim2() const {
+    return block_dim2_;
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::nnzb() const {
+    return nnzb_;
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::nnzb(size_t ib) const {
+    assert(ib < block_dim1_ && "ib is out of bounds in BSRArrayKokkos.nnzb()");
+    return start_index_(ib+1) - start_index_(ib);
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::nnz() const {
+    return nnzb_*B*B;
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+T* BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::pointer() const {
+    return array_.data();
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t* BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::get_starts() const {
+    return start_index_.data();
+}
+
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t* BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>::get_columns() const {
+    return column_index_.data();
+}
+
+////// END BSRArrayKokkos
+
+//=======================================================================
+//    fixed-rank kokkos MATAR data-types
+//========================================================================
+// Same index order as CArrayKokkos and FArrayKokkos, but the data is held in
+// a Kokkos::View of the compile-time rank instead of a flat 1D View, so Kokkos
+// computes the offsets and get_kokkos_view() returns a natively shaped View
+// that works with subview, deep_copy, and MemoryTraits such as RandomAccess, e.g.
+//     CArrayKokkosND <double,3> temperature(nx, ny, nz);
+//     temperature(i,j,k) = 0.0;
+// A View made elsewhere, for instance with Kokkos::AllowPadding, is wrapped
+// with the View constructor and keeps its own strides.
+
+// the data type of a rank-N View, T*...*
+template <typename T, size_t Rank>
+struct KokkosRankType {
+    using type = typename KokkosRankType<T, Rank-1>::type*;
+};
+
+template <typename T>
+struct KokkosRankType<T, 0> {
+    using type = T;
+};
+
+/*! \brief Kokkos version of the CArrayND class, backed by a rank-N View.
+ *
+ *  Indices are [0:N-1] and the last index is contiguous (LayoutRight).
+ */
+template <typename T, size_t Rank, typename ExecSpace = DefaultExecSpace, typename MemoryTraits = void>
+class CArrayKokkosND {
+
+    static_assert(Rank >= 1 && Rank <= 7, "CArrayKokkosND rank must be between 1 and 7");
+
+    using TArrayND = Kokkos::View<typename KokkosRankType<T,Rank>::type, Kokkos::LayoutRight, ExecSpace, MemoryTraits>;
+
+private:
+    size_t dims_[Rank];
+    size_t length_;
+    TArrayND this_array_;
+
+public:
+    CArrayKokkosND();
+
+    // --- one dimension per rank ---
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    CArrayKokkosND(Dims... dim);
+
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    CArrayKokkosND(const std::string& tag_string, Dims... dim);
+
+    // wraps an existing View, the data is shared
+    CArrayKokkosND(const TArrayND& view);
+
+    // Overload operator(), one index per rank
+    template <typename... Indices>
+    KOKKOS_INLINE_FUNCTION
+    T& operator()(Indices... indices) const;
+
+    KOKKOS_INLINE_FUNCTION
+    CArrayKokkosND& operator=(const CArrayKokkosND& temp);
+
+    // number of elements, without any padding
+    KOKKOS_INLINE_FUNCTION
+    size_t size() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t extent() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t dims(size_t i) const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t order() const;
+
+    // Methods returns the raw pointer (most likely GPU) of the Kokkos View
+    KOKKOS_INLINE_FUNCTION
+    T* pointer() const;
+
+    //return the rank-N view
+    KOKKOS_INLINE_FUNCTION
+    TArrayND get_kokkos_view() const;
+
+    // Deconstructor
+    KOKKOS_INLINE_FUNCTION
+    ~CArrayKokkosND ();
+}; // End of CArrayKokkosND
+
+// Default constructor
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::CArrayKokkosND() {
+    length_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = 0;
+    }
+}
+
+// one dimension per rank
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::CArrayKokkosND(Dims... dim)
+    : CArrayKokkosND(DEFAULTSTRINGARRAY, dim...) {}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::CArrayKokkosND(const std::string& tag_string, Dims... dim) {
+    static_assert(sizeof...(Dims) == Rank, "Number of dims does not match the rank of CArrayKokkosND!");
+    const size_t dims_in[Rank] = {static_cast<size_t>(dim)...};
+    length_ = 1;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = dims_in[r];
+        length_ *= dims_[r];
+    }
+    this_array_ = TArrayND(tag_string, static_cast<size_t>(dim)...);
+}
+
+// wrap a View
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::CArrayKokkosND(const TArrayND& view) {
+    length_ = 1;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = view.extent(r);
+        length_ *= dims_[r];
+    }
+    this_array_ = view;
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+template <typename... Indices>
+KOKKOS_INLINE_FUNCTION
+T& CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::operator()(Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of CArrayKokkosND!");
+#ifndef NDEBUG
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] < dims_[r] && "index is out of bounds in CArrayKokkosND!");
+    }
+#endif
+    return this_array_(indices...);
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>& CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::operator=(const CArrayKokkosND& temp) {
+    if (this != &temp) {
+        for (size_t r = 0; r < Rank; r++) {
+            dims_[r] = temp.dims_[r];
+        }
+        length_ = temp.length_;
+        this_array_ = temp.this_array_;
+    }
+    return *this;
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::size() const {
+    return length_;
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::extent() const {
+    return length_;
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::dims(size_t i) const {
+    assert(i < Rank && "CArrayKokkosND order (rank) does not match constructor, dim[i] does not exist!");
+    assert(dims_[i]>0 && "Access to CArrayKokkosND dims is out of bounds!");
+    return dims_[i];
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::order() const {
+    return Rank;
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+T* CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::pointer() const {
+    return this_array_.data();
+}
+
+//return the stored Kokkos view
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+Kokkos::View<typename KokkosRankType<T,Rank>::type, Kokkos::LayoutRight, ExecSpace, MemoryTraits> CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::get_kokkos_view() const {
+    return this_array_;
+}
+
+// Destructor
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+CArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::~CArrayKokkosND() {}
+
+////////////////////////////////////////////////////////////////////////////////
+// End of CArrayKokkosND
+////////////////////////////////////////////////////////////////////////////////
+
+/*! \brief Kokkos version of the FArrayND class, backed by a rank-N View.
+ *
+ *  Indices are [0:N-1] and the first index is contiguous (LayoutLeft).
+ */
+template <typename T, size_t Rank, typename ExecSpace = DefaultExecSpace, typename MemoryTraits = void>
+class FArrayKokkosND {
+
+    static_assert(Rank >= 1 && Rank <= 7, "FArrayKokkosND rank must be between 1 and 7");
+
+    using TArrayND = Kokkos::View<typename KokkosRankType<T,Rank>::type, Kokkos::LayoutLeft, ExecSpace, MemoryTraits>;
+
+private:
+    size_t dims_[Rank];
+    size_t length_;
+    TArrayND this_array_;
+
+public:
+    FArrayKokkosND();
+
+    // --- one dimension per rank ---
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    FArrayKokkosND(Dims... dim);
+
+    template <typename... Dims,
+              typename = typename std::enable_if<std::conjunction<std::is_integral<Dims>...>::value>::type>
+    FArrayKokkosND(const std::string& tag_string, Dims... dim);
+
+    // wraps an existing View, the data is shared
+    FArrayKokkosND(const TArrayND& view);
+
+    // Overload operator(), one index per rank
+    template <typename... Indices>
+    KOKKOS_INLINE_FUNCTION
+    T& operator()(Indices... indices) const;
+
+    KOKKOS_INLINE_FUNCTION
+    FArrayKokkosND& operator=(const FArrayKokkosND& temp);
+
+    // number of elements, without any padding
+    KOKKOS_INLINE_FUNCTION
+    size_t size() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t extent() const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t dims(size_t i) const;
+
+    KOKKOS_INLINE_FUNCTION
+    size_t order() const;
+
+    // Methods returns the raw pointer (most likely GPU) of the Kokkos View
+    KOKKOS_INLINE_FUNCTION
+    T* pointer() const;
+
+    //return the rank-N view
+    KOKKOS_INLINE_FUNCTION
+    TArrayND get_kokkos_view() const;
+
+    // Deconstructor
+    KOKKOS_INLINE_FUNCTION
+    ~FArrayKokkosND ();
+}; // End of FArrayKokkosND
+
+// Default constructor
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::FArrayKokkosND() {
+    length_ = 0;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = 0;
+    }
+}
+
+// one dimension per rank
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::FArrayKokkosND(Dims... dim)
+    : FArrayKokkosND(DEFAULTSTRINGARRAY, dim...) {}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+template <typename... Dims, typename>
+FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::FArrayKokkosND(const std::string& tag_string, Dims... dim) {
+    static_assert(sizeof...(Dims) == Rank, "Number of dims does not match the rank of FArrayKokkosND!");
+    const size_t dims_in[Rank] = {static_cast<size_t>(dim)...};
+    length_ = 1;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = dims_in[r];
+        length_ *= dims_[r];
+    }
+    this_array_ = TArrayND(tag_string, static_cast<size_t>(dim)...);
+}
+
+// wrap a View
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::FArrayKokkosND(const TArrayND& view) {
+    length_ = 1;
+    for (size_t r = 0; r < Rank; r++) {
+        dims_[r] = view.extent(r);
+        length_ *= dims_[r];
+    }
+    this_array_ = view;
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+template <typename... Indices>
+KOKKOS_INLINE_FUNCTION
+T& FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::operator()(Indices... indices) const {
+    static_assert(sizeof...(Indices) == Rank, "Number of indices does not match the rank of FArrayKokkosND!");
+#ifndef NDEBUG
+    const size_t idx[Rank] = {static_cast<size_t>(indices)...};
+    for (size_t r = 0; r < Rank; r++) {
+        assert(idx[r] < dims_[r] && "index is out of bounds in FArrayKokkosND!");
+    }
+#endif
+    return this_array_(indices...);
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>& FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::operator=(const FArrayKokkosND& temp) {
+    if (this != &temp) {
+        for (size_t r = 0; r < Rank; r++) {
+            dims_[r] = temp.dims_[r];
+        }
+        length_ = temp.length_;
+        this_array_ = temp.this_array_;
+    }
+    return *this;
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::size() const {
+    return length_;
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::extent() const {
+    return length_;
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::dims(size_t i) const {
+    assert(i < Rank && "FArrayKokkosND order (rank) does not match constructor, dim[i] does not exist!");
+    assert(dims_[i]>0 && "Access to FArrayKokkosND dims is out of bounds!");
+    return dims_[i];
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+size_t FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::order() const {
+    return Rank;
+}
+
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+T* FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::pointer() const {
+    return this_array_.data();
+}
+
+//return the stored Kokkos view
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+Kokkos::View<typename KokkosRankType<T,Rank>::type, Kokkos::LayoutLeft, ExecSpace, MemoryTraits> FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::get_kokkos_view() const {
+    return this_array_;
+}
+
+// Destructor
+template <typename T, size_t Rank, typename ExecSpace, typename MemoryTraits>
+KOKKOS_INLINE_FUNCTION
+FArrayKokkosND<T,Rank,ExecSpace,MemoryTraits>::~FArrayKokkosND() {}
+
+////////////////////////////////////////////////////////////////////////////////
+// End of FArrayKokkosND
+////////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////
 // Inherited Class Array
 //////////////////////////
@@ -0,0 +1,248 @@
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+/**********************************************************************************************
+ © 2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+/**********************************************************************************************
+ A built-in collector for the loop MACROS that needs no kokkos tools.  Every FOR_ALL, DO_ALL,
+ REDUCE, SCAN, and FOR_FIRST loop is labeled with the file and line of the MACRO, or with the
+ name given as the first input, and with MATAR_LOOP_PROFILE=1 in the environment each loop
+ records its number of calls, total time, and number of iterations under that label.
+
+ FOR_ALL("assemble", elem, 0, num_elems, {
+     loop contents is here
+ });
+
+ The report, sorted by total time, is printed by Kokkos::finalize() with kokkos, and at the
+ exit of the program without it.  mtr::LoopProfiler::instance().report() prints it at any time.
+ With kokkos the labels are the kernel names that kokkos tools see, and a profiled loop fences
+ before and after it runs so that the time is the time of the loop.  The _ASYNC loops are
+ labeled but not timed.
+ **********************************************************************************************/
+
+#ifdef HAVE_KOKKOS
+#include <Kokkos_Core.hpp>
+#endif
+
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace mtr
+{
+
+class LoopProfiler {
+
+private:
+    struct Record {
+        size_t calls = 0;
+        double seconds = 0.0;
+        double iterations = 0.0;
+    };
+
+    std::map<std::string, Record> records_;
+    mutable std::mutex mutex_;
+    bool enabled_;
+
+    LoopProfiler();
+
+public:
+    LoopProfiler(const LoopProfiler&) = delete;
+    LoopProfiler& operator=(const LoopProfiler&) = delete;
+
+    // the process wide collector, enabled by MATAR_LOOP_PROFILE=1
+    static LoopProfiler& instance();
+
+    bool enabled() const;
+
+    void set_enabled(bool enabled);
+
+    void record(const char* label, double seconds, long iterations);
+
+    // the calls, total time, and iterations recorded for a label
+    size_t calls(const std::string& label) const;
+
+    double seconds(const std::string& label) const;
+
+    double iterations(const std::string& label) const;
+
+    // prints the loops sorted by total time
+    void report(FILE* out = stdout) const;
+
+    void clear();
+
+    // reports the loops that were not reported at finalize
+    ~LoopProfiler();
+
+}; // end of LoopProfiler
+
+
+inline LoopProfiler::LoopProfiler() {
+    const char* profile = std::getenv("MATAR_LOOP_PROFILE");
+    enabled_ = profile != nullptr && std::string(profile) == "1";
+
+#ifdef HAVE_KOKKOS
+    if (enabled_) {
+        Kokkos::push_finalize_hook([]() {
+            LoopProfiler::instance().report();
+            LoopProfiler::instance().clear();
+        });
+    }
+#endif
+}
+
+inline LoopProfiler& LoopProfiler::instance() {
+    static LoopProfiler profiler;
+    return profiler;
+}
+
+inline bool LoopProfiler::enabled() const {
+    return enabled_;
+}
+
+inline void LoopProfiler::set_enabled(bool enabled) {
+    enabled_ = enabled;
+}
+
+inline void LoopProfiler::record(const char* label, double seconds, long iterations) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Record& loop = records_[label];
+    loop.calls++;
+    loop.seconds += seconds;
+    loop.iterations += static_cast<double>(iterations);
+}
+
+inline size_t LoopProfiler::calls(const std::string& label) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto loop = records_.find(label);
+    return loop != records_.end() ? loop->second.calls : 0;
+}
+
+inline double LoopProfiler::seconds(const std::string& label) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto loop = records_.find(label);
+    return loop != records_.end() ? loop->second.seconds : 0.0;
+}
+
+inline double LoopProfiler::iterations(const std::string& label) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto loop = records_.find(label);
+    return loop != records_.end() ? loop->second.iterations : 0.0;
+}
+
+inline void LoopProfiler::report(FILE* out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (records_.empty()) return;
+
+    std::vector<std::pair<std::string, Record>> loops(records_.begin(), records_.end());
+    std::sort(loops.begin(), loops.end(), [](const auto& a, const auto& b) {
+        return a.second.seconds > b.second.seconds;
+    });
+
+    fprintf(out, "MATAR loop profile, sorted by total time\n");
+    fprintf(out, "%14s %10s %16s %14s  %s\n", "total (s)", "calls", "iterations", "ns/iteration", "loop");
+    for (const auto& loop : loops) {
+        const Record& rec = loop.second;
+        double ns = rec.iterations > 0.0 ? 1.0e9 * rec.seconds / rec.iterations : 0.0;
+        fprintf(out, "%14.6f %10zu %16.0f %14.3f  %s\n",
+                rec.seconds, rec.calls, rec.iterations, ns, loop.first.c_str());
+    }
+}
+
+inline void LoopProfiler::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.clear();
+}
+
+inline LoopProfiler::~LoopProfiler() {
+    report();
+}
+
+
+// times one loop of a MACRO, the MACRO creates it as a temporary in the expression
+// that launches the loop, so it is destroyed when the loop returns
+class LoopTimer {
+
+private:
+    const char* label_;
+    long iterations_;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    LoopTimer(const char* label, long iterations) : label_(nullptr) {
+        if (!LoopProfiler::instance().enabled()) return;
+#ifdef HAVE_KOKKOS
+        Kokkos::fence();
+#endif
+        label_ = label;
+        iterations_ = iterations;
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    LoopTimer(const std::string& label, long iterations) : LoopTimer(label.c_str(), iterations) {}
+
+    LoopTimer(const LoopTimer&) = delete;
+    LoopTimer& operator=(const LoopTimer&) = delete;
+
+    ~LoopTimer() {
+        if (label_ == nullptr) return;
+#ifdef HAVE_KOKKOS
+        Kokkos::fence();
+#endif
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+        LoopProfiler::instance().record(label_, elapsed.count(), iterations_);
+    }
+
+}; // end of LoopTimer
+
+
+// the number of iterations of one index of a loop, 0 when the range is empty
+template <typename T0, typename T1>
+long loop_extent(T0 start, T1 end) {
+    long extent = static_cast<long>(end) - static_cast<long>(start);
+    return extent > 0 ? extent : 0;
+}
+
+} // end namespace mtr
+
+#endif // LOOP_PROFILER_H
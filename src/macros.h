@@ -64,6 +64,38 @@
          k, 0, 3,
         { loop contents is here });
 
+ // FOR_ALL, DO_ALL and the REDUCE_SUM, REDUCE_MAX and REDUCE_MIN loops take up to 6 indices
+ FOR_ALL(elem, 0, num_elems,
+         gauss, 0, num_gauss,
+         i, 0, 3,
+         j, 0, 3,
+        { loop contents is here });
+
+ With kokkos the 4D to 6D loops use MDRangePolicy, and the tile sizes are set with
+ MATAR_TILE_4D, MATAR_TILE_5D and MATAR_TILE_6D.
+
+ // the 2D and 3D loops with the tile size of every index after the ranges
+ FOR_ALL_TILED(i, 0, 1000,
+               j, 0, 1000,
+               4, 64,
+              { loop contents is here });
+
+ // the tile is looked up by the loop name, see tile_tuner.h for the autotuner
+ FOR_ALL_TUNED("stencil", i, 0, 1000,
+                          j, 0, 1000,
+              { loop contents is here });
+
+ Without kokkos the tile sizes are ignored.  FOR_ALL_TILED_CLASS and FOR_ALL_TUNED_CLASS are
+ used inside a class.
+
+ // FOR_ALL, DO_ALL, the REDUCE_SUM, REDUCE_MAX and REDUCE_MIN loops, and their _CLASS
+ // versions take an optional loop name first, the other loops are named by file and line
+ FOR_ALL("assemble", elem, 0, num_elems,
+        { loop contents is here });
+
+ The names label the kokkos kernels, and with MATAR_LOOP_PROFILE=1 the built-in collector in
+ loop_profiler.h reports the calls, time, and iterations of every loop.
+
  2.  The syntax to use the FOR_REDUCE is as follows:
 
  // reduce over a single loop
@@ -83,11 +115,110 @@
            { loop contents is here }, answer);
  
  // other reduces are: RDUCE_MAX and REDUCE_MIN
+
+ // the location of the minimum (or maximum, with REDUCE_MAXLOC), var and answer are
+ // mtr::ValLoc<T> with members val and loc, and the loop contents set both
+ REDUCE_MINLOC(i, 0, 100,
+               local_answer,
+               { if (a(i) < local_answer.val) {
+                     local_answer.val = a(i);
+                     local_answer.loc = i; } }, answer);
+
+ // several values in one pass, var and answer are a user type whose default
+ // constructor gives the identity and whose join(const T&) member combines two
+ // partial answers, both KOKKOS_INLINE_FUNCTION when used with kokkos
+ REDUCE_CUSTOM(i, 0, 100,
+               local_answer,
+               { loop contents is here }, answer);
+
+ // the 2D and 3D versions of REDUCE_MINLOC, REDUCE_MAXLOC and REDUCE_CUSTOM take the same
+ // inputs as REDUCE_SUM, ties in REDUCE_MINLOC and REDUCE_MAXLOC can return any of the
+ // tied locations
+
+ 3.  Without kokkos, the FOR_ALL, DO_ALL, and REDUCE loops are serial unless MATAR is
+ configured with THREAD_POOL=ON, in which case they run on the thread pool in thread_pool.h.
+ The FOR_LOOP and DO_LOOP MACROS are always serial.
+
+ 4.  The _ASYNC loops take an execution space instance as the first input and return without
+ waiting for the loop, so loops on different instances, and copies such as the dual types'
+ update_host_async(), overlap.  instance.fence() waits for the loops on that instance.
+
+ std::vector<mtr::ExecInstance> instances = mtr::partition_exec_space(2);
+
+ FOR_ALL_ASYNC(instances[0], i, 0, 100,
+              { loop contents is here });
+
+ REDUCE_SUM_ASYNC(instances[1], i, 0, 100,
+                  local_answer,
+                  { loop contents is here }, answer);
+
+ instances[1].fence();  // answer is now set
+
+ With kokkos an instance is a Kokkos execution space instance (a CUDA or HIP stream, or a
+ partition of the OpenMP or Threads backend), and mtr::ExecInstance is DefaultExecSpace.  With
+ the thread pool an instance is an in-order queue with a pool of its own (see thread_pool.h).
+ Without either, an instance runs each loop as it is submitted.  The loop bodies capture by
+ value, as they do with kokkos, and the result of a reduction must be a variable name.
+
+ 5.  The SCAN loops are parallel prefix sums.  var is the running sum, declared before the loop
+ to set its type, and value is the contribution of index i.  The loop contents see var including
+ value (FOR_SCAN) or excluding it (FOR_SCAN_EXCLUSIVE), and must not change var.  An optional
+ last input is set to the sum of all the values, and must have the same type as var.
+
+ // starts(i+1) = counts(0) + ... + counts(i)
+ size_t offset = 0;
+ FOR_SCAN(i, 0, n,
+          offset, counts(i),
+          { starts(i+1) = offset; }, total);
+
+ // starts(i) = counts(0) + ... + counts(i-1)
+ FOR_SCAN_EXCLUSIVE(i, 0, n,
+                    offset, counts(i),
+                    { starts(i) = offset; });
+
+ DO_SCAN and DO_SCAN_EXCLUSIVE include the end index, and FOR_SCAN_CLASS and
+ FOR_SCAN_EXCLUSIVE_CLASS are used inside a class.  value is read before the loop contents
+ run, so a scan can be done in place.
+
+ 6.  The team loops nest three levels of parallelism.  FOR_FIRST runs one team per index i,
+ FOR_SECOND splits a loop over the threads of the team, and FOR_THIRD splits a loop over the
+ vector lanes of a thread.  FOR_SECOND and FOR_THIRD are only used inside FOR_FIRST, and
+ FOR_THIRD only inside FOR_SECOND.  The reductions over the threads or the vector lanes of a
+ team give every thread of the team the result.  TEAM_BARRIER waits for every thread of the
+ team, e.g. between a FOR_SECOND that writes values and a loop that reads them, and
+ TEAM_SINGLE runs its contents on one thread of the team.
+
+ FOR_FIRST(i, 0, num_cells, {
+     double loc_sum = 0.0;
+     double cell_sum;
+     FOR_REDUCE_SUM_SECOND(j, 0, ragged.stride(i),
+                           loc_sum, {
+         loc_sum += ragged(i,j);
+     }, cell_sum);
+     TEAM_SINGLE({
+         cell_avg(i) = cell_sum/ragged.stride(i);
+     });
+ });
+
+ The other team reductions are FOR_REDUCE_MAX_SECOND, FOR_REDUCE_MIN_SECOND and the _THIRD
+ versions.  With kokkos the teams use TeamPolicy, and FOR_FIRST_CLASS is used inside a class.
+ Without kokkos FOR_FIRST is a FOR_ALL and the inner levels are serial loops.
  **********************************************************************************************/
 
 
 #include <stdio.h>
 #include <iostream>
+#include <type_traits>
+
+#if !defined(HAVE_KOKKOS) && defined(HAVE_THREAD_POOL)
+#include "thread_pool.h"
+#endif
+
+#ifdef HAVE_KOKKOS
+#include "tile_tuner.h"
+#endif
+
+#include "loop_profiler.h"
 
 
 
@@ -100,6 +231,15 @@
 #define \
     GET_MACRO(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, NAME,...) NAME
 
+// the same for the loops with up to 6 indices
+#define \
+    GET_MACRO_ND(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, NAME,...) NAME
+
+// the label of a loop without a name, the file and line of the MACRO
+#define MATAR_STRINGIFY_LINE(line) #line
+#define MATAR_LINE_STRING(line) MATAR_STRINGIFY_LINE(line)
+#define MATAR_LOOP_LABEL __FILE__ ":" MATAR_LINE_STRING(__LINE__)
+
 
 // -----------------------------------------
 // MACROS for kokkos
@@ -113,328 +253,1457 @@
 // FArray nested loop convention use Right
 #define F_LOOP_ORDER Kokkos::Iterate::Right
 
+// tile sizes of the 4D to 6D loops, zeros let kokkos pick the tiles, set them
+// at compile time with e.g. -DMATAR_TILE_4D="{1,1,8,8}"
+#ifndef MATAR_TILE_4D
+#define MATAR_TILE_4D {0,0,0,0}
+#endif
+
+#ifndef MATAR_TILE_5D
+#define MATAR_TILE_5D {0,0,0,0,0}
+#endif
+
+#ifndef MATAR_TILE_6D
+#define MATAR_TILE_6D {0,0,0,0,0,0}
+#endif
+
 
 // run once on the device
 #define \
     RUN(fcn) \
-    Kokkos::parallel_for( Kokkos::RangePolicy<> ( 0, 1), \
-                          KOKKOS_LAMBDA(const int ijkabc){fcn} )
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, 1 ), \
+    Kokkos::parallel_for( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( 0, 1), \
+                          KOKKOS_LAMBDA(const int ijkabc){fcn} ) )
 
 // run once on the device inside a class
 #define \
     RUN_CLASS(fcn) \
-    Kokkos::parallel_for( Kokkos::RangePolicy<> ( 0, 1), \
-                          KOKKOS_CLASS_LAMBDA(const int ijkabc){fcn} )
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, 1 ), \
+    Kokkos::parallel_for( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( 0, 1), \
+                          KOKKOS_CLASS_LAMBDA(const int ijkabc){fcn} ) )
               
 
 // the FOR_ALL loop
+#define \
+    FOR1D_NAMED(name, i, x0, x1,fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_for( (name), Kokkos::RangePolicy<> ( (x0), (x1)), \
+                          KOKKOS_LAMBDA( const int (i) ){fcn} ) )
 #define \
     FOR1D(i, x0, x1,fcn) \
-    Kokkos::parallel_for( Kokkos::RangePolicy<> ( (x0), (x1)), \
-                          KOKKOS_LAMBDA( const int (i) ){fcn} )
+    FOR1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1,fcn)
 
 #define \
-    FOR2D(i, x0, x1, j, y0, y1,fcn) \
-    Kokkos::parallel_for( \
+    FOR2D_NAMED(name, i, x0, x1, j, y0, y1,fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    Kokkos::parallel_for( (name), \
         Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
-        KOKKOS_LAMBDA( const int (i), const int (j) ){fcn} )
+        KOKKOS_LAMBDA( const int (i), const int (j) ){fcn} ) )
+#define \
+    FOR2D(i, x0, x1, j, y0, y1,fcn) \
+    FOR2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1,fcn)
 
 #define \
-    FOR3D(i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
-    Kokkos::parallel_for( \
+    FOR3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    Kokkos::parallel_for( (name), \
          Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
-         KOKKOS_LAMBDA( const int (i), const int (j), const int (k) ) {fcn} )
+         KOKKOS_LAMBDA( const int (i), const int (j), const int (k) ) {fcn} ) )
+#define \
+    FOR3D(i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+    FOR3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, fcn)
+
+#define \
+    FOR4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) ), \
+    Kokkos::parallel_for( (name), \
+         Kokkos::MDRangePolicy< Kokkos::Rank<4,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0)}, {(x1), (y1), (z1), (u1)}, MATAR_TILE_4D ), \
+         KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l) ) {fcn} ) )
+#define \
+    FOR4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn) \
+    FOR4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn)
+
+#define \
+    FOR5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) ), \
+    Kokkos::parallel_for( (name), \
+         Kokkos::MDRangePolicy< Kokkos::Rank<5,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0)}, {(x1), (y1), (z1), (u1), (v1)}, MATAR_TILE_5D ), \
+         KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m) ) {fcn} ) )
+#define \
+    FOR5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn) \
+    FOR5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn)
+
+#define \
+    FOR6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) * mtr::loop_extent((w0), (w1)) ), \
+    Kokkos::parallel_for( (name), \
+         Kokkos::MDRangePolicy< Kokkos::Rank<6,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0), (w0)}, {(x1), (y1), (z1), (u1), (v1), (w1)}, MATAR_TILE_6D ), \
+         KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n) ) {fcn} ) )
+#define \
+    FOR6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn) \
+    FOR6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn)
 
 #define \
     FOR_ALL(...) \
-    GET_MACRO(__VA_ARGS__, _13, _12, _11, FOR3D, _9, _8, FOR2D, _6, _5, FOR1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, _22, _21, FOR6D_NAMED, FOR6D, _18, FOR5D_NAMED, FOR5D, _15, FOR4D_NAMED, FOR4D, _12, FOR3D_NAMED, FOR3D, _9, FOR2D_NAMED, FOR2D, _6, FOR1D_NAMED, FOR1D)(__VA_ARGS__)
+
+
+// the FOR_ALL loop with the tile size of every index
+#define \
+    FOR2D_TILED(i, x0, x1, j, y0, y1, ti, tj, fcn) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    Kokkos::parallel_for( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)}, {(ti), (tj)} ), \
+        KOKKOS_LAMBDA( const int (i), const int (j) ){fcn} ) )
+
+#define \
+    FOR3D_TILED(i, x0, x1, j, y0, y1, k, z0, z1, ti, tj, tk, fcn) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    Kokkos::parallel_for( MATAR_LOOP_LABEL, \
+         Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)}, {(ti), (tj), (tk)} ), \
+         KOKKOS_LAMBDA( const int (i), const int (j), const int (k) ) {fcn} ) )
+
+#define \
+    FOR_ALL_TILED(...) \
+    GET_MACRO(__VA_ARGS__, FOR3D_TILED, _12, _11, _10, FOR2D_TILED)(__VA_ARGS__)
+
+
+// the FOR_ALL loop with the tile from the tuner for the loop name
+#define \
+    FOR2D_TUNED(name, i, x0, x1, j, y0, y1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    mtr::tuned_for< Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > >( (name), \
+        {(x0), (y0)}, {(x1), (y1)}, \
+        KOKKOS_LAMBDA( const int (i), const int (j) ){fcn} ) )
+
+#define \
+    FOR3D_TUNED(name, i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    mtr::tuned_for< Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > >( (name), \
+         {(x0), (y0), (z0)}, {(x1), (y1), (z1)}, \
+         KOKKOS_LAMBDA( const int (i), const int (j), const int (k) ) {fcn} ) )
+
+#define \
+    FOR_ALL_TUNED(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, FOR3D_TUNED, _10, _9, FOR2D_TUNED)(__VA_ARGS__)
 
 
 // the DO_ALL loop
+#define \
+    DO1D_NAMED(name, i, x0, x1,fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) ), \
+    Kokkos::parallel_for( (name), Kokkos::RangePolicy<> ( (x0), (x1)+1), \
+                          KOKKOS_LAMBDA( const int (i) ){fcn} ) )
 #define \
     DO1D(i, x0, x1,fcn) \
-    Kokkos::parallel_for( Kokkos::RangePolicy<> ( (x0), (x1)+1), \
-                          KOKKOS_LAMBDA( const int (i) ){fcn} )
+    DO1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1,fcn)
 
 #define \
-    DO2D(i, x0, x1, j, y0, y1,fcn) \
-    Kokkos::parallel_for( \
+    DO2D_NAMED(name, i, x0, x1, j, y0, y1,fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) ), \
+    Kokkos::parallel_for( (name), \
         Kokkos::MDRangePolicy< Kokkos::Rank<2,F_LOOP_ORDER, F_LOOP_ORDER> > ( {(x0), (y0)}, {(x1)+1, (y1)+1} ), \
-        KOKKOS_LAMBDA( const int (i), const int (j) ){fcn} )
+        KOKKOS_LAMBDA( const int (i), const int (j) ){fcn} ) )
+#define \
+    DO2D(i, x0, x1, j, y0, y1,fcn) \
+    DO2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1,fcn)
 
 #define \
-    DO3D(i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
-    Kokkos::parallel_for( \
+    DO3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) ), \
+    Kokkos::parallel_for( (name), \
          Kokkos::MDRangePolicy< Kokkos::Rank<3,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1)+1, (y1)+1, (z1)+1} ), \
-         KOKKOS_LAMBDA( const int (i), const int (j), const int (k) ) {fcn} )
+         KOKKOS_LAMBDA( const int (i), const int (j), const int (k) ) {fcn} ) )
+#define \
+    DO3D(i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+    DO3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, fcn)
+
+#define \
+    DO4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) ), \
+    Kokkos::parallel_for( (name), \
+         Kokkos::MDRangePolicy< Kokkos::Rank<4,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0), (u0)}, {(x1)+1, (y1)+1, (z1)+1, (u1)+1}, MATAR_TILE_4D ), \
+         KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l) ) {fcn} ) )
+#define \
+    DO4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn) \
+    DO4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn)
+
+#define \
+    DO5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) ), \
+    Kokkos::parallel_for( (name), \
+         Kokkos::MDRangePolicy< Kokkos::Rank<5,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0)}, {(x1)+1, (y1)+1, (z1)+1, (u1)+1, (v1)+1}, MATAR_TILE_5D ), \
+         KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m) ) {fcn} ) )
+#define \
+    DO5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn) \
+    DO5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn)
+
+#define \
+    DO6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) * mtr::loop_extent((w0), (w1)+1) ), \
+    Kokkos::parallel_for( (name), \
+         Kokkos::MDRangePolicy< Kokkos::Rank<6,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0), (w0)}, {(x1)+1, (y1)+1, (z1)+1, (u1)+1, (v1)+1, (w1)+1}, MATAR_TILE_6D ), \
+         KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n) ) {fcn} ) )
+#define \
+    DO6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn) \
+    DO6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn)
 
 #define \
     DO_ALL(...) \
-    GET_MACRO(__VA_ARGS__, _13, _12, _11, DO3D, _9, _8, DO2D, _6, _5, DO1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, _22, _21, DO6D_NAMED, DO6D, _18, DO5D_NAMED, DO5D, _15, DO4D_NAMED, DO4D, _12, DO3D_NAMED, DO3D, _9, DO2D_NAMED, DO2D, _6, DO1D_NAMED, DO1D)(__VA_ARGS__)
 
 
 // the REDUCE SUM loop
+#define \
+    RSUM1D_NAMED(name, i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_reduce( (name), Kokkos::RangePolicy<> ( (x0), (x1) ),  \
+                             KOKKOS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, (result)) )
 #define \
     RSUM1D(i, x0, x1, var, fcn, result) \
-    Kokkos::parallel_reduce( Kokkos::RangePolicy<> ( (x0), (x1) ),  \
-                             KOKKOS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, (result))
+    RSUM1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
 
 #define \
-    RSUM2D(i, x0, x1, j, y0, y1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    RSUM2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    Kokkos::parallel_reduce( (name), \
         Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
         KOKKOS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-           (result) )
+           (result) ) )
+#define \
+    RSUM2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    RSUM2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
 
 #define \
-    RSUM3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    RSUM3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    Kokkos::parallel_reduce( (name), \
         Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
         KOKKOS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-            (result) )
+            (result) ) )
+#define \
+    RSUM3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    RSUM3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+
+#define \
+    RSUM4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<4,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0)}, {(x1), (y1), (z1), (u1)}, MATAR_TILE_4D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                        (result) ) )
+#define \
+    RSUM4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    RSUM4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+
+#define \
+    RSUM5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<5,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0)}, {(x1), (y1), (z1), (u1), (v1)}, MATAR_TILE_5D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                        (result) ) )
+#define \
+    RSUM5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    RSUM5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+
+#define \
+    RSUM6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) * mtr::loop_extent((w0), (w1)) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<6,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0), (w0)}, {(x1), (y1), (z1), (u1), (v1), (w1)}, MATAR_TILE_6D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                        (result) ) )
+#define \
+    RSUM6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    RSUM6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
     REDUCE_SUM(...) \
-    GET_MACRO(__VA_ARGS__, _13, RSUM3D, _11, _10, RSUM2D, _8, _7, RSUM1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, RSUM6D_NAMED, RSUM6D, _20, RSUM5D_NAMED, RSUM5D, _17, RSUM4D_NAMED, RSUM4D, _14, RSUM3D_NAMED, RSUM3D, _11, RSUM2D_NAMED, RSUM2D, _8, RSUM1D_NAMED, RSUM1D)(__VA_ARGS__)
 
 
 // the DO_REDUCE_SUM loop
+#define \
+    DO_RSUM1D_NAMED(name, i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) ), \
+    Kokkos::parallel_reduce( (name), Kokkos::RangePolicy<> ( (x0), (x1)+1 ),  \
+                             KOKKOS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, (result)) )
 #define \
     DO_RSUM1D(i, x0, x1, var, fcn, result) \
-    Kokkos::parallel_reduce( Kokkos::RangePolicy<> ( (x0), (x1)+1 ),  \
-                             KOKKOS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, (result))
+    DO_RSUM1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
 
 #define \
-    DO_RSUM2D(i, x0, x1, j, y0, y1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    DO_RSUM2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
         Kokkos::MDRangePolicy< Kokkos::Rank<2,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0)}, {(x1)+1, (y1)+1} ), \
         KOKKOS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-           (result) )
+           (result) ) )
+#define \
+    DO_RSUM2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    DO_RSUM2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
 
 #define \
-    DO_RSUM3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    DO_RSUM3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
         Kokkos::MDRangePolicy< Kokkos::Rank<3,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1)+1, (y1)+1, (z1)+1} ), \
         KOKKOS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-            (result) )
+            (result) ) )
+#define \
+    DO_RSUM3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    DO_RSUM3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+
+#define \
+    DO_RSUM4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<4,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0), (u0)}, {(x1)+1, (y1)+1, (z1)+1, (u1)+1}, MATAR_TILE_4D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                        (result) ) )
+#define \
+    DO_RSUM4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    DO_RSUM4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+
+#define \
+    DO_RSUM5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<5,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0)}, {(x1)+1, (y1)+1, (z1)+1, (u1)+1, (v1)+1}, MATAR_TILE_5D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                        (result) ) )
+#define \
+    DO_RSUM5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    DO_RSUM5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+
+#define \
+    DO_RSUM6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) * mtr::loop_extent((w0), (w1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<6,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0), (w0)}, {(x1)+1, (y1)+1, (z1)+1, (u1)+1, (v1)+1, (w1)+1}, MATAR_TILE_6D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                        (result) ) )
+#define \
+    DO_RSUM6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    DO_RSUM6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
     DO_REDUCE_SUM(...) \
-    GET_MACRO(__VA_ARGS__, _13, DO_RSUM3D, _11, _10, DO_RSUM2D, _8, _7, DO_RSUM1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, DO_RSUM6D_NAMED, DO_RSUM6D, _20, DO_RSUM5D_NAMED, DO_RSUM5D, _17, DO_RSUM4D_NAMED, DO_RSUM4D, _14, DO_RSUM3D_NAMED, DO_RSUM3D, _11, DO_RSUM2D_NAMED, DO_RSUM2D, _8, DO_RSUM1D_NAMED, DO_RSUM1D)(__VA_ARGS__)
 
 
 // the REDUCE MAX loop
 #define \
-    RMAX1D(i, x0, x1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    RMAX1D_NAMED(name, i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_reduce( (name), \
                         Kokkos::RangePolicy<> ( (x0), (x1) ),  \
                         KOKKOS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, \
-                        Kokkos::Max< decltype(result) > ( (result) ) )
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+    RMAX1D(i, x0, x1, var, fcn, result) \
+    RMAX1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
 
 #define \
-    RMAX2D(i, x0, x1, j, y0, y1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    RMAX2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
                         KOKKOS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Max< decltype(result) > ( (result) ) )
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+    RMAX2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    RMAX2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
 
 #define \
-    RMAX3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    RMAX3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
                         KOKKOS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Max< decltype(result) > ( (result) ) )
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+    RMAX3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    RMAX3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+
+#define \
+    RMAX4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<4,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0)}, {(x1), (y1), (z1), (u1)}, MATAR_TILE_4D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+    RMAX4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    RMAX4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+
+#define \
+    RMAX5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<5,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0)}, {(x1), (y1), (z1), (u1), (v1)}, MATAR_TILE_5D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+    RMAX5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    RMAX5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+
+#define \
+    RMAX6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) * mtr::loop_extent((w0), (w1)) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<6,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0), (w0)}, {(x1), (y1), (z1), (u1), (v1), (w1)}, MATAR_TILE_6D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+    RMAX6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    RMAX6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
     REDUCE_MAX(...) \
-    GET_MACRO(__VA_ARGS__, _13, RMAX3D, _11, _10, RMAX2D, _8, _7, RMAX1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, RMAX6D_NAMED, RMAX6D, _20, RMAX5D_NAMED, RMAX5D, _17, RMAX4D_NAMED, RMAX4D, _14, RMAX3D_NAMED, RMAX3D, _11, RMAX2D_NAMED, RMAX2D, _8, RMAX1D_NAMED, RMAX1D)(__VA_ARGS__)
 
 
 // the DO_REDUCE_MAX loop
 #define \
-    DO_RMAX1D(i, x0, x1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    DO_RMAX1D_NAMED(name, i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
                         Kokkos::RangePolicy<> ( (x0), (x1)+1 ),  \
                         KOKKOS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, \
-                        Kokkos::Max< decltype(result) > ( (result) ) )
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+    DO_RMAX1D(i, x0, x1, var, fcn, result) \
+    DO_RMAX1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
 
 #define \
-    DO_RMAX2D(i, x0, x1, j, y0, y1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    DO_RMAX2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<2,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0)}, {(x1)+1, (y1)+1} ), \
                         KOKKOS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Max< decltype(result) > ( (result) ) )
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+    DO_RMAX2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    DO_RMAX2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
 
 #define \
-    DO_RMAX3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    DO_RMAX3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<3,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1)+1, (y1)+1, (z1)+1} ), \
                         KOKKOS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Max< decltype(result) > ( (result) ) )
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+    DO_RMAX3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    DO_RMAX3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+
+#define \
+    DO_RMAX4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<4,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0), (u0)}, {(x1)+1, (y1)+1, (z1)+1, (u1)+1}, MATAR_TILE_4D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+    DO_RMAX4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    DO_RMAX4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+
+#define \
+    DO_RMAX5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<5,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0)}, {(x1)+1, (y1)+1, (z1)+1, (u1)+1, (v1)+1}, MATAR_TILE_5D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+    DO_RMAX5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    DO_RMAX5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+
+#define \
+    DO_RMAX6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) * mtr::loop_extent((w0), (w1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<6,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0), (w0)}, {(x1)+1, (y1)+1, (z1)+1, (u1)+1, (v1)+1, (w1)+1}, MATAR_TILE_6D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+    DO_RMAX6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    DO_RMAX6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
     DO_REDUCE_MAX(...) \
-    GET_MACRO(__VA_ARGS__, _13, DO_RMAX3D, _11, _10, DO_RMAX2D, _8, _7, DO_RMAX1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, DO_RMAX6D_NAMED, DO_RMAX6D, _20, DO_RMAX5D_NAMED, DO_RMAX5D, _17, DO_RMAX4D_NAMED, DO_RMAX4D, _14, DO_RMAX3D_NAMED, DO_RMAX3D, _11, DO_RMAX2D_NAMED, DO_RMAX2D, _8, DO_RMAX1D_NAMED, DO_RMAX1D)(__VA_ARGS__)
 
 
 
 // the REDUCE MIN loop
 #define \
-    RMIN1D(i, x0, x1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    RMIN1D_NAMED(name, i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_reduce( (name), \
                         Kokkos::RangePolicy<> ( (x0), (x1) ),  \
                         KOKKOS_LAMBDA( const int (i), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Min< decltype(result) >(result))
+                        Kokkos::Min< decltype(result) >(result)) )
+#define \
+    RMIN1D(i, x0, x1, var, fcn, result) \
+    RMIN1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
 
 #define \
-    RMIN2D(i, x0, x1, j, y0, y1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    RMIN2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
                         KOKKOS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Min< decltype(result) >(result) )
+                        Kokkos::Min< decltype(result) >(result) ) )
+#define \
+    RMIN2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    RMIN2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
 
 #define \
-    RMIN3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    RMIN3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
                         KOKKOS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Min< decltype(result) >(result) )
+                        Kokkos::Min< decltype(result) >(result) ) )
+#define \
+    RMIN3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    RMIN3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+
+#define \
+    RMIN4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<4,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0)}, {(x1), (y1), (z1), (u1)}, MATAR_TILE_4D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Min< decltype(result) >(result) ) )
+#define \
+    RMIN4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    RMIN4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+
+#define \
+    RMIN5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<5,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0)}, {(x1), (y1), (z1), (u1), (v1)}, MATAR_TILE_5D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Min< decltype(result) >(result) ) )
+#define \
+    RMIN5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    RMIN5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+
+#define \
+    RMIN6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) * mtr::loop_extent((w0), (w1)) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<6,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0), (w0)}, {(x1), (y1), (z1), (u1), (v1), (w1)}, MATAR_TILE_6D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Min< decltype(result) >(result) ) )
+#define \
+    RMIN6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    RMIN6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
     REDUCE_MIN(...) \
-    GET_MACRO(__VA_ARGS__, _13, RMIN3D, _11, _10, RMIN2D, _8, _7, RMIN1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, RMIN6D_NAMED, RMIN6D, _20, RMIN5D_NAMED, RMIN5D, _17, RMIN4D_NAMED, RMIN4D, _14, RMIN3D_NAMED, RMIN3D, _11, RMIN2D_NAMED, RMIN2D, _8, RMIN1D_NAMED, RMIN1D)(__VA_ARGS__)
 
 
 // the DO_REDUCE MIN loop
 #define \
-    DO_RMIN1D(i, x0, x1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    DO_RMIN1D_NAMED(name, i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
                         Kokkos::RangePolicy<> ( (x0), (x1)+1 ),  \
                         KOKKOS_LAMBDA( const int (i), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Min< decltype(result) >(result))
+                        Kokkos::Min< decltype(result) >(result)) )
+#define \
+    DO_RMIN1D(i, x0, x1, var, fcn, result) \
+    DO_RMIN1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
 
 #define \
-    DO_RMIN2D(i, x0, x1, j, y0, y1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    DO_RMIN2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<2,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0)}, {(x1)+1, (y1)+1} ), \
                         KOKKOS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Min< decltype(result) >(result) )
+                        Kokkos::Min< decltype(result) >(result) ) )
+#define \
+    DO_RMIN2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    DO_RMIN2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
 
 #define \
-    DO_RMIN3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
-    Kokkos::parallel_reduce( \
+    DO_RMIN3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<3,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1)+1, (y1)+1, (z1)+1} ), \
                         KOKKOS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Min< decltype(result) >(result) )
+                        Kokkos::Min< decltype(result) >(result) ) )
+#define \
+    DO_RMIN3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    DO_RMIN3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+
+#define \
+    DO_RMIN4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<4,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0), (u0)}, {(x1)+1, (y1)+1, (z1)+1, (u1)+1}, MATAR_TILE_4D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Min< decltype(result) >(result) ) )
+#define \
+    DO_RMIN4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    DO_RMIN4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+
+#define \
+    DO_RMIN5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<5,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0)}, {(x1)+1, (y1)+1, (z1)+1, (u1)+1, (v1)+1}, MATAR_TILE_5D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Min< decltype(result) >(result) ) )
+#define \
+    DO_RMIN5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    DO_RMIN5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+
+#define \
+    DO_RMIN6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) * mtr::loop_extent((w0), (w1)+1) ), \
+    Kokkos::parallel_reduce( (name), \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<6,F_LOOP_ORDER,F_LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0), (w0)}, {(x1)+1, (y1)+1, (z1)+1, (u1)+1, (v1)+1, (w1)+1}, MATAR_TILE_6D ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Min< decltype(result) >(result) ) )
+#define \
+    DO_RMIN6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    DO_RMIN6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
     DO_REDUCE_MIN(...) \
-    GET_MACRO(__VA_ARGS__, _13, DO_RMIN3D, _11, _10, DO_RMIN2D, _8, _7, DO_RMIN1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, DO_RMIN6D_NAMED, DO_RMIN6D, _20, DO_RMIN5D_NAMED, DO_RMIN5D, _17, DO_RMIN4D_NAMED, DO_RMIN4D, _14, DO_RMIN3D_NAMED, DO_RMIN3D, _11, DO_RMIN2D_NAMED, DO_RMIN2D, _8, DO_RMIN1D_NAMED, DO_RMIN1D)(__VA_ARGS__)
 
 
 
 // the FOR_ALL loop with variables in a class
 #define \
+FORCLASS1D_NAMED(name, i, x0, x1,fcn) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) ), \
+Kokkos::parallel_for( (name), Kokkos::RangePolicy<> ( (x0), (x1)), \
+                     KOKKOS_CLASS_LAMBDA( const int (i) ){fcn} ) )
+#define \
 FORCLASS1D(i, x0, x1,fcn) \
-Kokkos::parallel_for( Kokkos::RangePolicy<> ( (x0), (x1)), \
-                     KOKKOS_CLASS_LAMBDA( const int (i) ){fcn} )
+FORCLASS1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1,fcn)
 
 #define \
-FORCLASS2D(i, x0, x1, j, y0, y1,fcn) \
-Kokkos::parallel_for( \
+FORCLASS2D_NAMED(name, i, x0, x1, j, y0, y1,fcn) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+Kokkos::parallel_for( (name), \
                      Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
-                     KOKKOS_CLASS_LAMBDA( const int (i), const int (j) ){fcn} )
+                     KOKKOS_CLASS_LAMBDA( const int (i), const int (j) ){fcn} ) )
+#define \
+FORCLASS2D(i, x0, x1, j, y0, y1,fcn) \
+FORCLASS2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1,fcn)
 
 #define \
-FORCLASS3D(i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
-Kokkos::parallel_for( \
+FORCLASS3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+Kokkos::parallel_for( (name), \
                      Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
-                     KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k) ) {fcn} )
+                     KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k) ) {fcn} ) )
+#define \
+FORCLASS3D(i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+FORCLASS3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, fcn)
+
+#define \
+FORCLASS4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) ), \
+Kokkos::parallel_for( (name), \
+     Kokkos::MDRangePolicy< Kokkos::Rank<4,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0)}, {(x1), (y1), (z1), (u1)}, MATAR_TILE_4D ), \
+     KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), const int (l) ) {fcn} ) )
+#define \
+FORCLASS4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn) \
+FORCLASS4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn)
+
+#define \
+FORCLASS5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) ), \
+Kokkos::parallel_for( (name), \
+     Kokkos::MDRangePolicy< Kokkos::Rank<5,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0)}, {(x1), (y1), (z1), (u1), (v1)}, MATAR_TILE_5D ), \
+     KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m) ) {fcn} ) )
+#define \
+FORCLASS5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn) \
+FORCLASS5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn)
+
+#define \
+FORCLASS6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) * mtr::loop_extent((w0), (w1)) ), \
+Kokkos::parallel_for( (name), \
+     Kokkos::MDRangePolicy< Kokkos::Rank<6,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0), (w0)}, {(x1), (y1), (z1), (u1), (v1), (w1)}, MATAR_TILE_6D ), \
+     KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n) ) {fcn} ) )
+#define \
+FORCLASS6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn) \
+FORCLASS6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn)
 
 #define \
 FOR_ALL_CLASS(...) \
-GET_MACRO(__VA_ARGS__, _13, _12, _11, FORCLASS3D, _9, _8, FORCLASS2D, _6, _5, FORCLASS1D)(__VA_ARGS__)
+GET_MACRO_ND(__VA_ARGS__, _22, _21, FORCLASS6D_NAMED, FORCLASS6D, _18, FORCLASS5D_NAMED, FORCLASS5D, _15, FORCLASS4D_NAMED, FORCLASS4D, _12, FORCLASS3D_NAMED, FORCLASS3D, _9, FORCLASS2D_NAMED, FORCLASS2D, _6, FORCLASS1D_NAMED, FORCLASS1D)(__VA_ARGS__)
+
+
+// the FOR_ALL loop with the tile size of every index inside a class
+#define \
+FORCLASS2D_TILED(i, x0, x1, j, y0, y1, ti, tj, fcn) \
+( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+Kokkos::parallel_for( MATAR_LOOP_LABEL, \
+                     Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)}, {(ti), (tj)} ), \
+                     KOKKOS_CLASS_LAMBDA( const int (i), const int (j) ){fcn} ) )
+
+#define \
+FORCLASS3D_TILED(i, x0, x1, j, y0, y1, k, z0, z1, ti, tj, tk, fcn) \
+( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+Kokkos::parallel_for( MATAR_LOOP_LABEL, \
+                     Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)}, {(ti), (tj), (tk)} ), \
+                     KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k) ) {fcn} ) )
+
+#define \
+FOR_ALL_TILED_CLASS(...) \
+GET_MACRO(__VA_ARGS__, FORCLASS3D_TILED, _12, _11, _10, FORCLASS2D_TILED)(__VA_ARGS__)
+
+
+// the FOR_ALL loop with the tile from the tuner inside a class
+#define \
+FORCLASS2D_TUNED(name, i, x0, x1, j, y0, y1, fcn) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+mtr::tuned_for< Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > >( (name), \
+                     {(x0), (y0)}, {(x1), (y1)}, \
+                     KOKKOS_CLASS_LAMBDA( const int (i), const int (j) ){fcn} ) )
+
+#define \
+FORCLASS3D_TUNED(name, i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+mtr::tuned_for< Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > >( (name), \
+                     {(x0), (y0), (z0)}, {(x1), (y1), (z1)}, \
+                     KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k) ) {fcn} ) )
+
+#define \
+FOR_ALL_TUNED_CLASS(...) \
+GET_MACRO(__VA_ARGS__, _13, _12, FORCLASS3D_TUNED, _10, _9, FORCLASS2D_TUNED)(__VA_ARGS__)
 
 
 // the REDUCE SUM loop
 #define \
+RSUMCLASS1D_NAMED(name, i, x0, x1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) ), \
+Kokkos::parallel_reduce( (name), Kokkos::RangePolicy<> ( (x0), (x1) ),  \
+                        KOKKOS_CLASS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, (result)) )
+#define \
 RSUMCLASS1D(i, x0, x1, var, fcn, result) \
-Kokkos::parallel_reduce( Kokkos::RangePolicy<> ( (x0), (x1) ),  \
-                        KOKKOS_CLASS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, (result))
+RSUMCLASS1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
 
 #define \
-RSUMCLASS2D(i, x0, x1, j, y0, y1, var, fcn, result) \
-Kokkos::parallel_reduce( \
+RSUMCLASS2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
                         KOKKOS_CLASS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                        (result) )
+                        (result) ) )
+#define \
+RSUMCLASS2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+RSUMCLASS2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
 
 #define \
-RSUMCLASS3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
-Kokkos::parallel_reduce( \
+RSUMCLASS3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
                         KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                        (result) )
+                        (result) ) )
+#define \
+RSUMCLASS3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+RSUMCLASS3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+
+#define \
+RSUMCLASS4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) ), \
+Kokkos::parallel_reduce( (name), \
+                    Kokkos::MDRangePolicy< Kokkos::Rank<4,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0)}, {(x1), (y1), (z1), (u1)}, MATAR_TILE_4D ), \
+                    KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                    (result) ) )
+#define \
+RSUMCLASS4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+RSUMCLASS4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+
+#define \
+RSUMCLASS5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) ), \
+Kokkos::parallel_reduce( (name), \
+                    Kokkos::MDRangePolicy< Kokkos::Rank<5,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0)}, {(x1), (y1), (z1), (u1), (v1)}, MATAR_TILE_5D ), \
+                    KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                    (result) ) )
+#define \
+RSUMCLASS5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+RSUMCLASS5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+
+#define \
+RSUMCLASS6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) * mtr::loop_extent((w0), (w1)) ), \
+Kokkos::parallel_reduce( (name), \
+                    Kokkos::MDRangePolicy< Kokkos::Rank<6,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0), (w0)}, {(x1), (y1), (z1), (u1), (v1), (w1)}, MATAR_TILE_6D ), \
+                    KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                    (result) ) )
+#define \
+RSUMCLASS6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+RSUMCLASS6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
 REDUCE_SUM_CLASS(...) \
-GET_MACRO(__VA_ARGS__, _13, RSUMCLASS3D, _11, _10, RSUMCLASS2D, _8, _7, RSUMCLASS1D)(__VA_ARGS__)
+GET_MACRO_ND(__VA_ARGS__, RSUMCLASS6D_NAMED, RSUMCLASS6D, _20, RSUMCLASS5D_NAMED, RSUMCLASS5D, _17, RSUMCLASS4D_NAMED, RSUMCLASS4D, _14, RSUMCLASS3D_NAMED, RSUMCLASS3D, _11, RSUMCLASS2D_NAMED, RSUMCLASS2D, _8, RSUMCLASS1D_NAMED, RSUMCLASS1D)(__VA_ARGS__)
 
 
 
 // the REDUCE MAX loop with variables in a class
 
 #define \
-RMAXCLASS1D(i, x0, x1, var, fcn, result) \
-Kokkos::parallel_reduce( \
+RMAXCLASS1D_NAMED(name, i, x0, x1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) ), \
+Kokkos::parallel_reduce( (name), \
                         Kokkos::RangePolicy<> ( (x0), (x1) ),  \
                         KOKKOS_CLASS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, \
-                        Kokkos::Max< decltype(result) > ( (result) ) )
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+RMAXCLASS1D(i, x0, x1, var, fcn, result) \
+RMAXCLASS1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
 
 #define \
-RMAXCLASS2D(i, x0, x1, j, y0, y1, var, fcn, result) \
-Kokkos::parallel_reduce( \
+RMAXCLASS2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
                         KOKKOS_CLASS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Max< decltype(result) > ( (result) ) )
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+RMAXCLASS2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+RMAXCLASS2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
 
 #define \
-RMAXCLASS3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
-Kokkos::parallel_reduce( \
+RMAXCLASS3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
                         KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Max< decltype(result) > ( (result) ) )
+                        Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+RMAXCLASS3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+RMAXCLASS3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+
+#define \
+RMAXCLASS4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) ), \
+Kokkos::parallel_reduce( (name), \
+                    Kokkos::MDRangePolicy< Kokkos::Rank<4,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0)}, {(x1), (y1), (z1), (u1)}, MATAR_TILE_4D ), \
+                    KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                    Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+RMAXCLASS4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+RMAXCLASS4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+
+#define \
+RMAXCLASS5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) ), \
+Kokkos::parallel_reduce( (name), \
+                    Kokkos::MDRangePolicy< Kokkos::Rank<5,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0)}, {(x1), (y1), (z1), (u1), (v1)}, MATAR_TILE_5D ), \
+                    KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                    Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+RMAXCLASS5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+RMAXCLASS5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+
+#define \
+RMAXCLASS6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) * mtr::loop_extent((w0), (w1)) ), \
+Kokkos::parallel_reduce( (name), \
+                    Kokkos::MDRangePolicy< Kokkos::Rank<6,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0), (w0)}, {(x1), (y1), (z1), (u1), (v1), (w1)}, MATAR_TILE_6D ), \
+                    KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                    Kokkos::Max< decltype(result) > ( (result) ) ) )
+#define \
+RMAXCLASS6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+RMAXCLASS6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
 REDUCE_MAX_CLASS(...) \
-GET_MACRO(__VA_ARGS__, _13, RMAXCLASS3D, _11, _10, RMAXCLASS2D, _8, _7, RMAXCLASS1D)(__VA_ARGS__)
+GET_MACRO_ND(__VA_ARGS__, RMAXCLASS6D_NAMED, RMAXCLASS6D, _20, RMAXCLASS5D_NAMED, RMAXCLASS5D, _17, RMAXCLASS4D_NAMED, RMAXCLASS4D, _14, RMAXCLASS3D_NAMED, RMAXCLASS3D, _11, RMAXCLASS2D_NAMED, RMAXCLASS2D, _8, RMAXCLASS1D_NAMED, RMAXCLASS1D)(__VA_ARGS__)
 
 
 // the REDUCE MIN loop with variables in a class
 #define \
-RMINCLASS1D(i, x0, x1, var, fcn, result) \
-Kokkos::parallel_reduce( \
+RMINCLASS1D_NAMED(name, i, x0, x1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) ), \
+Kokkos::parallel_reduce( (name), \
                         Kokkos::RangePolicy<> ( (x0), (x1) ),  \
                         KOKKOS_CLASS_LAMBDA( const int (i), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Min< decltype(result) >(result))
+                        Kokkos::Min< decltype(result) >(result)) )
+#define \
+RMINCLASS1D(i, x0, x1, var, fcn, result) \
+RMINCLASS1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
 
 #define \
-RMINCLASS2D(i, x0, x1, j, y0, y1, var, fcn, result) \
-Kokkos::parallel_reduce( \
+RMINCLASS2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
                         KOKKOS_CLASS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Min< decltype(result) >(result) )
+                        Kokkos::Min< decltype(result) >(result) ) )
+#define \
+RMINCLASS2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+RMINCLASS2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
 
 #define \
-RMINCLASS3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
-Kokkos::parallel_reduce( \
+RMINCLASS3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+Kokkos::parallel_reduce( (name), \
                         Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
                         KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                        Kokkos::Min< decltype(result) >(result) )
+                        Kokkos::Min< decltype(result) >(result) ) )
+#define \
+RMINCLASS3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+RMINCLASS3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+
+#define \
+RMINCLASS4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) ), \
+Kokkos::parallel_reduce( (name), \
+                    Kokkos::MDRangePolicy< Kokkos::Rank<4,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0)}, {(x1), (y1), (z1), (u1)}, MATAR_TILE_4D ), \
+                    KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                    Kokkos::Min< decltype(result) >(result) ) )
+#define \
+RMINCLASS4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+RMINCLASS4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+
+#define \
+RMINCLASS5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) ), \
+Kokkos::parallel_reduce( (name), \
+                    Kokkos::MDRangePolicy< Kokkos::Rank<5,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0)}, {(x1), (y1), (z1), (u1), (v1)}, MATAR_TILE_5D ), \
+                    KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                    Kokkos::Min< decltype(result) >(result) ) )
+#define \
+RMINCLASS5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+RMINCLASS5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+
+#define \
+RMINCLASS6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) * mtr::loop_extent((w0), (w1)) ), \
+Kokkos::parallel_reduce( (name), \
+                    Kokkos::MDRangePolicy< Kokkos::Rank<6,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0), (u0), (v0), (w0)}, {(x1), (y1), (z1), (u1), (v1), (w1)}, MATAR_TILE_6D ), \
+                    KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                    Kokkos::Min< decltype(result) >(result) ) )
+#define \
+RMINCLASS6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+RMINCLASS6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
 REDUCE_MIN_CLASS(...) \
-GET_MACRO(__VA_ARGS__, _13, RMINCLASS3D, _11, _10, RMINCLASS2D, _8, _7, RMINCLASS1D)(__VA_ARGS__)
+GET_MACRO_ND(__VA_ARGS__, RMINCLASS6D_NAMED, RMINCLASS6D, _20, RMINCLASS5D_NAMED, RMINCLASS5D, _17, RMINCLASS4D_NAMED, RMINCLASS4D, _14, RMINCLASS3D_NAMED, RMINCLASS3D, _11, RMINCLASS2D_NAMED, RMINCLASS2D, _8, RMINCLASS1D_NAMED, RMINCLASS1D)(__VA_ARGS__)
+
+
+// the REDUCE MINLOC loop, var and result are mtr::ValLoc
+#define \
+    RMINLOC1D(i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ),  \
+                             KOKKOS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, \
+                             Kokkos::MinLoc< decltype((result).val), decltype((result).loc) > ( (result) ) ) )
+
+#define \
+    RMINLOC2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
+        KOKKOS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
+        Kokkos::MinLoc< decltype((result).val), decltype((result).loc) > ( (result) ) ) )
+
+#define \
+    RMINLOC3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
+        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+        Kokkos::MinLoc< decltype((result).val), decltype((result).loc) > ( (result) ) ) )
+
+#define \
+    REDUCE_MINLOC(...) \
+    GET_MACRO(__VA_ARGS__, _13, RMINLOC3D, _11, _10, RMINLOC2D, _8, _7, RMINLOC1D)(__VA_ARGS__)
+
+
+// the REDUCE MAXLOC loop, var and result are mtr::ValLoc
+#define \
+    RMAXLOC1D(i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ),  \
+                             KOKKOS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, \
+                             Kokkos::MaxLoc< decltype((result).val), decltype((result).loc) > ( (result) ) ) )
+
+#define \
+    RMAXLOC2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
+        KOKKOS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
+        Kokkos::MaxLoc< decltype((result).val), decltype((result).loc) > ( (result) ) ) )
+
+#define \
+    RMAXLOC3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
+        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+        Kokkos::MaxLoc< decltype((result).val), decltype((result).loc) > ( (result) ) ) )
+
+#define \
+    REDUCE_MAXLOC(...) \
+    GET_MACRO(__VA_ARGS__, _13, RMAXLOC3D, _11, _10, RMAXLOC2D, _8, _7, RMAXLOC1D)(__VA_ARGS__)
+
+
+// the REDUCE CUSTOM loop, var and result are a user type with a join member
+#define \
+    RCUSTOM1D(i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ),  \
+                             KOKKOS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, \
+                             mtr::JoinReducer< decltype(result) > ( (result) ) ) )
+
+#define \
+    RCUSTOM2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
+        KOKKOS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
+        mtr::JoinReducer< decltype(result) > ( (result) ) ) )
+
+#define \
+    RCUSTOM3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
+        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+        mtr::JoinReducer< decltype(result) > ( (result) ) ) )
+
+#define \
+    REDUCE_CUSTOM(...) \
+    GET_MACRO(__VA_ARGS__, _13, RCUSTOM3D, _11, _10, RCUSTOM2D, _8, _7, RCUSTOM1D)(__VA_ARGS__)
+
+
+// the REDUCE MINLOC loop with variables in a class
+#define \
+    RMINLOCCLASS1D(i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ),  \
+                             KOKKOS_CLASS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, \
+                             Kokkos::MinLoc< decltype((result).val), decltype((result).loc) > ( (result) ) ) )
+
+#define \
+    RMINLOCCLASS2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
+        KOKKOS_CLASS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
+        Kokkos::MinLoc< decltype((result).val), decltype((result).loc) > ( (result) ) ) )
+
+#define \
+    RMINLOCCLASS3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
+        KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+        Kokkos::MinLoc< decltype((result).val), decltype((result).loc) > ( (result) ) ) )
+
+#define \
+    REDUCE_MINLOC_CLASS(...) \
+    GET_MACRO(__VA_ARGS__, _13, RMINLOCCLASS3D, _11, _10, RMINLOCCLASS2D, _8, _7, RMINLOCCLASS1D)(__VA_ARGS__)
+
+
+// the REDUCE MAXLOC loop with variables in a class
+#define \
+    RMAXLOCCLASS1D(i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ),  \
+                             KOKKOS_CLASS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, \
+                             Kokkos::MaxLoc< decltype((result).val), decltype((result).loc) > ( (result) ) ) )
+
+#define \
+    RMAXLOCCLASS2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
+        KOKKOS_CLASS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
+        Kokkos::MaxLoc< decltype((result).val), decltype((result).loc) > ( (result) ) ) )
+
+#define \
+    RMAXLOCCLASS3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
+        KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+        Kokkos::MaxLoc< decltype((result).val), decltype((result).loc) > ( (result) ) ) )
+
+#define \
+    REDUCE_MAXLOC_CLASS(...) \
+    GET_MACRO(__VA_ARGS__, _13, RMAXLOCCLASS3D, _11, _10, RMAXLOCCLASS2D, _8, _7, RMAXLOCCLASS1D)(__VA_ARGS__)
+
+
+// the REDUCE CUSTOM loop with variables in a class
+#define \
+    RCUSTOMCLASS1D(i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ),  \
+                             KOKKOS_CLASS_LAMBDA(const int (i), decltype(var) &(var)){fcn}, \
+                             mtr::JoinReducer< decltype(result) > ( (result) ) ) )
+
+#define \
+    RCUSTOMCLASS2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0)}, {(x1), (y1)} ), \
+        KOKKOS_CLASS_LAMBDA( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
+        mtr::JoinReducer< decltype(result) > ( (result) ) ) )
+
+#define \
+    RCUSTOMCLASS3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER> > ( {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
+        KOKKOS_CLASS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+        mtr::JoinReducer< decltype(result) > ( (result) ) ) )
+
+#define \
+    REDUCE_CUSTOM_CLASS(...) \
+    GET_MACRO(__VA_ARGS__, _13, RCUSTOMCLASS3D, _11, _10, RCUSTOMCLASS2D, _8, _7, RCUSTOMCLASS1D)(__VA_ARGS__)
+
+
+// the SCAN loops, var is the running sum and value is the contribution of i
+#define \
+    SCAN1D(i, x0, x1, var, value, fcn) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_scan( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ), \
+                           KOKKOS_LAMBDA( const int (i), decltype(var) &(var), const bool scan_final ){ \
+                               const auto scan_value = (value); \
+                               (var) += scan_value; \
+                               if (scan_final) {fcn} } ) )
+
+#define \
+    SCAN1D_TOTAL(i, x0, x1, var, value, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_scan( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ), \
+                           KOKKOS_LAMBDA( const int (i), decltype(var) &(var), const bool scan_final ){ \
+                               const auto scan_value = (value); \
+                               (var) += scan_value; \
+                               if (scan_final) {fcn} }, \
+                           (result) ) )
+
+#define \
+    XSCAN1D(i, x0, x1, var, value, fcn) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_scan( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ), \
+                           KOKKOS_LAMBDA( const int (i), decltype(var) &(var), const bool scan_final ){ \
+                               const auto scan_value = (value); \
+                               if (scan_final) {fcn} \
+                               (var) += scan_value; } ) )
+
+#define \
+    XSCAN1D_TOTAL(i, x0, x1, var, value, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_scan( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ), \
+                           KOKKOS_LAMBDA( const int (i), decltype(var) &(var), const bool scan_final ){ \
+                               const auto scan_value = (value); \
+                               if (scan_final) {fcn} \
+                               (var) += scan_value; }, \
+                           (result) ) )
+
+#define \
+    FOR_SCAN(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, _11, _10, _9, _8, SCAN1D_TOTAL, SCAN1D)(__VA_ARGS__)
+
+#define \
+    FOR_SCAN_EXCLUSIVE(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, _11, _10, _9, _8, XSCAN1D_TOTAL, XSCAN1D)(__VA_ARGS__)
+
+
+// the DO_SCAN loops
+#define \
+    DO_SCAN1D(i, x0, x1, var, value, fcn) \
+    SCAN1D(i, (x0), (x1)+1, var, value, fcn)
+
+#define \
+    DO_SCAN1D_TOTAL(i, x0, x1, var, value, fcn, result) \
+    SCAN1D_TOTAL(i, (x0), (x1)+1, var, value, fcn, result)
+
+#define \
+    DO_XSCAN1D(i, x0, x1, var, value, fcn) \
+    XSCAN1D(i, (x0), (x1)+1, var, value, fcn)
+
+#define \
+    DO_XSCAN1D_TOTAL(i, x0, x1, var, value, fcn, result) \
+    XSCAN1D_TOTAL(i, (x0), (x1)+1, var, value, fcn, result)
+
+#define \
+    DO_SCAN(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, _11, _10, _9, _8, DO_SCAN1D_TOTAL, DO_SCAN1D)(__VA_ARGS__)
+
+#define \
+    DO_SCAN_EXCLUSIVE(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, _11, _10, _9, _8, DO_XSCAN1D_TOTAL, DO_XSCAN1D)(__VA_ARGS__)
+
+
+// the SCAN loops with variables in a class
+#define \
+SCANCLASS1D(i, x0, x1, var, value, fcn) \
+( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+Kokkos::parallel_scan( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ), \
+                      KOKKOS_CLASS_LAMBDA( const int (i), decltype(var) &(var), const bool scan_final ){ \
+                          const auto scan_value = (value); \
+                          (var) += scan_value; \
+                          if (scan_final) {fcn} } ) )
+
+#define \
+SCANCLASS1D_TOTAL(i, x0, x1, var, value, fcn, result) \
+( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+Kokkos::parallel_scan( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ), \
+                      KOKKOS_CLASS_LAMBDA( const int (i), decltype(var) &(var), const bool scan_final ){ \
+                          const auto scan_value = (value); \
+                          (var) += scan_value; \
+                          if (scan_final) {fcn} }, \
+                      (result) ) )
+
+#define \
+XSCANCLASS1D(i, x0, x1, var, value, fcn) \
+( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+Kokkos::parallel_scan( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ), \
+                      KOKKOS_CLASS_LAMBDA( const int (i), decltype(var) &(var), const bool scan_final ){ \
+                          const auto scan_value = (value); \
+                          if (scan_final) {fcn} \
+                          (var) += scan_value; } ) )
+
+#define \
+XSCANCLASS1D_TOTAL(i, x0, x1, var, value, fcn, result) \
+( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+Kokkos::parallel_scan( MATAR_LOOP_LABEL, Kokkos::RangePolicy<> ( (x0), (x1) ), \
+                      KOKKOS_CLASS_LAMBDA( const int (i), decltype(var) &(var), const bool scan_final ){ \
+                          const auto scan_value = (value); \
+                          if (scan_final) {fcn} \
+                          (var) += scan_value; }, \
+                      (result) ) )
+
+#define \
+FOR_SCAN_CLASS(...) \
+GET_MACRO(__VA_ARGS__, _13, _12, _11, _10, _9, _8, SCANCLASS1D_TOTAL, SCANCLASS1D)(__VA_ARGS__)
+
+#define \
+FOR_SCAN_EXCLUSIVE_CLASS(...) \
+GET_MACRO(__VA_ARGS__, _13, _12, _11, _10, _9, _8, XSCANCLASS1D_TOTAL, XSCANCLASS1D)(__VA_ARGS__)
+
+
+// the team loops, FOR_FIRST launches one team per index and names the team
+// member that FOR_SECOND and FOR_THIRD split their loops over
+#define \
+    FOR_FIRST(i, x0, x1, fcn) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_for( MATAR_LOOP_LABEL, TeamPolicy( (x1)-(x0), Kokkos::AUTO, Kokkos::AUTO ), \
+                          KOKKOS_LAMBDA( const TeamPolicy::member_type& team_member ){ \
+                              const int i = (x0) + team_member.league_rank(); \
+                              fcn } ) )
+
+#define \
+    FOR_FIRST_CLASS(i, x0, x1, fcn) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    Kokkos::parallel_for( MATAR_LOOP_LABEL, TeamPolicy( (x1)-(x0), Kokkos::AUTO, Kokkos::AUTO ), \
+                          KOKKOS_CLASS_LAMBDA( const TeamPolicy::member_type& team_member ){ \
+                              const int i = (x0) + team_member.league_rank(); \
+                              fcn } ) )
+
+#define \
+    FOR_SECOND(j, y0, y1, fcn) \
+    Kokkos::parallel_for( Kokkos::TeamThreadRange( team_member, (y0), (y1) ), \
+                          [&]( const int (j) ){fcn} )
+
+#define \
+    FOR_THIRD(k, z0, z1, fcn) \
+    Kokkos::parallel_for( Kokkos::ThreadVectorRange( team_member, (z0), (z1) ), \
+                          [&]( const int (k) ){fcn} )
+
+// every thread of the team waits here for the others
+#define \
+    TEAM_BARRIER \
+    team_member.team_barrier()
+
+// the contents run once per team
+#define \
+    TEAM_SINGLE(fcn) \
+    Kokkos::single( Kokkos::PerTeam( team_member ), [&]( ){fcn} )
+
+
+// the team reductions, every thread of the team gets the result
+#define \
+    FOR_REDUCE_SUM_SECOND(j, y0, y1, var, fcn, result) \
+    Kokkos::parallel_reduce( Kokkos::TeamThreadRange( team_member, (y0), (y1) ), \
+                             [&]( const int (j), decltype(var) &(var) ){fcn}, (result) )
+
+#define \
+    FOR_REDUCE_MAX_SECOND(j, y0, y1, var, fcn, result) \
+    Kokkos::parallel_reduce( Kokkos::TeamThreadRange( team_member, (y0), (y1) ), \
+                             [&]( const int (j), decltype(var) &(var) ){fcn}, \
+                             Kokkos::Max< decltype(result) > ( (result) ) )
+
+#define \
+    FOR_REDUCE_MIN_SECOND(j, y0, y1, var, fcn, result) \
+    Kokkos::parallel_reduce( Kokkos::TeamThreadRange( team_member, (y0), (y1) ), \
+                             [&]( const int (j), decltype(var) &(var) ){fcn}, \
+                             Kokkos::Min< decltype(result) > ( (result) ) )
+
+#define \
+    FOR_REDUCE_SUM_THIRD(k, z0, z1, var, fcn, result) \
+    Kokkos::parallel_reduce( Kokkos::ThreadVectorRange( team_member, (z0), (z1) ), \
+                             [&]( const int (k), decltype(var) &(var) ){fcn}, (result) )
+
+#define \
+    FOR_REDUCE_MAX_THIRD(k, z0, z1, var, fcn, result) \
+    Kokkos::parallel_reduce( Kokkos::ThreadVectorRange( team_member, (z0), (z1) ), \
+                             [&]( const int (k), decltype(var) &(var) ){fcn}, \
+                             Kokkos::Max< decltype(result) > ( (result) ) )
+
+#define \
+    FOR_REDUCE_MIN_THIRD(k, z0, z1, var, fcn, result) \
+    Kokkos::parallel_reduce( Kokkos::ThreadVectorRange( team_member, (z0), (z1) ), \
+                             [&]( const int (k), decltype(var) &(var) ){fcn}, \
+                             Kokkos::Min< decltype(result) > ( (result) ) )
+
+
+// the type of an execution space instance passed to the _ASYNC loops
+#define \
+    INSTANCE_TYPE(instance) std::decay_t<decltype(instance)>
+
+// the FOR_ALL loop on an execution space instance
+#define \
+    FOR1D_ASYNC(instance, i, x0, x1, fcn) \
+    Kokkos::parallel_for( MATAR_LOOP_LABEL, Kokkos::RangePolicy< INSTANCE_TYPE(instance) > ( (instance), (x0), (x1)), \
+                          KOKKOS_LAMBDA( const int (i) ){fcn} )
+
+#define \
+    FOR2D_ASYNC(instance, i, x0, x1, j, y0, y1, fcn) \
+    Kokkos::parallel_for( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER>, INSTANCE_TYPE(instance) > ( (instance), {(x0), (y0)}, {(x1), (y1)} ), \
+        KOKKOS_LAMBDA( const int (i), const int (j) ){fcn} )
+
+#define \
+    FOR3D_ASYNC(instance, i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+    Kokkos::parallel_for( MATAR_LOOP_LABEL, \
+         Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER>, INSTANCE_TYPE(instance) > ( (instance), {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
+         KOKKOS_LAMBDA( const int (i), const int (j), const int (k) ) {fcn} )
+
+#define \
+    FOR_ALL_ASYNC(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, FOR3D_ASYNC, _10, _9, FOR2D_ASYNC, _7, _6, FOR1D_ASYNC)(__VA_ARGS__)
+
+
+// the DO_ALL loop on an execution space instance
+#define \
+    DO1D_ASYNC(instance, i, x0, x1, fcn) \
+    Kokkos::parallel_for( MATAR_LOOP_LABEL, Kokkos::RangePolicy< INSTANCE_TYPE(instance) > ( (instance), (x0), (x1)+1), \
+                          KOKKOS_LAMBDA( const int (i) ){fcn} )
+
+#define \
+    DO2D_ASYNC(instance, i, x0, x1, j, y0, y1, fcn) \
+    Kokkos::parallel_for( MATAR_LOOP_LABEL, \
+        Kokkos::MDRangePolicy< Kokkos::Rank<2,F_LOOP_ORDER,F_LOOP_ORDER>, INSTANCE_TYPE(instance) > ( (instance), {(x0), (y0)}, {(x1)+1, (y1)+1} ), \
+        KOKKOS_LAMBDA( const int (i), const int (j) ){fcn} )
+
+#define \
+    DO3D_ASYNC(instance, i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+    Kokkos::parallel_for( MATAR_LOOP_LABEL, \
+         Kokkos::MDRangePolicy< Kokkos::Rank<3,F_LOOP_ORDER,F_LOOP_ORDER>, INSTANCE_TYPE(instance) > ( (instance), {(x0), (y0), (z0)}, {(x1)+1, (y1)+1, (z1)+1} ), \
+         KOKKOS_LAMBDA( const int (i), const int (j), const int (k) ) {fcn} )
+
+#define \
+    DO_ALL_ASYNC(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, DO3D_ASYNC, _10, _9, DO2D_ASYNC, _7, _6, DO1D_ASYNC)(__VA_ARGS__)
+
+
+// the REDUCE SUM loop on an execution space instance
+#define \
+    RSUM1D_ASYNC(instance, i, x0, x1, var, fcn, result) \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+                        Kokkos::RangePolicy< INSTANCE_TYPE(instance) > ( (instance), (x0), (x1) ),  \
+                        KOKKOS_LAMBDA( const int (i), decltype(var) &(var) ){fcn}, \
+                        (result) )
+
+#define \
+    RSUM2D_ASYNC(instance, i, x0, x1, j, y0, y1, var, fcn, result) \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER>, INSTANCE_TYPE(instance) > ( (instance), {(x0), (y0)}, {(x1), (y1)} ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), decltype(var) &(var) ){fcn}, \
+                        (result) )
+
+#define \
+    RSUM3D_ASYNC(instance, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER>, INSTANCE_TYPE(instance) > ( (instance), {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+                        (result) )
+
+#define \
+    REDUCE_SUM_ASYNC(...) \
+    GET_MACRO(__VA_ARGS__, RSUM3D_ASYNC, _12, _11, RSUM2D_ASYNC, _9, _8, RSUM1D_ASYNC)(__VA_ARGS__)
+
+
+// the REDUCE MAX loop on an execution space instance
+#define \
+    RMAX1D_ASYNC(instance, i, x0, x1, var, fcn, result) \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+                        Kokkos::RangePolicy< INSTANCE_TYPE(instance) > ( (instance), (x0), (x1) ),  \
+                        KOKKOS_LAMBDA( const int (i), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Max< decltype(result) >(result) )
+
+#define \
+    RMAX2D_ASYNC(instance, i, x0, x1, j, y0, y1, var, fcn, result) \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER>, INSTANCE_TYPE(instance) > ( (instance), {(x0), (y0)}, {(x1), (y1)} ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Max< decltype(result) >(result) )
+
+#define \
+    RMAX3D_ASYNC(instance, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER>, INSTANCE_TYPE(instance) > ( (instance), {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Max< decltype(result) >(result) )
+
+#define \
+    REDUCE_MAX_ASYNC(...) \
+    GET_MACRO(__VA_ARGS__, RMAX3D_ASYNC, _12, _11, RMAX2D_ASYNC, _9, _8, RMAX1D_ASYNC)(__VA_ARGS__)
+
+
+// the REDUCE MIN loop on an execution space instance
+#define \
+    RMIN1D_ASYNC(instance, i, x0, x1, var, fcn, result) \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+                        Kokkos::RangePolicy< INSTANCE_TYPE(instance) > ( (instance), (x0), (x1) ),  \
+                        KOKKOS_LAMBDA( const int (i), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Min< decltype(result) >(result) )
+
+#define \
+    RMIN2D_ASYNC(instance, i, x0, x1, j, y0, y1, var, fcn, result) \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<2,LOOP_ORDER,LOOP_ORDER>, INSTANCE_TYPE(instance) > ( (instance), {(x0), (y0)}, {(x1), (y1)} ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Min< decltype(result) >(result) )
+
+#define \
+    RMIN3D_ASYNC(instance, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    Kokkos::parallel_reduce( MATAR_LOOP_LABEL, \
+                        Kokkos::MDRangePolicy< Kokkos::Rank<3,LOOP_ORDER,LOOP_ORDER>, INSTANCE_TYPE(instance) > ( (instance), {(x0), (y0), (z0)}, {(x1), (y1), (z1)} ), \
+                        KOKKOS_LAMBDA( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+                        Kokkos::Min< decltype(result) >(result) )
+
+#define \
+    REDUCE_MIN_ASYNC(...) \
+    GET_MACRO(__VA_ARGS__, RMIN3D_ASYNC, _12, _11, RMIN2D_ASYNC, _9, _8, RMIN1D_ASYNC)(__VA_ARGS__)
 
 #endif
 
@@ -491,6 +1760,75 @@ void for_all (int i_start, int i_end,
 }; // end for_all
 
 
+template <typename F>
+void for_all (int i_start, int i_end,
+              int j_start, int j_end,
+              int k_start, int k_end,
+              int l_start, int l_end,
+              const F &lambda_fcn){
+    
+    for (int i=i_start; i<i_end; i++){
+        for (int j=j_start; j<j_end; j++){
+            for (int k=k_start; k<k_end; k++){
+                for (int l=l_start; l<l_end; l++){
+                    lambda_fcn(i,j,k,l);
+                }
+            }
+        }
+    }
+    
+}; // end for_all
+
+
+template <typename F>
+void for_all (int i_start, int i_end,
+              int j_start, int j_end,
+              int k_start, int k_end,
+              int l_start, int l_end,
+              int m_start, int m_end,
+              const F &lambda_fcn){
+    
+    for (int i=i_start; i<i_end; i++){
+        for (int j=j_start; j<j_end; j++){
+            for (int k=k_start; k<k_end; k++){
+                for (int l=l_start; l<l_end; l++){
+                    for (int m=m_start; m<m_end; m++){
+                        lambda_fcn(i,j,k,l,m);
+                    }
+                }
+            }
+        }
+    }
+    
+}; // end for_all
+
+
+template <typename F>
+void for_all (int i_start, int i_end,
+              int j_start, int j_end,
+              int k_start, int k_end,
+              int l_start, int l_end,
+              int m_start, int m_end,
+              int n_start, int n_end,
+              const F &lambda_fcn){
+    
+    for (int i=i_start; i<i_end; i++){
+        for (int j=j_start; j<j_end; j++){
+            for (int k=k_start; k<k_end; k++){
+                for (int l=l_start; l<l_end; l++){
+                    for (int m=m_start; m<m_end; m++){
+                        for (int n=n_start; n<n_end; n++){
+                            lambda_fcn(i,j,k,l,m,n);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+}; // end for_all
+
+
 template <typename F>
 void for_all_delta (int i_start, int i_end, int i_delta,
                     const F &lambda_fcn){
@@ -533,6 +1871,44 @@ void for_all_delta (int i_start, int i_end, int i_delta,
 
 
 
+// SCAN on the host, lambda_fcn(i,var,final) adds the value of i to var and uses
+// var when final is true.  It is used by the non-kokkos SCAN MACROS and by the
+// host types, runs on the thread pool when it is enabled and returns the total.
+template <typename T, typename F>
+T par_scan (int i_start, int i_end,
+            [[maybe_unused]] T var,
+            const F &lambda_fcn){
+#if defined(HAVE_THREAD_POOL) && !defined(HAVE_KOKKOS)
+    return mtr::pool_scan<T>(i_start, i_end, lambda_fcn);
+#else
+    var = 0;
+    for (int i=i_start; i<i_end; i++){
+        lambda_fcn(i, var, true);
+    }
+    return var;
+#endif
+};  // end par_scan
+
+// the same for size_t bounds, used by the host types so a row count past 2^31
+// is not narrowed.  Only both bounds size_t pick it, so a SCAN MACRO with mixed
+// int and size_t bounds still takes the int version.
+template <typename I, typename T, typename F,
+          typename std::enable_if<std::is_same<I, size_t>::value, int>::type = 0>
+T par_scan (I i_start, I i_end,
+            [[maybe_unused]] T var,
+            const F &lambda_fcn){
+#if defined(HAVE_THREAD_POOL) && !defined(HAVE_KOKKOS)
+    return mtr::pool_scan<T>(i_start, i_end, lambda_fcn);
+#else
+    var = 0;
+    for (size_t i=i_start; i<i_end; i++){
+        lambda_fcn(i, var, true);
+    }
+    return var;
+#endif
+};  // end par_scan
+
+
 // the FOR_LOOP
 // 1D FOR loop has 4 inputs
 #define \
@@ -621,16 +1997,144 @@ void for_all_delta (int i_start, int i_end, int i_delta,
 #ifndef HAVE_KOKKOS
 #include <limits>  // for the max and min values of a int, double, etc.
 
+
+#ifndef HAVE_THREAD_POOL
+#include <vector>
+
+namespace mtr
+{
+
+// without kokkos or the thread pool an instance runs each loop as it is
+// submitted, so the _ASYNC MACROS compile the same way in every build
+class ExecInstance {
+public:
+    explicit ExecInstance(size_t = 1) {}
+
+    size_t num_threads() const { return 1; }
+
+    template <typename F>
+    void submit(const F& task) const { task(); }
+
+    void fence() const {}
+};
+
+inline std::vector<ExecInstance> partition_exec_space(size_t num_partitions) {
+    return std::vector<ExecInstance>(num_partitions);
+}
+
+} // end namespace mtr
+#endif
+
+
+// FOR_ALL, uses the thread pool when it is enabled
+template <typename F>
+void par_for_all (int i_start, int i_end,
+                  const F &lambda_fcn){
+#ifdef HAVE_THREAD_POOL
+    mtr::pool_for_all(i_start, i_end, lambda_fcn);
+#else
+    for_all(i_start, i_end, lambda_fcn);
+#endif
+};  // end par_for_all
+
+
+template <typename F>
+void par_for_all (int i_start, int i_end,
+                  int j_start, int j_end,
+                  const F &lambda_fcn){
+#ifdef HAVE_THREAD_POOL
+    mtr::pool_for_all(i_start, i_end, j_start, j_end, lambda_fcn);
+#else
+    for_all(i_start, i_end, j_start, j_end, lambda_fcn);
+#endif
+};  // end par_for_all
+
+
+template <typename F>
+void par_for_all (int i_start, int i_end,
+                  int j_start, int j_end,
+                  int k_start, int k_end,
+                  const F &lambda_fcn){
+#ifdef HAVE_THREAD_POOL
+    mtr::pool_for_all(i_start, i_end, j_start, j_end, k_start, k_end, lambda_fcn);
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, lambda_fcn);
+#endif
+};  // end par_for_all
+
+
+template <typename F>
+void par_for_all (int i_start, int i_end,
+                  int j_start, int j_end,
+                  int k_start, int k_end,
+                  int l_start, int l_end,
+                  const F &lambda_fcn){
+#ifdef HAVE_THREAD_POOL
+    mtr::pool_for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, lambda_fcn);
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, lambda_fcn);
+#endif
+};  // end par_for_all
+
+
+template <typename F>
+void par_for_all (int i_start, int i_end,
+                  int j_start, int j_end,
+                  int k_start, int k_end,
+                  int l_start, int l_end,
+                  int m_start, int m_end,
+                  const F &lambda_fcn){
+#ifdef HAVE_THREAD_POOL
+    mtr::pool_for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, lambda_fcn);
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, lambda_fcn);
+#endif
+};  // end par_for_all
+
+
+template <typename F>
+void par_for_all (int i_start, int i_end,
+                  int j_start, int j_end,
+                  int k_start, int k_end,
+                  int l_start, int l_end,
+                  int m_start, int m_end,
+                  int n_start, int n_end,
+                  const F &lambda_fcn){
+#ifdef HAVE_THREAD_POOL
+    mtr::pool_for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, n_start, n_end, lambda_fcn);
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, n_start, n_end, lambda_fcn);
+#endif
+};  // end par_for_all
+
+
+// a serial reduction from the initial value var, used by the team reductions
+template <typename T, typename F>
+void for_reduce (int i_start, int i_end,
+                 T var,
+                 const F &lambda_fcn, T &result){
+    for (int i=i_start; i<i_end; i++){
+        lambda_fcn(i, var);
+    }
+    result = var;
+};  // end for_reduce
+
+
 // SUM
 template <typename T, typename F>
 void reduce_sum (int i_start, int i_end,
                  T var,
                  const F &lambda_fcn, T &result){
     var = 0;
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, var, lambda_fcn,
+                              [](T a, T b){ return a + b; });
+#else
     for (int i=i_start; i<i_end; i++){
         lambda_fcn(i, var);
     }
     result = var;
+#endif
 };  // end for_reduce
 
 
@@ -640,6 +2144,10 @@ void reduce_sum (int i_start, int i_end,
                  T var,
                  const F &lambda_fcn, T &result){
     var = 0;
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, var, lambda_fcn,
+                              [](T a, T b){ return a + b; });
+#else
     for (int i=i_start; i<i_end; i++){
         for (int j=j_start; j<j_end; j++){
             lambda_fcn(i,j,var);
@@ -647,6 +2155,7 @@ void reduce_sum (int i_start, int i_end,
     }
     
     result = var;
+#endif
 };  // end for_reduce
 
 
@@ -657,6 +2166,10 @@ void reduce_sum (int i_start, int i_end,
                  T  var,
                  const F &lambda_fcn,  T &result){
     var = 0;
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, var, lambda_fcn,
+                              [](T a, T b){ return a + b; });
+#else
     for (int i=i_start; i<i_end; i++){
         for (int j=j_start; j<j_end; j++){
             for (int k=k_start; k<k_end; k++){
@@ -666,6 +2179,70 @@ void reduce_sum (int i_start, int i_end,
     }
     
     result = var;
+#endif
+};  // end for_reduce
+
+
+template <typename T, typename F>
+void reduce_sum (int i_start, int i_end,
+                 int j_start, int j_end,
+                 int k_start, int k_end,
+                 int l_start, int l_end,
+                 T  var,
+                 const F &lambda_fcn,  T &result){
+    var = 0;
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, var, lambda_fcn,
+                              [](T a, T b){ return a + b; });
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end,
+            [&](const int i, const int j, const int k, const int l){ lambda_fcn(i,j,k,l,var); });
+    
+    result = var;
+#endif
+};  // end for_reduce
+
+
+template <typename T, typename F>
+void reduce_sum (int i_start, int i_end,
+                 int j_start, int j_end,
+                 int k_start, int k_end,
+                 int l_start, int l_end,
+                 int m_start, int m_end,
+                 T  var,
+                 const F &lambda_fcn,  T &result){
+    var = 0;
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, var, lambda_fcn,
+                              [](T a, T b){ return a + b; });
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end,
+            [&](const int i, const int j, const int k, const int l, const int m){ lambda_fcn(i,j,k,l,m,var); });
+    
+    result = var;
+#endif
+};  // end for_reduce
+
+
+template <typename T, typename F>
+void reduce_sum (int i_start, int i_end,
+                 int j_start, int j_end,
+                 int k_start, int k_end,
+                 int l_start, int l_end,
+                 int m_start, int m_end,
+                 int n_start, int n_end,
+                 T  var,
+                 const F &lambda_fcn,  T &result){
+    var = 0;
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, n_start, n_end, var, lambda_fcn,
+                              [](T a, T b){ return a + b; });
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, n_start, n_end,
+            [&](const int i, const int j, const int k, const int l, const int m, const int n){ lambda_fcn(i,j,k,l,m,n,var); });
+    
+    result = var;
+#endif
 };  // end for_reduce
 
 
@@ -675,10 +2252,15 @@ void reduce_min (int i_start, int i_end,
                  T var,
                  const F &lambda_fcn, T &result){
     var = std::numeric_limits<T>::max(); //2147483647;
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, var, lambda_fcn,
+                              [](T a, T b){ return b < a ? b : a; });
+#else
     for (int i=i_start; i<i_end; i++){
         lambda_fcn(i, var);
     }
     result = var;
+#endif
 };  // end for_reduce
 
 
@@ -688,6 +2270,10 @@ void reduce_min (int i_start, int i_end,
                  T var,
                  const F &lambda_fcn, T &result){
     var = std::numeric_limits<T>::max(); //2147483647;
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, var, lambda_fcn,
+                              [](T a, T b){ return b < a ? b : a; });
+#else
     for (int i=i_start; i<i_end; i++){
         for (int j=j_start; j<j_end; j++){
             lambda_fcn(i,j,var);
@@ -695,6 +2281,7 @@ void reduce_min (int i_start, int i_end,
     }
     
     result = var;
+#endif
 };  // end for_reduce
 
 
@@ -705,6 +2292,10 @@ void reduce_min (int i_start, int i_end,
                  T  var,
                  const F &lambda_fcn,  T &result){
     var = std::numeric_limits<T>::max(); //2147483647;
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, var, lambda_fcn,
+                              [](T a, T b){ return b < a ? b : a; });
+#else
     for (int i=i_start; i<i_end; i++){
         for (int j=j_start; j<j_end; j++){
             for (int k=k_start; k<k_end; k++){
@@ -714,18 +2305,87 @@ void reduce_min (int i_start, int i_end,
     }
     
     result = var;
+#endif
+};  // end for_reduce
+
+template <typename T, typename F>
+void reduce_min (int i_start, int i_end,
+                 int j_start, int j_end,
+                 int k_start, int k_end,
+                 int l_start, int l_end,
+                 T  var,
+                 const F &lambda_fcn,  T &result){
+    var = std::numeric_limits<T>::max(); //2147483647;
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, var, lambda_fcn,
+                              [](T a, T b){ return b < a ? b : a; });
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end,
+            [&](const int i, const int j, const int k, const int l){ lambda_fcn(i,j,k,l,var); });
+    
+    result = var;
+#endif
+};  // end for_reduce
+
+
+template <typename T, typename F>
+void reduce_min (int i_start, int i_end,
+                 int j_start, int j_end,
+                 int k_start, int k_end,
+                 int l_start, int l_end,
+                 int m_start, int m_end,
+                 T  var,
+                 const F &lambda_fcn,  T &result){
+    var = std::numeric_limits<T>::max(); //2147483647;
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, var, lambda_fcn,
+                              [](T a, T b){ return b < a ? b : a; });
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end,
+            [&](const int i, const int j, const int k, const int l, const int m){ lambda_fcn(i,j,k,l,m,var); });
+    
+    result = var;
+#endif
+};  // end for_reduce
+
+
+template <typename T, typename F>
+void reduce_min (int i_start, int i_end,
+                 int j_start, int j_end,
+                 int k_start, int k_end,
+                 int l_start, int l_end,
+                 int m_start, int m_end,
+                 int n_start, int n_end,
+                 T  var,
+                 const F &lambda_fcn,  T &result){
+    var = std::numeric_limits<T>::max(); //2147483647;
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, n_start, n_end, var, lambda_fcn,
+                              [](T a, T b){ return b < a ? b : a; });
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, n_start, n_end,
+            [&](const int i, const int j, const int k, const int l, const int m, const int n){ lambda_fcn(i,j,k,l,m,n,var); });
+    
+    result = var;
+#endif
 };  // end for_reduce
 
+
 // MAX
 template <typename T, typename F>
 void reduce_max (int i_start, int i_end,
                  T var,
                  const F &lambda_fcn, T &result){
-    var = std::numeric_limits<T>::min(); // -2147483647 - 1;
+    var = std::numeric_limits<T>::lowest();
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, var, lambda_fcn,
+                              [](T a, T b){ return a < b ? b : a; });
+#else
     for (int i=i_start; i<i_end; i++){
         lambda_fcn(i, var);
     }
     result = var;
+#endif
 };  // end for_reduce
 
 
@@ -734,34 +2394,207 @@ void reduce_max (int i_start, int i_end,
                  int j_start, int j_end,
                  T var,
                  const F &lambda_fcn, T &result){
-    var = std::numeric_limits<T>::min(); //-2147483647 - 1;
+    var = std::numeric_limits<T>::lowest();
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, var, lambda_fcn,
+                              [](T a, T b){ return a < b ? b : a; });
+#else
     for (int i=i_start; i<i_end; i++){
         for (int j=j_start; j<j_end; j++){
             lambda_fcn(i,j,var);
         }
     }
-    
+    
+    result = var;
+#endif
+};  // end for_reduce
+
+
+template <typename T, typename F>
+void reduce_max (int i_start, int i_end,
+                 int j_start, int j_end,
+                 int k_start, int k_end,
+                 T  var,
+                 const F &lambda_fcn,  T &result){
+    var = std::numeric_limits<T>::lowest();
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, var, lambda_fcn,
+                              [](T a, T b){ return a < b ? b : a; });
+#else
+    for (int i=i_start; i<i_end; i++){
+        for (int j=j_start; j<j_end; j++){
+            for (int k=k_start; k<k_end; k++){
+                lambda_fcn(i,j,k,var);
+            }
+        }
+    }
+    
+    result = var;
+#endif
+};  // end for_reduce
+
+
+template <typename T, typename F>
+void reduce_max (int i_start, int i_end,
+                 int j_start, int j_end,
+                 int k_start, int k_end,
+                 int l_start, int l_end,
+                 T  var,
+                 const F &lambda_fcn,  T &result){
+    var = std::numeric_limits<T>::lowest();
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, var, lambda_fcn,
+                              [](T a, T b){ return a < b ? b : a; });
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end,
+            [&](const int i, const int j, const int k, const int l){ lambda_fcn(i,j,k,l,var); });
+    
+    result = var;
+#endif
+};  // end for_reduce
+
+
+template <typename T, typename F>
+void reduce_max (int i_start, int i_end,
+                 int j_start, int j_end,
+                 int k_start, int k_end,
+                 int l_start, int l_end,
+                 int m_start, int m_end,
+                 T  var,
+                 const F &lambda_fcn,  T &result){
+    var = std::numeric_limits<T>::lowest();
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, var, lambda_fcn,
+                              [](T a, T b){ return a < b ? b : a; });
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end,
+            [&](const int i, const int j, const int k, const int l, const int m){ lambda_fcn(i,j,k,l,m,var); });
+    
+    result = var;
+#endif
+};  // end for_reduce
+
+
+template <typename T, typename F>
+void reduce_max (int i_start, int i_end,
+                 int j_start, int j_end,
+                 int k_start, int k_end,
+                 int l_start, int l_end,
+                 int m_start, int m_end,
+                 int n_start, int n_end,
+                 T  var,
+                 const F &lambda_fcn,  T &result){
+    var = std::numeric_limits<T>::lowest();
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, n_start, n_end, var, lambda_fcn,
+                              [](T a, T b){ return a < b ? b : a; });
+#else
+    for_all(i_start, i_end, j_start, j_end, k_start, k_end, l_start, l_end, m_start, m_end, n_start, n_end,
+            [&](const int i, const int j, const int k, const int l, const int m, const int n){ lambda_fcn(i,j,k,l,m,n,var); });
+    
+    result = var;
+#endif
+};  // end for_reduce
+
+
+
+namespace mtr
+{
+
+// a value and its index, the variable and result of REDUCE_MINLOC and REDUCE_MAXLOC
+template <typename T, typename I = int>
+struct ValLoc {
+    T val;
+    I loc;
+};
+
+// the identities and joins of REDUCE_MINLOC and REDUCE_MAXLOC, a tie keeps the lower index
+template <typename V>
+V minloc_identity() {
+    return V{std::numeric_limits<decltype(V::val)>::max(), std::numeric_limits<decltype(V::loc)>::max()};
+}
+
+template <typename V>
+V maxloc_identity() {
+    return V{std::numeric_limits<decltype(V::val)>::lowest(), std::numeric_limits<decltype(V::loc)>::max()};
+}
+
+template <typename V>
+V minloc_join(const V& a, const V& b) {
+    return (b.val < a.val || (b.val == a.val && b.loc < a.loc)) ? b : a;
+}
+
+template <typename V>
+V maxloc_join(const V& a, const V& b) {
+    return (b.val > a.val || (b.val == a.val && b.loc < a.loc)) ? b : a;
+}
+
+// the join of REDUCE_CUSTOM, T has a join(const T&) member
+template <typename T>
+T custom_join(T a, const T& b) {
+    a.join(b);
+    return a;
+}
+
+} // end namespace mtr
+
+
+// a reduction from the identity init, join(a,b) combines two partial results
+template <typename T, typename F, typename J>
+void reduce_join (int i_start, int i_end,
+                  const T &init,
+                  const F &lambda_fcn, [[maybe_unused]] const J &join, T &result){
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, init, lambda_fcn, join);
+#else
+    T var = init;
+    for (int i=i_start; i<i_end; i++){
+        lambda_fcn(i, var);
+    }
+    result = var;
+#endif
+};  // end reduce_join
+
+
+template <typename T, typename F, typename J>
+void reduce_join (int i_start, int i_end,
+                  int j_start, int j_end,
+                  const T &init,
+                  const F &lambda_fcn, [[maybe_unused]] const J &join, T &result){
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, init, lambda_fcn, join);
+#else
+    T var = init;
+    for (int i=i_start; i<i_end; i++){
+        for (int j=j_start; j<j_end; j++){
+            lambda_fcn(i, j, var);
+        }
+    }
     result = var;
-};  // end for_reduce
-
-
-template <typename T, typename F>
-void reduce_max (int i_start, int i_end,
-                 int j_start, int j_end,
-                 int k_start, int k_end,
-                 T  var,
-                 const F &lambda_fcn,  T &result){
-    var = std::numeric_limits<T>::min(); // -2147483647 - 1;
+#endif
+};  // end reduce_join
+
+
+template <typename T, typename F, typename J>
+void reduce_join (int i_start, int i_end,
+                  int j_start, int j_end,
+                  int k_start, int k_end,
+                  const T &init,
+                  const F &lambda_fcn, [[maybe_unused]] const J &join, T &result){
+#ifdef HAVE_THREAD_POOL
+    result = mtr::pool_reduce(i_start, i_end, j_start, j_end, k_start, k_end, init, lambda_fcn, join);
+#else
+    T var = init;
     for (int i=i_start; i<i_end; i++){
         for (int j=j_start; j<j_end; j++){
             for (int k=k_start; k<k_end; k++){
-                lambda_fcn(i,j,k,var);
+                lambda_fcn(i, j, k, var);
             }
         }
     }
-    
     result = var;
-};  // end for_reduce
+#endif
+};  // end reduce_join
 
 #endif  // if not kokkos
 
@@ -774,184 +2607,797 @@ void reduce_max (int i_start, int i_end,
 
 // replace the CLASS loops to be the nominal loops
 #define FOR_ALL_CLASS FOR_ALL
+#define FOR_ALL_TILED_CLASS FOR_ALL_TILED
+#define FOR_ALL_TUNED_CLASS FOR_ALL_TUNED
 #define REDUCE_SUM_CLASS REDUCE_SUM
 #define REDUCE_MAX_CLASS REDUCE_MAX
 #define REDUCE_MIN_CLASS REDUCE_MIN
+#define FOR_SCAN_CLASS FOR_SCAN
+#define FOR_SCAN_EXCLUSIVE_CLASS FOR_SCAN_EXCLUSIVE
+#define FOR_FIRST_CLASS FOR_FIRST
+#define REDUCE_MINLOC_CLASS REDUCE_MINLOC
+#define REDUCE_MAXLOC_CLASS REDUCE_MAXLOC
+#define REDUCE_CUSTOM_CLASS REDUCE_CUSTOM
 
 // the FOR_ALL loop is chosen based on the number of inputs
 
 // the FOR_ALL loop
 // 1D FOR loop has 4 inputs
+#define \
+    FOR1D_NAMED(name, i, x0, x1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) ), \
+    par_for_all( (x0), (x1), \
+             [&]( const int (i) ){fcn} ) )
 #define \
     FOR1D(i, x0, x1, fcn) \
-    for_all( (x0), (x1), \
-             [&]( const int (i) ){fcn} )
+    FOR1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, fcn)
 // 2D FOR loop has 7 inputs
 #define \
-    FOR2D(i, x0, x1, j, y0, y1, fcn)  \
-    for_all( (x0), (x1), (y0), (y1), \
-             [&]( const int (i), const int (j) ){fcn} )
+    FOR2D_NAMED(name, i, x0, x1, j, y0, y1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    par_for_all( (x0), (x1), (y0), (y1), \
+             [&]( const int (i), const int (j) ){fcn} ) )
+#define \
+    FOR2D(i, x0, x1, j, y0, y1, fcn) \
+    FOR2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, fcn)
 // 3D FOR loop has 10 inputs
+#define \
+    FOR3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    par_for_all( (x0), (x1), (y0), (y1), (z0), (z1), \
+             [&]( const int (i), const int (j), const int (k) ) {fcn} ) )
 #define \
     FOR3D(i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
-    for_all( (x0), (x1), (y0), (y1), (z0), (z1), \
-             [&]( const int (i), const int (j), const int (k) ) {fcn} )
+    FOR3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, fcn)
+// 4D FOR loop has 13 inputs
+#define \
+    FOR4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) ), \
+    par_for_all( (x0), (x1), (y0), (y1), (z0), (z1), (u0), (u1), \
+             [&]( const int (i), const int (j), const int (k), const int (l) ) {fcn} ) )
+#define \
+    FOR4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn) \
+    FOR4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn)
+// 5D FOR loop has 16 inputs
+#define \
+    FOR5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) ), \
+    par_for_all( (x0), (x1), (y0), (y1), (z0), (z1), (u0), (u1), (v0), (v1), \
+             [&]( const int (i), const int (j), const int (k), const int (l), const int (m) ) {fcn} ) )
+#define \
+    FOR5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn) \
+    FOR5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn)
+// 6D FOR loop has 19 inputs
+#define \
+    FOR6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) * mtr::loop_extent((w0), (w1)) ), \
+    par_for_all( (x0), (x1), (y0), (y1), (z0), (z1), (u0), (u1), (v0), (v1), (w0), (w1), \
+             [&]( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n) ) {fcn} ) )
+#define \
+    FOR6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn) \
+    FOR6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn)
 #define \
     FOR_ALL(...) \
-    GET_MACRO(__VA_ARGS__, _13, _12, _11, FOR3D, _9, _8, FOR2D, _6, _5, FOR1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, _22, _21, FOR6D_NAMED, FOR6D, _18, FOR5D_NAMED, FOR5D, _15, FOR4D_NAMED, FOR4D, _12, FOR3D_NAMED, FOR3D, _9, FOR2D_NAMED, FOR2D, _6, FOR1D_NAMED, FOR1D)(__VA_ARGS__)
+
+
+// the tile sizes are only used with kokkos, the loop names label the loops
+#define \
+    FOR2D_TILED(i, x0, x1, j, y0, y1, ti, tj, fcn) \
+    FOR2D(i, x0, x1, j, y0, y1, fcn)
+#define \
+    FOR3D_TILED(i, x0, x1, j, y0, y1, k, z0, z1, ti, tj, tk, fcn) \
+    FOR3D(i, x0, x1, j, y0, y1, k, z0, z1, fcn)
+#define \
+    FOR_ALL_TILED(...) \
+    GET_MACRO(__VA_ARGS__, FOR3D_TILED, _12, _11, _10, FOR2D_TILED)(__VA_ARGS__)
+
+#define \
+    FOR2D_TUNED(name, i, x0, x1, j, y0, y1, fcn) \
+    FOR2D_NAMED(name, i, x0, x1, j, y0, y1, fcn)
+#define \
+    FOR3D_TUNED(name, i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+    FOR3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, fcn)
+#define \
+    FOR_ALL_TUNED(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, FOR3D_TUNED, _10, _9, FOR2D_TUNED)(__VA_ARGS__)
 
 
 // the DO_ALL loop
 // 1D DOloop has 4 inputs
+#define \
+    DO1D_NAMED(name, i, x0, x1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) ), \
+    par_for_all( (x0), (x1)+1, \
+             [&]( const int (i) ){fcn} ) )
 #define \
     DO1D(i, x0, x1, fcn) \
-    for_all( (x0), (x1)+1, \
-             [&]( const int (i) ){fcn} )
+    DO1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, fcn)
 // 2D DO loop has 7 inputs
 #define \
-    DO2D(i, x0, x1, j, y0, y1, fcn)  \
-    for_all( (x0), (x1)+1, (y0), (y1)+1, \
-             [&]( const int (i), const int (j) ){fcn} )
+    DO2D_NAMED(name, i, x0, x1, j, y0, y1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) ), \
+    par_for_all( (x0), (x1)+1, (y0), (y1)+1, \
+             [&]( const int (i), const int (j) ){fcn} ) )
+#define \
+    DO2D(i, x0, x1, j, y0, y1, fcn) \
+    DO2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, fcn)
 // 3D DO loop has 10 inputs
+#define \
+    DO3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) ), \
+    par_for_all( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, \
+             [&]( const int (i), const int (j), const int (k) ) {fcn} ) )
 #define \
     DO3D(i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
-    for_all( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, \
-             [&]( const int (i), const int (j), const int (k) ) {fcn} )
+    DO3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, fcn)
+// 4D DO loop has 13 inputs
+#define \
+    DO4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) ), \
+    par_for_all( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (u0), (u1)+1, \
+             [&]( const int (i), const int (j), const int (k), const int (l) ) {fcn} ) )
+#define \
+    DO4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn) \
+    DO4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, fcn)
+// 5D DO loop has 16 inputs
+#define \
+    DO5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) ), \
+    par_for_all( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (u0), (u1)+1, (v0), (v1)+1, \
+             [&]( const int (i), const int (j), const int (k), const int (l), const int (m) ) {fcn} ) )
+#define \
+    DO5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn) \
+    DO5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, fcn)
+// 6D DO loop has 19 inputs
+#define \
+    DO6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) * mtr::loop_extent((w0), (w1)+1) ), \
+    par_for_all( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (u0), (u1)+1, (v0), (v1)+1, (w0), (w1)+1, \
+             [&]( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n) ) {fcn} ) )
+#define \
+    DO6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn) \
+    DO6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, fcn)
 #define \
     DO_ALL(...) \
-    GET_MACRO(__VA_ARGS__, _13, _12, _11, DO3D, _9, _8, DO2D, _6, _5, DO1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, _22, _21, DO6D_NAMED, DO6D, _18, DO5D_NAMED, DO5D, _15, DO4D_NAMED, DO4D, _12, DO3D_NAMED, DO3D, _9, DO2D_NAMED, DO2D, _6, DO1D_NAMED, DO1D)(__VA_ARGS__)
 
 
 // the REDUCE loops, no kokkos
 #define \
-    RSUM1D(i, x0, x1, var, fcn, result) \
+    RSUM1D_NAMED(name, i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) ), \
     reduce_sum( (x0), (x1), (var),  \
                 [=]( const int (i), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
 #define \
-    RSUM2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    RSUM1D(i, x0, x1, var, fcn, result) \
+    RSUM1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
+#define \
+    RSUM2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
     reduce_sum( (x0), (x1), (y0), (y1), (var),  \
                 [=]( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
 #define \
-    RSUM3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    RSUM2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    RSUM2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
+#define \
+    RSUM3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
     reduce_sum( (x0), (x1), (y0), (y1), (z0), (z1), (var),  \
                 [=]( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
+#define \
+    RSUM3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    RSUM3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+#define \
+    RSUM4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) ), \
+    reduce_sum( (x0), (x1), (y0), (y1), (z0), (z1), (u0), (u1), (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    RSUM4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    RSUM4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+#define \
+    RSUM5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) ), \
+    reduce_sum( (x0), (x1), (y0), (y1), (z0), (z1), (u0), (u1), (v0), (v1), (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    RSUM5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    RSUM5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+#define \
+    RSUM6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) * mtr::loop_extent((w0), (w1)) ), \
+    reduce_sum( (x0), (x1), (y0), (y1), (z0), (z1), (u0), (u1), (v0), (v1), (w0), (w1), (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    RSUM6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    RSUM6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
     REDUCE_SUM(...) \
-    GET_MACRO(__VA_ARGS__, _13, RSUM3D, _11, _10, RSUM2D, _8, _7, RSUM1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, RSUM6D_NAMED, RSUM6D, _20, RSUM5D_NAMED, RSUM5D, _17, RSUM4D_NAMED, RSUM4D, _14, RSUM3D_NAMED, RSUM3D, _11, RSUM2D_NAMED, RSUM2D, _8, RSUM1D_NAMED, RSUM1D)(__VA_ARGS__)
 
 
 // DO_REDUCE_SUM
 #define \
-    DO_RSUM1D(i, x0, x1, var, fcn, result) \
+    DO_RSUM1D_NAMED(name, i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) ), \
     reduce_sum( (x0), (x1)+1, (var),  \
                 [=]( const int (i), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
 #define \
-    DO_RSUM2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    DO_RSUM1D(i, x0, x1, var, fcn, result) \
+    DO_RSUM1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
+#define \
+    DO_RSUM2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) ), \
     reduce_sum( (x0), (x1)+1, (y0), (y1)+1, (var),  \
                 [=]( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
 #define \
-    DO_RSUM3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    DO_RSUM2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    DO_RSUM2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
+#define \
+    DO_RSUM3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) ), \
     reduce_sum( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (var),  \
                 [=]( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
+#define \
+    DO_RSUM3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    DO_RSUM3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+#define \
+    DO_RSUM4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) ), \
+    reduce_sum( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (u0), (u1)+1, (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    DO_RSUM4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    DO_RSUM4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+#define \
+    DO_RSUM5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) ), \
+    reduce_sum( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (u0), (u1)+1, (v0), (v1)+1, (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    DO_RSUM5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    DO_RSUM5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+#define \
+    DO_RSUM6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) * mtr::loop_extent((w0), (w1)+1) ), \
+    reduce_sum( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (u0), (u1)+1, (v0), (v1)+1, (w0), (w1)+1, (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    DO_RSUM6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    DO_RSUM6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
     DO_REDUCE_SUM(...) \
-    GET_MACRO(__VA_ARGS__, _13, DO_RSUM3D, _11, _10, DO_RSUM2D, _8, _7, DO_RSUM1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, DO_RSUM6D_NAMED, DO_RSUM6D, _20, DO_RSUM5D_NAMED, DO_RSUM5D, _17, DO_RSUM4D_NAMED, DO_RSUM4D, _14, DO_RSUM3D_NAMED, DO_RSUM3D, _11, DO_RSUM2D_NAMED, DO_RSUM2D, _8, DO_RSUM1D_NAMED, DO_RSUM1D)(__VA_ARGS__)
 
 
 // Reduce max
 #define \
-    RMAX1D(i, x0, x1, var, fcn, result) \
+    RMAX1D_NAMED(name, i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) ), \
     reduce_max( (x0), (x1), (var),  \
                 [=]( const int (i), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
 #define \
-    RMAX2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    RMAX1D(i, x0, x1, var, fcn, result) \
+    RMAX1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
+#define \
+    RMAX2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
     reduce_max( (x0), (x1), (y0), (y1), (var),  \
                 [=]( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
 #define \
-    RMAX3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    RMAX2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    RMAX2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
+#define \
+    RMAX3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
     reduce_max( (x0), (x1), (y0), (y1), (z0), (z1), (var),  \
                 [=]( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
+#define \
+    RMAX3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    RMAX3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+#define \
+    RMAX4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) ), \
+    reduce_max( (x0), (x1), (y0), (y1), (z0), (z1), (u0), (u1), (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    RMAX4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    RMAX4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+#define \
+    RMAX5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) ), \
+    reduce_max( (x0), (x1), (y0), (y1), (z0), (z1), (u0), (u1), (v0), (v1), (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    RMAX5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    RMAX5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+#define \
+    RMAX6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) * mtr::loop_extent((w0), (w1)) ), \
+    reduce_max( (x0), (x1), (y0), (y1), (z0), (z1), (u0), (u1), (v0), (v1), (w0), (w1), (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    RMAX6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    RMAX6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
     REDUCE_MAX(...) \
-    GET_MACRO(__VA_ARGS__, _13, RMAX3D, _11, _10, RMAX2D, _8, _7, RMAX1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, RMAX6D_NAMED, RMAX6D, _20, RMAX5D_NAMED, RMAX5D, _17, RMAX4D_NAMED, RMAX4D, _14, RMAX3D_NAMED, RMAX3D, _11, RMAX2D_NAMED, RMAX2D, _8, RMAX1D_NAMED, RMAX1D)(__VA_ARGS__)
 
 
 // DO_REDUCE_MAX
 #define \
-    DO_RMAX1D(i, x0, x1, var, fcn, result) \
+    DO_RMAX1D_NAMED(name, i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) ), \
     reduce_max( (x0), (x1)+1, (var),  \
                 [=]( const int (i), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
 #define \
-    DO_RMAX2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    DO_RMAX1D(i, x0, x1, var, fcn, result) \
+    DO_RMAX1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
+#define \
+    DO_RMAX2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) ), \
     reduce_max( (x0), (x1)+1, (y0), (y1)+1, (var),  \
                 [=]( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
 #define \
-    DO_RMAX3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    DO_RMAX2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    DO_RMAX2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
+#define \
+    DO_RMAX3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) ), \
     reduce_max( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (var),  \
                 [=]( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
+#define \
+    DO_RMAX3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    DO_RMAX3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+#define \
+    DO_RMAX4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) ), \
+    reduce_max( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (u0), (u1)+1, (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    DO_RMAX4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    DO_RMAX4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+#define \
+    DO_RMAX5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) ), \
+    reduce_max( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (u0), (u1)+1, (v0), (v1)+1, (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    DO_RMAX5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    DO_RMAX5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+#define \
+    DO_RMAX6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) * mtr::loop_extent((w0), (w1)+1) ), \
+    reduce_max( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (u0), (u1)+1, (v0), (v1)+1, (w0), (w1)+1, (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    DO_RMAX6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    DO_RMAX6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
     DO_REDUCE_MAX(...) \
-    GET_MACRO(__VA_ARGS__, _13, DO_RMAX3D, _11, _10, DO_RMAX2D, _8, _7, DO_RMAX1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, DO_RMAX6D_NAMED, DO_RMAX6D, _20, DO_RMAX5D_NAMED, DO_RMAX5D, _17, DO_RMAX4D_NAMED, DO_RMAX4D, _14, DO_RMAX3D_NAMED, DO_RMAX3D, _11, DO_RMAX2D_NAMED, DO_RMAX2D, _8, DO_RMAX1D_NAMED, DO_RMAX1D)(__VA_ARGS__)
 
 
 // reduce min
 #define \
-    RMIN1D(i, x0, x1, var, fcn, result) \
+    RMIN1D_NAMED(name, i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) ), \
     reduce_min( (x0), (x1), (var),  \
                 [=]( const int (i), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
 #define \
-    RMIN2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    RMIN1D(i, x0, x1, var, fcn, result) \
+    RMIN1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
+#define \
+    RMIN2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
     reduce_min( (x0), (x1), (y0), (y1), (var),  \
                 [=]( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
 #define \
-    RMIN3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    RMIN2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    RMIN2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
+#define \
+    RMIN3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
     reduce_min( (x0), (x1), (y0), (y1), (z0), (z1), (var),  \
                 [=]( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
+#define \
+    RMIN3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    RMIN3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+#define \
+    RMIN4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) ), \
+    reduce_min( (x0), (x1), (y0), (y1), (z0), (z1), (u0), (u1), (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    RMIN4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    RMIN4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+#define \
+    RMIN5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) ), \
+    reduce_min( (x0), (x1), (y0), (y1), (z0), (z1), (u0), (u1), (v0), (v1), (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    RMIN5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    RMIN5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+#define \
+    RMIN6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) * mtr::loop_extent((u0), (u1)) * mtr::loop_extent((v0), (v1)) * mtr::loop_extent((w0), (w1)) ), \
+    reduce_min( (x0), (x1), (y0), (y1), (z0), (z1), (u0), (u1), (v0), (v1), (w0), (w1), (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    RMIN6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    RMIN6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
     REDUCE_MIN(...) \
-    GET_MACRO(__VA_ARGS__, _13, RMIN3D, _11, _10, RMIN2D, _8, _7, RMIN1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, RMIN6D_NAMED, RMIN6D, _20, RMIN5D_NAMED, RMIN5D, _17, RMIN4D_NAMED, RMIN4D, _14, RMIN3D_NAMED, RMIN3D, _11, RMIN2D_NAMED, RMIN2D, _8, RMIN1D_NAMED, RMIN1D)(__VA_ARGS__)
 
 
 // DO_REDUCE_MIN
 #define \
-    DO_RMIN1D(i, x0, x1, var, fcn, result) \
+    DO_RMIN1D_NAMED(name, i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) ), \
     reduce_min( (x0), (x1)+1, (var),  \
                 [=]( const int (i), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
 #define \
-    DO_RMIN2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    DO_RMIN1D(i, x0, x1, var, fcn, result) \
+    DO_RMIN1D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, var, fcn, result)
+#define \
+    DO_RMIN2D_NAMED(name, i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) ), \
     reduce_min( (x0), (x1)+1, (y0), (y1)+1, (var),  \
                 [=]( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
 #define \
-    DO_RMIN3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    DO_RMIN2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    DO_RMIN2D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, var, fcn, result)
+#define \
+    DO_RMIN3D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) ), \
     reduce_min( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (var),  \
                 [=]( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
-                (result) )
+                (result) ) )
+#define \
+    DO_RMIN3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    DO_RMIN3D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result)
+#define \
+    DO_RMIN4D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) ), \
+    reduce_min( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (u0), (u1)+1, (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    DO_RMIN4D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result) \
+    DO_RMIN4D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, var, fcn, result)
+#define \
+    DO_RMIN5D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) ), \
+    reduce_min( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (u0), (u1)+1, (v0), (v1)+1, (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), const int (m), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    DO_RMIN5D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result) \
+    DO_RMIN5D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, var, fcn, result)
+#define \
+    DO_RMIN6D_NAMED(name, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    ( mtr::LoopTimer( (name), mtr::loop_extent((x0), (x1)+1) * mtr::loop_extent((y0), (y1)+1) * mtr::loop_extent((z0), (z1)+1) * mtr::loop_extent((u0), (u1)+1) * mtr::loop_extent((v0), (v1)+1) * mtr::loop_extent((w0), (w1)+1) ), \
+    reduce_min( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, (u0), (u1)+1, (v0), (v1)+1, (w0), (w1)+1, (var),  \
+                [=]( const int (i), const int (j), const int (k), const int (l), const int (m), const int (n), decltype(var) &(var) ){fcn}, \
+                (result) ) )
+#define \
+    DO_RMIN6D(i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result) \
+    DO_RMIN6D_NAMED(MATAR_LOOP_LABEL, i, x0, x1, j, y0, y1, k, z0, z1, l, u0, u1, m, v0, v1, n, w0, w1, var, fcn, result)
 
 #define \
     DO_REDUCE_MIN(...) \
-    GET_MACRO(__VA_ARGS__, _13, DO_RMIN3D, _11, _10, DO_RMIN2D, _8, _7, DO_RMIN1D)(__VA_ARGS__)
+    GET_MACRO_ND(__VA_ARGS__, DO_RMIN6D_NAMED, DO_RMIN6D, _20, DO_RMIN5D_NAMED, DO_RMIN5D, _17, DO_RMIN4D_NAMED, DO_RMIN4D, _14, DO_RMIN3D_NAMED, DO_RMIN3D, _11, DO_RMIN2D_NAMED, DO_RMIN2D, _8, DO_RMIN1D_NAMED, DO_RMIN1D)(__VA_ARGS__)
+
+
+// reduce minloc, var and result are mtr::ValLoc
+#define \
+    RMINLOC1D(i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    reduce_join( (x0), (x1), mtr::minloc_identity<decltype(var)>(),  \
+                 [=]( const int (i), decltype(var) &(var) ){fcn}, \
+                 mtr::minloc_join<decltype(var)>, (result) ) )
+#define \
+    RMINLOC2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    reduce_join( (x0), (x1), (y0), (y1), mtr::minloc_identity<decltype(var)>(),  \
+                 [=]( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
+                 mtr::minloc_join<decltype(var)>, (result) ) )
+#define \
+    RMINLOC3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    reduce_join( (x0), (x1), (y0), (y1), (z0), (z1), mtr::minloc_identity<decltype(var)>(),  \
+                 [=]( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+                 mtr::minloc_join<decltype(var)>, (result) ) )
+
+#define \
+    REDUCE_MINLOC(...) \
+    GET_MACRO(__VA_ARGS__, _13, RMINLOC3D, _11, _10, RMINLOC2D, _8, _7, RMINLOC1D)(__VA_ARGS__)
+
+
+// reduce maxloc, var and result are mtr::ValLoc
+#define \
+    RMAXLOC1D(i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    reduce_join( (x0), (x1), mtr::maxloc_identity<decltype(var)>(),  \
+                 [=]( const int (i), decltype(var) &(var) ){fcn}, \
+                 mtr::maxloc_join<decltype(var)>, (result) ) )
+#define \
+    RMAXLOC2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    reduce_join( (x0), (x1), (y0), (y1), mtr::maxloc_identity<decltype(var)>(),  \
+                 [=]( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
+                 mtr::maxloc_join<decltype(var)>, (result) ) )
+#define \
+    RMAXLOC3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    reduce_join( (x0), (x1), (y0), (y1), (z0), (z1), mtr::maxloc_identity<decltype(var)>(),  \
+                 [=]( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+                 mtr::maxloc_join<decltype(var)>, (result) ) )
+
+#define \
+    REDUCE_MAXLOC(...) \
+    GET_MACRO(__VA_ARGS__, _13, RMAXLOC3D, _11, _10, RMAXLOC2D, _8, _7, RMAXLOC1D)(__VA_ARGS__)
+
+
+// reduce custom, var and result are a user type with a join member
+#define \
+    RCUSTOM1D(i, x0, x1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    reduce_join( (x0), (x1), decltype(var)(),  \
+                 [=]( const int (i), decltype(var) &(var) ){fcn}, \
+                 mtr::custom_join<decltype(var)>, (result) ) )
+#define \
+    RCUSTOM2D(i, x0, x1, j, y0, y1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) ), \
+    reduce_join( (x0), (x1), (y0), (y1), decltype(var)(),  \
+                 [=]( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
+                 mtr::custom_join<decltype(var)>, (result) ) )
+#define \
+    RCUSTOM3D(i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) * mtr::loop_extent((y0), (y1)) * mtr::loop_extent((z0), (z1)) ), \
+    reduce_join( (x0), (x1), (y0), (y1), (z0), (z1), decltype(var)(),  \
+                 [=]( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+                 mtr::custom_join<decltype(var)>, (result) ) )
+
+#define \
+    REDUCE_CUSTOM(...) \
+    GET_MACRO(__VA_ARGS__, _13, RCUSTOM3D, _11, _10, RCUSTOM2D, _8, _7, RCUSTOM1D)(__VA_ARGS__)
+
+
+// the SCAN loops, no kokkos
+#define \
+    SCAN1D(i, x0, x1, var, value, fcn) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    par_scan( (x0), (x1), (var), \
+              [=]( const int (i), decltype(var) &(var), const bool scan_final ){ \
+                  const auto scan_value = (value); \
+                  (var) += scan_value; \
+                  if (scan_final) {fcn} } ) )
+#define \
+    SCAN1D_TOTAL(i, x0, x1, var, value, fcn, result) \
+    (result) = SCAN1D(i, x0, x1, var, value, fcn)
+#define \
+    XSCAN1D(i, x0, x1, var, value, fcn) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    par_scan( (x0), (x1), (var), \
+              [=]( const int (i), decltype(var) &(var), const bool scan_final ){ \
+                  const auto scan_value = (value); \
+                  if (scan_final) {fcn} \
+                  (var) += scan_value; } ) )
+#define \
+    XSCAN1D_TOTAL(i, x0, x1, var, value, fcn, result) \
+    (result) = XSCAN1D(i, x0, x1, var, value, fcn)
+
+#define \
+    FOR_SCAN(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, _11, _10, _9, _8, SCAN1D_TOTAL, SCAN1D)(__VA_ARGS__)
+#define \
+    FOR_SCAN_EXCLUSIVE(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, _11, _10, _9, _8, XSCAN1D_TOTAL, XSCAN1D)(__VA_ARGS__)
+
+
+// DO_SCAN
+#define \
+    DO_SCAN1D(i, x0, x1, var, value, fcn) \
+    SCAN1D(i, (x0), (x1)+1, var, value, fcn)
+#define \
+    DO_SCAN1D_TOTAL(i, x0, x1, var, value, fcn, result) \
+    SCAN1D_TOTAL(i, (x0), (x1)+1, var, value, fcn, result)
+#define \
+    DO_XSCAN1D(i, x0, x1, var, value, fcn) \
+    XSCAN1D(i, (x0), (x1)+1, var, value, fcn)
+#define \
+    DO_XSCAN1D_TOTAL(i, x0, x1, var, value, fcn, result) \
+    XSCAN1D_TOTAL(i, (x0), (x1)+1, var, value, fcn, result)
+
+#define \
+    DO_SCAN(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, _11, _10, _9, _8, DO_SCAN1D_TOTAL, DO_SCAN1D)(__VA_ARGS__)
+#define \
+    DO_SCAN_EXCLUSIVE(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, _11, _10, _9, _8, DO_XSCAN1D_TOTAL, DO_XSCAN1D)(__VA_ARGS__)
+
+
+// the team loops, no kokkos, the teams are a FOR_ALL and the
+// thread and vector levels are serial loops
+#define \
+    FOR_FIRST(i, x0, x1, fcn) \
+    ( mtr::LoopTimer( MATAR_LOOP_LABEL, mtr::loop_extent((x0), (x1)) ), \
+    par_for_all( (x0), (x1), \
+                 [=]( const int (i) ){fcn} ) )
+#define \
+    FOR_SECOND(j, y0, y1, fcn) \
+    for_all( (y0), (y1), \
+             [&]( const int (j) ){fcn} )
+#define \
+    FOR_THIRD(k, z0, z1, fcn) \
+    for_all( (z0), (z1), \
+             [&]( const int (k) ){fcn} )
+#define \
+    TEAM_BARRIER \
+    ((void) 0)
+#define \
+    TEAM_SINGLE(fcn) \
+    [&]( ){fcn}( )
+
+#define \
+    FOR_REDUCE_SUM_SECOND(j, y0, y1, var, fcn, result) \
+    for_reduce( (y0), (y1), decltype(var)(0), \
+                [&]( const int (j), decltype(var) &(var) ){fcn}, \
+                (result) )
+#define \
+    FOR_REDUCE_MAX_SECOND(j, y0, y1, var, fcn, result) \
+    for_reduce( (y0), (y1), std::numeric_limits<decltype(var)>::lowest(), \
+                [&]( const int (j), decltype(var) &(var) ){fcn}, \
+                (result) )
+#define \
+    FOR_REDUCE_MIN_SECOND(j, y0, y1, var, fcn, result) \
+    for_reduce( (y0), (y1), std::numeric_limits<decltype(var)>::max(), \
+                [&]( const int (j), decltype(var) &(var) ){fcn}, \
+                (result) )
+#define FOR_REDUCE_SUM_THIRD FOR_REDUCE_SUM_SECOND
+#define FOR_REDUCE_MAX_THIRD FOR_REDUCE_MAX_SECOND
+#define FOR_REDUCE_MIN_THIRD FOR_REDUCE_MIN_SECOND
+
+
+// the _ASYNC loops queue the loop on an ExecInstance
+#define \
+    FOR1D_ASYNC(instance, i, x0, x1, fcn) \
+    (instance).submit( [=]() { par_for_all( (x0), (x1), \
+             [=]( const int (i) ){fcn} ); } )
+#define \
+    FOR2D_ASYNC(instance, i, x0, x1, j, y0, y1, fcn)  \
+    (instance).submit( [=]() { par_for_all( (x0), (x1), (y0), (y1), \
+             [=]( const int (i), const int (j) ){fcn} ); } )
+#define \
+    FOR3D_ASYNC(instance, i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+    (instance).submit( [=]() { par_for_all( (x0), (x1), (y0), (y1), (z0), (z1), \
+             [=]( const int (i), const int (j), const int (k) ) {fcn} ); } )
+#define \
+    FOR_ALL_ASYNC(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, FOR3D_ASYNC, _10, _9, FOR2D_ASYNC, _7, _6, FOR1D_ASYNC)(__VA_ARGS__)
+
+#define \
+    DO1D_ASYNC(instance, i, x0, x1, fcn) \
+    (instance).submit( [=]() { par_for_all( (x0), (x1)+1, \
+             [=]( const int (i) ){fcn} ); } )
+#define \
+    DO2D_ASYNC(instance, i, x0, x1, j, y0, y1, fcn)  \
+    (instance).submit( [=]() { par_for_all( (x0), (x1)+1, (y0), (y1)+1, \
+             [=]( const int (i), const int (j) ){fcn} ); } )
+#define \
+    DO3D_ASYNC(instance, i, x0, x1, j, y0, y1, k, z0, z1, fcn) \
+    (instance).submit( [=]() { par_for_all( (x0), (x1)+1, (y0), (y1)+1, (z0), (z1)+1, \
+             [=]( const int (i), const int (j), const int (k) ) {fcn} ); } )
+#define \
+    DO_ALL_ASYNC(...) \
+    GET_MACRO(__VA_ARGS__, _13, _12, DO3D_ASYNC, _10, _9, DO2D_ASYNC, _7, _6, DO1D_ASYNC)(__VA_ARGS__)
+
+
+// reduce sum on an ExecInstance, result is set once the instance is fenced
+#define \
+    RSUM1D_ASYNC(instance, i, x0, x1, var, fcn, result) \
+    (instance).submit( [=, &result]() { reduce_sum( (x0), (x1), (var),  \
+                [=]( const int (i), decltype(var) &(var) ){fcn}, \
+                (result) ); } )
+#define \
+    RSUM2D_ASYNC(instance, i, x0, x1, j, y0, y1, var, fcn, result) \
+    (instance).submit( [=, &result]() { reduce_sum( (x0), (x1), (y0), (y1), (var),  \
+                [=]( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
+                (result) ); } )
+#define \
+    RSUM3D_ASYNC(instance, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    (instance).submit( [=, &result]() { reduce_sum( (x0), (x1), (y0), (y1), (z0), (z1), (var),  \
+                [=]( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+                (result) ); } )
+
+#define \
+    REDUCE_SUM_ASYNC(...) \
+    GET_MACRO(__VA_ARGS__, RSUM3D_ASYNC, _12, _11, RSUM2D_ASYNC, _9, _8, RSUM1D_ASYNC)(__VA_ARGS__)
+
+
+// reduce max on an ExecInstance, result is set once the instance is fenced
+#define \
+    RMAX1D_ASYNC(instance, i, x0, x1, var, fcn, result) \
+    (instance).submit( [=, &result]() { reduce_max( (x0), (x1), (var),  \
+                [=]( const int (i), decltype(var) &(var) ){fcn}, \
+                (result) ); } )
+#define \
+    RMAX2D_ASYNC(instance, i, x0, x1, j, y0, y1, var, fcn, result) \
+    (instance).submit( [=, &result]() { reduce_max( (x0), (x1), (y0), (y1), (var),  \
+                [=]( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
+                (result) ); } )
+#define \
+    RMAX3D_ASYNC(instance, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    (instance).submit( [=, &result]() { reduce_max( (x0), (x1), (y0), (y1), (z0), (z1), (var),  \
+                [=]( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+                (result) ); } )
+
+#define \
+    REDUCE_MAX_ASYNC(...) \
+    GET_MACRO(__VA_ARGS__, RMAX3D_ASYNC, _12, _11, RMAX2D_ASYNC, _9, _8, RMAX1D_ASYNC)(__VA_ARGS__)
+
+
+// reduce min on an ExecInstance, result is set once the instance is fenced
+#define \
+    RMIN1D_ASYNC(instance, i, x0, x1, var, fcn, result) \
+    (instance).submit( [=, &result]() { reduce_min( (x0), (x1), (var),  \
+                [=]( const int (i), decltype(var) &(var) ){fcn}, \
+                (result) ); } )
+#define \
+    RMIN2D_ASYNC(instance, i, x0, x1, j, y0, y1, var, fcn, result) \
+    (instance).submit( [=, &result]() { reduce_min( (x0), (x1), (y0), (y1), (var),  \
+                [=]( const int (i),const int (j), decltype(var) &(var) ){fcn}, \
+                (result) ); } )
+#define \
+    RMIN3D_ASYNC(instance, i, x0, x1, j, y0, y1, k, z0, z1, var, fcn, result) \
+    (instance).submit( [=, &result]() { reduce_min( (x0), (x1), (y0), (y1), (z0), (z1), (var),  \
+                [=]( const int (i), const int (j), const int (k), decltype(var) &(var) ){fcn}, \
+                (result) ); } )
+
+#define \
+    REDUCE_MIN_ASYNC(...) \
+    GET_MACRO(__VA_ARGS__, RMIN3D_ASYNC, _12, _11, RMIN2D_ASYNC, _9, _8, RMIN1D_ASYNC)(__VA_ARGS__)
 
 
 #endif  // if not kokkos
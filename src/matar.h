@@ -76,10 +76,46 @@
 //   31. DViewFArrayKokkos
 //   32. DViewFMatrixKokkos
 
+//  ----
+//   Fixed-rank host types (rank is a template parameter)
+//   33. FArrayND
+//   34. ViewFArrayND
+//   35. FMatrixND
+//   36. ViewFMatrixND
+//   37. CArrayND
+//   38. ViewCArrayND
+//   39. CMatrixND
+//   40. ViewCMatrixND
+
+//  ----
+//   Non-owning host handles to ragged and sparse data (see borrow())
+//   41. ViewRaggedRightArray
+//   42. ViewRaggedDownArray
+//   43. ViewCSRArray
+//   44. ViewCSCArray
+
+//  ----
+//   Fixed-size types (extents are template parameters, no heap)
+//   45. FArrayFixed
+//   46. CArrayFixed
+
+//  ----
+//   Sliced ELLPACK sparse types (SELL-C-sigma, for SIMD products)
+//   47. SELLArray
+//   48. SELLArrayKokkos
+
+//  ----
+//   Block sparse types (BSR, B x B blocks with one column index each)
+//   49. BSRArray
+//   50. BSRArrayKokkos
+
 
 #include "macros.h"
 #include "host_types.h"
 #include "kokkos_types.h"
+#include "expressions.h"
+#include "batched_linalg.h"
+#include "sparse_linalg.h"
 #include "aliases.h"
 
 
@@ -0,0 +1,861 @@
+#ifndef SPARSE_LINALG_H
+#define SPARSE_LINALG_H
+/**********************************************************************************************
+ © 2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+/**********************************************************************************************
+ Sparse matrix-vector products, y = alpha*A*x + beta*y, for CSRArray, CSCArray, their
+ borrow() views, SELLArray, BSRArray, and the Kokkos CSRArrayKokkos, CSCArrayKokkos,
+ SELLArrayKokkos and BSRArrayKokkos.
+ x and y are rank 1 CArray or FArray for a host matrix and CArrayKokkos or FArrayKokkos for a
+ Kokkos matrix, and the product runs where FOR_ALL runs for them.
+
+     CSRArray <double> A(values, columns, starts, num_rows, num_cols);
+     CArray <double> x(num_cols);
+     CArray <double> y(num_rows);
+     spmv(A, x, y);              // y = A*x
+     spmv(A, x, y, 2.0, 1.0);    // y = 2*A*x + y
+
+ A CSR product has three variants:
+
+     row_per_thread  each row is one iteration of a parallel loop
+     team_per_row    each row is one Kokkos team and its threads split the row, for long rows
+                     on a device
+     merge_path      the rows and values are split evenly over the threads along the merge
+                     path of the row ends and the values, so a few very long rows do not keep
+                     one thread busy while the others wait; a row cut by a chunk boundary is
+                     finished by a fix-up pass
+
+ SpmvAlgorithm::automatic takes merge_path when the longest row is much longer than the
+ mean, team_per_row when the mean row is long and the matrix is on a device, and
+ row_per_thread otherwise.  spmv_plan() computes the row statistics and the choice, which
+ costs a pass over the row starts, so a loop that multiplies by the same matrix many times
+ should make the plan once and pass it to each spmv().  Without Kokkos there are no teams
+ and team_per_row runs as row_per_thread.
+
+ A CSC product scales y by beta and then scatters each column, alpha*x(j)*A(:,j), into it.
+ With Kokkos the columns are split over threads (one per thread, one per team or along the
+ merge path, as for the rows of CSR) and the scatter uses atomic adds.  On the host without
+ Kokkos each thread scatters its part of the merge path into its own copy of y, which are
+ then summed, so it needs one extra vector of num_rows values per thread.
+
+ A SELL-C-sigma product (SELLArray) has no variants.  On the host each iteration is a chunk
+ of C rows, one row per SIMD lane, and every lane runs to the padded width of the chunk, so
+ short irregular rows still fill the vector registers.  On a device each thread is a row and
+ the threads of a chunk read neighboring values.
+
+ A BSR product (BSRArray) takes a block row per iteration and keeps its B sums in registers,
+ with one column index per B x B block.  spmm(A, X, Y) multiplies the rank 2 X, whose rows
+ match the columns of A, into Y, column by column within each block row, so the blocks are
+ read from memory once for all the columns.
+
+ When beta is zero y is not read, so it may hold NaNs, as in the BLAS.  x and y must not
+ overlap.
+ **********************************************************************************************/
+
+#include <assert.h>
+#include <type_traits>
+#include "host_types.h"
+#ifdef HAVE_KOKKOS
+#include "kokkos_types.h"
+#endif
+#include "expressions.h"
+
+#ifndef MATAR_SPMV_IMBALANCE
+#define MATAR_SPMV_IMBALANCE 8 // merge_path when the longest row is this many times the mean
+#endif
+
+#ifndef MATAR_SPMV_TEAM_NNZ
+#define MATAR_SPMV_TEAM_NNZ 32 // team_per_row on a device when the mean row is this long
+#endif
+
+#ifndef MATAR_SPMV_PATH_ITEMS
+#define MATAR_SPMV_PATH_ITEMS 64 // rows plus values per merge path chunk on a device
+#endif
+
+
+namespace mtr
+{
+
+enum class SpmvAlgorithm {
+    automatic,
+    row_per_thread,
+    team_per_row,
+    merge_path
+};
+
+// the row length statistics of a matrix and the variant chosen from them, where
+// the rows are the columns of a CSC matrix
+struct SpmvPlan {
+    SpmvAlgorithm algorithm = SpmvAlgorithm::row_per_thread;
+    size_t num_rows = 0;
+    size_t nnz = 0;
+    size_t max_row_nnz = 0;
+    double mean_row_nnz = 0.0;
+    size_t num_chunks = 1; // merge path chunks
+};
+
+// The raw arrays of a compressed matrix, which the kernels copy.  The major
+// dimension is the compressed one, rows for CSR and columns for CSC.
+template <typename T>
+struct CompressedSparse {
+    const T* values;
+    const size_t* indices;
+    const size_t* starts;
+    size_t num_major;
+    size_t num_minor;
+    size_t nnz;
+};
+
+// The matrices that spmv takes
+template <typename S>
+struct sparse_traits {
+    static constexpr bool is_sparse = false;
+};
+
+template <typename T>
+struct sparse_traits<CSRArray<T>> {
+    static constexpr bool is_sparse = true;
+    static constexpr bool compressed_rows = true;
+    static constexpr ExprSpace space = ExprSpace::host;
+    using value_type = T;
+
+    static CompressedSparse<T> data(const CSRArray<T>& a) {
+        return {a.pointer(), a.get_columns(), a.get_starts(), a.dim1(), a.dim2(), a.get_starts()[a.dim1()]};
+    }
+};
+
+template <typename T>
+struct sparse_traits<ViewCSRArray<T>> {
+    static constexpr bool is_sparse = true;
+    static constexpr bool compressed_rows = true;
+    static constexpr ExprSpace space = ExprSpace::host;
+    using value_type = T;
+
+    static CompressedSparse<T> data(const ViewCSRArray<T>& a) {
+        return {a.pointer(), a.get_columns(), a.get_starts(), a.dim1(), a.dim2(), a.nnz()};
+    }
+};
+
+template <typename T>
+struct sparse_traits<CSCArray<T>> {
+    static constexpr bool is_sparse = true;
+    static constexpr bool compressed_rows = false;
+    static constexpr ExprSpace space = ExprSpace::host;
+    using value_type = T;
+
+    static CompressedSparse<T> data(const CSCArray<T>& a) {
+        return {a.pointer(), a.get_rows(), a.get_starts(), a.dim2(), a.dim1(), a.get_starts()[a.dim2()]};
+    }
+};
+
+template <typename T>
+struct sparse_traits<ViewCSCArray<T>> {
+    static constexpr bool is_sparse = true;
+    static constexpr bool compressed_rows = false;
+    static constexpr ExprSpace space = ExprSpace::host;
+    using value_type = T;
+
+    static CompressedSparse<T> data(const ViewCSCArray<T>& a) {
+        return {a.pointer(), a.get_rows(), a.get_starts(), a.dim2(), a.dim1(), a.nnz()};
+    }
+};
+
+#ifdef HAVE_KOKKOS
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+struct sparse_traits<CSRArrayKokkos<T,Layout,ExecSpace,MemoryTraits>> {
+    static constexpr bool is_sparse = true;
+    static constexpr bool compressed_rows = true;
+    static constexpr ExprSpace space = ExprSpace::kokkos;
+    using value_type = T;
+    using execution_space = typename Kokkos::View<T*, Layout, ExecSpace, MemoryTraits>::execution_space;
+
+    static CompressedSparse<T> data(const CSRArrayKokkos<T,Layout,ExecSpace,MemoryTraits>& a) {
+        return {a.pointer(), a.get_columns(), a.get_starts(), a.dim1(), a.dim2(), a.nnz()};
+    }
+};
+
+template <typename T, typename Layout, typename ExecSpace, typename MemoryTraits>
+struct sparse_traits<CSCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>> {
+    static constexpr bool is_sparse = true;
+    static constexpr bool compressed_rows = false;
+    static constexpr ExprSpace space = ExprSpace::kokkos;
+    using value_type = T;
+    using execution_space = typename Kokkos::View<T*, Layout, ExecSpace, MemoryTraits>::execution_space;
+
+    static CompressedSparse<T> data(const CSCArrayKokkos<T,Layout,ExecSpace,MemoryTraits>& a) {
+        return {a.pointer(), a.get_rows(), a.get_starts(), a.dim2(), a.dim1(), a.nnz()};
+    }
+};
+#endif
+
+
+// ---------------------------------------------
+// kernels, shared by the host and Kokkos paths
+// ---------------------------------------------
+
+template <typename T>
+SPARSE_INLINE_FUNCTION
+void spmv_update(T* y, size_t i, T alpha, T beta, T sum) {
+    y[i] = (beta == T(0)) ? alpha*sum : alpha*sum + beta*y[i];
+}
+
+// The point where diagonal d crosses the merge path of the row ends
+// (starts[1..num_major]) and the value indices 0..nnz-1: major is the number
+// of rows finished before it and k the number of values consumed
+SPARSE_INLINE_FUNCTION
+void merge_path_search(const size_t* starts, size_t num_major, size_t nnz, size_t diagonal,
+                       size_t& major, size_t& k) {
+    size_t lo = diagonal > nnz ? diagonal - nnz : 0;
+    size_t hi = diagonal < num_major ? diagonal : num_major;
+    while (lo < hi) {
+        size_t pivot = (lo + hi)/2;
+        if (starts[pivot+1] <= diagonal - pivot - 1) {
+            lo = pivot + 1;
+        }
+        else {
+            hi = pivot;
+        }
+    }
+    major = lo;
+    k = diagonal - lo;
+}
+
+// the ends of chunk c of the merge path split into num_chunks
+template <typename T>
+SPARSE_INLINE_FUNCTION
+void merge_path_chunk(const CompressedSparse<T>& a, size_t c, size_t num_chunks,
+                      size_t& major, size_t& k, size_t& major_end, size_t& k_end) {
+    const size_t path = a.num_major + a.nnz;
+    const size_t items = (path + num_chunks - 1)/num_chunks;
+    const size_t d0 = c*items < path ? c*items : path;
+    const size_t d1 = d0 + items < path ? d0 + items : path;
+    merge_path_search(a.starts, a.num_major, a.nnz, d0, major, k);
+    merge_path_search(a.starts, a.num_major, a.nnz, d1, major_end, k_end);
+}
+
+template <typename T, typename X>
+SPARSE_INLINE_FUNCTION
+T csr_row_dot(const CompressedSparse<T>& a, const X* x, size_t begin, size_t end) {
+    T sum = 0;
+    for (size_t k = begin; k < end; k++) {
+        sum += a.values[k]*x[a.indices[k]];
+    }
+    return sum;
+}
+
+// Chunk c of a CSR merge path product.  The rows that end in the chunk are
+// written, the first one may have started in an earlier chunk, and the partial
+// sum of the row the chunk stops in is returned in carry_row and carry for the
+// fix-up pass, y(carry_row) += alpha*carry.
+template <typename T, typename X>
+SPARSE_INLINE_FUNCTION
+void csr_merge_chunk(const CompressedSparse<T>& a, const X* x, T* y, T alpha, T beta,
+                     size_t c, size_t num_chunks, size_t& carry_row, T& carry) {
+    size_t row, k, row_end, k_end;
+    merge_path_chunk(a, c, num_chunks, row, k, row_end, k_end);
+    for (; row < row_end; row++) {
+        const size_t end = a.starts[row+1];
+        spmv_update(y, row, alpha, beta, csr_row_dot(a, x, k, end));
+        k = end;
+    }
+    carry_row = row_end;
+    carry = csr_row_dot(a, x, k, k_end);
+}
+
+// Chunk c of a CSC merge path product, adding alpha*A(i,j)*x(j) for the
+// values of the chunk into y with add(y, i, value)
+template <typename T, typename X, typename Add>
+SPARSE_INLINE_FUNCTION
+void csc_merge_chunk(const CompressedSparse<T>& a, const X* x, T* y, T alpha,
+                     size_t c, size_t num_chunks, const Add& add) {
+    size_t col, k, col_end, k_end;
+    merge_path_chunk(a, c, num_chunks, col, k, col_end, k_end);
+    for (; col <= col_end && col < a.num_major; col++) {
+        const size_t end = col < col_end ? a.starts[col+1] : k_end;
+        const T xj = alpha*x[col];
+        for (; k < end; k++) {
+            add(y, a.indices[k], a.values[k]*xj);
+        }
+    }
+}
+
+struct SparsePlainAdd {
+    template <typename T>
+    SPARSE_INLINE_FUNCTION
+    void operator()(T* y, size_t i, T value) const {
+        y[i] += value;
+    }
+};
+
+#ifdef HAVE_KOKKOS
+struct SparseAtomicAdd {
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION
+    void operator()(T* y, size_t i, T value) const {
+        Kokkos::atomic_add(&y[i], value);
+    }
+};
+#endif
+
+
+// -----------------
+// plan and dispatch
+// -----------------
+
+// threads of the host backend
+inline size_t sparse_host_concurrency() {
+#if defined(HAVE_KOKKOS)
+    return Kokkos::DefaultHostExecutionSpace::concurrency();
+#elif defined(HAVE_THREAD_POOL)
+    return get_num_threads();
+#else
+    return 1;
+#endif
+}
+
+inline SpmvAlgorithm spmv_choose(const SpmvPlan& plan, bool device, size_t concurrency) {
+    if (concurrency > 1 && plan.max_row_nnz > MATAR_SPMV_IMBALANCE*(plan.mean_row_nnz + 1.0)) {
+        return SpmvAlgorithm::merge_path;
+    }
+    if (device && plan.mean_row_nnz >= MATAR_SPMV_TEAM_NNZ) {
+        return SpmvAlgorithm::team_per_row;
+    }
+    return SpmvAlgorithm::row_per_thread;
+}
+
+// The row length statistics of a, and algorithm, or the variant they suggest
+// for automatic
+template <typename S>
+SpmvPlan spmv_plan(const S& a, SpmvAlgorithm algorithm = SpmvAlgorithm::automatic) {
+    using traits = sparse_traits<S>;
+    static_assert(traits::is_sparse, "spmv takes CSRArray, CSCArray, their views, CSRArrayKokkos or CSCArrayKokkos!");
+    const CompressedSparse<typename traits::value_type> data = traits::data(a);
+
+    SpmvPlan plan;
+    plan.num_rows = data.num_major;
+    plan.nnz = data.nnz;
+    plan.mean_row_nnz = data.num_major > 0 ? (double)data.nnz/data.num_major : 0.0;
+
+    bool device = false;
+    size_t concurrency = sparse_host_concurrency();
+#ifdef HAVE_KOKKOS
+    if constexpr (traits::space == ExprSpace::kokkos) {
+        using exec_space = typename traits::execution_space;
+        const size_t* starts = data.starts;
+        size_t max_row_nnz = 0;
+        Kokkos::parallel_reduce("mtr::spmv_plan", Kokkos::RangePolicy<exec_space>(0, data.num_major),
+                                KOKKOS_LAMBDA(const size_t i, size_t& loc_max) {
+            const size_t len = starts[i+1] - starts[i];
+            loc_max = len > loc_max ? len : loc_max;
+        }, Kokkos::Max<size_t>(max_row_nnz));
+        plan.max_row_nnz = max_row_nnz;
+        device = !std::is_same<typename exec_space::memory_space, Kokkos::HostSpace>::value;
+        concurrency = exec_space::concurrency();
+        if (device) {
+            plan.num_chunks = (data.num_major + data.nnz + MATAR_SPMV_PATH_ITEMS - 1)/MATAR_SPMV_PATH_ITEMS;
+        }
+        else {
+            plan.num_chunks = concurrency;
+        }
+    }
+#endif
+    if constexpr (traits::space == ExprSpace::host) {
+        for (size_t i = 0; i < data.num_major; i++) {
+            const size_t len = data.starts[i+1] - data.starts[i];
+            plan.max_row_nnz = len > plan.max_row_nnz ? len : plan.max_row_nnz;
+        }
+        plan.num_chunks = concurrency;
+    }
+    plan.num_chunks = plan.num_chunks > 0 ? plan.num_chunks : 1;
+
+    plan.algorithm = algorithm == SpmvAlgorithm::automatic ? spmv_choose(plan, device, concurrency) : algorithm;
+    return plan;
+}
+
+// the host path of spmv, CSRArray, CSCArray and their views
+template <typename T, typename X>
+void spmv_host(const CompressedSparse<T>& a, bool compressed_rows, const X* x, T* y,
+               T alpha, T beta, const SpmvPlan& plan) {
+    const size_t num_chunks = plan.num_chunks;
+
+    if (compressed_rows) {
+        if (plan.algorithm == SpmvAlgorithm::merge_path) {
+            CArray <size_t> carry_row(num_chunks);
+            CArray <T> carry(num_chunks);
+            host_for_each("mtr::spmv_merge_path", num_chunks, [&](size_t c) {
+                csr_merge_chunk(a, x, y, alpha, beta, c, num_chunks, carry_row(c), carry(c));
+            });
+            for (size_t c = 0; c < num_chunks; c++) {
+                if (carry_row(c) < a.num_major) y[carry_row(c)] += alpha*carry(c);
+            }
+        }
+        else {
+            host_for_each("mtr::spmv_row_per_thread", a.num_major, [&](size_t i) {
+                spmv_update(y, i, alpha, beta, csr_row_dot(a, x, a.starts[i], a.starts[i+1]));
+            });
+        }
+        return;
+    }
+
+    // CSC, each chunk scatters into its own copy of y when there are several
+    const size_t num_rows = a.num_minor;
+    if (num_chunks == 1) {
+        for (size_t i = 0; i < num_rows; i++) {
+            y[i] = (beta == T(0)) ? T(0) : beta*y[i];
+        }
+        csc_merge_chunk(a, x, y, alpha, 0, 1, SparsePlainAdd());
+        return;
+    }
+    CArray <T> partial(num_chunks, num_rows);
+    host_for_each("mtr::spmv_csc_scatter", num_chunks, [&](size_t c) {
+        T* y_c = &partial(c,0);
+        for (size_t i = 0; i < num_rows; i++) {
+            y_c[i] = T(0);
+        }
+        csc_merge_chunk(a, x, y_c, alpha, c, num_chunks, SparsePlainAdd());
+    });
+    host_for_each("mtr::spmv_csc_sum", num_rows, [&](size_t i) {
+        T sum = (beta == T(0)) ? T(0) : beta*y[i];
+        for (size_t c = 0; c < num_chunks; c++) {
+            sum += partial(c,i);
+        }
+        y[i] = sum;
+    });
+}
+
+#ifdef HAVE_KOKKOS
+// the Kokkos path of spmv, CSRArrayKokkos and CSCArrayKokkos
+template <typename ExecSpace, typename T, typename X>
+void spmv_kokkos(const CompressedSparse<T>& a, bool compressed_rows, const X* x, T* y,
+                 T alpha, T beta, const SpmvPlan& plan) {
+    using range = Kokkos::RangePolicy<ExecSpace>;
+    using policy = Kokkos::TeamPolicy<ExecSpace>;
+    using member_type = typename policy::member_type;
+    using memory_space = typename ExecSpace::memory_space;
+    const size_t num_chunks = plan.num_chunks;
+
+    if (compressed_rows) {
+        if (plan.algorithm == SpmvAlgorithm::merge_path) {
+            Kokkos::View<size_t*, memory_space> carry_row(Kokkos::view_alloc(Kokkos::WithoutInitializing, "carry_row"), num_chunks);
+            Kokkos::View<T*, memory_space> carry(Kokkos::view_alloc(Kokkos::WithoutInitializing, "carry"), num_chunks);
+            Kokkos::parallel_for("mtr::spmv_merge_path", range(0, num_chunks), KOKKOS_LAMBDA(const size_t c) {
+                csr_merge_chunk(a, x, y, alpha, beta, c, num_chunks, carry_row(c), carry(c));
+            });
+            // a row can span several chunks, so the carries are added atomically
+            Kokkos::parallel_for("mtr::spmv_merge_fixup", range(0, num_chunks), KOKKOS_LAMBDA(const size_t c) {
+                if (carry_row(c) < a.num_major) Kokkos::atomic_add(&y[carry_row(c)], alpha*carry(c));
+            });
+        }
+        else if (plan.algorithm == SpmvAlgorithm::team_per_row) {
+            Kokkos::parallel_for("mtr::spmv_team_per_row", policy(a.num_major, Kokkos::AUTO),
+                                 KOKKOS_LAMBDA(const member_type& team) {
+                const size_t i = team.league_rank();
+                T sum = 0;
+                Kokkos::parallel_reduce(Kokkos::TeamThreadRange(team, a.starts[i], a.starts[i+1]),
+                                        [&](const size_t k, T& loc_sum) {
+                    loc_sum += a.values[k]*x[a.indices[k]];
+                }, sum);
+                Kokkos::single(Kokkos::PerTeam(team), [&]() {
+                    spmv_update(y, i, alpha, beta, sum);
+                });
+            });
+        }
+        else {
+            Kokkos::parallel_for("mtr::spmv_row_per_thread", range(0, a.num_major), KOKKOS_LAMBDA(const size_t i) {
+                spmv_update(y, i, alpha, beta, csr_row_dot(a, x, a.starts[i], a.starts[i+1]));
+            });
+        }
+        return;
+    }
+
+    // CSC, scale y and then scatter the columns with atomic adds
+    Kokkos::parallel_for("mtr::spmv_csc_scale", range(0, a.num_minor), KOKKOS_LAMBDA(const size_t i) {
+        y[i] = (beta == T(0)) ? T(0) : beta*y[i];
+    });
+    if (plan.algorithm == SpmvAlgorithm::merge_path) {
+        Kokkos::parallel_for("mtr::spmv_csc_merge_path", range(0, num_chunks), KOKKOS_LAMBDA(const size_t c) {
+            csc_merge_chunk(a, x, y, alpha, c, num_chunks, SparseAtomicAdd());
+        });
+    }
+    else if (plan.algorithm == SpmvAlgorithm::team_per_row) {
+        Kokkos::parallel_for("mtr::spmv_csc_team_per_col", policy(a.num_major, Kokkos::AUTO),
+                             KOKKOS_LAMBDA(const member_type& team) {
+            const size_t j = team.league_rank();
+            const T xj = alpha*x[j];
+            Kokkos::parallel_for(Kokkos::TeamThreadRange(team, a.starts[j], a.starts[j+1]), [&](const size_t k) {
+                Kokkos::atomic_add(&y[a.indices[k]], a.values[k]*xj);
+            });
+        });
+    }
+    else {
+        Kokkos::parallel_for("mtr::spmv_csc_col_per_thread", range(0, a.num_major), KOKKOS_LAMBDA(const size_t j) {
+            const T xj = alpha*x[j];
+            for (size_t k = a.starts[j]; k < a.starts[j+1]; k++) {
+                Kokkos::atomic_add(&y[a.indices[k]], a.values[k]*xj);
+            }
+        });
+    }
+}
+#endif
+
+// y = alpha*A*x + beta*y with the variant of plan, which is from spmv_plan(A)
+template <typename S, typename X, typename Y>
+void spmv(const S& a, const X& x, const Y& y,
+          typename sparse_traits<S>::value_type alpha, typename sparse_traits<S>::value_type beta,
+          const SpmvPlan& plan) {
+    using traits = sparse_traits<S>;
+    using T = typename traits::value_type;
+    static_assert(traits::is_sparse, "spmv takes CSRArray, CSCArray, their views, CSRArrayKokkos or CSCArrayKokkos!");
+    static_assert(expr_array_traits<X>::is_array && expr_array_traits<Y>::is_array,
+                  "spmv vectors are CArray, FArray, CArrayKokkos or FArrayKokkos!");
+    static_assert(expr_array_traits<X>::space == traits::space && expr_array_traits<Y>::space == traits::space,
+                  "spmv vectors must be in the same space as the matrix!");
+    static_assert(std::is_same<typename expr_array_traits<Y>::value_type, T>::value,
+                  "spmv y must have the value type of the matrix!");
+
+    const CompressedSparse<T> data = traits::data(a);
+    [[maybe_unused]] const size_t num_rows = traits::compressed_rows ? data.num_major : data.num_minor;
+    [[maybe_unused]] const size_t num_cols = traits::compressed_rows ? data.num_minor : data.num_major;
+    assert(x.size() == num_cols && y.size() == num_rows && "spmv vectors do not match the matrix!");
+    assert(plan.num_rows == data.num_major && plan.nnz == data.nnz && "spmv plan is for another matrix!");
+    assert((const void*)x.pointer() != (const void*)y.pointer() && "spmv x and y must not overlap!");
+
+#ifdef HAVE_KOKKOS
+    if constexpr (traits::space == ExprSpace::kokkos) {
+        spmv_kokkos<typename traits::execution_space>(data, traits::compressed_rows, x.pointer(), y.pointer(),
+                                                      alpha, beta, plan);
+        return;
+    }
+#endif
+    if constexpr (traits::space == ExprSpace::host) {
+        spmv_host(data, traits::compressed_rows, x.pointer(), y.pointer(), alpha, beta, plan);
+    }
+}
+
+// y = alpha*A*x + beta*y, choosing the variant from the row lengths of A
+template <typename S, typename X, typename Y>
+void spmv(const S& a, const X& x, const Y& y,
+          typename sparse_traits<S>::value_type alpha = 1, typename sparse_traits<S>::value_type beta = 0) {
+    spmv(a, x, y, alpha, beta, spmv_plan(a));
+}
+
+// ---------------------------------------------
+// sliced ELLPACK, SELLArray and SELLArrayKokkos
+// ---------------------------------------------
+
+// The raw arrays of a SELL-C-sigma matrix, which the kernels copy
+template <typename T>
+struct SlicedSparse {
+    const T* values;
+    const size_t* columns;
+    const size_t* chunk_starts;
+    const size_t* row_order;
+    const size_t* row_lengths;
+    size_t num_rows;
+    size_t num_chunks;
+};
+
+template <typename S>
+struct sell_traits {
+    static constexpr bool is_sell = false;
+};
+
+template <typename T, size_t C>
+struct sell_traits<SELLArray<T,C>> {
+    static constexpr bool is_sell = true;
+    static constexpr size_t chunk = C;
+    static constexpr ExprSpace space = ExprSpace::host;
+    using value_type = T;
+
+    static SlicedSparse<T> data(const SELLArray<T,C>& a) {
+        return {a.pointer(), a.get_columns(), a.get_chunk_starts(), a.get_row_order(), a.get_row_lengths(),
+                a.dim1(), a.num_chunks()};
+    }
+};
+
+#ifdef HAVE_KOKKOS
+template <typename T, size_t C, typename Layout, typename ExecSpace, typename MemoryTraits>
+struct sell_traits<SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>> {
+    static constexpr bool is_sell = true;
+    static constexpr size_t chunk = C;
+    static constexpr ExprSpace space = ExprSpace::kokkos;
+    using value_type = T;
+    using execution_space = typename Kokkos::View<T*, Layout, ExecSpace, MemoryTraits>::execution_space;
+
+    static SlicedSparse<T> data(const SELLArrayKokkos<T,C,Layout,ExecSpace,MemoryTraits>& a) {
+        return {a.pointer(), a.get_columns(), a.get_chunk_starts(), a.get_row_order(), a.get_row_lengths(),
+                a.dim1(), a.num_chunks()};
+    }
+};
+#endif
+
+// Chunk c of a SELL product on the host, the C rows of the chunk in the lanes
+// of sum.  The padding is multiplied too, so the lane loop has no branch.
+template <size_t C, typename T, typename X>
+SPARSE_INLINE_FUNCTION
+void sell_chunk(const SlicedSparse<T>& a, const X* x, T* y, T alpha, T beta, size_t c) {
+    T sum[C];
+    for (size_t r = 0; r < C; r++) {
+        sum[r] = 0;
+    }
+    const size_t start = a.chunk_starts[c];
+    const size_t width = (a.chunk_starts[c+1] - start)/C;
+    for (size_t k = 0; k < width; k++) {
+        const T* values = a.values + start + k*C;
+        const size_t* columns = a.columns + start + k*C;
+        for (size_t r = 0; r < C; r++) {
+            sum[r] += values[r]*x[columns[r]];
+        }
+    }
+    for (size_t r = 0; r < C && c*C + r < a.num_rows; r++) {
+        spmv_update(y, a.row_order[c*C + r], alpha, beta, sum[r]);
+    }
+}
+
+// Sorted position s of a SELL product, one row per device thread.  The
+// threads of a chunk read neighboring values, and each stops at its own row
+// length instead of the padded width.
+template <size_t C, typename T, typename X>
+SPARSE_INLINE_FUNCTION
+void sell_row(const SlicedSparse<T>& a, const X* x, T* y, T alpha, T beta, size_t s) {
+    const size_t base = a.chunk_starts[s/C] + s%C;
+    const size_t length = a.row_lengths[s];
+    T sum = 0;
+    for (size_t k = 0; k < length; k++) {
+        sum += a.values[base + k*C]*x[a.columns[base + k*C]];
+    }
+    spmv_update(y, a.row_order[s], alpha, beta, sum);
+}
+
+// y = alpha*A*x + beta*y for a SELLArray or SELLArrayKokkos.  The host, and a
+// host execution space of Kokkos, takes a chunk per iteration with the rows in
+// SIMD lanes, a device takes a row per thread.
+template <typename S, typename X, typename Y>
+void spmv(const S& a, const X& x, const Y& y,
+          typename sell_traits<S>::value_type alpha = 1, typename sell_traits<S>::value_type beta = 0) {
+    using traits = sell_traits<S>;
+    using T = typename traits::value_type;
+    constexpr size_t C = traits::chunk;
+    static_assert(expr_array_traits<X>::is_array && expr_array_traits<Y>::is_array,
+                  "spmv vectors are CArray, FArray, CArrayKokkos or FArrayKokkos!");
+    static_assert(expr_array_traits<X>::space == traits::space && expr_array_traits<Y>::space == traits::space,
+                  "spmv vectors must be in the same space as the matrix!");
+    static_assert(std::is_same<typename expr_array_traits<Y>::value_type, T>::value,
+                  "spmv y must have the value type of the matrix!");
+    assert(x.size() == a.dim2() && y.size() == a.dim1() && "spmv vectors do not match the matrix!");
+    assert((const void*)x.pointer() != (const void*)y.pointer() && "spmv x and y must not overlap!");
+
+    const SlicedSparse<T> data = traits::data(a);
+    const auto* x_data = x.pointer();
+    T* y_data = y.pointer();
+
+#ifdef HAVE_KOKKOS
+    if constexpr (traits::space == ExprSpace::kokkos) {
+        using exec_space = typename traits::execution_space;
+        using range = Kokkos::RangePolicy<exec_space>;
+        if (std::is_same<typename exec_space::memory_space, Kokkos::HostSpace>::value) {
+            Kokkos::parallel_for("mtr::spmv_sell_chunks", range(0, data.num_chunks), KOKKOS_LAMBDA(const size_t c) {
+                sell_chunk<C>(data, x_data, y_data, alpha, beta, c);
+            });
+        }
+        else {
+            Kokkos::parallel_for("mtr::spmv_sell_rows", range(0, data.num_rows), KOKKOS_LAMBDA(const size_t s) {
+                sell_row<C>(data, x_data, y_data, alpha, beta, s);
+            });
+        }
+        return;
+    }
+#endif
+    if constexpr (traits::space == ExprSpace::host) {
+        host_for_each("mtr::spmv_sell_chunks", data.num_chunks, [&](size_t c) {
+            sell_chunk<C>(data, x_data, y_data, alpha, beta, c);
+        });
+    }
+}
+
+// --------------------------------------------
+// block sparse rows, BSRArray and BSRArrayKokkos
+// --------------------------------------------
+
+// The raw arrays of a BSR matrix, which the kernels copy
+template <typename T>
+struct BlockSparse {
+    const T* values;
+    const size_t* columns;
+    const size_t* starts;
+    size_t num_block_rows;
+};
+
+template <typename S>
+struct bsr_traits {
+    static constexpr bool is_bsr = false;
+};
+
+template <typename T, size_t B>
+struct bsr_traits<BSRArray<T,B>> {
+    static constexpr bool is_bsr = true;
+    static constexpr size_t block = B;
+    static constexpr ExprSpace space = ExprSpace::host;
+    using value_type = T;
+
+    static BlockSparse<T> data(const BSRArray<T,B>& a) {
+        return {a.pointer(), a.get_columns(), a.get_starts(), a.block_dim1()};
+    }
+};
+
+#ifdef HAVE_KOKKOS
+template <typename T, size_t B, typename Layout, typename ExecSpace, typename MemoryTraits>
+struct bsr_traits<BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>> {
+    static constexpr bool is_bsr = true;
+    static constexpr size_t block = B;
+    static constexpr ExprSpace space = ExprSpace::kokkos;
+    using value_type = T;
+    using execution_space = typename Kokkos::View<T*, Layout, ExecSpace, MemoryTraits>::execution_space;
+
+    static BlockSparse<T> data(const BSRArrayKokkos<T,B,Layout,ExecSpace,MemoryTraits>& a) {
+        return {a.pointer(), a.get_columns(), a.get_starts(), a.block_dim1()};
+    }
+};
+#endif
+
+// Block row ib of a BSR product against column c of X, whose rows are
+// row_stride apart (a vector is one column with row_stride 1).  The B sums of
+// the block row stay in registers and each block reads B values of x.
+template <size_t B, typename T, typename X>
+SPARSE_INLINE_FUNCTION
+void bsr_row(const BlockSparse<T>& a, const X* x, size_t row_stride, T* y, size_t y_stride,
+             T alpha, T beta, size_t ib) {
+    T sum[B];
+    for (size_t bi = 0; bi < B; bi++) {
+        sum[bi] = 0;
+    }
+    for (size_t k = a.starts[ib]; k < a.starts[ib+1]; k++) {
+        const T* block = a.values + k*B*B;
+        const X* xb = x + a.columns[k]*B*row_stride;
+        for (size_t bi = 0; bi < B; bi++) {
+            for (size_t bj = 0; bj < B; bj++) {
+                sum[bi] += block[bi*B + bj]*xb[bj*row_stride];
+            }
+        }
+    }
+    for (size_t bi = 0; bi < B; bi++) {
+        spmv_update(y, (ib*B + bi)*y_stride, alpha, beta, sum[bi]);
+    }
+}
+
+// Runs bsr_row for every block row and each of the num_cols columns of X and
+// Y, a column c starting at c*col_stride
+template <typename S, typename X, typename T>
+void bsr_product(const S& a, const X* x, size_t x_row_stride, size_t x_col_stride,
+                 T* y, size_t y_row_stride, size_t y_col_stride, size_t num_cols, T alpha, T beta) {
+    using traits = bsr_traits<S>;
+    constexpr size_t B = traits::block;
+    const BlockSparse<T> data = traits::data(a);
+    const size_t num_block_rows = data.num_block_rows;
+
+#ifdef HAVE_KOKKOS
+    if constexpr (traits::space == ExprSpace::kokkos) {
+        using range = Kokkos::RangePolicy<typename traits::execution_space>;
+        Kokkos::parallel_for("mtr::bsr_product", range(0, num_block_rows*num_cols), KOKKOS_LAMBDA(const size_t n) {
+            const size_t ib = n/num_cols;
+            const size_t c = n%num_cols;
+            bsr_row<B>(data, x + c*x_col_stride, x_row_stride, y + c*y_col_stride, y_row_stride, alpha, beta, ib);
+        });
+        return;
+    }
+#endif
+    if constexpr (traits::space == ExprSpace::host) {
+        host_for_each("mtr::bsr_product", num_block_rows, [&](size_t ib) {
+            for (size_t c = 0; c < num_cols; c++) {
+                bsr_row<B>(data, x + c*x_col_stride, x_row_stride, y + c*y_col_stride, y_row_stride, alpha, beta, ib);
+            }
+        });
+    }
+}
+
+// y = alpha*A*x + beta*y for a BSRArray or BSRArrayKokkos, one block row per
+// iteration
+template <typename S, typename X, typename Y>
+void spmv(const S& a, const X& x, const Y& y,
+          typename bsr_traits<S>::value_type alpha = 1, typename bsr_traits<S>::value_type beta = 0) {
+    using traits = bsr_traits<S>;
+    using T = typename traits::value_type;
+    static_assert(expr_array_traits<X>::is_array && expr_array_traits<Y>::is_array,
+                  "spmv vectors are CArray, FArray, CArrayKokkos or FArrayKokkos!");
+    static_assert(expr_array_traits<X>::space == traits::space && expr_array_traits<Y>::space == traits::space,
+                  "spmv vectors must be in the same space as the matrix!");
+    static_assert(std::is_same<typename expr_array_traits<Y>::value_type, T>::value,
+                  "spmv y must have the value type of the matrix!");
+    assert(x.size() == a.dim2() && y.size() == a.dim1() && "spmv vectors do not match the matrix!");
+    assert((const void*)x.pointer() != (const void*)y.pointer() && "spmv x and y must not overlap!");
+
+    bsr_product(a, x.pointer(), 1, 0, y.pointer(), 1, 0, 1, alpha, beta);
+}
+
+// Y = alpha*A*X + beta*Y for a BSRArray or BSRArrayKokkos and rank 2 X and Y
+// with dim2() and dim1() rows and the same number of columns.  Each block is
+// read once per column of X, from cache after the first, so the block values
+// and indices are loaded from memory once for all the columns.
+template <typename S, typename X, typename Y>
+void spmm(const S& a, const X& x, const Y& y,
+          typename bsr_traits<S>::value_type alpha = 1, typename bsr_traits<S>::value_type beta = 0) {
+    using traits = bsr_traits<S>;
+    using T = typename traits::value_type;
+    static_assert(traits::is_bsr, "spmm takes BSRArray or BSRArrayKokkos!");
+    static_assert(expr_array_traits<X>::is_array && expr_array_traits<Y>::is_array,
+                  "spmm matrices are CArray, FArray, CArrayKokkos or FArrayKokkos!");
+    static_assert(expr_array_traits<X>::space == traits::space && expr_array_traits<Y>::space == traits::space,
+                  "spmm matrices must be in the same space as the sparse matrix!");
+    static_assert(std::is_same<typename expr_array_traits<Y>::value_type, T>::value,
+                  "spmm Y must have the value type of the matrix!");
+    assert(x.order() == 2 && y.order() == 2 && "spmm X and Y are rank 2!");
+    assert(x.dims(0) == a.dim2() && y.dims(0) == a.dim1() && x.dims(1) == y.dims(1)
+           && "spmm X and Y do not match the matrix!");
+    assert((const void*)x.pointer() != (const void*)y.pointer() && "spmm X and Y must not overlap!");
+
+    // a row is contiguous in C layout and a column in F layout
+    constexpr bool x_c = std::is_same<typename expr_array_traits<X>::layout, ExprLayoutC>::value;
+    constexpr bool y_c = std::is_same<typename expr_array_traits<Y>::layout, ExprLayoutC>::value;
+    const size_t num_cols = x.dims(1);
+    bsr_product(a, x.pointer(), x_c ? num_cols : 1, x_c ? 1 : x.dims(0),
+                y.pointer(), y_c ? num_cols : 1, y_c ? 1 : y.dims(0), num_cols, alpha, beta);
+}
+
+} // end namespace mtr
+
+#endif // SPARSE_LINALG_H
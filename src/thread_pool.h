@@ -0,0 +1,885 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+/**********************************************************************************************
+ © 2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+/**********************************************************************************************
+ A persistent thread pool that backs the non-kokkos FOR_ALL, DO_ALL, REDUCE and SCAN MACROS when
+ MATAR is configured with THREAD_POOL=ON (i.e., HAVE_THREAD_POOL is defined).  The pool is
+ created on first use and the worker threads sleep between loops, so launching a loop does not
+ create threads.
+
+ A loop with 1 to 6 indices is flattened into a single iteration space of (i_end-i_start)*...
+ iterations.  The flat range is split into chunks and each chunk decodes its first (i,j,k,...)
+ once and then walks the inner index contiguously, so the loop body sees the same inner-loop
+ order as the serial version.
+
+ The number of threads is taken from the MATAR_NUM_THREADS environment variable, or
+ std::thread::hardware_concurrency() when it is not set, and can be changed with
+ mtr::set_num_threads(n).  Chunking is static (one contiguous block per thread) by default;
+ dynamic chunking is selected with
+
+ mtr::set_loop_schedule(mtr::LoopSchedule::Dynamic, chunk_size);
+
+ where a chunk_size of 0 picks a size that gives each thread about 8 chunks.  Reductions keep
+ one partial value per thread and join the partials in thread order on the calling thread.
+ Scans always use one block per thread, summed in a first pass and rescanned from the block
+ offsets in a second pass.
+ A loop launched from inside another pool loop runs serially on the calling worker.
+
+ An mtr::ExecInstance is an in-order queue of loops with a thread pool of its own, the thread
+ pool counterpart of a Kokkos execution space instance.  The *_ASYNC MACROS queue a loop on an
+ instance and return; instance.fence() waits for the queued loops.  Loops on different
+ instances, and loops on the calling thread, run at the same time.
+
+ std::vector<mtr::ExecInstance> parts = mtr::partition_exec_space(2);
+
+ The instances do not take threads from the process wide pool, they start their own, and
+ partition_exec_space splits the number of threads of the process wide pool between them, so
+ the instances together run no more threads than it (as long as there are no more instances
+ than threads, each instance has at least one).  The workers of the process wide pool
+ sleep meanwhile, but a loop the calling thread launches on it while the instances are busy
+ runs on top of their threads.
+ **********************************************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace mtr
+{
+
+enum class LoopSchedule { Static, Dynamic };
+
+class ThreadPool {
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;              // guards the wake up of the workers
+    std::mutex run_mutex_;          // one loop at a time from outside the pool
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::atomic<size_t> generation_;
+    std::atomic<size_t> pending_;
+    std::atomic<bool> stop_;
+    void (*task_fcn_)(const void*, size_t, size_t);
+    const void* task_;
+    size_t num_threads_;
+    LoopSchedule schedule_;
+    size_t chunk_size_;
+
+    ThreadPool();
+
+    void start_workers();
+    void stop_workers();
+    void worker_loop(size_t thread_id, size_t seen);
+
+    // number of polls before a waiting thread blocks, short so that an
+    // oversubscribed machine does not spend its time spinning
+    static constexpr int spin_count = 64;
+
+    static bool& in_parallel_flag();
+
+    static ThreadPool*& current_pool();
+
+    template <typename F>
+    static void invoke(const void* task, size_t thread_id, size_t num_threads);
+
+public:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // a pool of its own, used for a partition of the threads
+    explicit ThreadPool(size_t num_threads);
+
+    // the process wide pool, created on first use
+    static ThreadPool& instance();
+
+    // the pool that loops launched from the calling thread run on, the pool of
+    // an ExecInstance on its queue thread and the process wide pool elsewhere
+    static ThreadPool& current();
+
+    // binds the calling thread to pool, nullptr restores the process wide pool
+    static void set_current(ThreadPool* pool);
+
+    // number of threads used by a loop, including the calling thread
+    size_t num_threads() const;
+
+    void set_num_threads(size_t num_threads);
+
+    LoopSchedule schedule() const;
+
+    size_t chunk_size() const;
+
+    void set_schedule(LoopSchedule schedule, size_t chunk_size);
+
+    // true on a thread that is currently executing a pool task
+    static bool in_parallel();
+
+    // runs task(thread_id, num_threads) once on every thread of the pool, the calling
+    // thread is thread 0, and returns when all of them are done
+    template <typename F>
+    void run(const F& task);
+
+    ~ThreadPool();
+
+}; // end of ThreadPool
+
+
+inline ThreadPool::ThreadPool()
+    : generation_(0), pending_(0), stop_(false),
+      task_fcn_(nullptr), task_(nullptr),
+      num_threads_(1), schedule_(LoopSchedule::Static), chunk_size_(0) {
+
+    size_t num_threads = std::thread::hardware_concurrency();
+    const char* env = getenv("MATAR_NUM_THREADS");
+    if (env != nullptr && atoi(env) > 0) {
+        num_threads = atoi(env);
+    }
+    num_threads_ = num_threads > 0 ? num_threads : 1;
+    start_workers();
+}
+
+inline ThreadPool::ThreadPool(size_t num_threads)
+    : generation_(0), pending_(0), stop_(false),
+      task_fcn_(nullptr), task_(nullptr),
+      num_threads_(num_threads > 0 ? num_threads : 1),
+      schedule_(LoopSchedule::Static), chunk_size_(0) {
+    start_workers();
+}
+
+inline ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+inline ThreadPool*& ThreadPool::current_pool() {
+    thread_local ThreadPool* pool = nullptr;
+    return pool;
+}
+
+inline ThreadPool& ThreadPool::current() {
+    ThreadPool* pool = current_pool();
+    return pool != nullptr ? *pool : instance();
+}
+
+inline void ThreadPool::set_current(ThreadPool* pool) {
+    current_pool() = pool;
+}
+
+inline bool& ThreadPool::in_parallel_flag() {
+    thread_local bool flag = false;
+    return flag;
+}
+
+inline bool ThreadPool::in_parallel() {
+    return in_parallel_flag();
+}
+
+inline size_t ThreadPool::num_threads() const {
+    return num_threads_;
+}
+
+inline void ThreadPool::set_num_threads(size_t num_threads) {
+    assert(num_threads > 0 && "num_threads must be positive in ThreadPool!");
+    assert(!in_parallel() && "set_num_threads called inside a ThreadPool loop!");
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    if (num_threads == num_threads_) return;
+    stop_workers();
+    num_threads_ = num_threads;
+    start_workers();
+}
+
+inline LoopSchedule ThreadPool::schedule() const {
+    return schedule_;
+}
+
+inline size_t ThreadPool::chunk_size() const {
+    return chunk_size_;
+}
+
+inline void ThreadPool::set_schedule(LoopSchedule schedule, size_t chunk_size) {
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    schedule_ = schedule;
+    chunk_size_ = chunk_size;
+}
+
+inline void ThreadPool::start_workers() {
+    stop_ = false;
+    for (size_t thread_id = 1; thread_id < num_threads_; thread_id++) {
+        // pass the current generation, a worker that starts late must not miss the first loop
+        workers_.emplace_back(&ThreadPool::worker_loop, this, thread_id, generation_.load());
+    }
+}
+
+inline void ThreadPool::stop_workers() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+inline void ThreadPool::worker_loop(size_t thread_id, size_t seen) {
+    while (true) {
+        // spin briefly before sleeping, back-to-back loops are the common case
+        for (int spin = 0; spin < spin_count; spin++) {
+            if (generation_.load(std::memory_order_acquire) != seen || stop_) break;
+            std::this_thread::yield();
+        }
+        if (generation_.load(std::memory_order_acquire) == seen && !stop_) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&]() {
+                return stop_ || generation_.load(std::memory_order_acquire) != seen;
+            });
+        }
+        if (stop_) return;
+
+        seen = generation_.load(std::memory_order_acquire);
+        in_parallel_flag() = true;
+        task_fcn_(task_, thread_id, num_threads_);
+        in_parallel_flag() = false;
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_.notify_one();
+        }
+    }
+}
+
+template <typename F>
+void ThreadPool::invoke(const void* task, size_t thread_id, size_t num_threads) {
+    (*static_cast<const F*>(task))(thread_id, num_threads);
+}
+
+template <typename F>
+void ThreadPool::run(const F& task) {
+    // nested loops run on the calling thread only
+    if (in_parallel() || num_threads_ == 1) {
+        bool was_parallel = in_parallel_flag();
+        in_parallel_flag() = true;
+        task(0, 1);
+        in_parallel_flag() = was_parallel;
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_fcn_ = &ThreadPool::invoke<F>;
+        task_ = &task;
+        pending_.store(workers_.size(), std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+    }
+    wake_.notify_all();
+
+    in_parallel_flag() = true;
+    task(0, num_threads_);
+    in_parallel_flag() = false;
+
+    for (int spin = 0; spin < spin_count; spin++) {
+        if (pending_.load(std::memory_order_acquire) == 0) return;
+        std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&]() { return pending_.load(std::memory_order_acquire) == 0; });
+}
+
+inline ThreadPool::~ThreadPool() {
+    stop_workers();
+}
+
+
+inline void set_num_threads(size_t num_threads) {
+    ThreadPool::instance().set_num_threads(num_threads);
+}
+
+inline size_t get_num_threads() {
+    return ThreadPool::instance().num_threads();
+}
+
+inline void set_loop_schedule(LoopSchedule schedule, size_t chunk_size = 0) {
+    ThreadPool::instance().set_schedule(schedule, chunk_size);
+}
+
+
+// -----------------------------------------
+// chunked loops over a flat iteration space
+// -----------------------------------------
+
+// calls chunk_fcn(begin, end, thread_id) over chunks that cover [0, length)
+template <typename F>
+void pool_chunks(size_t length, const F& chunk_fcn) {
+    if (length == 0) return;
+
+    ThreadPool& pool = ThreadPool::current();
+
+    if (pool.schedule() == LoopSchedule::Static) {
+        pool.run([&](size_t thread_id, size_t num_threads) {
+            size_t begin = (length * thread_id) / num_threads;
+            size_t end = (length * (thread_id + 1)) / num_threads;
+            if (begin < end) chunk_fcn(begin, end, thread_id);
+        });
+    }
+    else {
+        std::atomic<size_t> next(0);
+        pool.run([&](size_t thread_id, size_t num_threads) {
+            size_t chunk = pool.chunk_size();
+            if (chunk == 0) {
+                chunk = length / (8 * num_threads);
+                chunk = chunk > 0 ? chunk : 1;
+            }
+            while (true) {
+                size_t begin = next.fetch_add(chunk, std::memory_order_relaxed);
+                if (begin >= length) break;
+                size_t end = begin + chunk < length ? begin + chunk : length;
+                chunk_fcn(begin, end, thread_id);
+            }
+        });
+    }
+} // end pool_chunks
+
+
+// walks the flat indices [begin, end) of a 2D loop, decoding (i,j) once
+template <typename F>
+void pool_walk(size_t begin, size_t end,
+               int i_start,
+               int j_start, int j_end,
+               const F& fcn) {
+    size_t nj = j_end - j_start;
+    int i = i_start + static_cast<int>(begin / nj);
+    int j = j_start + static_cast<int>(begin % nj);
+    size_t count = end - begin;
+
+    while (count > 0) {
+        size_t row = j_end - j;
+        row = row < count ? row : count;
+        int j_stop = j + static_cast<int>(row);
+        for (int jj = j; jj < j_stop; jj++) {
+            fcn(i, jj);
+        }
+        count -= row;
+        j = j_start;
+        i++;
+    }
+} // end pool_walk
+
+
+// walks the flat indices [begin, end) of a 3D loop, decoding (i,j,k) once
+template <typename F>
+void pool_walk(size_t begin, size_t end,
+               int i_start,
+               int j_start, int j_end,
+               int k_start, int k_end,
+               const F& fcn) {
+    size_t nj = j_end - j_start;
+    size_t nk = k_end - k_start;
+    int i = i_start + static_cast<int>(begin / (nj * nk));
+    int j = j_start + static_cast<int>((begin / nk) % nj);
+    int k = k_start + static_cast<int>(begin % nk);
+    size_t count = end - begin;
+
+    while (count > 0) {
+        size_t row = k_end - k;
+        row = row < count ? row : count;
+        int k_stop = k + static_cast<int>(row);
+        for (int kk = k; kk < k_stop; kk++) {
+            fcn(i, j, kk);
+        }
+        count -= row;
+        k = k_start;
+        if (++j == j_end) {
+            j = j_start;
+            i++;
+        }
+    }
+} // end pool_walk
+
+
+// walks the flat indices [begin, end) of a loop with N > 3 indices, decoding the
+// indices once and stepping them like an odometer, fcn gets the index array
+template <size_t N, typename F>
+void pool_walk_nd(size_t begin, size_t end,
+                  const int (&start)[N], const int (&stop)[N],
+                  const F& fcn) {
+    int idx[N];
+    size_t rest = begin;
+    for (size_t d = N; d-- > 0;) {
+        size_t n = stop[d] - start[d];
+        idx[d] = start[d] + static_cast<int>(rest % n);
+        rest /= n;
+    }
+    size_t count = end - begin;
+
+    while (count > 0) {
+        size_t row = stop[N-1] - idx[N-1];
+        row = row < count ? row : count;
+        int last_stop = idx[N-1] + static_cast<int>(row);
+        for (; idx[N-1] < last_stop; idx[N-1]++) {
+            fcn(idx);
+        }
+        count -= row;
+        idx[N-1] = start[N-1];
+        for (size_t d = N-1; d-- > 0;) {
+            if (++idx[d] < stop[d]) break;
+            idx[d] = start[d];
+        }
+    }
+} // end pool_walk_nd
+
+
+// calls fcn(idx[0], ..., idx[N-1], extra...)
+template <typename F, size_t N, size_t... I, typename... E>
+void pool_apply(const F& fcn, const int (&idx)[N], std::index_sequence<I...>, E&... extra) {
+    fcn(idx[I]..., extra...);
+} // end pool_apply
+
+
+// the number of iterations of a loop with N indices, 0 if any range is empty
+template <size_t N>
+size_t pool_length(const int (&start)[N], const int (&stop)[N]) {
+    size_t length = 1;
+    for (size_t d = 0; d < N; d++) {
+        if (stop[d] <= start[d]) return 0;
+        length *= stop[d] - start[d];
+    }
+    return length;
+} // end pool_length
+
+
+// -----------------------------------------
+// parallel for
+// -----------------------------------------
+
+template <typename F>
+void pool_for_all(int i_start, int i_end,
+                  const F& lambda_fcn) {
+    if (i_end <= i_start) return;
+    pool_chunks(i_end - i_start, [&](size_t begin, size_t end, size_t) {
+        int i_stop = i_start + static_cast<int>(end);
+        for (int i = i_start + static_cast<int>(begin); i < i_stop; i++) {
+            lambda_fcn(i);
+        }
+    });
+} // end pool_for_all
+
+
+template <typename F>
+void pool_for_all(int i_start, int i_end,
+                  int j_start, int j_end,
+                  const F& lambda_fcn) {
+    if (i_end <= i_start || j_end <= j_start) return;
+    size_t length = size_t(i_end - i_start) * (j_end - j_start);
+    pool_chunks(length, [&](size_t begin, size_t end, size_t) {
+        pool_walk(begin, end, i_start, j_start, j_end, lambda_fcn);
+    });
+} // end pool_for_all
+
+
+template <typename F>
+void pool_for_all(int i_start, int i_end,
+                  int j_start, int j_end,
+                  int k_start, int k_end,
+                  const F& lambda_fcn) {
+    if (i_end <= i_start || j_end <= j_start || k_end <= k_start) return;
+    size_t length = size_t(i_end - i_start) * (j_end - j_start) * (k_end - k_start);
+    pool_chunks(length, [&](size_t begin, size_t end, size_t) {
+        pool_walk(begin, end, i_start, j_start, j_end, k_start, k_end, lambda_fcn);
+    });
+} // end pool_for_all
+
+
+template <size_t N, typename F>
+void pool_for_all_nd(const int (&start)[N], const int (&stop)[N],
+                     const F& lambda_fcn) {
+    pool_chunks(pool_length(start, stop), [&](size_t begin, size_t end, size_t) {
+        pool_walk_nd(begin, end, start, stop, [&](const int (&idx)[N]) {
+            pool_apply(lambda_fcn, idx, std::make_index_sequence<N>{});
+        });
+    });
+} // end pool_for_all_nd
+
+
+template <typename F>
+void pool_for_all(int i_start, int i_end,
+                  int j_start, int j_end,
+                  int k_start, int k_end,
+                  int l_start, int l_end,
+                  const F& lambda_fcn) {
+    const int start[] = {i_start, j_start, k_start, l_start};
+    const int stop[] = {i_end, j_end, k_end, l_end};
+    pool_for_all_nd(start, stop, lambda_fcn);
+} // end pool_for_all
+
+
+template <typename F>
+void pool_for_all(int i_start, int i_end,
+                  int j_start, int j_end,
+                  int k_start, int k_end,
+                  int l_start, int l_end,
+                  int m_start, int m_end,
+                  const F& lambda_fcn) {
+    const int start[] = {i_start, j_start, k_start, l_start, m_start};
+    const int stop[] = {i_end, j_end, k_end, l_end, m_end};
+    pool_for_all_nd(start, stop, lambda_fcn);
+} // end pool_for_all
+
+
+template <typename F>
+void pool_for_all(int i_start, int i_end,
+                  int j_start, int j_end,
+                  int k_start, int k_end,
+                  int l_start, int l_end,
+                  int m_start, int m_end,
+                  int n_start, int n_end,
+                  const F& lambda_fcn) {
+    const int start[] = {i_start, j_start, k_start, l_start, m_start, n_start};
+    const int stop[] = {i_end, j_end, k_end, l_end, m_end, n_end};
+    pool_for_all_nd(start, stop, lambda_fcn);
+} // end pool_for_all
+
+
+// -----------------------------------------
+// parallel reduce, lambda_fcn(i,...,var) updates the
+// thread partial var and join(a,b) combines partials
+// -----------------------------------------
+
+// one partial per cache line to avoid false sharing
+template <typename T>
+struct alignas(64) PoolPartial {
+    T value;
+};
+
+template <typename T, typename C, typename J>
+T pool_reduce_chunks(size_t length, T init, const C& chunk_fcn, const J& join) {
+    size_t num_threads = ThreadPool::current().num_threads();
+    std::vector<PoolPartial<T>> partials(num_threads, PoolPartial<T>{init});
+
+    pool_chunks(length, [&](size_t begin, size_t end, size_t thread_id) {
+        chunk_fcn(begin, end, partials[thread_id].value);
+    });
+
+    T result = init;
+    for (size_t thread_id = 0; thread_id < num_threads; thread_id++) {
+        result = join(result, partials[thread_id].value);
+    }
+    return result;
+} // end pool_reduce_chunks
+
+
+template <typename T, typename F, typename J>
+T pool_reduce(int i_start, int i_end,
+              T init,
+              const F& lambda_fcn, const J& join) {
+    if (i_end <= i_start) return init;
+    return pool_reduce_chunks(i_end - i_start, init,
+        [&](size_t begin, size_t end, T& var) {
+            int i_stop = i_start + static_cast<int>(end);
+            for (int i = i_start + static_cast<int>(begin); i < i_stop; i++) {
+                lambda_fcn(i, var);
+            }
+        }, join);
+} // end pool_reduce
+
+
+template <typename T, typename F, typename J>
+T pool_reduce(int i_start, int i_end,
+              int j_start, int j_end,
+              T init,
+              const F& lambda_fcn, const J& join) {
+    if (i_end <= i_start || j_end <= j_start) return init;
+    size_t length = size_t(i_end - i_start) * (j_end - j_start);
+    return pool_reduce_chunks(length, init,
+        [&](size_t begin, size_t end, T& var) {
+            pool_walk(begin, end, i_start, j_start, j_end,
+                      [&](int i, int j) { lambda_fcn(i, j, var); });
+        }, join);
+} // end pool_reduce
+
+
+template <typename T, typename F, typename J>
+T pool_reduce(int i_start, int i_end,
+              int j_start, int j_end,
+              int k_start, int k_end,
+              T init,
+              const F& lambda_fcn, const J& join) {
+    if (i_end <= i_start || j_end <= j_start || k_end <= k_start) return init;
+    size_t length = size_t(i_end - i_start) * (j_end - j_start) * (k_end - k_start);
+    return pool_reduce_chunks(length, init,
+        [&](size_t begin, size_t end, T& var) {
+            pool_walk(begin, end, i_start, j_start, j_end, k_start, k_end,
+                      [&](int i, int j, int k) { lambda_fcn(i, j, k, var); });
+        }, join);
+} // end pool_reduce
+
+
+template <size_t N, typename T, typename F, typename J>
+T pool_reduce_nd(const int (&start)[N], const int (&stop)[N],
+                 T init,
+                 const F& lambda_fcn, const J& join) {
+    size_t length = pool_length(start, stop);
+    if (length == 0) return init;
+    return pool_reduce_chunks(length, init,
+        [&](size_t begin, size_t end, T& var) {
+            pool_walk_nd(begin, end, start, stop, [&](const int (&idx)[N]) {
+                pool_apply(lambda_fcn, idx, std::make_index_sequence<N>{}, var);
+            });
+        }, join);
+} // end pool_reduce_nd
+
+
+template <typename T, typename F, typename J>
+T pool_reduce(int i_start, int i_end,
+              int j_start, int j_end,
+              int k_start, int k_end,
+              int l_start, int l_end,
+              T init,
+              const F& lambda_fcn, const J& join) {
+    const int start[] = {i_start, j_start, k_start, l_start};
+    const int stop[] = {i_end, j_end, k_end, l_end};
+    return pool_reduce_nd(start, stop, init, lambda_fcn, join);
+} // end pool_reduce
+
+
+template <typename T, typename F, typename J>
+T pool_reduce(int i_start, int i_end,
+              int j_start, int j_end,
+              int k_start, int k_end,
+              int l_start, int l_end,
+              int m_start, int m_end,
+              T init,
+              const F& lambda_fcn, const J& join) {
+    const int start[] = {i_start, j_start, k_start, l_start, m_start};
+    const int stop[] = {i_end, j_end, k_end, l_end, m_end};
+    return pool_reduce_nd(start, stop, init, lambda_fcn, join);
+} // end pool_reduce
+
+
+template <typename T, typename F, typename J>
+T pool_reduce(int i_start, int i_end,
+              int j_start, int j_end,
+              int k_start, int k_end,
+              int l_start, int l_end,
+              int m_start, int m_end,
+              int n_start, int n_end,
+              T init,
+              const F& lambda_fcn, const J& join) {
+    const int start[] = {i_start, j_start, k_start, l_start, m_start, n_start};
+    const int stop[] = {i_end, j_end, k_end, l_end, m_end, n_end};
+    return pool_reduce_nd(start, stop, init, lambda_fcn, join);
+} // end pool_reduce
+
+
+// -----------------------------------------
+// parallel scan, lambda_fcn(i,var,final) adds the
+// value of i to the running sum var, the same
+// convention as a Kokkos::parallel_scan functor
+// -----------------------------------------
+
+// Each thread takes one contiguous block.  The first pass sums the blocks with
+// final = false, the block sums are scanned on the calling thread, and the second
+// pass rescans every block from its offset with final = true.  Returns the total.
+// I is int for the SCAN MACROS and size_t for the host types.
+template <typename T, typename I, typename F>
+T pool_scan(I i_start, I i_end,
+            const F& lambda_fcn) {
+    T total = 0;
+    if (i_end <= i_start) return total;
+
+    ThreadPool& pool = ThreadPool::current();
+    size_t num_threads = pool.num_threads();
+    if (ThreadPool::in_parallel() || num_threads == 1) {
+        for (I i = i_start; i < i_end; i++) {
+            lambda_fcn(i, total, true);
+        }
+        return total;
+    }
+
+    size_t length = i_end - i_start;
+    std::vector<PoolPartial<T>> partials(num_threads, PoolPartial<T>{T(0)});
+
+    pool.run([&](size_t thread_id, size_t num_blocks) {
+        I i_begin = i_start + static_cast<I>((length * thread_id) / num_blocks);
+        I i_stop = i_start + static_cast<I>((length * (thread_id + 1)) / num_blocks);
+        for (I i = i_begin; i < i_stop; i++) {
+            lambda_fcn(i, partials[thread_id].value, false);
+        }
+    });
+
+    for (size_t thread_id = 0; thread_id < num_threads; thread_id++) {
+        T block_sum = partials[thread_id].value;
+        partials[thread_id].value = total;
+        total += block_sum;
+    }
+
+    pool.run([&](size_t thread_id, size_t num_blocks) {
+        I i_begin = i_start + static_cast<I>((length * thread_id) / num_blocks);
+        I i_stop = i_start + static_cast<I>((length * (thread_id + 1)) / num_blocks);
+        T var = partials[thread_id].value;
+        for (I i = i_begin; i < i_stop; i++) {
+            lambda_fcn(i, var, true);
+        }
+    });
+
+    return total;
+} // end pool_scan
+
+
+// -----------------------------------------
+// execution instances
+// -----------------------------------------
+
+// An in-order queue of loops with its own pool of threads.  A queue thread takes
+// the loops in order and runs them on the instance's pool, so the caller returns
+// as soon as a loop is queued.  Copies of an instance share the same queue.
+class ExecInstance {
+
+private:
+    struct Queue {
+        ThreadPool pool;
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        std::deque<std::function<void()>> tasks;
+        size_t pending;
+        bool stop;
+
+        explicit Queue(size_t num_threads);
+        ~Queue();
+        void loop();
+    };
+
+    std::shared_ptr<Queue> queue_;
+
+public:
+    // num_threads includes the queue thread, which takes part in every loop
+    explicit ExecInstance(size_t num_threads = 1);
+
+    size_t num_threads() const;
+
+    // queues task() and returns without waiting for it
+    template <typename F>
+    void submit(const F& task) const;
+
+    // waits for every task queued so far
+    void fence() const;
+
+}; // end of ExecInstance
+
+
+inline ExecInstance::Queue::Queue(size_t num_threads)
+    : pool(num_threads), pending(0), stop(false) {
+    thread = std::thread(&ExecInstance::Queue::loop, this);
+}
+
+inline ExecInstance::Queue::~Queue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+inline void ExecInstance::Queue::loop() {
+    ThreadPool::set_current(&pool);
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stop || !tasks.empty(); });
+            if (tasks.empty()) return; // stopped, with nothing left to run
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0) idle.notify_all();
+    }
+}
+
+inline ExecInstance::ExecInstance(size_t num_threads)
+    : queue_(std::make_shared<Queue>(num_threads)) {}
+
+inline size_t ExecInstance::num_threads() const {
+    return queue_->pool.num_threads();
+}
+
+template <typename F>
+void ExecInstance::submit(const F& task) const {
+    {
+        std::lock_guard<std::mutex> lock(queue_->mutex);
+        queue_->tasks.emplace_back(task);
+        queue_->pending++;
+    }
+    queue_->wake.notify_one();
+}
+
+inline void ExecInstance::fence() const {
+    std::unique_lock<std::mutex> lock(queue_->mutex);
+    queue_->idle.wait(lock, [&]() { return queue_->pending == 0; });
+}
+
+// num_partitions instances, each with a pool of its own of 1/num_partitions of
+// the threads of the process wide pool (at least 1).  The threads are new ones,
+// not taken from the process wide pool, see the comment at the top.
+inline std::vector<ExecInstance> partition_exec_space(size_t num_partitions) {
+    assert(num_partitions > 0 && "num_partitions must be positive in partition_exec_space!");
+    size_t num_threads = ThreadPool::instance().num_threads() / num_partitions;
+    std::vector<ExecInstance> instances;
+    for (size_t part = 0; part < num_partitions; part++) {
+        instances.emplace_back(num_threads > 0 ? num_threads : 1);
+    }
+    return instances;
+}
+
+} // end namespace mtr
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,281 @@
+#ifndef TILE_TUNER_H
+#define TILE_TUNER_H
+/**********************************************************************************************
+ © 2020. Triad National Security, LLC. All rights reserved.
+ This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos
+ National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S.
+ Department of Energy/National Nuclear Security Administration. All rights in the program are
+ reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear
+ Security Administration. The Government is granted for itself and others acting on its behalf a
+ nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare
+ derivative works, distribute copies to the public, perform publicly and display publicly, and
+ to permit others to do so.
+ This program is open source under the BSD-3 License.
+ Redistribution and use in source and binary forms, with or without modification, are permitted
+ provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this list of
+ conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice, this list of
+ conditions and the following disclaimer in the documentation and/or other materials
+ provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder nor the names of its contributors may be used
+ to endorse or promote products derived from this software without specific prior
+ written permission.
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************/
+
+/**********************************************************************************************
+ Tile sizes for the kokkos 2D and 3D FOR_ALL loops.  FOR_ALL_TILED takes the tile size of every
+ index, and FOR_ALL_TUNED takes a loop name and looks its tile up in a cache keyed by the loop
+ name, the extents of the loop, and the kokkos backend.  A loop that is not in the cache runs
+ with the tiles kokkos picks.
+
+ Tuning is opt-in with the MATAR_TILE_TUNING=1 environment variable.  A tuned loop that is not
+ in the cache then runs each candidate tile on one of its next executions and times it, so the
+ loop contents still run once per execution.  When every candidate has run, the fastest tile is
+ kept and appended to the cache file, MATAR_TILE_CACHE or matar_tile_cache.txt when it is not
+ set, and later runs of the program read it back.  Each line of the file is
+
+ name <tab> backend <tab> extents <tab> tile sizes
+ **********************************************************************************************/
+
+#include <Kokkos_Core.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <initializer_list>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace mtr
+{
+
+class TileTuner {
+
+private:
+    // a loop that is being tuned, times[c] is the time of candidates[c]
+    struct Tuning {
+        std::vector<std::vector<long>> candidates;
+        std::vector<double> times;
+    };
+
+    std::map<std::string, std::vector<long>> cache_;
+    std::map<std::string, Tuning> tuning_;
+    std::mutex mutex_;
+    std::string path_;
+    bool enabled_;
+
+    TileTuner();
+
+    void read_cache();
+
+    void append_cache(const std::string& key, const std::vector<long>& tile);
+
+    // the inner index gets the longest tiles, an empty tile is the kokkos default
+    static std::vector<std::vector<long>> candidates(const std::vector<long>& extents);
+
+public:
+    TileTuner(const TileTuner&) = delete;
+    TileTuner& operator=(const TileTuner&) = delete;
+
+    // the process wide tuner, reads the cache on first use
+    static TileTuner& instance();
+
+    // true when MATAR_TILE_TUNING=1
+    bool enabled() const;
+
+    static std::string key(const std::string& name, const std::vector<long>& extents);
+
+    // sets tile for the next run of the loop, empty for the kokkos default, and
+    // returns true when that run is timed and passed to record()
+    bool next_tile(const std::string& key, const std::vector<long>& extents, std::vector<long>& tile);
+
+    // the time of a run that next_tile() asked for
+    void record(const std::string& key, double seconds);
+
+}; // end of TileTuner
+
+
+inline TileTuner::TileTuner() {
+    const char* tuning = std::getenv("MATAR_TILE_TUNING");
+    enabled_ = tuning != nullptr && std::string(tuning) == "1";
+
+    const char* path = std::getenv("MATAR_TILE_CACHE");
+    path_ = path != nullptr ? path : "matar_tile_cache.txt";
+
+    read_cache();
+}
+
+inline TileTuner& TileTuner::instance() {
+    static TileTuner tuner;
+    return tuner;
+}
+
+inline bool TileTuner::enabled() const {
+    return enabled_;
+}
+
+inline std::string TileTuner::key(const std::string& name, const std::vector<long>& extents) {
+    std::ostringstream key;
+    key << name << '\t' << Kokkos::DefaultExecutionSpace::name() << '\t';
+    for (size_t d = 0; d < extents.size(); d++) {
+        key << (d > 0 ? "x" : "") << extents[d];
+    }
+    return key.str();
+}
+
+inline void TileTuner::read_cache() {
+    std::ifstream file(path_);
+    std::string line;
+    while (std::getline(file, line)) {
+        // the key is everything before the last tab
+        size_t tab = line.rfind('\t');
+        if (tab == std::string::npos) continue;
+
+        std::istringstream sizes(line.substr(tab + 1));
+        std::vector<long> tile;
+        long size;
+        while (sizes >> size) {
+            tile.push_back(size);
+        }
+        cache_[line.substr(0, tab)] = tile;
+    }
+}
+
+inline void TileTuner::append_cache(const std::string& key, const std::vector<long>& tile) {
+    std::ofstream file(path_, std::ios::app);
+    file << key << '\t';
+    for (size_t d = 0; d < tile.size(); d++) {
+        file << (d > 0 ? " " : "") << tile[d];
+    }
+    file << '\n';
+}
+
+inline std::vector<std::vector<long>> TileTuner::candidates(const std::vector<long>& extents) {
+    // at most 1024 iterations per tile, the largest block on the gpu backends
+    const long max_tile = 1024;
+    const size_t rank = extents.size();
+
+    std::vector<std::vector<long>> tiles(1);  // the kokkos default
+    for (long inner : {4, 16, 64, 256}) {
+        for (long outer : {1, 4, 16}) {
+            std::vector<long> tile(rank, 1);
+            tile[rank-1] = inner;
+            tile[rank-2] = outer;
+
+            long total = 1;
+            for (size_t d = 0; d < rank; d++) {
+                tile[d] = tile[d] < extents[d] ? tile[d] : extents[d];
+                tile[d] = tile[d] > 1 ? tile[d] : 1;
+                total *= tile[d];
+            }
+
+            bool repeated = false;
+            for (const auto& other : tiles) {
+                repeated = repeated || other == tile;
+            }
+            if (total <= max_tile && !repeated) tiles.push_back(tile);
+        }
+    }
+    return tiles;
+}
+
+inline bool TileTuner::next_tile(const std::string& key, const std::vector<long>& extents,
+                                 std::vector<long>& tile) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto cached = cache_.find(key);
+    if (cached != cache_.end()) {
+        tile = cached->second;
+        return false;
+    }
+
+    if (!enabled_) {
+        tile.clear();
+        return false;
+    }
+
+    Tuning& tuning = tuning_[key];
+    if (tuning.candidates.empty()) {
+        tuning.candidates = candidates(extents);
+    }
+    tile = tuning.candidates[tuning.times.size()];
+    return true;
+}
+
+inline void TileTuner::record(const std::string& key, double seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Tuning& tuning = tuning_[key];
+    tuning.times.push_back(seconds);
+    if (tuning.times.size() < tuning.candidates.size()) return;
+
+    size_t best = 0;
+    for (size_t c = 1; c < tuning.times.size(); c++) {
+        if (tuning.times[c] < tuning.times[best]) best = c;
+    }
+    cache_[key] = tuning.candidates[best];
+    append_cache(key, tuning.candidates[best]);
+    tuning_.erase(key);
+}
+
+
+// runs a FOR_ALL_TUNED loop with the tile from the tuner, Policy is a 2D or 3D MDRangePolicy
+template <typename Policy, typename LT, typename UT, typename F>
+void tuned_for(const std::string& name,
+               std::initializer_list<LT> lower_list,
+               std::initializer_list<UT> upper_list,
+               const F& lambda_fcn) {
+    constexpr size_t rank = Policy::rank;
+
+    typename Policy::point_type lower;
+    typename Policy::point_type upper;
+    std::vector<long> extents(rank);
+    for (size_t d = 0; d < rank; d++) {
+        lower[d] = lower_list.begin()[d];
+        upper[d] = upper_list.begin()[d];
+        extents[d] = static_cast<long>(upper[d] - lower[d]);
+    }
+
+    TileTuner& tuner = TileTuner::instance();
+    const std::string key = TileTuner::key(name, extents);
+    std::vector<long> tile;
+    bool timed = tuner.next_tile(key, extents, tile);
+
+    typename Policy::tile_type tiles;
+    for (size_t d = 0; d < rank; d++) {
+        tiles[d] = tile.size() == rank ? tile[d] : 0;
+    }
+    Policy policy(lower, upper, tiles);
+
+    if (!timed) {
+        Kokkos::parallel_for(name, policy, lambda_fcn);
+        return;
+    }
+
+    Kokkos::fence();
+    Kokkos::Timer timer;
+    Kokkos::parallel_for(name, policy, lambda_fcn);
+    Kokkos::fence();
+    tuner.record(key, timer.seconds());
+} // end tuned_for
+
+} // end namespace mtr
+
+#endif // TILE_TUNER_H
@@ -193,6 +193,35 @@ TEST(CSCArray, toSparseColArray){
     }
 }
 
+// Rows given out of order are sorted within each column
+//  | 1 0 |
+//  | 2 4 |
+//  | 3 0 |
+TEST(CSCArray, UnsortedRows){
+    CArray<int> data(4);
+    CArray<size_t> starts(3);
+    CArray<size_t> rows(4);
+    data(0) = 3; rows(0) = 2;
+    data(1) = 1; rows(1) = 0;
+    data(2) = 2; rows(2) = 1;
+    data(3) = 4; rows(3) = 1;
+    starts(0) = 0;
+    starts(1) = 3;
+    starts(2) = 4;
+    CSCArray<int> A(data, rows, starts, 3, 2);
+
+    EXPECT_EQ(0, A.get_row_flat(0));
+    EXPECT_EQ(1, A.get_row_flat(1));
+    EXPECT_EQ(2, A.get_row_flat(2));
+    EXPECT_EQ(1, A(0,0));
+    EXPECT_EQ(2, A(1,0));
+    EXPECT_EQ(3, A(2,0));
+    EXPECT_EQ(4, A(1,1));
+    EXPECT_EQ(0, A(2,1));
+    EXPECT_EQ(2, A.flat_index(2,0));
+    EXPECT_EQ(-1, A.flat_index(0,1));
+}
+
 int main(int argc, char* argv[]){
     int result = 0;
         
@@ -180,7 +180,7 @@ TEST(CSRArray, toCSCArray){
     size_t elements_row = B.nnz(1);
     size_t nnz = B.nnz();
     CArray<int> out_data(nnz);
-    CArray<size_t> out_cols(6);
+    CArray<size_t> out_cols(7);
     CArray<size_t> out_rows(nnz); // change this
     B.toCSC(out_data, out_cols, out_rows);
     int expected_data[] = {1, 2, 3, 5, 4, 6, 7, 8}; 
@@ -190,6 +190,108 @@ TEST(CSRArray, toCSCArray){
 }
 
 
+// Columns given out of order are sorted within each row, lookups use a binary
+// search, and build_hash_index() gives the same answers for long rows
+TEST(CSRArray, UnsortedColumnsAndHashIndex){
+    const size_t dim1 = 3;
+    const size_t dim2 = 400;
+    const size_t row_nnz = 200;
+    CArray<int> data(dim1*row_nnz);
+    CArray<size_t> cols(dim1*row_nnz);
+    CArray<size_t> rows(dim1 + 1);
+    size_t i, k;
+    // row i stores the odd columns, highest first, with A(i,j) = 1000*i + j
+    for(i = 0; i < dim1; i++){
+        rows(i) = i*row_nnz;
+        for(k = 0; k < row_nnz; k++){
+            size_t j = dim2 - 1 - 2*k;
+            cols(i*row_nnz + k) = j;
+            data(i*row_nnz + k) = 1000*i + j;
+        }
+    }
+    rows(dim1) = dim1*row_nnz;
+    CSRArray<int> A(data, cols, rows, dim1, dim2);
+
+    for(k = 1; k < A.nnz(); k++){
+        if(k % row_nnz != 0){
+            EXPECT_LT(A.get_col_flat(k-1), A.get_col_flat(k)) << "Columns not sorted at flat index " << k;
+        }
+    }
+    EXPECT_EQ(row_nnz, A.stride(1));
+
+    for(int pass = 0; pass < 2; pass++){
+        if(pass == 1){
+            A.build_hash_index(row_nnz);
+        }
+        ViewCSRArray<int> A_view = A.borrow();
+        for(i = 0; i < dim1; i++){
+            for(size_t j = 0; j < dim2; j++){
+                int expected = (j % 2 == 1) ? 1000*i + j : 0;
+                EXPECT_EQ(expected, A(i,j)) << "pass " << pass << " at " << i << " " << j;
+                EXPECT_EQ(expected, A_view(i,j)) << "pass " << pass << " at " << i << " " << j;
+                if(j % 2 == 0){
+                    EXPECT_EQ(A.nnz(), A.flat_index(i,j));
+                }
+            }
+        }
+    }
+}
+
+// CSR -> CSC -> CSR on a matrix large enough to be split into several blocks
+// when the thread pool is enabled
+TEST(CSRArray, TransposeRoundTrip){
+    const size_t dim1 = 300;
+    const size_t dim2 = 200;
+    size_t i, j, k;
+    size_t nnz = 0;
+    for(i = 0; i < dim1; i++){
+        for(j = 0; j < dim2; j++){
+            if((7*i + 13*j) % 5 == 0) nnz++;
+        }
+    }
+    CArray<int> data(nnz);
+    CArray<size_t> cols(nnz);
+    CArray<size_t> rows(dim1 + 1);
+    k = 0;
+    for(i = 0; i < dim1; i++){
+        rows(i) = k;
+        for(j = 0; j < dim2; j++){
+            if((7*i + 13*j) % 5 == 0){
+                cols(k) = j;
+                data(k) = 1000*i + j + 1;
+                k++;
+            }
+        }
+    }
+    rows(dim1) = nnz;
+    CSRArray<int> A(data, cols, rows, dim1, dim2);
+
+    CSCArray<int> B(A);
+    EXPECT_EQ(nnz, B.nnz());
+    for(j = 0; j < dim2; j++){
+        for(k = B.begin_index(j) + 1; k < B.end_index(j); k++){
+            EXPECT_LT(B.get_row_flat(k-1), B.get_row_flat(k)) << "Rows not sorted in column " << j;
+        }
+    }
+    for(i = 0; i < dim1; i++){
+        for(j = 0; j < dim2; j++){
+            EXPECT_EQ(A(i,j), B(i,j)) << "at " << i << " " << j;
+        }
+    }
+
+    CArray<int> back_data(nnz);
+    CArray<size_t> back_cols(nnz);
+    CArray<size_t> back_rows(dim1 + 1);
+    B.toCSR(back_data, back_cols, back_rows);
+    for(i = 0; i <= dim1; i++){
+        EXPECT_EQ(rows(i), back_rows(i));
+    }
+    for(k = 0; k < nnz; k++){
+        EXPECT_EQ(cols(k), back_cols(k));
+        EXPECT_EQ(data(k), back_data(k));
+    }
+}
+
 int main(int argc, char* argv[]){
     int result = 0;
         
@@ -48,7 +48,7 @@ T return_ragged_type(size_t *strides, size_t dim)
  
   T ragged_type(strides, dim);
 
-  size_t size;
+  size_t size = 0;
   for (size_t i = 0; i < dim; i++) {
     size += strides[i];
   }
@@ -251,6 +251,1326 @@ TEST(StandaredTypesTests, FunctionModifyRaggedTypes)
   }
 }
 
+TEST(StandaredTypesTests, FixedRankDenseTypesMatchRuntimeRank)
+{
+  // the fixed-rank types must address the same element as the runtime-rank
+  // type with the same layout for every index
+  const size_t d0 = 3, d1 = 4, d2 = 5;
+
+  FArray <int> farray(d0, d1, d2);
+  FArrayND <int,3> farray_nd(d0, d1, d2);
+  CArray <int> carray(d0, d1, d2);
+  CArrayND <int,3> carray_nd(d0, d1, d2);
+  for (size_t i = 0; i < farray.size(); i++) {
+    farray.pointer()[i] = farray_nd.pointer()[i] = i;
+    carray.pointer()[i] = carray_nd.pointer()[i] = i;
+  }
+  ViewFArrayND <int,3> view_farray_nd(farray.pointer(), d0, d1, d2);
+  ViewCArrayND <int,3> view_carray_nd(carray.pointer(), d0, d1, d2);
+
+  for (size_t i = 0; i < d0; i++) {
+    for (size_t j = 0; j < d1; j++) {
+      for (size_t k = 0; k < d2; k++) {
+        EXPECT_EQ(farray(i,j,k), farray_nd(i,j,k));
+        EXPECT_EQ(farray(i,j,k), view_farray_nd(i,j,k));
+        EXPECT_EQ(carray(i,j,k), carray_nd(i,j,k));
+        EXPECT_EQ(carray(i,j,k), view_carray_nd(i,j,k));
+      }
+    }
+  }
+
+  FMatrix <int> fmatrix(d0, d1, d2);
+  FMatrixND <int,3> fmatrix_nd(d0, d1, d2);
+  CMatrix <int> cmatrix(d0, d1, d2);
+  CMatrixND <int,3> cmatrix_nd(d0, d1, d2);
+  for (size_t i = 0; i < fmatrix.size(); i++) {
+    fmatrix.pointer()[i] = fmatrix_nd.pointer()[i] = i;
+    cmatrix.pointer()[i] = cmatrix_nd.pointer()[i] = i;
+  }
+  ViewFMatrixND <int,3> view_fmatrix_nd(fmatrix.pointer(), d0, d1, d2);
+  ViewCMatrixND <int,3> view_cmatrix_nd(cmatrix.pointer(), d0, d1, d2);
+
+  for (size_t i = 1; i <= d0; i++) {
+    for (size_t j = 1; j <= d1; j++) {
+      for (size_t k = 1; k <= d2; k++) {
+        EXPECT_EQ(fmatrix(i,j,k), fmatrix_nd(i,j,k));
+        EXPECT_EQ(fmatrix(i,j,k), view_fmatrix_nd(i,j,k));
+        EXPECT_EQ(cmatrix(i,j,k), cmatrix_nd(i,j,k));
+        EXPECT_EQ(cmatrix(i,j,k), view_cmatrix_nd(i,j,k));
+      }
+    }
+  }
+
+  EXPECT_EQ(3, carray_nd.order());
+  EXPECT_EQ(d1, carray_nd.dims(1));
+  EXPECT_EQ(d1, cmatrix_nd.dims(2));
+  EXPECT_EQ(d0*d1*d2, fmatrix_nd.size());
+}
+
+TEST(StandaredTypesTests, AlignedAndPaddedAllocation)
+{
+  // 5 doubles in the fastest dimension pad to 8, one 64-byte line
+  const size_t d0 = 3, d1 = 4, d2 = 5;
+
+  CArray <double> carray(d0, d1, d2);
+  CArray <double> carray_padded(d0, d1, d2, simd_padded<double>());
+  FArray <double> farray_padded(d2, d1, d0, simd_padded<double>());
+  CMatrix <double> cmatrix_padded(d0, d1, d2, simd_padded<double>());
+  FMatrix <double> fmatrix_padded(d2, d1, d0, simd_padded<double>());
+
+  EXPECT_EQ(0, (size_t) carray.pointer() % MATAR_HOST_ALIGNMENT);
+  EXPECT_EQ(0, (size_t) carray_padded.pointer() % 64);
+  EXPECT_EQ(0, (size_t) fmatrix_padded.pointer() % 64);
+  EXPECT_EQ(d0*d1*d2, carray.size());
+  EXPECT_EQ(d0*d1*8, carray_padded.size());
+  EXPECT_EQ(d2, carray_padded.dims(2));
+
+  // every row (column) starts on its own line
+  EXPECT_EQ(8, &carray_padded(0,1,0) - &carray_padded(0,0,0));
+  EXPECT_EQ(8, &farray_padded(0,1,0) - &farray_padded(0,0,0));
+  EXPECT_EQ(8, &cmatrix_padded(1,2,1) - &cmatrix_padded(1,1,1));
+  EXPECT_EQ(8, &fmatrix_padded(1,2,1) - &fmatrix_padded(1,1,1));
+
+  for (size_t i = 0; i < d0; i++) {
+    for (size_t j = 0; j < d1; j++) {
+      for (size_t k = 0; k < d2; k++) {
+        carray(i,j,k) = carray_padded(i,j,k) = 100*i + 10*j + k;
+        farray_padded(k,j,i) = carray(i,j,k);
+        cmatrix_padded(i+1,j+1,k+1) = carray(i,j,k);
+        fmatrix_padded(k+1,j+1,i+1) = carray(i,j,k);
+      }
+    }
+  }
+  for (size_t i = 0; i < d0; i++) {
+    for (size_t j = 0; j < d1; j++) {
+      for (size_t k = 0; k < d2; k++) {
+        EXPECT_EQ(carray(i,j,k), carray_padded(i,j,k));
+        EXPECT_EQ(carray(i,j,k), farray_padded(k,j,i));
+        EXPECT_EQ(carray(i,j,k), cmatrix_padded(i+1,j+1,k+1));
+        EXPECT_EQ(carray(i,j,k), fmatrix_padded(k+1,j+1,i+1));
+      }
+    }
+  }
+
+  // copies keep the padded strides
+  CArray <double> carray_copy = carray_padded;
+  EXPECT_EQ(&carray_padded(2,3,4), &carray_copy(2,3,4));
+
+  // a user-chosen alignment
+  AllocPolicy page;
+  page.alignment = 4096;
+  FArray <int> farray_page(10, page);
+  EXPECT_EQ(0, (size_t) farray_page.pointer() % 4096);
+}
+
+TEST(StandaredTypesTests, PoolAndArenaAllocators)
+{
+  // scratch arrays made and dropped in a loop reuse the first block
+  PoolAllocator pool("pool test");
+  AllocPolicy pooled;
+  pooled.allocator = &pool;
+  double* first = nullptr;
+  for (int step = 0; step < 100; step++) {
+    CArray <double> scratch(10, 10, pooled);
+    scratch(9,9) = step;
+    if (step == 0) first = scratch.pointer();
+    EXPECT_EQ(first, scratch.pointer());
+    EXPECT_EQ(0, (size_t) scratch.pointer() % 64);
+  }
+  AllocStats stats = pool.stats();
+  EXPECT_EQ(100, stats.allocations);
+  EXPECT_EQ(100, stats.deallocations);
+  EXPECT_EQ(99, stats.reused);
+  EXPECT_EQ(1, stats.upstream_allocations);
+  EXPECT_EQ(0, stats.bytes_in_use);
+
+  // a copy keeps the block out of the pool
+  {
+    FArray <int> a(1000, pooled);
+    FArray <int> b = a;
+    EXPECT_EQ(4096, pool.stats().bytes_in_use);
+  }
+  EXPECT_EQ(0, pool.stats().bytes_in_use);
+
+  // everything made in a scope is given back at its end, and nested scopes
+  // give back only their own
+  ArenaAllocator arena("arena test", nullptr, 4096);
+  AllocPolicy scratch;
+  scratch.allocator = &arena;
+  for (int step = 0; step < 10; step++) {
+    ArenaScope outer(arena);
+    CArray <double> a(16, scratch);
+    {
+      ArenaScope inner(arena);
+      CArray <double> b(16, scratch);
+      CArray <double> c(1000, scratch); // larger than a chunk
+      EXPECT_EQ(0, (size_t) b.pointer() % 64);
+      EXPECT_EQ(0, (size_t) c.pointer() % 64);
+      EXPECT_EQ(a.pointer() + 16, b.pointer());
+    }
+    CArray <double> d(16, scratch);
+    EXPECT_EQ(a.pointer() + 16, d.pointer());
+  }
+  EXPECT_EQ(40, arena.stats().allocations);
+  EXPECT_EQ(2, arena.stats().upstream_allocations);
+  EXPECT_EQ(0, arena.stats().bytes_in_use);
+}
+
+TEST(StandaredTypesTests, FirstTouchInitialization)
+{
+  // reuse arena memory that holds old values, so only the requested
+  // initialization can zero it
+  ArenaAllocator arena("init test");
+  AllocPolicy stale;
+  stale.allocator = &arena;
+  {
+    ArenaScope scope(arena);
+    CArray <double> old(100, 100, stale);
+    for (size_t i = 0; i < old.size(); i++) {
+      old.pointer()[i] = 7.0;
+    }
+  }
+
+  AllocPolicy touched = first_touch();
+  touched.allocator = &arena;
+  AllocPolicy zeroed;
+  zeroed.init = ArrayInit::zero;
+  zeroed.allocator = &arena;
+  for (AllocPolicy policy : {touched, zeroed}) {
+    ArenaScope scope(arena);
+    CArray <double> a(100, 100, policy);
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); i++) {
+      sum += a.pointer()[i];
+    }
+    EXPECT_EQ(0.0, sum);
+  }
+
+  // first touch keeps the padding and alignment of the policy
+  AllocPolicy padded = simd_padded<double>();
+  padded.init = ArrayInit::first_touch;
+  FArray <double> b(10, 3, padded);
+  EXPECT_EQ(48, b.size());
+  EXPECT_EQ(0, (size_t) b.pointer() % 64);
+  EXPECT_EQ(0.0, b(9,2));
+}
+
+TEST(StandaredTypesTests, ElementwiseExpressions)
+{
+  const double dt = 0.5;
+  CArray <double> a(4, 5, 6);
+  CArray <double> b(4, 5, 6);
+  CArray <double> c(4, 5, 6);
+  CArray <double> d(4, 5, 6);
+  for (size_t i = 0; i < 4; i++) {
+    for (size_t j = 0; j < 5; j++) {
+      for (size_t k = 0; k < 6; k++) {
+        b(i,j,k) = i + j + k;
+        c(i,j,k) = i * j * k;
+        d(i,j,k) = 1.0;
+      }
+    }
+  }
+
+  // one fused update, the inputs are untouched
+  a = b + dt*c - d;
+  EXPECT_EQ(3 + 4 + 5 + dt*60 - 1.0, a(3,4,5));
+  EXPECT_EQ(-1.0, a(0,0,0));
+  EXPECT_EQ(60.0, c(3,4,5));
+
+  // the array assigned to may be an operand, and unary minus and division work
+  a = -a / 2.0 + a;
+  EXPECT_EQ((3 + 4 + 5 + dt*60 - 1.0) / 2.0, a(3,4,5));
+
+  // copy assignment still shares the data
+  CArray <double> e(4, 5, 6);
+  e = b;
+  EXPECT_EQ(b.pointer(), e.pointer());
+
+  // F arrays and padded storage, and integer scalars convert
+  AllocPolicy padded = simd_padded<float>();
+  padded.init = ArrayInit::zero;
+  FArray <float> f(10, 3, padded);
+  FArray <float> g(10, 3, padded);
+  g = f*0 + 2;
+  f = g*g - 1;
+  EXPECT_EQ(3.0f, f(9,2));
+  EXPECT_EQ(3.0f, f(0,0));
+}
+
+TEST(StandaredTypesTests, StridedSlicesAndSubarrays)
+{
+  CArray <double> u(4, 5, 6, simd_padded<double>());
+  for (size_t i = 0; i < 4; i++) {
+    for (size_t j = 0; j < 5; j++) {
+      for (size_t k = 0; k < 6; k++) {
+        u(i,j,k) = 100*i + 10*j + k;
+      }
+    }
+  }
+
+  // a plane, the padded stride is kept
+  ViewStridedArray <double> face = u.slice(2, 3);
+  EXPECT_EQ(2, face.order());
+  EXPECT_EQ(4, face.dims(0));
+  EXPECT_EQ(5, face.dims(1));
+  EXPECT_EQ(243, face(2,4));
+  EXPECT_EQ(8, face.stride(1));
+
+  // the interior and every other element, and views of views
+  ViewStridedArray <double> inner = u.subarray({1, 3}, {1, 4}, {1, 5});
+  EXPECT_EQ(24, inner.size());
+  EXPECT_EQ(111, inner(0,0,0));
+  EXPECT_EQ(234, inner(1,2,3));
+  ViewStridedArray <double> red = u.subarray({0, 4, 2}, SliceRange(), {1, 6, 2});
+  EXPECT_EQ(2, red.dims(0));
+  EXPECT_EQ(3, red.dims(2));
+  EXPECT_EQ(245, red(1,4,2));
+  ViewStridedArray <double> line = inner.slice(0, 1).slice(0, 2);
+  EXPECT_EQ(1, line.order());
+  EXPECT_EQ(234, line(3));
+
+  // writes go to the array
+  face(0,0) = -1.0;
+  EXPECT_EQ(-1.0, u(0,0,3));
+
+  // the matrix types keep their indices starting at 1
+  FMatrix <int> m(3, 4);
+  for (size_t j = 1; j <= 4; j++) {
+    for (size_t i = 1; i <= 3; i++) {
+      m(i,j) = 10*i + j;
+    }
+  }
+  ViewStridedMatrix <int> column = m.slice(1, 2);
+  EXPECT_EQ(12, column(1));
+  EXPECT_EQ(32, column(3));
+  ViewStridedMatrix <int> block = m.subarray({2, 4}, {2, 5, 2});
+  EXPECT_EQ(2, block.dims(0));
+  EXPECT_EQ(2, block.dims(1));
+  EXPECT_EQ(34, block(2,2));
+
+  // F arrays and the non-owning views
+  FArray <int> f(3, 4);
+  ViewFArray <int> vf(f.pointer(), 3, 4);
+  for (size_t j = 0; j < 4; j++) {
+    for (size_t i = 0; i < 3; i++) {
+      f(i,j) = 10*i + j;
+    }
+  }
+  EXPECT_EQ(f.slice(0, 2)(3), vf.slice(0, 2)(3));
+  EXPECT_EQ(23, vf.subarray({1, 3}, {1, 4, 2})(1,1));
+}
+
+TEST(StandaredTypesTests, FixedSizeArrays)
+{
+  // extents are template parameters and the data lives in the object
+  CArrayFixed <double,3,3> c(0.0);
+  FArrayFixed <double,3,3> f(0.0);
+  static_assert(sizeof(CArrayFixed <double,3,3>) == 9*sizeof(double), "no header or heap pointer");
+  static_assert(CArrayFixed <double,2,3,4>::size() == 24, "size is a compile-time constant");
+  EXPECT_EQ(2, (CArrayFixed <int,4,5>::order()));
+  EXPECT_EQ(5, (FArrayFixed <int,4,5>::dims(1)));
+
+  for (size_t i = 0; i < 3; i++) {
+    for (size_t j = 0; j < 3; j++) {
+      c(i,j) = 10*i + j;
+      f(i,j) = 10*i + j;
+    }
+  }
+  // row-major and column-major in memory
+  EXPECT_EQ(12, c.pointer()[5]);
+  EXPECT_EQ(21, f.pointer()[5]);
+
+  // value semantics, a copy does not share the data
+  CArrayFixed <double,3,3> copy = c;
+  copy(1,1) = -1.0;
+  EXPECT_EQ(11, c(1,1));
+
+  // a per-iteration temporary inside a parallel loop, the alias keeps the
+  // commas of the template arguments out of the macro arguments
+  using Tensor3x3 = FArrayFixed <double,3,3>;
+  using Vector3 = CArrayFixed <double,3>;
+  CArray <double> traces(8);
+  FOR_ALL (e, 0, 8, {
+    Tensor3x3 a(1.0);
+    a(0,0) = e;
+    Vector3 diag;
+    for (size_t n = 0; n < 3; n++) {
+      diag(n) = a(n,n);
+    }
+    traces(e) = diag(0) + diag(1) + diag(2);
+  });
+  for (size_t e = 0; e < 8; e++) {
+    EXPECT_EQ(e + 2.0, traces(e));
+  }
+}
+
+TEST(StandaredTypesTests, BatchedSmallLinearAlgebra)
+{
+  // 11 matrices, not a multiple of the host block width, each well
+  // conditioned and needing row swaps
+  const size_t num = 11;
+  const size_t n = 5;
+  FArray <double> a(num, n, n);
+  FArray <double> a_copy(num, n, n);
+  FArray <double> ainv(num, n, n);
+  FArray <double> x(num, n);
+  FArray <double> b(num, n);
+  for (size_t m = 0; m < num; m++) {
+    for (size_t i = 0; i < n; i++) {
+      for (size_t j = 0; j < n; j++) {
+        a(m,i,j) = (i == (j+1) % n) ? 10.0 + m : 1.0/(1.0 + i + 2*j + m);
+        a_copy(m,i,j) = a(m,i,j);
+      }
+      x(m,i) = 1.0 + i - 0.5*m;
+    }
+  }
+
+  // b = A x, then solve for x again
+  batched_gemv<5,5>(1.0, a, x, 0.0, b);
+  for (size_t i = 0; i < n; i++) {
+    double sum = 0.0;
+    for (size_t j = 0; j < n; j++) {
+      sum += a(3,i,j)*x(3,j);
+    }
+    EXPECT_DOUBLE_EQ(sum, b(3,i));
+  }
+
+  // the inverse times A is the identity, and A is not changed
+  batched_inverse<5>(a, ainv);
+  FArray <double> product(num, n, n);
+  batched_gemm<5,5,5>(1.0, ainv, a, 0.0, product);
+  for (size_t m = 0; m < num; m++) {
+    for (size_t i = 0; i < n; i++) {
+      for (size_t j = 0; j < n; j++) {
+        EXPECT_NEAR(i == j ? 1.0 : 0.0, product(m,i,j), 1e-12);
+        EXPECT_EQ(a_copy(m,i,j), a(m,i,j));
+      }
+    }
+  }
+
+  // det(A) det(A^-1) = 1
+  FArray <double> det(num);
+  FArray <double> det_inv(num);
+  batched_determinant<5>(a, det);
+  batched_determinant<5>(ainv, det_inv);
+  for (size_t m = 0; m < num; m++) {
+    EXPECT_NEAR(1.0, det(m)*det_inv(m), 1e-10);
+  }
+
+  // LU with the pivots kept, and solve in one call
+  FArray <double> b_copy(num, n);
+  CArray <size_t> piv(num, n);
+  for (size_t m = 0; m < num; m++) {
+    for (size_t i = 0; i < n; i++) {
+      b_copy(m,i) = b(m,i);
+    }
+  }
+  batched_lu<5>(a, piv);
+  EXPECT_NE(0, piv(0,0));
+  batched_lu_solve<5>(a, piv, b);
+  batched_solve<5>(a_copy, b_copy);
+  for (size_t m = 0; m < num; m++) {
+    for (size_t i = 0; i < n; i++) {
+      EXPECT_NEAR(x(m,i), b(m,i), 1e-12);
+      EXPECT_NEAR(x(m,i), b_copy(m,i), 1e-12);
+    }
+  }
+
+  // Cholesky of a symmetric, diagonally dominant matrix, in C order
+  CArray <double> spd(num, 4, 4);
+  CArray <double> rhs(num, 4);
+  for (size_t m = 0; m < num; m++) {
+    for (size_t i = 0; i < 4; i++) {
+      for (size_t j = 0; j < 4; j++) {
+        spd(m,i,j) = (i == j ? 4.0 : 0.0) + 1.0/(1.0 + i + j + m);
+      }
+      rhs(m,i) = 1.0;
+    }
+  }
+  CArray <double> spd_copy(num, 4, 4);
+  for (size_t m = 0; m < num; m++) {
+    for (size_t i = 0; i < 4; i++) {
+      for (size_t j = 0; j < 4; j++) {
+        spd_copy(m,i,j) = spd(m,i,j);
+      }
+    }
+  }
+  batched_cholesky<4>(spd);
+  batched_cholesky_solve<4>(spd, rhs);
+  for (size_t m = 0; m < num; m++) {
+    for (size_t i = 0; i < 4; i++) {
+      double sum = 0.0;
+      for (size_t j = 0; j < 4; j++) {
+        sum += spd_copy(m,i,j)*rhs(m,j);
+      }
+      EXPECT_NEAR(1.0, sum, 1e-12);
+    }
+  }
+
+  // the closed forms, on one matrix inside a loop body
+  using Matrix3 = CArrayFixed <double,3,3>;
+  CArray <double> dets(num);
+  CArray <double> traces(num);
+  FOR_ALL (m, 0, num, {
+    Matrix3 j_mat(0.0);
+    Matrix3 j_inv;
+    j_mat(0,0) = 2.0;
+    j_mat(1,1) = 3.0 + m;
+    j_mat(2,2) = 0.5;
+    j_mat(0,2) = 1.0;
+    dets(m) = small_determinant<3>(j_mat);
+    small_inverse<3>(j_mat, j_inv);
+    traces(m) = j_inv(0,0) + j_inv(1,1) + j_inv(2,2);
+  });
+  for (size_t m = 0; m < num; m++) {
+    EXPECT_DOUBLE_EQ(3.0 + m, dets(m));
+    EXPECT_DOUBLE_EQ(0.5 + 1.0/(3.0 + m) + 2.0, traces(m));
+  }
+}
+
+TEST(StandaredTypesTests, SparseMatrixVectorProducts)
+{
+  // 9 x 40 with a full first row, an empty row and short rows, so the
+  // merge path chunks cut rows
+  const size_t rows = 9;
+  const size_t cols = 40;
+  CArray <double> dense(rows, cols);
+  size_t nnz = 0;
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t j = 0; j < cols; j++) {
+      bool stored = (i == 0) || (i != 3 && (j == i || j == (5*i) % cols || j == cols-1-i));
+      dense(i,j) = stored ? 1.0 + i + 0.25*j : 0.0;
+      nnz += stored ? 1 : 0;
+    }
+  }
+  CArray <double> values(nnz);
+  CArray <size_t> column_index(nnz);
+  CArray <size_t> start_index(rows+1);
+  size_t k = 0;
+  for (size_t i = 0; i < rows; i++) {
+    start_index(i) = k;
+    for (size_t j = 0; j < cols; j++) {
+      if (dense(i,j) != 0.0) {
+        values(k) = dense(i,j);
+        column_index(k) = j;
+        k++;
+      }
+    }
+  }
+  start_index(rows) = k;
+  CSRArray <double> csr(values, column_index, start_index, rows, cols);
+  CSCArray <double> csc(csr);
+
+  CArray <double> x(cols);
+  CArray <double> y0(rows);
+  CArray <double> expected(rows);
+  for (size_t j = 0; j < cols; j++) {
+    x(j) = 1.0 - 0.1*j;
+  }
+  for (size_t i = 0; i < rows; i++) {
+    y0(i) = 2.0 + i;
+    double sum = 0.0;
+    for (size_t j = 0; j < cols; j++) {
+      sum += dense(i,j)*x(j);
+    }
+    expected(i) = 2.0*sum + 0.5*y0(i);
+  }
+
+  SpmvPlan plan = spmv_plan(csr);
+  EXPECT_EQ(40, plan.max_row_nnz);
+  EXPECT_EQ(nnz, plan.nnz);
+
+  // every variant, and merge path with more chunks than rows
+  SpmvAlgorithm algorithms[] = {SpmvAlgorithm::automatic, SpmvAlgorithm::row_per_thread,
+                                SpmvAlgorithm::team_per_row, SpmvAlgorithm::merge_path};
+  for (SpmvAlgorithm algorithm : algorithms) {
+    for (size_t num_chunks : {1, 4, 13}) {
+      SpmvPlan csr_plan = spmv_plan(csr, algorithm);
+      SpmvPlan csc_plan = spmv_plan(csc, algorithm);
+      if (algorithm == SpmvAlgorithm::merge_path) {
+        csr_plan.num_chunks = num_chunks;
+        csc_plan.num_chunks = num_chunks;
+      }
+      CArray <double> y_csr(rows);
+      CArray <double> y_csc(rows);
+      for (size_t i = 0; i < rows; i++) {
+        y_csr(i) = y0(i);
+        y_csc(i) = y0(i);
+      }
+      spmv(csr, x, y_csr, 2.0, 0.5, csr_plan);
+      spmv(csc, x, y_csc, 2.0, 0.5, csc_plan);
+      for (size_t i = 0; i < rows; i++) {
+        EXPECT_NEAR(expected(i), y_csr(i), 1e-12);
+        EXPECT_NEAR(expected(i), y_csc(i), 1e-12);
+      }
+    }
+  }
+
+  // beta = 0 does not read y
+  CArray <double> y(rows);
+  for (size_t i = 0; i < rows; i++) {
+    y(i) = NAN;
+  }
+  spmv(csr.borrow(), x, y);
+  EXPECT_NEAR(0.5*(expected(1) - 0.5*y0(1)), y(1), 1e-12);
+  EXPECT_EQ(0.0, y(3));
+}
+
+TEST(StandaredTypesTests, SlicedEllpackArrays)
+{
+  // 13 x 20, not a multiple of the chunk height, rows of 0 to 9 values
+  const size_t rows = 13;
+  const size_t cols = 20;
+  CArray <double> dense(rows, cols);
+  size_t nnz = 0;
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t j = 0; j < cols; j++) {
+      bool stored = (j*7 + i) % 13 < (i*3) % 10;
+      dense(i,j) = stored ? 1.0 + i + 0.5*j : 0.0;
+      nnz += stored ? 1 : 0;
+    }
+  }
+  CArray <double> values(nnz);
+  CArray <size_t> column_index(nnz);
+  CArray <size_t> start_index(rows+1);
+  size_t k = 0;
+  for (size_t i = 0; i < rows; i++) {
+    start_index(i) = k;
+    for (size_t j = 0; j < cols; j++) {
+      if (dense(i,j) != 0.0) {
+        values(k) = dense(i,j);
+        column_index(k) = j;
+        k++;
+      }
+    }
+  }
+  start_index(rows) = k;
+  CSRArray <double> csr(values, column_index, start_index, rows, cols);
+
+  CArray <double> x(cols);
+  for (size_t j = 0; j < cols; j++) {
+    x(j) = 1.0 - 0.1*j;
+  }
+
+  // sorted in windows of 8 rows and unsorted, C = 4
+  for (size_t sigma : {8, 1}) {
+    SELLArray <double,4> sell(csr, sigma);
+    EXPECT_EQ(rows, sell.dim1());
+    EXPECT_EQ(cols, sell.dim2());
+    EXPECT_EQ(nnz, sell.nnz());
+    EXPECT_EQ(4u, sell.num_chunks());
+    EXPECT_LE(nnz, sell.padded_nnz());
+    for (size_t i = 0; i < rows; i++) {
+      EXPECT_EQ(start_index(i+1) - start_index(i), sell.nnz(i));
+      for (size_t j = 0; j < cols; j++) {
+        EXPECT_EQ(dense(i,j), sell(i,j));
+      }
+    }
+
+    CArray <double> y(rows);
+    for (size_t i = 0; i < rows; i++) {
+      y(i) = 2.0 + i;
+    }
+    spmv(sell, x, y, 2.0, 0.5);
+    for (size_t i = 0; i < rows; i++) {
+      double sum = 0.0;
+      for (size_t j = 0; j < cols; j++) {
+        sum += dense(i,j)*x(j);
+      }
+      EXPECT_NEAR(2.0*sum + 0.5*(2.0 + i), y(i), 1e-12);
+    }
+  }
+
+  // sorting by length takes out padding
+  SELLArray <double,4> sorted(csr, 16);
+  SELLArray <double,4> unsorted(csr, 1);
+  EXPECT_LE(sorted.padded_nnz(), unsorted.padded_nnz());
+
+  // values are writable in place
+  size_t i_set = 5;
+  size_t j_set = 0;
+  while (dense(i_set,j_set) == 0.0) j_set++;
+  sorted(i_set,j_set) = -3.0;
+  EXPECT_EQ(-3.0, sorted(i_set,j_set));
+}
+
+TEST(StandaredTypesTests, BlockSparseArrays)
+{
+  // 3 x 3 blocks on a chain of 4 nodes, assembled from the bars between them
+  const size_t num_nodes = 4;
+  CArray <size_t> num_neighbors(num_nodes);
+  for (size_t n = 0; n < num_nodes; n++) {
+    num_neighbors(n) = (n > 0) + (n + 1 < num_nodes);
+  }
+  RaggedRightArray <size_t> nodes_in_node(num_neighbors);
+  for (size_t n = 0; n < num_nodes; n++) {
+    size_t k = 0;
+    if (n > 0) nodes_in_node(n, k++) = n - 1;
+    if (n + 1 < num_nodes) nodes_in_node(n, k++) = n + 1;
+  }
+  EXPECT_EQ(num_nodes, nodes_in_node.dim1());
+
+  BSRArray <double,3> stiffness(nodes_in_node, num_nodes);
+  EXPECT_EQ(12u, stiffness.dim1());
+  EXPECT_EQ(12u, stiffness.dim2());
+  EXPECT_EQ(10u, stiffness.nnzb());
+  EXPECT_EQ(90u, stiffness.nnz());
+  EXPECT_EQ(2u, stiffness.nnzb(0));
+  EXPECT_EQ(3u, stiffness.nnzb(1));
+  EXPECT_EQ(stiffness.nnzb(), stiffness.block_index(0, 3));
+
+  CArray <double> dense(12, 12);
+  for (size_t i = 0; i < 12; i++) {
+    for (size_t j = 0; j < 12; j++) {
+      dense(i,j) = 0.0;
+    }
+  }
+  CArray <double> local(3, 3);
+  for (size_t e = 0; e + 1 < num_nodes; e++) {
+    size_t nodes[2] = {e, e + 1};
+    for (size_t a = 0; a < 2; a++) {
+      for (size_t b = 0; b < 2; b++) {
+        for (size_t bi = 0; bi < 3; bi++) {
+          for (size_t bj = 0; bj < 3; bj++) {
+            local(bi,bj) = (a == b ? 2.0 : -1.0)*(1.0 + e + bi*3 + bj);
+            dense(nodes[a]*3 + bi, nodes[b]*3 + bj) += local(bi,bj);
+          }
+        }
+        stiffness.add_block(nodes[a], nodes[b], local);
+      }
+    }
+  }
+  for (size_t i = 0; i < 12; i++) {
+    for (size_t j = 0; j < 12; j++) {
+      EXPECT_EQ(dense(i,j), stiffness(i/3, j/3, i%3, j%3));
+    }
+  }
+
+  // the same matrix from CSR has the same blocks
+  CSRArray <double> csr(dense);
+  BSRArray <double,3> converted(csr);
+  EXPECT_EQ(stiffness.nnzb(), converted.nnzb());
+  for (size_t i = 0; i < 12; i++) {
+    for (size_t j = 0; j < 12; j++) {
+      EXPECT_EQ(dense(i,j), converted(i/3, j/3, i%3, j%3));
+    }
+  }
+
+  CArray <double> x(12);
+  CArray <double> y(12);
+  for (size_t j = 0; j < 12; j++) {
+    x(j) = 1.0 - 0.1*j;
+    y(j) = 2.0 + j;
+  }
+  spmv(stiffness, x, y, 2.0, 0.5);
+  for (size_t i = 0; i < 12; i++) {
+    double sum = 0.0;
+    for (size_t j = 0; j < 12; j++) {
+      sum += dense(i,j)*x(j);
+    }
+    EXPECT_NEAR(2.0*sum + 0.5*(2.0 + i), y(i), 1e-12);
+  }
+
+  // three right hand sides, in C and F layout
+  CArray <double> xc(12, 3);
+  CArray <double> yc(12, 3);
+  FArray <double> xf(12, 3);
+  FArray <double> yf(12, 3);
+  for (size_t j = 0; j < 12; j++) {
+    for (size_t c = 0; c < 3; c++) {
+      xc(j,c) = xf(j,c) = 0.5*c - 0.1*j;
+    }
+  }
+  spmm(stiffness, xc, yc);
+  spmm(stiffness, xf, yf);
+  for (size_t i = 0; i < 12; i++) {
+    for (size_t c = 0; c < 3; c++) {
+      double sum = 0.0;
+      for (size_t j = 0; j < 12; j++) {
+        sum += dense(i,j)*xc(j,c);
+      }
+      EXPECT_NEAR(sum, yc(i,c), 1e-12);
+      EXPECT_NEAR(sum, yf(i,c), 1e-12);
+    }
+  }
+
+  // reassembly starts from zero
+  stiffness.set_values(0.0);
+  EXPECT_EQ(0.0, stiffness(1, 2, 0, 1));
+}
+
+TEST(StandaredTypesTests, MoveDenseAndRaggedTypes)
+{
+  // moving hands over the data and leaves the source empty
+  CArray<int> carray = return_dense_type <CArray<int>>();
+  int *data = carray.pointer();
+  CArray<int> moved(std::move(carray));
+  EXPECT_EQ(data, moved.pointer());
+  EXPECT_EQ(5, moved.size());
+  EXPECT_EQ(0, carray.size());
+  EXPECT_EQ(nullptr, carray.pointer());
+
+  FMatrix<int> fmatrix;
+  fmatrix = return_dense_type <FMatrix<int>>();
+  for (size_t i = 1; i <= fmatrix.size(); i++) {
+    EXPECT_EQ(i-1, fmatrix(i));
+  }
+
+  CArrayND<int,2> carray_nd(2, 3);
+  data = carray_nd.pointer();
+  CArrayND<int,2> moved_nd;
+  moved_nd = std::move(carray_nd);
+  EXPECT_EQ(data, moved_nd.pointer());
+  EXPECT_EQ(6, moved_nd.size());
+  EXPECT_EQ(0, carray_nd.size());
+
+  const size_t dim = 4;
+  size_t strides[dim] = {3,2,1,4};
+  RaggedRightArray <int> ragged_right(strides, dim);
+  data = ragged_right.pointer();
+  RaggedRightArray <int> moved_ragged(std::move(ragged_right));
+  EXPECT_EQ(data, moved_ragged.pointer());
+  EXPECT_EQ(10, moved_ragged.size());
+  EXPECT_EQ(0, ragged_right.size());
+}
+
+
+TEST(StandaredTypesTests, BorrowSharesData)
+{
+  // a borrowed handle addresses the same memory as its owner
+  CArray<int> carray(3, 4);
+  ViewCArray<int> carray_view = carray.borrow();
+  EXPECT_EQ(carray.pointer(), carray_view.pointer());
+  EXPECT_EQ(2, carray_view.order());
+  carray_view(2,3) = 7;
+  EXPECT_EQ(7, carray(2,3));
+
+  FMatrix<int> fmatrix(3, 4);
+  ViewFMatrix<int> fmatrix_view = fmatrix.borrow();
+  fmatrix(3,2) = 5;
+  EXPECT_EQ(5, fmatrix_view(3,2));
+
+  CMatrixND<int,3> cmatrix_nd(2, 3, 4);
+  ViewCMatrixND<int,3> cmatrix_nd_view = cmatrix_nd.borrow();
+  cmatrix_nd_view(2,3,4) = 9;
+  EXPECT_EQ(9, cmatrix_nd(2,3,4));
+
+  const size_t dim = 4;
+  size_t strides[dim] = {3,2,1,4};
+  RaggedRightArray <int> ragged_right(strides, dim);
+  ViewRaggedRightArray <int> ragged_right_view = ragged_right.borrow();
+  ragged_right(3,3) = 11;
+  EXPECT_EQ(4, ragged_right_view.stride(3));
+  EXPECT_EQ(11, ragged_right_view(3,3));
+
+  RaggedDownArray <int> ragged_down(strides, dim);
+  ViewRaggedDownArray <int> ragged_down_view = ragged_down.borrow();
+  ragged_down_view(1,0) = 12;
+  EXPECT_EQ(12, ragged_down(1,0));
+
+  // [1 0 2]
+  // [0 3 0]
+  CArray<int> values(3), columns(3);
+  CArray<size_t> column_index(3), start_index(3);
+  values(0) = 1; values(1) = 2; values(2) = 3;
+  column_index(0) = 0; column_index(1) = 2; column_index(2) = 1;
+  start_index(0) = 0; start_index(1) = 2; start_index(2) = 3;
+  CSRArray<int> csr(values, column_index, start_index, 2, 3);
+  ViewCSRArray<int> csr_view = csr.borrow();
+  EXPECT_EQ(2, csr_view(0,2));
+  EXPECT_EQ(0, csr_view(1,2));
+  EXPECT_EQ(3, csr_view.nnz());
+  csr_view(1,1) = 4;
+  EXPECT_EQ(4, csr(1,1));
+}
+
+TEST(StandaredTypesTests, ForAllAndReduceMacros)
+{
+  // the macros give the same answer serially and on the thread pool
+  CArray<double> a(40, 30, 20);
+  FOR_ALL(i, 0, 40,
+          j, 0, 30,
+          k, 0, 20, {
+    a(i,j,k) = i*600 + j*20 + k;
+  });
+
+  double loc_sum = 0.0;
+  double sum;
+  REDUCE_SUM(i, 0, 40,
+             j, 0, 30,
+             k, 0, 20,
+             loc_sum, {
+    loc_sum += a(i,j,k);
+  }, sum);
+  EXPECT_EQ(0.5*24000.0*23999.0, sum);
+
+  double loc_max = 0.0;
+  double max_value;
+  REDUCE_MAX(i, 0, 40,
+             j, 0, 30,
+             loc_max, {
+    if (-a(i,j,0) > loc_max) loc_max = -a(i,j,0);
+  }, max_value);
+  EXPECT_EQ(0.0, max_value);
+
+  int loc_min = 0;
+  int min_value;
+  DO_REDUCE_MIN(i, 1, 100,
+                loc_min, {
+    if (i < loc_min) loc_min = i;
+  }, min_value);
+  EXPECT_EQ(1, min_value);
+
+  CArray<int> count(7);
+  DO_ALL(i, 0, 6, {
+    count(i) = i;
+  });
+  EXPECT_EQ(6, count(6));
+}
+
+TEST(StandaredTypesTests, HigherRankLoopMacros)
+{
+  // 4D to 6D loops visit every index once, serially and on the thread pool
+  CArray<int> a(5, 4, 3, 6);
+  FOR_ALL(i, 0, 5,
+          j, 0, 4,
+          k, 0, 3,
+          l, 0, 6, {
+    a(i,j,k,l) = ((i*4 + j)*3 + k)*6 + l;
+  });
+
+  long loc_sum = 0;
+  long sum;
+  REDUCE_SUM(i, 0, 5,
+             j, 0, 4,
+             k, 0, 3,
+             l, 0, 6,
+             loc_sum, {
+    loc_sum += a(i,j,k,l);
+  }, sum);
+  EXPECT_EQ(360L*359L/2L, sum);
+
+  CArray<int> b(3, 2, 4, 2, 5);
+  FOR_ALL(i, 0, 3,
+          j, 0, 2,
+          k, 0, 4,
+          l, 0, 2,
+          m, 0, 5, {
+    b(i,j,k,l,m) = i + j + k + l + m;
+  });
+
+  int loc_max = 0;
+  int max_value;
+  REDUCE_MAX(i, 0, 3,
+             j, 0, 2,
+             k, 0, 4,
+             l, 0, 2,
+             m, 1, 5,
+             loc_max, {
+    if (b(i,j,k,l,m) > loc_max) loc_max = b(i,j,k,l,m);
+  }, max_value);
+  EXPECT_EQ(2 + 1 + 3 + 1 + 4, max_value);
+
+  CArray<int> c(2, 3, 2, 3, 2, 4);
+  DO_ALL(i, 0, 1,
+         j, 0, 2,
+         k, 0, 1,
+         l, 0, 2,
+         m, 0, 1,
+         n, 0, 3, {
+    c(i,j,k,l,m,n) = 1 + i - j + k - l + m - n;
+  });
+
+  int loc_count = 0;
+  int count;
+  REDUCE_SUM(i, 0, 2,
+             j, 0, 3,
+             k, 0, 2,
+             l, 0, 3,
+             m, 0, 2,
+             n, 0, 4,
+             loc_count, {
+    loc_count += 1;
+  }, count);
+  EXPECT_EQ(2*3*2*3*2*4, count);
+
+  int loc_min = 0;
+  int min_value;
+  DO_REDUCE_MIN(i, 0, 1,
+                j, 0, 2,
+                k, 0, 1,
+                l, 0, 2,
+                m, 0, 1,
+                n, 0, 3,
+                loc_min, {
+    if (c(i,j,k,l,m,n) < loc_min) loc_min = c(i,j,k,l,m,n);
+  }, min_value);
+  EXPECT_EQ(1 - 2 - 2 - 3, min_value);
+}
+
+TEST(StandaredTypesTests, TiledAndTunedLoopMacros)
+{
+  // without kokkos the tiles and the loop names do not change the loops
+  CArray<int> a(6, 7, 8);
+  FOR_ALL_TILED(i, 0, 6,
+                j, 0, 7,
+                k, 0, 8,
+                2, 2, 4, {
+    a(i,j,k) = 1;
+  });
+  for (int run = 0; run < 3; run++) {
+    FOR_ALL_TUNED("tuned 3D", i, 0, 6,
+                              j, 0, 7,
+                              k, 0, 8, {
+      a(i,j,k) += i;
+    });
+  }
+  FOR_ALL_TUNED("tuned 2D", i, 0, 6,
+                            j, 0, 7, {
+    a(i,j,0) -= 1;
+  });
+
+  int loc_sum = 0;
+  int sum;
+  REDUCE_SUM(i, 0, 6,
+             j, 0, 7,
+             k, 0, 8,
+             loc_sum, {
+    loc_sum += a(i,j,k);
+  }, sum);
+  EXPECT_EQ(6*7*8 + 3*15*7*8 - 6*7, sum);
+}
+
+TEST(StandaredTypesTests, LoopProfiler)
+{
+  mtr::LoopProfiler& profiler = mtr::LoopProfiler::instance();
+  bool was_enabled = profiler.enabled();
+  profiler.set_enabled(true);
+  profiler.clear();
+
+  CArray<int> a(10, 20);
+  for (int run = 0; run < 3; run++) {
+    FOR_ALL("profiled fill", i, 0, 10,
+                             j, 0, 20, {
+      a(i,j) = i + j;
+    });
+  }
+
+  int loc_sum = 0;
+  int sum;
+  DO_REDUCE_SUM("profiled sum", i, 0, 9,
+                                loc_sum, {
+    loc_sum += a(i,0);
+  }, sum);
+  EXPECT_EQ(45, sum);
+
+  EXPECT_EQ(3u, profiler.calls("profiled fill"));
+  EXPECT_EQ(600.0, profiler.iterations("profiled fill"));
+  EXPECT_EQ(1u, profiler.calls("profiled sum"));
+  EXPECT_EQ(10.0, profiler.iterations("profiled sum"));
+
+  // a loop without a name is labeled with its file and line
+  FOR_ALL(i, 0, 4, { a(i,0) = 0; });
+  EXPECT_EQ(1u, profiler.calls(std::string(__FILE__) + ":" + std::to_string(__LINE__ - 1)));
+
+  profiler.clear();
+  profiler.set_enabled(was_enabled);
+}
+
+// sum, max and min in one pass
+struct SumMaxMin {
+  double sum;
+  double max;
+  double min;
+
+  SumMaxMin() : sum(0.0), max(-1.0e300), min(1.0e300) {}
+
+  void join(const SumMaxMin& other) {
+    sum += other.sum;
+    max = other.max > max ? other.max : max;
+    min = other.min < min ? other.min : min;
+  }
+};
+
+TEST(StandaredTypesTests, LocationAndCustomReduceMacros)
+{
+  const int n = 5000;
+  CArray<double> a(n);
+  FOR_ALL(i, 0, n, {
+    a(i) = (i*37) % 1001 - 500.0;
+  });
+  a(1234) = 2000.0;
+  a(4321) = -2000.0;
+
+  ValLoc<double> loc_max;
+  ValLoc<double> max_loc;
+  REDUCE_MAXLOC(i, 0, n,
+                loc_max, {
+    if (a(i) > loc_max.val) {
+      loc_max.val = a(i);
+      loc_max.loc = i;
+    }
+  }, max_loc);
+  EXPECT_EQ(2000.0, max_loc.val);
+  EXPECT_EQ(1234, max_loc.loc);
+
+  ValLoc<double> loc_min;
+  ValLoc<double> min_loc;
+  REDUCE_MINLOC(i, 0, n,
+                loc_min, {
+    if (a(i) < loc_min.val) {
+      loc_min.val = a(i);
+      loc_min.loc = i;
+    }
+  }, min_loc);
+  EXPECT_EQ(-2000.0, min_loc.val);
+  EXPECT_EQ(4321, min_loc.loc);
+
+  SumMaxMin loc_stats;
+  SumMaxMin stats;
+  REDUCE_CUSTOM(i, 0, n,
+                loc_stats, {
+    loc_stats.sum += a(i);
+    if (a(i) > loc_stats.max) loc_stats.max = a(i);
+    if (a(i) < loc_stats.min) loc_stats.min = a(i);
+  }, stats);
+  double sum = 0.0;
+  for (int i = 0; i < n; i++) {
+    sum += a(i);
+  }
+  EXPECT_EQ(sum, stats.sum);
+  EXPECT_EQ(2000.0, stats.max);
+  EXPECT_EQ(-2000.0, stats.min);
+
+  // the location in a 2D loop is the flat index
+  CArray<int> b(30, 40);
+  FOR_ALL(i, 0, 30,
+          j, 0, 40, {
+    b(i,j) = (i - 7)*(i - 7) + (j - 11)*(j - 11);
+  });
+  ValLoc<int> loc_low;
+  ValLoc<int> low;
+  REDUCE_MINLOC(i, 0, 30,
+                j, 0, 40,
+                loc_low, {
+    if (b(i,j) < loc_low.val) {
+      loc_low.val = b(i,j);
+      loc_low.loc = 40*i + j;
+    }
+  }, low);
+  EXPECT_EQ(0, low.val);
+  EXPECT_EQ(40*7 + 11, low.loc);
+}
+
+TEST(StandaredTypesTests, ScanMacros)
+{
+  const int n = 10000;
+  CArray<size_t> counts(n);
+  FOR_ALL(i, 0, n, {
+    counts(i) = i % 7;
+  });
+
+  // inclusive and exclusive prefix sums with the total
+  CArray<size_t> inclusive(n);
+  CArray<size_t> exclusive(n);
+  size_t offset = 0;
+  size_t total = 0;
+  FOR_SCAN(i, 0, n,
+           offset, counts(i), {
+    inclusive(i) = offset;
+  }, total);
+  FOR_SCAN_EXCLUSIVE(i, 0, n,
+                     offset, counts(i), {
+    exclusive(i) = offset;
+  });
+
+  size_t sum = 0;
+  for (int i = 0; i < n; i++) {
+    EXPECT_EQ(sum, exclusive(i));
+    sum += counts(i);
+    EXPECT_EQ(sum, inclusive(i));
+  }
+  EXPECT_EQ(sum, total);
+
+  // a scan in place, the DO loop includes the end index
+  CArray<int> starts(n + 1);
+  FOR_ALL(i, 0, n + 1, {
+    starts(i) = 1;
+  });
+  int start = 0;
+  int length = 0;
+  DO_SCAN_EXCLUSIVE(i, 0, n,
+                    start, starts(i), {
+    starts(i) = start;
+  }, length);
+  EXPECT_EQ(n + 1, length);
+  EXPECT_EQ(0, starts(0));
+  EXPECT_EQ(n, starts(n));
+
+  // the ragged types set their start indices with a scan
+  RaggedRightArray<int> ragged(counts);
+  EXPECT_EQ(sum, ragged.size());
+  EXPECT_EQ(size_t(6), ragged.stride(6));
+  EXPECT_EQ(size_t((n - 1) % 7), ragged.stride(n - 1));
+}
+
+TEST(StandaredTypesTests, TeamLoopMacros)
+{
+  // one team per row of a ragged-right array
+  const size_t dim = 5;
+  size_t strides[dim] = {3,0,7,1,4};
+  RaggedRightArray<int> ragged(strides, dim);
+  CArray<int> row_sum(dim);
+  CArray<int> row_max(dim);
+  CArray<int> row_min(dim);
+
+  FOR_FIRST(i, 0, dim, {
+    FOR_SECOND(j, 0, ragged.stride(i), {
+      ragged(i,j) = 10*i + j;
+    });
+    TEAM_BARRIER; // the row is written before it is reduced
+
+    int loc_sum = 0;
+    int sum;
+    FOR_REDUCE_SUM_SECOND(j, 0, ragged.stride(i),
+                          loc_sum, {
+      loc_sum += ragged(i,j);
+    }, sum);
+    TEAM_SINGLE({
+      row_sum(i) = sum;
+    });
+
+    int loc_max = 0;
+    int max;
+    FOR_REDUCE_MAX_SECOND(j, 0, ragged.stride(i),
+                          loc_max, {
+      if (ragged(i,j) > loc_max) loc_max = ragged(i,j);
+    }, max);
+    TEAM_SINGLE({
+      row_max(i) = max;
+    });
+
+    int loc_min = 0;
+    int min;
+    FOR_REDUCE_MIN_SECOND(j, 0, ragged.stride(i),
+                          loc_min, {
+      if (ragged(i,j) < loc_min) loc_min = ragged(i,j);
+    }, min);
+    TEAM_SINGLE({
+      row_min(i) = min;
+    });
+  });
+
+  EXPECT_EQ(0 + 1 + 2, row_sum(0));
+  EXPECT_EQ(0, row_sum(1));
+  EXPECT_EQ(7*20 + 21, row_sum(2));
+  EXPECT_EQ(26, row_max(2));
+  EXPECT_EQ(40, row_min(4));
+
+  // the vector level inside the thread level
+  CArray<int> block(4, 3, 5);
+  FOR_FIRST(i, 0, 4, {
+    FOR_SECOND(j, 0, 3, {
+      FOR_THIRD(k, 0, 5, {
+        block(i,j,k) = i + j + k;
+      });
+      int loc_sum = 0;
+      int sum;
+      FOR_REDUCE_SUM_THIRD(k, 0, 5,
+                           loc_sum, {
+        loc_sum += block(i,j,k);
+      }, sum);
+      block(i,j,0) = sum;
+    });
+  });
+  EXPECT_EQ(5*(3 + 2) + 10, block(3,2,0));
+}
+
+#ifdef HAVE_THREAD_POOL
+TEST(StandaredTypesTests, ThreadPoolSchedules)
+{
+  size_t num_threads = get_num_threads();
+  set_num_threads(4);
+
+  for (int pass = 0; pass < 2; pass++) {
+    if (pass == 1) set_loop_schedule(LoopSchedule::Dynamic, 7);
+
+    // every iteration is visited exactly once
+    CArray<int> visits(13, 17, 19);
+    for (size_t i = 0; i < visits.size(); i++) visits.pointer()[i] = 0;
+    FOR_ALL(i, 0, 13,
+            j, 0, 17,
+            k, 0, 19, {
+      visits(i,j,k) += 1;
+    });
+    int loc_sum = 0;
+    int sum;
+    REDUCE_SUM(i, 0, 13*17*19,
+               loc_sum, {
+      loc_sum += visits.pointer()[i];
+    }, sum);
+    EXPECT_EQ(13*17*19, sum);
+
+    // a loop inside a loop runs serially on the calling thread
+    CArray<int> rows(8);
+    FOR_ALL(i, 0, 8, {
+      int loc_row = 0;
+      int row;
+      REDUCE_SUM(j, 0, 100,
+                 loc_row, {
+        loc_row += j;
+      }, row);
+      rows(i) = row;
+    });
+    for (size_t i = 0; i < 8; i++) {
+      EXPECT_EQ(4950, rows(i));
+    }
+  }
+
+  set_loop_schedule(LoopSchedule::Static);
+  set_num_threads(num_threads);
+}
+#endif
+
+// loops queued on two instances, then fenced
+TEST(StandaredTypesTests, AsyncLoopsOnInstances)
+{
+  std::vector<ExecInstance> instances = partition_exec_space(2);
+  CArray<int> a(1000);
+  CArray<int> b(10, 100);
+
+  FOR_ALL_ASYNC(instances[0], i, 0, 1000, {
+    a(i) = 2*i;
+  });
+  FOR_ALL_ASYNC(instances[1], i, 0, 10,
+                j, 0, 100, {
+    b(i,j) = i + j;
+  });
+  instances[0].fence();
+
+  int loc_sum = 0;
+  int sum;
+  REDUCE_SUM_ASYNC(instances[0], i, 0, 1000,
+                   loc_sum, {
+    loc_sum += a(i);
+  }, sum);
+
+  int loc_max = 0;
+  int max;
+  instances[1].fence();
+  REDUCE_MAX_ASYNC(instances[1], i, 0, 10,
+                   j, 0, 100,
+                   loc_max, {
+    if (b(i,j) > loc_max) loc_max = b(i,j);
+  }, max);
+
+  instances[0].fence();
+  instances[1].fence();
+  EXPECT_EQ(999000, sum);
+  EXPECT_EQ(108, max);
+}
+
 int main(int argc, char* argv[])
 {
 